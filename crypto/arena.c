@@ -0,0 +1,265 @@
+/*
+ * Copyright 2025 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+#include <string.h>
+#include <openssl/crypto.h>
+#include "internal/numbers.h"
+#include "internal/arena.h"
+
+/* Every allocation is aligned to this */
+#define ARENA_ALIGN         16
+#define ARENA_ROUND(n)      (((n) + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1))
+
+/*
+ * Chunks are ARENA_CHUNK_SIZE bytes in total, header included.  Requests
+ * larger than ARENA_LARGE get a chunk of their own, which is returned to the
+ * system allocator rather than to the pool.  libssl's raw extension arrays
+ * are a little over 1 KiB and there are several of them in a handshake, so
+ * a chunk must hold a few of those.
+ */
+#define ARENA_CHUNK_SIZE    8192
+#define ARENA_LARGE         (ARENA_CHUNK_SIZE / 4)
+
+typedef struct arena_chunk_st {
+    struct arena_chunk_st *next;
+    size_t size;                /* usable bytes after the header */
+    size_t used;
+} ARENA_CHUNK;
+
+#define CHUNK_HDR_SIZE      ARENA_ROUND(sizeof(ARENA_CHUNK))
+#define CHUNK_DATA(c)       ((unsigned char *)(c) + CHUNK_HDR_SIZE)
+#define CHUNK_STD_SIZE      (ARENA_CHUNK_SIZE - CHUNK_HDR_SIZE)
+
+struct ossl_arena_pool_st {
+    CRYPTO_RWLOCK *lock;
+    ARENA_CHUNK *free_chunks;
+    size_t num_free;
+    size_t max_free;
+};
+
+struct ossl_arena_st {
+    OSSL_ARENA_POOL *pool;
+    unsigned int flags;
+    ARENA_CHUNK *home;          /* the chunk holding this structure */
+    ARENA_CHUNK *chunks;        /* the chunk in use comes first */
+    size_t in_use;
+    size_t peak;
+};
+
+#define ARENA_HDR_SIZE      ARENA_ROUND(sizeof(OSSL_ARENA))
+
+OSSL_ARENA_POOL *ossl_arena_pool_new(size_t max_chunks)
+{
+    OSSL_ARENA_POOL *pool = OPENSSL_zalloc(sizeof(*pool));
+
+    if (pool == NULL)
+        return NULL;
+    if ((pool->lock = CRYPTO_THREAD_lock_new()) == NULL) {
+        OPENSSL_free(pool);
+        return NULL;
+    }
+    pool->max_free = max_chunks;
+    return pool;
+}
+
+void ossl_arena_pool_free(OSSL_ARENA_POOL *pool)
+{
+    ARENA_CHUNK *c, *next;
+
+    if (pool == NULL)
+        return;
+    for (c = pool->free_chunks; c != NULL; c = next) {
+        next = c->next;
+        OPENSSL_free(c);
+    }
+    CRYPTO_THREAD_lock_free(pool->lock);
+    OPENSSL_free(pool);
+}
+
+static ARENA_CHUNK *chunk_get(OSSL_ARENA_POOL *pool, size_t size)
+{
+    ARENA_CHUNK *c = NULL;
+
+    if (size == CHUNK_STD_SIZE && pool != NULL
+            && CRYPTO_THREAD_write_lock(pool->lock)) {
+        if ((c = pool->free_chunks) != NULL) {
+            pool->free_chunks = c->next;
+            pool->num_free--;
+        }
+        CRYPTO_THREAD_unlock(pool->lock);
+    }
+    if (c == NULL) {
+        if ((c = OPENSSL_malloc(CHUNK_HDR_SIZE + size)) == NULL)
+            return NULL;
+        c->size = size;
+    }
+    c->next = NULL;
+    c->used = 0;
+    return c;
+}
+
+/*
+ * Give a list of standard sized chunks back to |pool|, taking its lock just
+ * once.  What the pool has no room for is freed.
+ */
+static void chunk_put_list(OSSL_ARENA_POOL *pool, ARENA_CHUNK *list)
+{
+    ARENA_CHUNK *c;
+
+    if (list != NULL && pool != NULL && CRYPTO_THREAD_write_lock(pool->lock)) {
+        while (list != NULL && pool->num_free < pool->max_free) {
+            c = list;
+            list = c->next;
+            c->next = pool->free_chunks;
+            pool->free_chunks = c;
+            pool->num_free++;
+        }
+        CRYPTO_THREAD_unlock(pool->lock);
+    }
+    for (; list != NULL; list = c) {
+        c = list->next;
+        OPENSSL_free(list);
+    }
+}
+
+/*
+ * The arena structure lives at the start of its first chunk, so that an
+ * arena costs no allocation of its own once the pool has spare chunks.
+ */
+OSSL_ARENA *ossl_arena_new(OSSL_ARENA_POOL *pool, unsigned int flags)
+{
+    ARENA_CHUNK *c = chunk_get(pool, CHUNK_STD_SIZE);
+    OSSL_ARENA *arena;
+
+    if (c == NULL)
+        return NULL;
+    arena = (OSSL_ARENA *)CHUNK_DATA(c);
+    memset(arena, 0, sizeof(*arena));
+    c->used = ARENA_HDR_SIZE;
+    arena->pool = pool;
+    arena->flags = flags;
+    arena->home = c;
+    arena->chunks = c;
+    return arena;
+}
+
+/*
+ * Give back every chunk apart from the home chunk, which is emptied of
+ * everything but the arena itself.
+ */
+static void arena_release(OSSL_ARENA *arena)
+{
+    ARENA_CHUNK *c, *next, *home = arena->home, *pooled = NULL;
+
+    for (c = arena->chunks; c != NULL; c = next) {
+        next = c->next;
+        if (c == home)
+            continue;
+        if ((arena->flags & OSSL_ARENA_FLAG_CLEAR) != 0)
+            OPENSSL_cleanse(CHUNK_DATA(c), c->used);
+        if (c->size != CHUNK_STD_SIZE) {
+            OPENSSL_free(c);
+        } else {
+            c->next = pooled;
+            pooled = c;
+        }
+    }
+    chunk_put_list(arena->pool, pooled);
+
+    if ((arena->flags & OSSL_ARENA_FLAG_CLEAR) != 0)
+        OPENSSL_cleanse(CHUNK_DATA(home) + ARENA_HDR_SIZE,
+                        home->used - ARENA_HDR_SIZE);
+    home->next = NULL;
+    home->used = ARENA_HDR_SIZE;
+    arena->chunks = home;
+    arena->in_use = 0;
+}
+
+void ossl_arena_reset(OSSL_ARENA *arena)
+{
+    if (arena != NULL)
+        arena_release(arena);
+}
+
+void ossl_arena_free(OSSL_ARENA *arena)
+{
+    OSSL_ARENA_POOL *pool;
+    ARENA_CHUNK *home;
+
+    if (arena == NULL)
+        return;
+    arena_release(arena);
+    pool = arena->pool;
+    home = arena->home;
+    OPENSSL_cleanse(arena, sizeof(*arena));
+    chunk_put_list(pool, home);
+}
+
+void *ossl_arena_alloc(OSSL_ARENA *arena, size_t num)
+{
+    ARENA_CHUNK *c = arena->chunks;
+    size_t n = ARENA_ROUND(num);
+    void *ret;
+
+    if (n < num || n == 0)
+        return NULL;
+
+    if (c == NULL || c->size - c->used < n) {
+        if (n > ARENA_LARGE) {
+            if (n > SIZE_MAX - CHUNK_HDR_SIZE || (c = chunk_get(NULL, n)) == NULL)
+                return NULL;
+            /* A dedicated chunk is full straight away, keep it out of the way */
+            if (arena->chunks != NULL) {
+                c->next = arena->chunks->next;
+                arena->chunks->next = c;
+            } else {
+                arena->chunks = c;
+            }
+        } else {
+            if ((c = chunk_get(arena->pool, CHUNK_STD_SIZE)) == NULL)
+                return NULL;
+            c->next = arena->chunks;
+            arena->chunks = c;
+        }
+    }
+
+    ret = CHUNK_DATA(c) + c->used;
+    c->used += n;
+    arena->in_use += n;
+    if (arena->in_use > arena->peak)
+        arena->peak = arena->in_use;
+    return ret;
+}
+
+void *ossl_arena_zalloc(OSSL_ARENA *arena, size_t num)
+{
+    void *ret = ossl_arena_alloc(arena, num);
+
+    if (ret != NULL)
+        memset(ret, 0, num);
+    return ret;
+}
+
+int ossl_arena_owns(const OSSL_ARENA *arena, const void *ptr)
+{
+    const ARENA_CHUNK *c;
+    const unsigned char *p = ptr;
+
+    if (arena == NULL || p == NULL)
+        return 0;
+    for (c = arena->chunks; c != NULL; c = c->next)
+        if (p >= CHUNK_DATA(c) && p < CHUNK_DATA(c) + c->used)
+            return 1;
+    return 0;
+}
+
+size_t ossl_arena_get_peak(const OSSL_ARENA *arena)
+{
+    return arena == NULL ? 0 : arena->peak;
+}
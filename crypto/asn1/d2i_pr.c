@@ -24,17 +24,74 @@
 #include "internal/asn1.h"
 #include "internal/sizes.h"
 
+/*
+ * Guess the key type of a type-specific private key from the number of
+ * elements in its outer SEQUENCE, so that the decoders for all other key
+ * types don't have to try it first.  Returns NULL when there is no good
+ * guess.
+ */
+static const char *guess_type_specific_key(const unsigned char *p, long len)
+{
+    const unsigned char *end;
+    long elen;
+    int tag, xclass, n = 0, ret;
+
+    ret = ASN1_get_object(&p, &elen, &tag, &xclass, len);
+    if ((ret & 0x81) != 0 || (ret & V_ASN1_CONSTRUCTED) == 0
+            || tag != V_ASN1_SEQUENCE || xclass != V_ASN1_UNIVERSAL)
+        return NULL;
+    for (end = p + elen; p < end; n++) {
+        if ((ASN1_get_object(&p, &elen, &tag, &xclass, end - p) & 0x81) != 0)
+            return NULL;
+        p += elen;
+    }
+
+    switch (n) {
+    case 4:
+        /* This may be SM2 as well, which the EC OID name covers */
+        return "id-ecPublicKey";
+    case 6:
+        return "DSA";
+    case 9:
+    case 10:
+        return "RSA";
+    }
+    return NULL;
+}
+
+static int d2i_PrivateKey_decode(EVP_PKEY **ppkey, EVP_PKEY **a,
+                                 const unsigned char **pp, long length,
+                                 const char *structure, const char *key_name,
+                                 OSSL_LIB_CTX *libctx, const char *propq)
+{
+    OSSL_DECODER_CTX *dctx = NULL;
+    EVP_PKEY *bak_a = NULL;
+    size_t len = length;
+    int ret;
+
+    if (a != NULL)
+        bak_a = *a;
+    dctx = OSSL_DECODER_CTX_new_for_pkey(ppkey, "DER", structure, key_name,
+                                         EVP_PKEY_KEYPAIR, libctx, propq);
+    if (a != NULL)
+        *a = bak_a;
+    if (dctx == NULL)
+        return 0;
+
+    ret = OSSL_DECODER_from_data(dctx, pp, &len);
+    OSSL_DECODER_CTX_free(dctx);
+    return ret;
+}
+
 static EVP_PKEY *
 d2i_PrivateKey_decoder(int keytype, EVP_PKEY **a, const unsigned char **pp,
                        long length, OSSL_LIB_CTX *libctx, const char *propq)
 {
-    OSSL_DECODER_CTX *dctx = NULL;
-    size_t len = length;
     EVP_PKEY *pkey = NULL, *bak_a = NULL;
     EVP_PKEY **ppkey = &pkey;
     const char *key_name = NULL;
     char keytypebuf[OSSL_MAX_NAME_SIZE];
-    int ret;
+    int ret, guessed = 0;
     const unsigned char *p = *pp;
     const char *structure;
     PKCS8_PRIV_KEY_INFO *p8info;
@@ -48,8 +105,7 @@ d2i_PrivateKey_decoder(int keytype, EVP_PKEY **a, const unsigned char **pp,
 
     /* This is just a probe. It might fail, so we ignore errors */
     ERR_set_mark();
-    p8info = d2i_PKCS8_PRIV_KEY_INFO(NULL, pp, len);
-    ERR_pop_to_mark();
+    p8info = d2i_PKCS8_PRIV_KEY_INFO(NULL, pp, length);
     if (p8info != NULL) {
         if (key_name == NULL
                 && PKCS8_pkey_get0(&algoid, NULL, NULL, NULL, p8info)
@@ -59,20 +115,35 @@ d2i_PrivateKey_decoder(int keytype, EVP_PKEY **a, const unsigned char **pp,
         PKCS8_PRIV_KEY_INFO_free(p8info);
     } else {
         structure = "type-specific";
+        if (key_name == NULL
+                && (key_name = guess_type_specific_key(p, length)) != NULL)
+            guessed = 1;
     }
+    ERR_pop_to_mark();
     *pp = p;
 
     if (a != NULL && (bak_a = *a) != NULL)
         ppkey = a;
-    dctx = OSSL_DECODER_CTX_new_for_pkey(ppkey, "DER", structure, key_name,
-                                         EVP_PKEY_KEYPAIR, libctx, propq);
-    if (a != NULL)
-        *a = bak_a;
-    if (dctx == NULL)
-        goto err;
 
-    ret = OSSL_DECODER_from_data(dctx, pp, &len);
-    OSSL_DECODER_CTX_free(dctx);
+    if (guessed) {
+        /* A wrong guess isn't an error, everything is tried below */
+        ERR_set_mark();
+        ret = d2i_PrivateKey_decode(ppkey, a, pp, length, structure, key_name,
+                                    libctx, propq);
+        if (ret && *ppkey != NULL) {
+            ERR_clear_last_mark();
+        } else {
+            ERR_pop_to_mark();
+            if (ppkey == a)
+                *a = bak_a;
+            ret = d2i_PrivateKey_decode(ppkey, a, pp, length, structure, NULL,
+                                        libctx, propq);
+        }
+    } else {
+        ret = d2i_PrivateKey_decode(ppkey, a, pp, length, structure, key_name,
+                                    libctx, propq);
+    }
+
     if (ret
         && *ppkey != NULL
         && evp_keymgmt_util_has(*ppkey, OSSL_KEYMGMT_SELECT_PRIVATE_KEY)) {
@@ -81,7 +152,6 @@ d2i_PrivateKey_decoder(int keytype, EVP_PKEY **a, const unsigned char **pp,
         return *ppkey;
     }
 
- err:
     if (ppkey != a)
         EVP_PKEY_free(*ppkey);
     return NULL;
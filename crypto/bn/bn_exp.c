@@ -1529,3 +1529,47 @@ err:
 
     return ret;
 }
+
+/*
+ * Computes rr[i] = a[i]^p[i] mod m[i] in constant time for |num| independent
+ * exponentiations.  Exponentiations whose moduli have the same bit length are
+ * paired up and passed to BN_mod_exp_mont_consttime_x2(), so that they share
+ * the dual AVX512_IFMA kernel where it is available.  Entries of |mont| may be
+ * NULL.
+ */
+int ossl_bn_mod_exp_mont_consttime_batch(BIGNUM *rr[], const BIGNUM *a[],
+                                          const BIGNUM *p[], const BIGNUM *m[],
+                                          BN_MONT_CTX *mont[], size_t num,
+                                          BN_CTX *ctx)
+{
+    uint64_t done = 0;
+    size_t i, j;
+
+    if (num > 64)
+        return ossl_bn_mod_exp_mont_consttime_batch(rr, a, p, m, mont, 64, ctx)
+            && ossl_bn_mod_exp_mont_consttime_batch(rr + 64, a + 64, p + 64,
+                                                     m + 64, mont + 64,
+                                                     num - 64, ctx);
+
+    for (i = 0; i < num; i++) {
+        if ((done & ((uint64_t)1 << i)) != 0)
+            continue;
+
+        for (j = i + 1; j < num; j++)
+            if ((done & ((uint64_t)1 << j)) == 0
+                    && BN_num_bits(m[j]) == BN_num_bits(m[i]))
+                break;
+
+        if (j < num) {
+            done |= (uint64_t)1 << j;
+            if (!BN_mod_exp_mont_consttime_x2(rr[i], a[i], p[i], m[i], mont[i],
+                                              rr[j], a[j], p[j], m[j], mont[j],
+                                              ctx))
+                return 0;
+        } else if (!BN_mod_exp_mont_consttime(rr[i], a[i], p[i], m[i], ctx,
+                                              mont[i])) {
+            return 0;
+        }
+    }
+    return 1;
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright 2019-2021 The OpenSSL Project Authors. All Rights Reserved.
+ * Copyright 2019-2025 The OpenSSL Project Authors. All Rights Reserved.
  *
  * Licensed under the Apache License 2.0 (the "License").  You may not use
  * this file except in compliance with the License.  You can obtain a copy
@@ -8,13 +8,29 @@
  */
 
 #include <stddef.h>
+#include <string.h>
 
 #include <openssl/core.h>
 #include "internal/cryptlib.h"
 #include "internal/core.h"
+#include "internal/namemap.h"
+#include "internal/nelem.h"
 #include "internal/property.h"
 #include "internal/provider.h"
 
+#define NAME_SEPARATOR ':'
+
+/*
+ * Each provider has one operation bit per operation to tell that all its
+ * methods for that operation have been constructed, and a second one to
+ * tell that the names of all its algorithms for that operation have been
+ * registered in the namemap, which is all that's done up front when
+ * methods are constructed on demand.
+ */
+#define OPBIT_ALL_CONSTRUCTED(operation_id)   (operation_id)
+#define OPBIT_NAMES_REGISTERED(operation_id)  \
+    (OSSL_OP__HIGHEST + 1 + (operation_id))
+
 struct construct_data_st {
     OSSL_LIB_CTX *libctx;
     OSSL_METHOD_STORE *store;
@@ -22,6 +38,17 @@ struct construct_data_st {
     int force_store;
     OSSL_METHOD_CONSTRUCT_METHOD *mcm;
     void *mcm_data;
+
+    /*
+     * When non-zero, only methods with this name identity are constructed,
+     * otherwise all of them are.  The names it goes by are collected here,
+     * unless there are too many of them.
+     */
+    int name_id;
+    const char *names[16];
+    size_t names_len[16];
+    size_t names_num;
+    unsigned int names_incomplete : 1;
 };
 
 static int is_temporary_method_store(int no_store, void *cbdata)
@@ -60,6 +87,8 @@ static int ossl_method_construct_precondition(OSSL_PROVIDER *provider,
                                               int operation_id, int no_store,
                                               void *cbdata, int *result)
 {
+    struct construct_data_st *data = cbdata;
+
     if (!ossl_assert(result != NULL)) {
         ERR_raise(ERR_LIB_CRYPTO, ERR_R_PASSED_NULL_PARAMETER);
         return 0;
@@ -69,9 +98,16 @@ static int ossl_method_construct_precondition(OSSL_PROVIDER *provider,
     *result = 0;
 
     /* No flag bits for temporary stores */
-    if (!is_temporary_method_store(no_store, cbdata)
-        && !ossl_provider_test_operation_bit(provider, operation_id, result))
-        return 0;
+    if (!is_temporary_method_store(no_store, cbdata)) {
+        if (!ossl_provider_test_operation_bit(provider,
+                                              OPBIT_ALL_CONSTRUCTED(operation_id),
+                                              result))
+            return 0;
+        if (!*result && data->name_id != 0
+            && !ossl_provider_test_name_bit(provider, operation_id,
+                                            data->name_id, result))
+            return 0;
+    }
 
     /*
      * The result we get tells if methods have already been constructed.
@@ -86,6 +122,64 @@ static int ossl_method_construct_precondition(OSSL_PROVIDER *provider,
 static int ossl_method_construct_postcondition(OSSL_PROVIDER *provider,
                                                int operation_id, int no_store,
                                                void *cbdata, int *result)
+{
+    struct construct_data_st *data = cbdata;
+
+    if (!ossl_assert(result != NULL)) {
+        ERR_raise(ERR_LIB_CRYPTO, ERR_R_PASSED_NULL_PARAMETER);
+        return 0;
+    }
+
+    *result = 1;
+
+    /* No flag bits for temporary stores */
+    if (is_temporary_method_store(no_store, cbdata))
+        return 1;
+    if (data->name_id != 0)
+        return ossl_provider_set_name_bit(provider, operation_id,
+                                          data->name_id);
+    return ossl_provider_set_operation_bit(provider,
+                                           OPBIT_ALL_CONSTRUCTED(operation_id));
+}
+
+/*
+ * Registering the names of all algorithms of a provider before anything is
+ * constructed on demand gives names that are aliases across providers the
+ * same identity they would have had if all methods had been constructed at
+ * once, whatever order things happen in.
+ */
+static int ossl_method_register_names_precondition(OSSL_PROVIDER *provider,
+                                                   int operation_id,
+                                                   int no_store,
+                                                   void *cbdata, int *result)
+{
+    if (!ossl_assert(result != NULL)) {
+        ERR_raise(ERR_LIB_CRYPTO, ERR_R_PASSED_NULL_PARAMETER);
+        return 0;
+    }
+
+    *result = 0;
+
+    /* No flag bits for temporary stores */
+    if (!is_temporary_method_store(no_store, cbdata)
+        && (!ossl_provider_test_operation_bit(provider,
+                                              OPBIT_NAMES_REGISTERED(operation_id),
+                                              result)
+            || (!*result
+                && !ossl_provider_test_operation_bit(provider,
+                                                     OPBIT_ALL_CONSTRUCTED(operation_id),
+                                                     result))))
+        return 0;
+
+    *result = !*result;
+
+    return 1;
+}
+
+static int ossl_method_register_names_postcondition(OSSL_PROVIDER *provider,
+                                                    int operation_id,
+                                                    int no_store,
+                                                    void *cbdata, int *result)
 {
     if (!ossl_assert(result != NULL)) {
         ERR_raise(ERR_LIB_CRYPTO, ERR_R_PASSED_NULL_PARAMETER);
@@ -96,7 +190,65 @@ static int ossl_method_construct_postcondition(OSSL_PROVIDER *provider,
 
     /* No flag bits for temporary stores */
     return is_temporary_method_store(no_store, cbdata)
-        || ossl_provider_set_operation_bit(provider, operation_id);
+        || ossl_provider_set_operation_bit(provider,
+                                           OPBIT_NAMES_REGISTERED(operation_id));
+}
+
+static void ossl_method_register_names_this(OSSL_PROVIDER *provider,
+                                            const OSSL_ALGORITHM *algo,
+                                            int no_store, void *cbdata)
+{
+    OSSL_NAMEMAP *namemap = ossl_namemap_stored(ossl_provider_libctx(provider));
+
+    /*
+     * Failures are left for the construction of the method to report, should
+     * it ever be asked for.
+     */
+    ERR_set_mark();
+    (void)ossl_namemap_add_names(namemap, 0, algo->algorithm_names,
+                                 NAME_SEPARATOR);
+    ERR_pop_to_mark();
+}
+
+static void collect_name(const char *name, void *cbdata)
+{
+    struct construct_data_st *data = cbdata;
+
+    if (data->names_num < OSSL_NELEM(data->names)) {
+        data->names_len[data->names_num] = strlen(name);
+        data->names[data->names_num++] = name;
+    } else {
+        data->names_incomplete = 1;
+    }
+}
+
+/*
+ * All the names of an algorithm have the same identity once registered, so
+ * it's enough to look for the first one among the names we're after.  That
+ * is far cheaper than a namemap lookup, and this is done for every algorithm
+ * of every provider each time a method is constructed.
+ */
+static int algorithm_has_name_id(OSSL_PROVIDER *provider,
+                                 const OSSL_ALGORITHM *algo,
+                                 struct construct_data_st *data)
+{
+    const char *names = algo->algorithm_names;
+    const char *q = strchr(names, NAME_SEPARATOR);
+    size_t l = (q == NULL ? strlen(names) : (size_t)(q - names));
+    size_t i;
+
+    if (data->names_incomplete) {
+        OSSL_NAMEMAP *namemap =
+            ossl_namemap_stored(ossl_provider_libctx(provider));
+
+        return ossl_namemap_name2num_n(namemap, names, l) == data->name_id;
+    }
+
+    for (i = 0; i < data->names_num; i++)
+        if (data->names_len[i] == l
+            && OPENSSL_strncasecmp(data->names[i], names, l) == 0)
+            return 1;
+    return 0;
 }
 
 static void ossl_method_construct_this(OSSL_PROVIDER *provider,
@@ -106,6 +258,9 @@ static void ossl_method_construct_this(OSSL_PROVIDER *provider,
     struct construct_data_st *data = cbdata;
     void *method = NULL;
 
+    if (data->name_id != 0 && !algorithm_has_name_id(provider, algo, data))
+        return;
+
     if ((method = data->mcm->construct(algo, provider, data->mcm_data))
         == NULL)
         return;
@@ -128,7 +283,8 @@ static void ossl_method_construct_this(OSSL_PROVIDER *provider,
 }
 
 void *ossl_method_construct(OSSL_LIB_CTX *libctx, int operation_id,
-                            OSSL_PROVIDER **provider_rw, int force_store,
+                            const char *name, OSSL_PROVIDER **provider_rw,
+                            int force_store,
                             OSSL_METHOD_CONSTRUCT_METHOD *mcm, void *mcm_data)
 {
     void *method = NULL;
@@ -146,10 +302,42 @@ void *ossl_method_construct(OSSL_LIB_CTX *libctx, int operation_id,
      * a provider have already been constructed.
      */
 
+    cbdata.libctx = libctx;
     cbdata.store = NULL;
+    cbdata.operation_id = operation_id;
     cbdata.force_store = force_store;
     cbdata.mcm = mcm;
     cbdata.mcm_data = mcm_data;
+    cbdata.name_id = 0;
+    cbdata.names_num = 0;
+    cbdata.names_incomplete = 0;
+
+    /*
+     * When a name is given, only the methods by that name are constructed,
+     * which spares short lived processes that only need a few algorithms
+     * the cost of constructing and storing all of them.  That only needs the
+     * names of the provider algorithms to be known, to identify the right
+     * ones.  If no provider has anything by that name, there's nothing to
+     * construct.
+     */
+    if (name != NULL) {
+        OSSL_NAMEMAP *namemap = ossl_namemap_stored(libctx);
+
+        if (namemap == NULL)
+            return NULL;
+        ossl_algorithm_do_all(libctx, operation_id, provider,
+                              ossl_method_register_names_precondition,
+                              ossl_method_construct_reserve_store,
+                              ossl_method_register_names_this,
+                              ossl_method_construct_unreserve_store,
+                              ossl_method_register_names_postcondition,
+                              &cbdata);
+        if ((cbdata.name_id = ossl_namemap_name2num(namemap, name)) == 0
+            || !ossl_namemap_doall_names(namemap, cbdata.name_id,
+                                         collect_name, &cbdata))
+            return NULL;
+    }
+
     ossl_algorithm_do_all(libctx, operation_id, provider,
                           ossl_method_construct_precondition,
                           ossl_method_construct_reserve_store,
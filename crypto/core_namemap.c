@@ -1,5 +1,5 @@
 /*
- * Copyright 2019-2024 The OpenSSL Project Authors. All Rights Reserved.
+ * Copyright 2019-2025 The OpenSSL Project Authors. All Rights Reserved.
  *
  * Licensed under the Apache License 2.0 (the "License").  You may not use
  * this file except in compliance with the License.  You can obtain a copy
@@ -169,14 +169,27 @@ int ossl_namemap_name2num(const OSSL_NAMEMAP *namemap, const char *name)
 int ossl_namemap_name2num_n(const OSSL_NAMEMAP *namemap,
                             const char *name, size_t name_len)
 {
-    char *tmp;
+    char buf[64], *tmp = buf;
     int ret;
 
-    if (name == NULL || (tmp = OPENSSL_strndup(name, name_len)) == NULL)
+    if (name == NULL)
         return 0;
 
+    /*
+     * This is called for every algorithm a provider offers when methods are
+     * constructed, so avoid the allocation for the names that fit the hash
+     * table key anyway, which is nearly all of them.
+     */
+    if (name_len < sizeof(buf)) {
+        memcpy(buf, name, name_len);
+        buf[name_len] = '\0';
+    } else if ((tmp = OPENSSL_strndup(name, name_len)) == NULL) {
+        return 0;
+    }
+
     ret = ossl_namemap_name2num(namemap, tmp);
-    OPENSSL_free(tmp);
+    if (tmp != buf)
+        OPENSSL_free(tmp);
     return ret;
 }
 
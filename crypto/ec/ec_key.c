@@ -437,6 +437,89 @@ err:
     }
     return ok;
 }
+
+/*
+ * Generate key pairs for |num| keys that all use the same group.  This does
+ * what ec_generate_key() does for each of them, except that the public keys
+ * are converted to affine coordinates together, so that they share a single
+ * field inversion instead of paying for one each.  Keys with their own key
+ * generation method fall back to EC_KEY_generate_key().
+ */
+int ossl_ec_key_generate_batch(EC_KEY *keys[], size_t num)
+{
+    const EC_GROUP *group;
+    const BIGNUM *order;
+    BIGNUM *range = NULL;
+    EC_POINT **points = NULL;
+    BN_CTX *ctx = NULL;
+    size_t i, npoints = 0;
+    int ok = 0;
+
+    if (num == 0)
+        return 1;
+
+    for (i = 0; i < num; i++)
+        if (keys[i]->group == NULL
+            || keys[i]->meth->keygen != ossl_ec_key_gen
+            || keys[i]->group->meth->keygen != ossl_ec_key_simple_generate_key)
+            break;
+    if (i < num) {
+        for (i = 0; i < num; i++)
+            if (!EC_KEY_generate_key(keys[i]))
+                return 0;
+        return 1;
+    }
+
+    group = keys[0]->group;
+    if ((order = EC_GROUP_get0_order(group)) == NULL
+        || (ctx = BN_CTX_secure_new_ex(keys[0]->libctx)) == NULL
+        || (range = BN_dup(order)) == NULL
+        || (points = OPENSSL_malloc(num * sizeof(*points))) == NULL)
+        goto err;
+
+    /* range of SM2 private key is [1, n-1) */
+    if ((EC_KEY_get_flags(keys[0]) & EC_FLAG_SM2_RANGE) != 0
+        && !BN_sub_word(range, 1))
+        goto err;
+
+    for (i = 0; i < num; i++) {
+        EC_KEY *eckey = keys[i];
+
+        if (eckey->priv_key == NULL
+            && (eckey->priv_key = BN_secure_new()) == NULL)
+            goto err;
+        if (eckey->pub_key == NULL
+            && (eckey->pub_key = EC_POINT_new(eckey->group)) == NULL)
+            goto err;
+
+        do
+            if (!BN_priv_rand_range_ex(eckey->priv_key, range, 0, ctx))
+                goto err;
+        while (BN_is_zero(eckey->priv_key));
+
+        if (!EC_POINT_mul(eckey->group, eckey->pub_key, eckey->priv_key,
+                          NULL, NULL, ctx))
+            goto err;
+        if (!eckey->pub_key->Z_is_one)
+            points[npoints++] = eckey->pub_key;
+        eckey->dirty_cnt++;
+    }
+
+    ok = npoints == 0 || EC_POINTs_make_affine(group, npoints, points, ctx);
+ err:
+    if (!ok) {
+        for (i = 0; i < num; i++) {
+            BN_clear_free(keys[i]->priv_key);
+            keys[i]->priv_key = NULL;
+            if (keys[i]->pub_key != NULL)
+                EC_POINT_set_to_infinity(keys[i]->group, keys[i]->pub_key);
+        }
+    }
+    OPENSSL_free(points);
+    BN_free(range);
+    BN_CTX_free(ctx);
+    return ok;
+}
 #endif
 
 int ossl_ec_key_simple_generate_key(EC_KEY *eckey)
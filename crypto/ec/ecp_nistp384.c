@@ -1219,112 +1219,192 @@ static void point_add(felem x3, felem y3, felem z3,
  * elements (x, y, z).
  *
  * For the base point table, z is usually 1 (0 for the point at infinity).
- * This table has 16 elements:
+ * This table has 2 * 16 elements, starting with the following:
  * index | bits    | point
  * ------+---------+------------------------------
  *     0 | 0 0 0 0 | 0G
  *     1 | 0 0 0 1 | 1G
- *     2 | 0 0 1 0 | 2^95G
- *     3 | 0 0 1 1 | (2^95 + 1)G
- *     4 | 0 1 0 0 | 2^190G
- *     5 | 0 1 0 1 | (2^190 + 1)G
- *     6 | 0 1 1 0 | (2^190 + 2^95)G
- *     7 | 0 1 1 1 | (2^190 + 2^95 + 1)G
- *     8 | 1 0 0 0 | 2^285G
- *     9 | 1 0 0 1 | (2^285 + 1)G
- *    10 | 1 0 1 0 | (2^285 + 2^95)G
- *    11 | 1 0 1 1 | (2^285 + 2^95 + 1)G
- *    12 | 1 1 0 0 | (2^285 + 2^190)G
- *    13 | 1 1 0 1 | (2^285 + 2^190 + 1)G
- *    14 | 1 1 1 0 | (2^285 + 2^190 + 2^95)G
- *    15 | 1 1 1 1 | (2^285 + 2^190 + 2^95 + 1)G
+ *     2 | 0 0 1 0 | 2^96G
+ *     3 | 0 0 1 1 | (2^96 + 1)G
+ *     4 | 0 1 0 0 | 2^192G
+ *     5 | 0 1 0 1 | (2^192 + 1)G
+ *     6 | 0 1 1 0 | (2^192 + 2^96)G
+ *     7 | 0 1 1 1 | (2^192 + 2^96 + 1)G
+ *     8 | 1 0 0 0 | 2^288G
+ *     9 | 1 0 0 1 | (2^288 + 1)G
+ *    10 | 1 0 1 0 | (2^288 + 2^96)G
+ *    11 | 1 0 1 1 | (2^288 + 2^96 + 1)G
+ *    12 | 1 1 0 0 | (2^288 + 2^192)G
+ *    13 | 1 1 0 1 | (2^288 + 2^192 + 1)G
+ *    14 | 1 1 1 0 | (2^288 + 2^192 + 2^96)G
+ *    15 | 1 1 1 1 | (2^288 + 2^192 + 2^96 + 1)G
+ * followed by a copy of this with each element multiplied by 2^48.
  *
  * The reason for this is so that we can clock bits into four different
- * locations when doing simple scalar multiplies against the base point.
+ * locations when doing simple scalar multiplies against the base point,
+ * and then another four locations using the second 16 elements.
  *
  * Tables for other points have table[i] = iG for i in 0 .. 16.
  */
 
 /* gmul is the table of precomputed base points */
-static const felem gmul[16][3] = {
-{{0, 0, 0, 0, 0, 0, 0},
- {0, 0, 0, 0, 0, 0, 0},
- {0, 0, 0, 0, 0, 0, 0}},
-{{0x00545e3872760ab7, 0x00f25dbf55296c3a, 0x00e082542a385502, 0x008ba79b9859f741,
-  0x0020ad746e1d3b62, 0x0005378eb1c71ef3, 0x0000aa87ca22be8b},
- {0x00431d7c90ea0e5f, 0x00b1ce1d7e819d7a, 0x0013b5f0b8c00a60, 0x00289a147ce9da31,
-  0x0092dc29f8f41dbd, 0x002c6f5d9e98bf92, 0x00003617de4a9626},
- {1, 0, 0, 0, 0, 0, 0}},
-{{0x00024711cc902a90, 0x00acb2e579ab4fe1, 0x00af818a4b4d57b1, 0x00a17c7bec49c3de,
-  0x004280482d726a8b, 0x00128dd0f0a90f3b, 0x00004387c1c3fa3c},
- {0x002ce76543cf5c3a, 0x00de6cee5ef58f0a, 0x00403e42fa561ca6, 0x00bc54d6f9cb9731,
-  0x007155f925fb4ff1, 0x004a9ce731b7b9bc, 0x00002609076bd7b2},
- {1, 0, 0, 0, 0, 0, 0}},
-{{0x00e74c9182f0251d, 0x0039bf54bb111974, 0x00b9d2f2eec511d2, 0x0036b1594eb3a6a4,
-  0x00ac3bb82d9d564b, 0x00f9313f4615a100, 0x00006716a9a91b10},
- {0x0046698116e2f15c, 0x00f34347067d3d33, 0x008de4ccfdebd002, 0x00e838c6b8e8c97b,
-  0x006faf0798def346, 0x007349794a57563c, 0x00002629e7e6ad84},
- {1, 0, 0, 0, 0, 0, 0}},
-{{0x0075300e34fd163b, 0x0092e9db4e8d0ad3, 0x00254be9f625f760, 0x00512c518c72ae68,
-  0x009bfcf162bede5a, 0x00bf9341566ce311, 0x0000cd6175bd41cf},
- {0x007dfe52af4ac70f, 0x0002159d2d5c4880, 0x00b504d16f0af8d0, 0x0014585e11f5e64c,
-  0x0089c6388e030967, 0x00ffb270cbfa5f71, 0x00009a15d92c3947},
- {1, 0, 0, 0, 0, 0, 0}},
-{{0x0033fc1278dc4fe5, 0x00d53088c2caa043, 0x0085558827e2db66, 0x00c192bef387b736,
-  0x00df6405a2225f2c, 0x0075205aa90fd91a, 0x0000137e3f12349d},
- {0x00ce5b115efcb07e, 0x00abc3308410deeb, 0x005dc6fc1de39904, 0x00907c1c496f36b4,
-  0x0008e6ad3926cbe1, 0x00110747b787928c, 0x0000021b9162eb7e},
- {1, 0, 0, 0, 0, 0, 0}},
-{{0x008180042cfa26e1, 0x007b826a96254967, 0x0082473694d6b194, 0x007bd6880a45b589,
-  0x00c0a5097072d1a3, 0x0019186555e18b4e, 0x000020278190e5ca},
- {0x00b4bef17de61ac0, 0x009535e3c38ed348, 0x002d4aa8e468ceab, 0x00ef40b431036ad3,
-  0x00defd52f4542857, 0x0086edbf98234266, 0x00002025b3a7814d},
- {1, 0, 0, 0, 0, 0, 0}},
-{{0x00b238aa97b886be, 0x00ef3192d6dd3a32, 0x0079f9e01fd62df8, 0x00742e890daba6c5,
-  0x008e5289144408ce, 0x0073bbcc8e0171a5, 0x0000c4fd329d3b52},
- {0x00c6f64a15ee23e7, 0x00dcfb7b171cad8b, 0x00039f6cbd805867, 0x00de024e428d4562,
-  0x00be6a594d7c64c5, 0x0078467b70dbcd64, 0x0000251f2ed7079b},
- {1, 0, 0, 0, 0, 0, 0}},
-{{0x000e5cc25fc4b872, 0x005ebf10d31ef4e1, 0x0061e0ebd11e8256, 0x0076e026096f5a27,
-  0x0013e6fc44662e9a, 0x0042b00289d3597e, 0x000024f089170d88},
- {0x001604d7e0effbe6, 0x0048d77cba64ec2c, 0x008166b16da19e36, 0x006b0d1a0f28c088,
-  0x000259fcd47754fd, 0x00cc643e4d725f9a, 0x00007b10f3c79c14},
- {1, 0, 0, 0, 0, 0, 0}},
-{{0x00430155e3b908af, 0x00b801e4fec25226, 0x00b0d4bcfe806d26, 0x009fc4014eb13d37,
-  0x0066c94e44ec07e8, 0x00d16adc03874ba2, 0x000030c917a0d2a7},
- {0x00edac9e21eb891c, 0x00ef0fb768102eff, 0x00c088cef272a5f3, 0x00cbf782134e2964,
-  0x0001044a7ba9a0e3, 0x00e363f5b194cf3c, 0x00009ce85249e372},
- {1, 0, 0, 0, 0, 0, 0}},
-{{0x001dd492dda5a7eb, 0x008fd577be539fd1, 0x002ff4b25a5fc3f1, 0x0074a8a1b64df72f,
-  0x002ba3d8c204a76c, 0x009d5cff95c8235a, 0x0000e014b9406e0f},
- {0x008c2e4dbfc98aba, 0x00f30bb89f1a1436, 0x00b46f7aea3e259c, 0x009224454ac02f54,
-  0x00906401f5645fa2, 0x003a1d1940eabc77, 0x00007c9351d680e6},
- {1, 0, 0, 0, 0, 0, 0}},
-{{0x005a35d872ef967c, 0x0049f1b7884e1987, 0x0059d46d7e31f552, 0x00ceb4869d2d0fb6,
-  0x00e8e89eee56802a, 0x0049d806a774aaf2, 0x0000147e2af0ae24},
- {0x005fd1bd852c6e5e, 0x00b674b7b3de6885, 0x003b9ea5eb9b6c08, 0x005c9f03babf3ef7,
-  0x00605337fecab3c7, 0x009a3f85b11bbcc8, 0x0000455470f330ec},
- {1, 0, 0, 0, 0, 0, 0}},
-{{0x002197ff4d55498d, 0x00383e8916c2d8af, 0x00eb203f34d1c6d2, 0x0080367cbd11b542,
-  0x00769b3be864e4f5, 0x0081a8458521c7bb, 0x0000c531b34d3539},
- {0x00e2a3d775fa2e13, 0x00534fc379573844, 0x00ff237d2a8db54a, 0x00d301b2335a8882,
-  0x000f75ea96103a80, 0x0018fecb3cdd96fa, 0x0000304bf61e94eb},
- {1, 0, 0, 0, 0, 0, 0}},
-{{0x00b2afc332a73dbd, 0x0029a0d5bb007bc5, 0x002d628eb210f577, 0x009f59a36dd05f50,
-  0x006d339de4eca613, 0x00c75a71addc86bc, 0x000060384c5ea93c},
- {0x00aa9641c32a30b4, 0x00cc73ae8cce565d, 0x00ec911a4df07f61, 0x00aa4b762ea4b264,
-  0x0096d395bb393629, 0x004efacfb7632fe0, 0x00006f252f46fa3f},
- {1, 0, 0, 0, 0, 0, 0}},
-{{0x00567eec597c7af6, 0x0059ba6795204413, 0x00816d4e6f01196f, 0x004ae6b3eb57951d,
-  0x00420f5abdda2108, 0x003401d1f57ca9d9, 0x0000cf5837b0b67a},
- {0x00eaa64b8aeeabf9, 0x00246ddf16bcb4de, 0x000e7e3c3aecd751, 0x0008449f04fed72e,
-  0x00307b67ccf09183, 0x0017108c3556b7b1, 0x0000229b2483b3bf},
- {1, 0, 0, 0, 0, 0, 0}},
-{{0x00e7c491a7bb78a1, 0x00eafddd1d3049ab, 0x00352c05e2bc7c98, 0x003d6880c165fa5c,
-  0x00b6ac61cc11c97d, 0x00beeb54fcf90ce5, 0x0000dc1f0b455edc},
- {0x002db2e7aee34d60, 0x0073b5f415a2d8c0, 0x00dd84e4193e9a0c, 0x00d02d873467c572,
-  0x0018baaeda60aee5, 0x0013fb11d697c61e, 0x000083aafcc3a973},
- {1, 0, 0, 0, 0, 0, 0}}
+static const felem gmul[2][16][3] = {
+    {{{0, 0, 0, 0, 0, 0, 0},
+      {0, 0, 0, 0, 0, 0, 0},
+      {0, 0, 0, 0, 0, 0, 0}},
+     {{0x00545e3872760ab7, 0x00f25dbf55296c3a, 0x00e082542a385502, 0x008ba79b9859f741,
+       0x0020ad746e1d3b62, 0x0005378eb1c71ef3, 0x0000aa87ca22be8b},
+      {0x00431d7c90ea0e5f, 0x00b1ce1d7e819d7a, 0x0013b5f0b8c00a60, 0x00289a147ce9da31,
+       0x0092dc29f8f41dbd, 0x002c6f5d9e98bf92, 0x00003617de4a9626},
+      {1, 0, 0, 0, 0, 0, 0}},
+     {{0x00c1b328d8ee21c9, 0x000c91558717db39, 0x008b3f8686a92c3e, 0x0018141b1a4b5880,
+       0x00ca7abc43603909, 0x00bd1bd6e98b0d37, 0x0000f532389a060c},
+      {0x007e183923d86ecd, 0x0031b1085a4e9a7a, 0x005abe64360331ea, 0x00a2124163bc40ce,
+       0x003a82babd22cfb2, 0x008e696f04caa2de, 0x0000b9d2852cc3b3},
+      {1, 0, 0, 0, 0, 0, 0}},
+     {{0x004e5246eb09a0e5, 0x00be1132cdf03c26, 0x00835faefa4ff8f4, 0x0017a31b22da9d54,
+       0x00f06145bbbc4fd0, 0x002cabc3decd0c86, 0x0000528ef1670a5f},
+      {0x001e9858c14f0dd6, 0x0038a809cb75248a, 0x00b4c87fed225505, 0x00631d058dbd60ca,
+       0x001dcf14f8b76fdd, 0x00f56c5803eaa11a, 0x00007b9b1fbe7bcc},
+      {1, 0, 0, 0, 0, 0, 0}},
+     {{0x0028b09aaa03bd53, 0x005458a4f52d78a6, 0x00894d10ddeaba06, 0x008a3e297ddb2987,
+       0x00421279b42a31af, 0x0019c440f7f9e706, 0x0000c19e0b4c8001},
+      {0x002d0fc5e6c88c41, 0x00aa6de639d85882, 0x00d135f6ebf2af68, 0x00e3567af9c1c7ca,
+       0x005b77f6577a30ea, 0x00b301e5a0191d1f, 0x000016f3fdbf0356},
+      {1, 0, 0, 0, 0, 0, 0}},
+     {{0x00991560aa133909, 0x00dbb1c6cb001730, 0x0024b860fae69097, 0x0070b375ddd37de4,
+       0x006ce3a39bb183b2, 0x003088567a6233cd, 0x0000aab8bb9f0fdc},
+      {0x00c5b981600ad5a6, 0x0073f2d62faa4416, 0x00b3c9747bf3ebdf, 0x0015eb04ac6d955b,
+       0x002050b5f6005fc8, 0x006d28f0af01d128, 0x000048942f81314f},
+      {1, 0, 0, 0, 0, 0, 0}},
+     {{0x002211217716605e, 0x00d2c89ef281c820, 0x0099567d63422347, 0x0077c0f03f54ba45,
+       0x00367444ce0fba30, 0x00a0527022f802cb, 0x00007334a936a9a6},
+      {0x00461f68d658a01a, 0x00d519c2bd0efab5, 0x008f697a92800a64, 0x007d0e017a9e2eee,
+       0x00bd4ccd8e5d9b89, 0x00c9261f7c5c367c, 0x00007ffceff7f632},
+      {1, 0, 0, 0, 0, 0, 0}},
+     {{0x000ae2e60e758344, 0x00707a371a2ca530, 0x00105052dd32451c, 0x004862b95425651d,
+       0x0081ef13bf88de7f, 0x00090efafce26e03, 0x0000dc916c17960e},
+      {0x0017cc44026b0889, 0x001ff19b42441bed, 0x0078cc16069795c0, 0x000ba04a35408964,
+       0x001c295252d154b8, 0x00ca0ab3d92ea470, 0x0000266e8a40d69e},
+      {1, 0, 0, 0, 0, 0, 0}},
+     {{0x00bfc2c04905ca71, 0x00450ad156f761e4, 0x00dbd08848c2f33a, 0x00a23096863d8b29,
+       0x004972d7097da395, 0x00aa12211905035f, 0x0000b2d1055817cb},
+      {0x00cebb55753ee324, 0x00b07c6924666fdd, 0x00744ecf1a68e87a, 0x002e6236c09b475d,
+       0x00fd056bf82be8f5, 0x00cbd2237c0dba3c, 0x0000354cd872c3c6},
+      {1, 0, 0, 0, 0, 0, 0}},
+     {{0x00104d24708d4cee, 0x006958819cf0438d, 0x00faf0712210197d, 0x005c20155847fc87,
+       0x001ef638103df785, 0x00bfec30b0a9e861, 0x000000b19ac8fdfe},
+      {0x000e8d6fd201e03e, 0x00969c2228ff5fd4, 0x0082636164c5bb7c, 0x00e754220d688102,
+       0x00f6edc4cdbb3cd2, 0x0060311418fe25e9, 0x0000a72f91059ee3},
+      {1, 0, 0, 0, 0, 0, 0}},
+     {{0x00d2c273b769737a, 0x00245197d53ffd64, 0x004be86c46bd2cc0, 0x00685e926dc3b6ac,
+       0x00203a3617e9411f, 0x00b27e136df36b75, 0x00003f9561e08bf0},
+      {0x006ff8d527e990a7, 0x00e586f9867a60dd, 0x00478554e014c34b, 0x006f52e4cbea0887,
+       0x002ab641cfced664, 0x0095874b1a5a2041, 0x00000b06f0063962},
+      {1, 0, 0, 0, 0, 0, 0}},
+     {{0x004c0dd285651f82, 0x0051e7785d3ef704, 0x006188e95532325c, 0x00522c2931b83a18,
+       0x0080f137539f94ad, 0x0066d715274e5b89, 0x00009fd7b010df0f},
+      {0x00a7b94a4064e4c0, 0x00ba4525d7d211e4, 0x0054be8a04e3d44e, 0x00149033de0a806b,
+       0x00739246929226bd, 0x000225795f6fa3c9, 0x0000321aa9a3b926},
+      {1, 0, 0, 0, 0, 0, 0}},
+     {{0x00bcc2f58b707b8e, 0x00b5191d92898349, 0x00567d49c7802901, 0x004c6a99642e4c29,
+       0x00ee3e13ebd1cff8, 0x0068f72caebbd316, 0x000036a543eea87a},
+      {0x00b41c29b569946d, 0x00e7d43ef2267e75, 0x0072d4b3394d1510, 0x008fbd85d1912350,
+       0x00a6784758eaff04, 0x00e41cd349ab0378, 0x0000f277bacda50e},
+      {1, 0, 0, 0, 0, 0, 0}},
+     {{0x00b056585f863bbd, 0x00dc5ab483283d10, 0x0009dc7c421de92c, 0x006d01a5a8ebb312,
+       0x008b6a513afcbd79, 0x007aebe2b067caa0, 0x0000026e0dc2e8cb},
+      {0x00c3502902dde18a, 0x005facd8c6cf36d8, 0x000110781e4564c1, 0x001f3443d817ea27,
+       0x007461a5d68d1ffc, 0x0024e14be256378c, 0x0000ae8866bad8ef},
+      {1, 0, 0, 0, 0, 0, 0}},
+     {{0x003a78d0d265a91c, 0x00f8ef6c8f83d3ac, 0x00de8fd8d8171a29, 0x00c42bf748ef98fd,
+       0x00a73dc7df459ea1, 0x00fa2d14dafc3981, 0x0000b03dfa54c52a},
+      {0x00406f6e6c0d2ce7, 0x000b2b41fd72cacc, 0x000678f602ddcd12, 0x008accf229ef5d90,
+       0x006d908af5f8a2d1, 0x0085f2aafd1fcfce, 0x00002ce2885a0e6d},
+      {1, 0, 0, 0, 0, 0, 0}},
+     {{0x00109a0ec62666de, 0x002e757ffcd01e89, 0x0069c48b5ab0c8c1, 0x00f983ac6ca82061,
+       0x00977d234bc2fdcf, 0x00c96a59cfca7155, 0x00001264cb335766},
+      {0x006913812e014b4b, 0x008707e4483ec56b, 0x000cffb1975831d2, 0x0065a5f248cbf719,
+       0x003b4f69b66717a0, 0x00a376d94ad8fac5, 0x0000119ebeeea1a1},
+      {1, 0, 0, 0, 0, 0, 0}}},
+    {{{0, 0, 0, 0, 0, 0, 0},
+      {0, 0, 0, 0, 0, 0, 0},
+      {0, 0, 0, 0, 0, 0, 0}},
+     {{0x0012e340f47168ac, 0x00d3a09008070591, 0x00a1cc7fdedf3917, 0x008512e48ab6971d,
+       0x00f6297ecbd8aa25, 0x00b6a3804100caa7, 0x0000f19c3f9b433e},
+      {0x00e0b1762d8b523f, 0x0078cb39d2cf6c45, 0x008bee4928be1b70, 0x005a620149af40b6,
+       0x0038904565d24d48, 0x00090c4a1e9b515d, 0x0000ae61a171f610},
+      {1, 0, 0, 0, 0, 0, 0}},
+     {{0x005e0f5d2805e596, 0x00a01d262810506f, 0x0053ee0d124b89bb, 0x00badc49fb712e12,
+       0x00f0c000d214b583, 0x00c3ef049f9294aa, 0x00004e5a9dfe6ac2},
+      {0x005622c691013e25, 0x00321bced6e71496, 0x003d0051e0574b8f, 0x007a5e5a25b5a060,
+       0x006b571281a2b658, 0x00f1717bdd7fa630, 0x0000526f1b07f6ac},
+      {1, 0, 0, 0, 0, 0, 0}},
+     {{0x00ff5ece88f05154, 0x00be4f62091c2c9b, 0x00b4fc1b7102b008, 0x00bf37e0c6bc5cd1,
+       0x0012eb0e1eadfda0, 0x004fcf1c4a42aae9, 0x0000aef19fb9e788},
+      {0x001276425b94e7af, 0x00a2a398102462b8, 0x005834e2fa7ae591, 0x00e9413a45ca4d2b,
+       0x00783cd6fe84fc47, 0x00532f7814995822, 0x000023d1ed959bb5},
+      {1, 0, 0, 0, 0, 0, 0}},
+     {{0x00de52c7a213e83b, 0x0092d055db2392b3, 0x007fa76f70c9464a, 0x00455c1c820f5490,
+       0x001bfebcf03811a5, 0x00fa7fdbc082aba7, 0x0000c6b405288edf},
+      {0x007bb07de3636016, 0x009e9a4c00333ac0, 0x000753eec12112b2, 0x00640707c9888e19,
+       0x00519fa164acc0d1, 0x00eafbb78ca0ff03, 0x00005c88fb72c6c4},
+      {1, 0, 0, 0, 0, 0, 0}},
+     {{0x00bd2b8ef75508fc, 0x00f29262bfd0c558, 0x0030142ab328a91b, 0x00632c89cf88d90e,
+       0x002d6788729f12b6, 0x004dc6c892750221, 0x0000e5003a3f2915},
+      {0x0090953325010799, 0x008d422bb5ff4b0c, 0x003576aa7b5fe70c, 0x00a1c6f02e1c1a2a,
+       0x000ab45f38569944, 0x00d7abb580ce6abc, 0x000064aa8ae383c9},
+      {1, 0, 0, 0, 0, 0, 0}},
+     {{0x006f396e7c41cec4, 0x00cf56bdb3029a58, 0x00ffdc28f3ff6273, 0x00adcbfafc3e31b2,
+       0x000a9a632084e14d, 0x00e1dff39aa51ad4, 0x0000d1af43828307},
+      {0x00285854d1474980, 0x00b3be7bd30cbff4, 0x0016bdb54eeb6f9c, 0x004202560e69efed,
+       0x00181994b6456f62, 0x007bc3726ea875f8, 0x0000a922c4508358},
+      {1, 0, 0, 0, 0, 0, 0}},
+     {{0x000829822360374b, 0x0095a7bae9408424, 0x001074a33f398368, 0x004266b4fd8631b5,
+       0x00a51be58e09378b, 0x005e12e75930f90f, 0x0000a06ea7d1fd03},
+      {0x0020ab1e5cb6a429, 0x004118cb96b0e94f, 0x008963edba69630c, 0x00b2dc37cba862b0,
+       0x0077b186a7a42760, 0x00c396405292fe38, 0x0000abc08adc6dd6},
+      {1, 0, 0, 0, 0, 0, 0}},
+     {{0x00b2e4383f385d2b, 0x008ac4932b516d35, 0x00fe51a3599f6e66, 0x00d12c0f3a8a1646,
+       0x006da385aee309ab, 0x00e9430231423bc4, 0x0000f23c10b4637e},
+      {0x00bc215d22248e00, 0x0047e3d45f6553c0, 0x0071daad7d1d9ed4, 0x001f2d8179af0847,
+       0x007bb3fdee94bf70, 0x00ac781e8c72ad26, 0x0000c425de168de7},
+      {1, 0, 0, 0, 0, 0, 0}},
+     {{0x00a51c99470f3a77, 0x00228125d95dd3d8, 0x003e2a5fab8d8d6a, 0x005ac2cb2b57fa04,
+       0x00628e690677506d, 0x00fe6d134c04ee53, 0x000089d95ca20ecc},
+      {0x00c443936ee36b40, 0x006703663f07f9c4, 0x001eeb5d4d0bddba, 0x0094b962cc03e7dd,
+       0x0013cdb6f9d5c477, 0x0047a5eb8ffdb312, 0x00009d9927dab768},
+      {1, 0, 0, 0, 0, 0, 0}},
+     {{0x00ad4eb3c058ec50, 0x003e243165e00596, 0x00abc2c17c13243b, 0x0010135494b483ca,
+       0x00cc3b8e97a8dc97, 0x0069f824f2c4750d, 0x000057d89c1ff7e7},
+      {0x00da442a7bc53acb, 0x001e5a7fb230cd3d, 0x004137b0654b143b, 0x00506caa55e86618,
+       0x002efddfae713a85, 0x0071ca4c177b58ee, 0x0000b3ad81083541},
+      {1, 0, 0, 0, 0, 0, 0}},
+     {{0x00db76932d4575b7, 0x0073dfc259599ab6, 0x00bbdc10b088830d, 0x00d4ace4b2d93c90,
+       0x000b8d5bcec529b5, 0x001953db269d5d57, 0x00001ac4c02a73b1},
+      {0x004d4a8e642fd505, 0x004f3d58d2377703, 0x003eaefe54c00b1d, 0x004d8743d300d28d,
+       0x0082d9cf31b3a326, 0x0062048ac60d5abf, 0x0000ebc5abc0e494},
+      {1, 0, 0, 0, 0, 0, 0}},
+     {{0x00d0739bc0539803, 0x006bd6cbbec2f6d3, 0x00554f8e076ba512, 0x00a5ef3a9a014976,
+       0x00a01bd3fd7bdc2b, 0x0090ee0d2ee2a8ef, 0x0000a905806485a3},
+      {0x00aa5cc6f93f855d, 0x0063117347e35a32, 0x00673141361c0a58, 0x000c0cc8b191209b,
+       0x00f4841d38f98f25, 0x006edf8de6ffdd57, 0x0000f5af1a9ac251},
+      {1, 0, 0, 0, 0, 0, 0}},
+     {{0x00bd9de80856efa9, 0x0027c03c66ad4cbd, 0x0086aa0dd7a0a36f, 0x001314a5c1408ca4,
+       0x00c4c80f3e877b51, 0x00642956fec23eee, 0x0000217186f9324d},
+      {0x00d788ad470678f0, 0x005c3555f895260b, 0x00358fdae64162b9, 0x0054304321ef9454,
+       0x00e02dc8f8e08661, 0x0097edfa9ccf772b, 0x0000d419dae5f120},
+      {1, 0, 0, 0, 0, 0, 0}},
+     {{0x009366612dc6971d, 0x002082d99b377eb9, 0x007bee5f6ee7b09d, 0x00e8826c629f3759,
+       0x00cabf536e23d920, 0x003ff4bea835af08, 0x00003d245181ea77},
+      {0x0068abef0506d4c9, 0x002a29c53f53e148, 0x00cc5817bdbc91a3, 0x0048d6b592c1ed17,
+       0x009a972a20f09153, 0x00a6a5459978de71, 0x0000701432ee05a1},
+      {1, 0, 0, 0, 0, 0, 0}},
+     {{0x00306c550ef05a18, 0x00c94dff356193fa, 0x002d27730e609791, 0x0070831c35c0c6a1,
+       0x00449c11f5b0702a, 0x00111645872e8c32, 0x000006c21a5723a4},
+      {0x00704be004e4de38, 0x00e051aab21335ce, 0x00eac9d2f3c924c3, 0x0092b962d5bf3fc7,
+       0x00a8e06c5fffb892, 0x000e750660f04217, 0x0000b00515a9c0bf},
+      {1, 0, 0, 0, 0, 0, 0}}}
 };
 
 /*
@@ -1374,11 +1454,12 @@ static void batch_mul(felem x_out, felem y_out, felem z_out,
                       const felem_bytearray scalars[],
                       const unsigned int num_points, const u8 *g_scalar,
                       const int mixed, const felem pre_comp[][17][3],
-                      const felem g_pre_comp[16][3])
+                      const felem g_pre_comp[2][16][3])
 {
     int i, skip;
     unsigned int num, gen_mul = (g_scalar != NULL);
     felem nq[3], tmp[4];
+    widefelem wide;
     limb bits;
     u8 sign, digit;
 
@@ -1387,26 +1468,25 @@ static void batch_mul(felem x_out, felem y_out, felem z_out,
 
     /*
      * Loop over all scalars msb-to-lsb, interleaving additions of multiples
-     * of the generator (last quarter of rounds) and additions of other
-     * points multiples (every 5th round).
+     * of the generator (two in each of the last 48 rounds) and additions of
+     * other points multiples (every 5th round).
      */
     skip = 1;                   /* save two point operations in the first
                                  * round */
-    for (i = (num_points ? 380 : 98); i >= 0; --i) {
+    for (i = (num_points ? 380 : 47); i >= 0; --i) {
         /* double */
         if (!skip)
             point_double(nq[0], nq[1], nq[2], nq[0], nq[1], nq[2]);
 
         /* add multiples of the generator */
-        if (gen_mul && (i <= 98)) {
-            bits = get_bit(g_scalar, i + 285) << 3;
-            if (i < 95) {
-                bits |= get_bit(g_scalar, i + 190) << 2;
-                bits |= get_bit(g_scalar, i + 95) << 1;
-                bits |= get_bit(g_scalar, i);
-            }
+        if (gen_mul && (i <= 47)) {
+            /* first, look 48 bits upwards */
+            bits = get_bit(g_scalar, i + 336) << 3;
+            bits |= get_bit(g_scalar, i + 240) << 2;
+            bits |= get_bit(g_scalar, i + 144) << 1;
+            bits |= get_bit(g_scalar, i + 48);
             /* select the point to add, in constant time */
-            select_point(bits, 16, g_pre_comp, tmp);
+            select_point(bits, 16, g_pre_comp[1], tmp);
             if (!skip) {
                 /* The 1 argument below is for "mixed" */
                 point_add(nq[0],  nq[1],  nq[2],
@@ -1416,6 +1496,18 @@ static void batch_mul(felem x_out, felem y_out, felem z_out,
                 memcpy(nq, tmp, 3 * sizeof(felem));
                 skip = 0;
             }
+
+            /* second, look at the current position */
+            bits = get_bit(g_scalar, i + 288) << 3;
+            bits |= get_bit(g_scalar, i + 192) << 2;
+            bits |= get_bit(g_scalar, i + 96) << 1;
+            bits |= get_bit(g_scalar, i);
+            /* select the point to add, in constant time */
+            select_point(bits, 16, g_pre_comp[0], tmp);
+            /* The 1 argument below is for "mixed" */
+            point_add(nq[0],  nq[1],  nq[2],
+                      nq[0],  nq[1],  nq[2], 1,
+                      tmp[0], tmp[1], tmp[2]);
         }
 
         /* do other additions every 5 doublings */
@@ -1450,13 +1542,21 @@ static void batch_mul(felem x_out, felem y_out, felem z_out,
         }
     }
     felem_assign(x_out, nq[0]);
-    felem_assign(y_out, nq[1]);
+    /*
+     * If the last addition was to the point at infinity, y may be a negated
+     * point from felem_neg(), with limbs of up to 2^60. Bring it back within
+     * the bounds that felem_contract() expects.
+     */
+    memset(wide, 0, sizeof(wide));
+    for (num = 0; num < NLIMBS; num++)
+        wide[num] = nq[1][num];
+    felem_reduce(y_out, wide);
     felem_assign(z_out, nq[2]);
 }
 
 /* Precomputation for the group generator. */
 struct nistp384_pre_comp_st {
-    felem g_pre_comp[16][3];
+    felem g_pre_comp[2][16][3];
     CRYPTO_REF_COUNT references;
 };
 
@@ -1715,7 +1815,7 @@ int ossl_ec_GFp_nistp384_points_mul(const EC_GROUP *group, EC_POINT *r,
     size_t num_points = num;
     felem x_in, y_in, z_in, x_out, y_out, z_out;
     NISTP384_PRE_COMP *pre = NULL;
-    felem(*g_pre_comp)[3] = NULL;
+    felem(*g_pre_comp)[16][3] = NULL;
     EC_POINT *generator = NULL;
     const EC_POINT *p = NULL;
     const BIGNUM *p_scalar = NULL;
@@ -1735,14 +1835,14 @@ int ossl_ec_GFp_nistp384_points_mul(const EC_GROUP *group, EC_POINT *r,
             g_pre_comp = &pre->g_pre_comp[0];
         else
             /* try to use the standard precomputation */
-            g_pre_comp = (felem(*)[3]) gmul;
+            g_pre_comp = (felem(*)[16][3]) gmul;
         generator = EC_POINT_new(group);
         if (generator == NULL)
             goto err;
         /* get the generator from precomputation */
-        if (!felem_to_BN(x, g_pre_comp[1][0]) ||
-            !felem_to_BN(y, g_pre_comp[1][1]) ||
-            !felem_to_BN(z, g_pre_comp[1][2])) {
+        if (!felem_to_BN(x, g_pre_comp[0][1][0]) ||
+            !felem_to_BN(y, g_pre_comp[0][1][1]) ||
+            !felem_to_BN(z, g_pre_comp[0][1][2])) {
             ERR_raise(ERR_LIB_EC, ERR_R_BN_LIB);
             goto err;
         }
@@ -1863,7 +1963,7 @@ int ossl_ec_GFp_nistp384_points_mul(const EC_GROUP *group, EC_POINT *r,
                   (const felem_bytearray(*))secrets, num_points,
                   g_secret,
                   mixed, (const felem(*)[17][3])pre_comp,
-                  (const felem(*)[3])g_pre_comp);
+                  (const felem(*)[16][3])g_pre_comp);
     } else {
         /* do the multiplication without generator precomputation */
         batch_mul(x_out, y_out, z_out,
@@ -1898,7 +1998,7 @@ int ossl_ec_GFp_nistp384_precompute_mult(EC_GROUP *group, BN_CTX *ctx)
     int i, j;
     BIGNUM *x, *y;
     EC_POINT *generator = NULL;
-    felem tmp_felems[16];
+    felem tmp_felems[32];
 #ifndef FIPS_MODULE
     BN_CTX *new_ctx = NULL;
 #endif
@@ -1937,45 +2037,58 @@ int ossl_ec_GFp_nistp384_precompute_mult(EC_GROUP *group, BN_CTX *ctx)
         memcpy(pre->g_pre_comp, gmul, sizeof(pre->g_pre_comp));
         goto done;
     }
-    if ((!BN_to_felem(pre->g_pre_comp[1][0], group->generator->X)) ||
-        (!BN_to_felem(pre->g_pre_comp[1][1], group->generator->Y)) ||
-        (!BN_to_felem(pre->g_pre_comp[1][2], group->generator->Z)))
+    if ((!BN_to_felem(pre->g_pre_comp[0][1][0], group->generator->X)) ||
+        (!BN_to_felem(pre->g_pre_comp[0][1][1], group->generator->Y)) ||
+        (!BN_to_felem(pre->g_pre_comp[0][1][2], group->generator->Z)))
         goto err;
-    /* compute 2^95*G, 2^190*G, 2^285*G */
-    for (i = 1; i <= 4; i <<= 1) {
-        point_double(pre->g_pre_comp[2 * i][0], pre->g_pre_comp[2 * i][1], pre->g_pre_comp[2 * i][2],
-                     pre->g_pre_comp[i][0],  pre->g_pre_comp[i][1],    pre->g_pre_comp[i][2]);
-        for (j = 0; j < 94; ++j) {
-            point_double(pre->g_pre_comp[2 * i][0], pre->g_pre_comp[2 * i][1], pre->g_pre_comp[2 * i][2],
-                         pre->g_pre_comp[2 * i][0], pre->g_pre_comp[2 * i][1], pre->g_pre_comp[2 * i][2]);
+    /*
+     * compute 2^96*G, 2^192*G, 2^288*G for the first table, 2^48*G, 2^144*G,
+     * 2^240*G, 2^336*G for the second one
+     */
+    for (i = 1; i <= 8; i <<= 1) {
+        point_double(pre->g_pre_comp[1][i][0], pre->g_pre_comp[1][i][1], pre->g_pre_comp[1][i][2],
+                     pre->g_pre_comp[0][i][0], pre->g_pre_comp[0][i][1], pre->g_pre_comp[0][i][2]);
+        for (j = 0; j < 47; ++j) {
+            point_double(pre->g_pre_comp[1][i][0], pre->g_pre_comp[1][i][1], pre->g_pre_comp[1][i][2],
+                         pre->g_pre_comp[1][i][0], pre->g_pre_comp[1][i][1], pre->g_pre_comp[1][i][2]);
+        }
+        if (i == 8)
+            break;
+        point_double(pre->g_pre_comp[0][2 * i][0], pre->g_pre_comp[0][2 * i][1], pre->g_pre_comp[0][2 * i][2],
+                     pre->g_pre_comp[1][i][0],     pre->g_pre_comp[1][i][1],     pre->g_pre_comp[1][i][2]);
+        for (j = 0; j < 47; ++j) {
+            point_double(pre->g_pre_comp[0][2 * i][0], pre->g_pre_comp[0][2 * i][1], pre->g_pre_comp[0][2 * i][2],
+                         pre->g_pre_comp[0][2 * i][0], pre->g_pre_comp[0][2 * i][1], pre->g_pre_comp[0][2 * i][2]);
         }
     }
-    /* g_pre_comp[0] is the point at infinity */
-    memset(pre->g_pre_comp[0], 0, sizeof(pre->g_pre_comp[0]));
-    /* the remaining multiples */
-    /* 2^95*G + 2^190*G */
-    point_add(pre->g_pre_comp[6][0],  pre->g_pre_comp[6][1],  pre->g_pre_comp[6][2],
-              pre->g_pre_comp[4][0],  pre->g_pre_comp[4][1],  pre->g_pre_comp[4][2], 0,
-              pre->g_pre_comp[2][0],  pre->g_pre_comp[2][1],  pre->g_pre_comp[2][2]);
-    /* 2^95*G + 2^285*G */
-    point_add(pre->g_pre_comp[10][0], pre->g_pre_comp[10][1], pre->g_pre_comp[10][2],
-              pre->g_pre_comp[8][0],  pre->g_pre_comp[8][1],  pre->g_pre_comp[8][2], 0,
-              pre->g_pre_comp[2][0],  pre->g_pre_comp[2][1],  pre->g_pre_comp[2][2]);
-    /* 2^190*G + 2^285*G */
-    point_add(pre->g_pre_comp[12][0], pre->g_pre_comp[12][1], pre->g_pre_comp[12][2],
-              pre->g_pre_comp[8][0],  pre->g_pre_comp[8][1],  pre->g_pre_comp[8][2], 0,
-              pre->g_pre_comp[4][0],  pre->g_pre_comp[4][1],  pre->g_pre_comp[4][2]);
-    /* 2^95*G + 2^190*G + 2^285*G */
-    point_add(pre->g_pre_comp[14][0], pre->g_pre_comp[14][1], pre->g_pre_comp[14][2],
-              pre->g_pre_comp[12][0], pre->g_pre_comp[12][1], pre->g_pre_comp[12][2], 0,
-              pre->g_pre_comp[2][0],  pre->g_pre_comp[2][1],  pre->g_pre_comp[2][2]);
-    for (i = 1; i < 8; ++i) {
-        /* odd multiples: add G */
-        point_add(pre->g_pre_comp[2 * i + 1][0], pre->g_pre_comp[2 * i + 1][1], pre->g_pre_comp[2 * i + 1][2],
-                  pre->g_pre_comp[2 * i][0],     pre->g_pre_comp[2 * i][1],     pre->g_pre_comp[2 * i][2], 0,
-                  pre->g_pre_comp[1][0],         pre->g_pre_comp[1][1],         pre->g_pre_comp[1][2]);
+    for (i = 0; i < 2; i++) {
+        /* g_pre_comp[i][0] is the point at infinity */
+        memset(pre->g_pre_comp[i][0], 0, sizeof(pre->g_pre_comp[i][0]));
+        /* the remaining multiples */
+        /* 2^96*G + 2^192*G resp. 2^144*G + 2^240*G */
+        point_add(pre->g_pre_comp[i][6][0],  pre->g_pre_comp[i][6][1],  pre->g_pre_comp[i][6][2],
+                  pre->g_pre_comp[i][4][0],  pre->g_pre_comp[i][4][1],  pre->g_pre_comp[i][4][2], 0,
+                  pre->g_pre_comp[i][2][0],  pre->g_pre_comp[i][2][1],  pre->g_pre_comp[i][2][2]);
+        /* 2^96*G + 2^288*G resp. 2^144*G + 2^336*G */
+        point_add(pre->g_pre_comp[i][10][0], pre->g_pre_comp[i][10][1], pre->g_pre_comp[i][10][2],
+                  pre->g_pre_comp[i][8][0],  pre->g_pre_comp[i][8][1],  pre->g_pre_comp[i][8][2], 0,
+                  pre->g_pre_comp[i][2][0],  pre->g_pre_comp[i][2][1],  pre->g_pre_comp[i][2][2]);
+        /* 2^192*G + 2^288*G resp. 2^240*G + 2^336*G */
+        point_add(pre->g_pre_comp[i][12][0], pre->g_pre_comp[i][12][1], pre->g_pre_comp[i][12][2],
+                  pre->g_pre_comp[i][8][0],  pre->g_pre_comp[i][8][1],  pre->g_pre_comp[i][8][2], 0,
+                  pre->g_pre_comp[i][4][0],  pre->g_pre_comp[i][4][1],  pre->g_pre_comp[i][4][2]);
+        /* 2^96*G + 2^192*G + 2^288*G resp. 2^144*G + 2^240*G + 2^336*G */
+        point_add(pre->g_pre_comp[i][14][0], pre->g_pre_comp[i][14][1], pre->g_pre_comp[i][14][2],
+                  pre->g_pre_comp[i][12][0], pre->g_pre_comp[i][12][1], pre->g_pre_comp[i][12][2], 0,
+                  pre->g_pre_comp[i][2][0],  pre->g_pre_comp[i][2][1],  pre->g_pre_comp[i][2][2]);
+        for (j = 1; j < 8; ++j) {
+            /* odd multiples: add G resp. 2^48*G */
+            point_add(pre->g_pre_comp[i][2 * j + 1][0], pre->g_pre_comp[i][2 * j + 1][1], pre->g_pre_comp[i][2 * j + 1][2],
+                      pre->g_pre_comp[i][2 * j][0],     pre->g_pre_comp[i][2 * j][1],     pre->g_pre_comp[i][2 * j][2], 0,
+                      pre->g_pre_comp[i][1][0],         pre->g_pre_comp[i][1][1],         pre->g_pre_comp[i][1][2]);
+        }
     }
-    make_points_affine(15, &(pre->g_pre_comp[1]), tmp_felems);
+    make_points_affine(31, &(pre->g_pre_comp[0][1]), tmp_felems);
 
  done:
     SETPRECOMP(group, nistp384, pre);
@@ -1400,141 +1400,251 @@ static void point_add(felem x3, felem y3, felem z3,
  * elements (x, y, z).
  *
  * For the base point table, z is usually 1 (0 for the point at infinity).
- * This table has 16 elements:
+ * This table has 2 * 16 elements, starting with the following:
  * index | bits    | point
  * ------+---------+------------------------------
  *     0 | 0 0 0 0 | 0G
  *     1 | 0 0 0 1 | 1G
- *     2 | 0 0 1 0 | 2^130G
- *     3 | 0 0 1 1 | (2^130 + 1)G
- *     4 | 0 1 0 0 | 2^260G
- *     5 | 0 1 0 1 | (2^260 + 1)G
- *     6 | 0 1 1 0 | (2^260 + 2^130)G
- *     7 | 0 1 1 1 | (2^260 + 2^130 + 1)G
- *     8 | 1 0 0 0 | 2^390G
- *     9 | 1 0 0 1 | (2^390 + 1)G
- *    10 | 1 0 1 0 | (2^390 + 2^130)G
- *    11 | 1 0 1 1 | (2^390 + 2^130 + 1)G
- *    12 | 1 1 0 0 | (2^390 + 2^260)G
- *    13 | 1 1 0 1 | (2^390 + 2^260 + 1)G
- *    14 | 1 1 1 0 | (2^390 + 2^260 + 2^130)G
- *    15 | 1 1 1 1 | (2^390 + 2^260 + 2^130 + 1)G
+ *     2 | 0 0 1 0 | 2^132G
+ *     3 | 0 0 1 1 | (2^132 + 1)G
+ *     4 | 0 1 0 0 | 2^264G
+ *     5 | 0 1 0 1 | (2^264 + 1)G
+ *     6 | 0 1 1 0 | (2^264 + 2^132)G
+ *     7 | 0 1 1 1 | (2^264 + 2^132 + 1)G
+ *     8 | 1 0 0 0 | 2^396G
+ *     9 | 1 0 0 1 | (2^396 + 1)G
+ *    10 | 1 0 1 0 | (2^396 + 2^132)G
+ *    11 | 1 0 1 1 | (2^396 + 2^132 + 1)G
+ *    12 | 1 1 0 0 | (2^396 + 2^264)G
+ *    13 | 1 1 0 1 | (2^396 + 2^264 + 1)G
+ *    14 | 1 1 1 0 | (2^396 + 2^264 + 2^132)G
+ *    15 | 1 1 1 1 | (2^396 + 2^264 + 2^132 + 1)G
+ * followed by a copy of this with each element multiplied by 2^66.
  *
  * The reason for this is so that we can clock bits into four different
- * locations when doing simple scalar multiplies against the base point.
+ * locations when doing simple scalar multiplies against the base point,
+ * and then another four locations using the second 16 elements.
  *
  * Tables for other points have table[i] = iG for i in 0 .. 16. */
 
 /* gmul is the table of precomputed base points */
-static const felem gmul[16][3] = {
-{{0, 0, 0, 0, 0, 0, 0, 0, 0},
- {0, 0, 0, 0, 0, 0, 0, 0, 0},
- {0, 0, 0, 0, 0, 0, 0, 0, 0}},
-{{0x017e7e31c2e5bd66, 0x022cf0615a90a6fe, 0x00127a2ffa8de334,
-  0x01dfbf9d64a3f877, 0x006b4d3dbaa14b5e, 0x014fed487e0a2bd8,
-  0x015b4429c6481390, 0x03a73678fb2d988e, 0x00c6858e06b70404},
- {0x00be94769fd16650, 0x031c21a89cb09022, 0x039013fad0761353,
-  0x02657bd099031542, 0x03273e662c97ee72, 0x01e6d11a05ebef45,
-  0x03d1bd998f544495, 0x03001172297ed0b1, 0x011839296a789a3b},
- {1, 0, 0, 0, 0, 0, 0, 0, 0}},
-{{0x0373faacbc875bae, 0x00f325023721c671, 0x00f666fd3dbde5ad,
-  0x01a6932363f88ea7, 0x01fc6d9e13f9c47b, 0x03bcbffc2bbf734e,
-  0x013ee3c3647f3a92, 0x029409fefe75d07d, 0x00ef9199963d85e5},
- {0x011173743ad5b178, 0x02499c7c21bf7d46, 0x035beaeabb8b1a58,
-  0x00f989c4752ea0a3, 0x0101e1de48a9c1a3, 0x01a20076be28ba6c,
-  0x02f8052e5eb2de95, 0x01bfe8f82dea117c, 0x0160074d3c36ddb7},
- {1, 0, 0, 0, 0, 0, 0, 0, 0}},
-{{0x012f3fc373393b3b, 0x03d3d6172f1419fa, 0x02adc943c0b86873,
-  0x00d475584177952b, 0x012a4d1673750ee2, 0x00512517a0f13b0c,
-  0x02b184671a7b1734, 0x0315b84236f1a50a, 0x00a4afc472edbdb9},
- {0x00152a7077f385c4, 0x03044007d8d1c2ee, 0x0065829d61d52b52,
-  0x00494ff6b6631d0d, 0x00a11d94d5f06bcf, 0x02d2f89474d9282e,
-  0x0241c5727c06eeb9, 0x0386928710fbdb9d, 0x01f883f727b0dfbe},
- {1, 0, 0, 0, 0, 0, 0, 0, 0}},
-{{0x019b0c3c9185544d, 0x006243a37c9d97db, 0x02ee3cbe030a2ad2,
-  0x00cfdd946bb51e0d, 0x0271c00932606b91, 0x03f817d1ec68c561,
-  0x03f37009806a369c, 0x03c1f30baf184fd5, 0x01091022d6d2f065},
- {0x0292c583514c45ed, 0x0316fca51f9a286c, 0x00300af507c1489a,
-  0x0295f69008298cf1, 0x02c0ed8274943d7b, 0x016509b9b47a431e,
-  0x02bc9de9634868ce, 0x005b34929bffcb09, 0x000c1a0121681524},
- {1, 0, 0, 0, 0, 0, 0, 0, 0}},
-{{0x0286abc0292fb9f2, 0x02665eee9805b3f7, 0x01ed7455f17f26d6,
-  0x0346355b83175d13, 0x006284944cd0a097, 0x0191895bcdec5e51,
-  0x02e288370afda7d9, 0x03b22312bfefa67a, 0x01d104d3fc0613fe},
- {0x0092421a12f7e47f, 0x0077a83fa373c501, 0x03bd25c5f696bd0d,
-  0x035c41e4d5459761, 0x01ca0d1742b24f53, 0x00aaab27863a509c,
-  0x018b6de47df73917, 0x025c0b771705cd01, 0x01fd51d566d760a7},
- {1, 0, 0, 0, 0, 0, 0, 0, 0}},
-{{0x01dd92ff6b0d1dbd, 0x039c5e2e8f8afa69, 0x0261ed13242c3b27,
-  0x0382c6e67026e6a0, 0x01d60b10be2089f9, 0x03c15f3dce86723f,
-  0x03c764a32d2a062d, 0x017307eac0fad056, 0x018207c0b96c5256},
- {0x0196a16d60e13154, 0x03e6ce74c0267030, 0x00ddbf2b4e52a5aa,
-  0x012738241bbf31c8, 0x00ebe8dc04685a28, 0x024c2ad6d380d4a2,
-  0x035ee062a6e62d0e, 0x0029ed74af7d3a0f, 0x00eef32aec142ebd},
- {1, 0, 0, 0, 0, 0, 0, 0, 0}},
-{{0x00c31ec398993b39, 0x03a9f45bcda68253, 0x00ac733c24c70890,
-  0x00872b111401ff01, 0x01d178c23195eafb, 0x03bca2c816b87f74,
-  0x0261a9af46fbad7a, 0x0324b2a8dd3d28f9, 0x00918121d8f24e23},
- {0x032bc8c1ca983cd7, 0x00d869dfb08fc8c6, 0x01693cb61fce1516,
-  0x012a5ea68f4e88a8, 0x010869cab88d7ae3, 0x009081ad277ceee1,
-  0x033a77166d064cdc, 0x03955235a1fb3a95, 0x01251a4a9b25b65e},
- {1, 0, 0, 0, 0, 0, 0, 0, 0}},
-{{0x00148a3a1b27f40b, 0x0123186df1b31fdc, 0x00026e7beaad34ce,
-  0x01db446ac1d3dbba, 0x0299c1a33437eaec, 0x024540610183cbb7,
-  0x0173bb0e9ce92e46, 0x02b937e43921214b, 0x01ab0436a9bf01b5},
- {0x0383381640d46948, 0x008dacbf0e7f330f, 0x03602122bcc3f318,
-  0x01ee596b200620d6, 0x03bd0585fda430b3, 0x014aed77fd123a83,
-  0x005ace749e52f742, 0x0390fe041da2b842, 0x0189a8ceb3299242},
- {1, 0, 0, 0, 0, 0, 0, 0, 0}},
-{{0x012a19d6b3282473, 0x00c0915918b423ce, 0x023a954eb94405ae,
-  0x00529f692be26158, 0x0289fa1b6fa4b2aa, 0x0198ae4ceea346ef,
-  0x0047d8cdfbdedd49, 0x00cc8c8953f0f6b8, 0x001424abbff49203},
- {0x0256732a1115a03a, 0x0351bc38665c6733, 0x03f7b950fb4a6447,
-  0x000afffa94c22155, 0x025763d0a4dab540, 0x000511e92d4fc283,
-  0x030a7e9eda0ee96c, 0x004c3cd93a28bf0a, 0x017edb3a8719217f},
- {1, 0, 0, 0, 0, 0, 0, 0, 0}},
-{{0x011de5675a88e673, 0x031d7d0f5e567fbe, 0x0016b2062c970ae5,
-  0x03f4a2be49d90aa7, 0x03cef0bd13822866, 0x03f0923dcf774a6c,
-  0x0284bebc4f322f72, 0x016ab2645302bb2c, 0x01793f95dace0e2a},
- {0x010646e13527a28f, 0x01ca1babd59dc5e7, 0x01afedfd9a5595df,
-  0x01f15785212ea6b1, 0x0324e5d64f6ae3f4, 0x02d680f526d00645,
-  0x0127920fadf627a7, 0x03b383f75df4f684, 0x0089e0057e783b0a},
- {1, 0, 0, 0, 0, 0, 0, 0, 0}},
-{{0x00f334b9eb3c26c6, 0x0298fdaa98568dce, 0x01c2d24843a82292,
-  0x020bcb24fa1b0711, 0x02cbdb3d2b1875e6, 0x0014907598f89422,
-  0x03abe3aa43b26664, 0x02cbf47f720bc168, 0x0133b5e73014b79b},
- {0x034aab5dab05779d, 0x00cdc5d71fee9abb, 0x0399f16bd4bd9d30,
-  0x03582fa592d82647, 0x02be1cdfb775b0e9, 0x0034f7cea32e94cb,
-  0x0335a7f08f56f286, 0x03b707e9565d1c8b, 0x0015c946ea5b614f},
- {1, 0, 0, 0, 0, 0, 0, 0, 0}},
-{{0x024676f6cff72255, 0x00d14625cac96378, 0x00532b6008bc3767,
-  0x01fc16721b985322, 0x023355ea1b091668, 0x029de7afdc0317c3,
-  0x02fc8a7ca2da037c, 0x02de1217d74a6f30, 0x013f7173175b73bf},
- {0x0344913f441490b5, 0x0200f9e272b61eca, 0x0258a246b1dd55d2,
-  0x03753db9ea496f36, 0x025e02937a09c5ef, 0x030cbd3d14012692,
-  0x01793a67e70dc72a, 0x03ec1d37048a662e, 0x006550f700c32a8d},
- {1, 0, 0, 0, 0, 0, 0, 0, 0}},
-{{0x00d3f48a347eba27, 0x008e636649b61bd8, 0x00d3b93716778fb3,
-  0x004d1915757bd209, 0x019d5311a3da44e0, 0x016d1afcbbe6aade,
-  0x0241bf5f73265616, 0x0384672e5d50d39b, 0x005009fee522b684},
- {0x029b4fab064435fe, 0x018868ee095bbb07, 0x01ea3d6936cc92b8,
-  0x000608b00f78a2f3, 0x02db911073d1c20f, 0x018205938470100a,
-  0x01f1e4964cbe6ff2, 0x021a19a29eed4663, 0x01414485f42afa81},
- {1, 0, 0, 0, 0, 0, 0, 0, 0}},
-{{0x01612b3a17f63e34, 0x03813992885428e6, 0x022b3c215b5a9608,
-  0x029b4057e19f2fcb, 0x0384059a587af7e6, 0x02d6400ace6fe610,
-  0x029354d896e8e331, 0x00c047ee6dfba65e, 0x0037720542e9d49d},
- {0x02ce9eed7c5e9278, 0x0374ed703e79643b, 0x01316c54c4072006,
-  0x005aaa09054b2ee8, 0x002824000c840d57, 0x03d4eba24771ed86,
-  0x0189c50aabc3bdae, 0x0338c01541e15510, 0x00466d56e38eed42},
- {1, 0, 0, 0, 0, 0, 0, 0, 0}},
-{{0x007efd8330ad8bd6, 0x02465ed48047710b, 0x0034c6606b215e0c,
-  0x016ae30c53cbf839, 0x01fa17bd37161216, 0x018ead4e61ce8ab9,
-  0x005482ed5f5dee46, 0x037543755bba1d7f, 0x005e5ac7e70a9d0f},
- {0x0117e1bb2fdcb2a2, 0x03deea36249f40c4, 0x028d09b4a6246cb7,
-  0x03524b8855bcf756, 0x023d7d109d5ceb58, 0x0178e43e3223ef9c,
-  0x0154536a0c6e966a, 0x037964d1286ee9fe, 0x0199bcd90e125055},
- {1, 0, 0, 0, 0, 0, 0, 0, 0}}
+static const felem gmul[2][16][3] = {
+    {{{0, 0, 0, 0, 0, 0, 0, 0, 0},
+      {0, 0, 0, 0, 0, 0, 0, 0, 0},
+      {0, 0, 0, 0, 0, 0, 0, 0, 0}},
+     {{0x017e7e31c2e5bd66, 0x022cf0615a90a6fe, 0x00127a2ffa8de334,
+       0x01dfbf9d64a3f877, 0x006b4d3dbaa14b5e, 0x014fed487e0a2bd8,
+       0x015b4429c6481390, 0x03a73678fb2d988e, 0x00c6858e06b70404},
+      {0x00be94769fd16650, 0x031c21a89cb09022, 0x039013fad0761353,
+       0x02657bd099031542, 0x03273e662c97ee72, 0x01e6d11a05ebef45,
+       0x03d1bd998f544495, 0x03001172297ed0b1, 0x011839296a789a3b},
+      {1, 0, 0, 0, 0, 0, 0, 0, 0}},
+     {{0x004f2d4bdf9314e0, 0x03a14379e802ab24, 0x01083582efb03daa,
+       0x020fb1ff9b49e48c, 0x02199d74a880f1c2, 0x025401f9cb56ce65,
+       0x033f03e5f120b9b3, 0x02da18c348ddcd1d, 0x0121f4c192733b78},
+      {0x0103ff6dfa8b51f0, 0x02bed45038af7c3c, 0x0380e83254171ae7,
+       0x02e33684365444c0, 0x024f3a8c01e83501, 0x03201c1a4415ddc7,
+       0x02238218f52196aa, 0x029fc4d826c2aa95, 0x01db8c25790694a0},
+      {1, 0, 0, 0, 0, 0, 0, 0, 0}},
+     {{0x000370ccb2c0958d, 0x03bc599a69ece1cc, 0x033cf480c9b3889a,
+       0x03cbeacf85249e4b, 0x02507489670b2984, 0x034cf6caa5d4790d,
+       0x00a4daa9cab99d5a, 0x01cc95365174cad1, 0x000aa26cca5216c7},
+      {0x01be1d41f9e66d18, 0x03bbe5aa845f9eb3, 0x014a2ddb0d24b80a,
+       0x009d7262defc14c8, 0x02dfd3c8486dcfb2, 0x0329354b184f9d0d,
+       0x0151e646e703fa13, 0x0149f43238a5dc61, 0x01c6f5e90eacbfa8},
+      {1, 0, 0, 0, 0, 0, 0, 0, 0}},
+     {{0x0231e71a286492ad, 0x00f791197e1ab13b, 0x000d4da713cb408f,
+       0x03a6a1adc413a25c, 0x032572c1617ad0f5, 0x0173072676698b93,
+       0x0162e0c77d223ef2, 0x02c817b7fda584ee, 0x008e818d28f381d8},
+      {0x021231cf8cdf1f60, 0x0103cad9c5dd83dc, 0x02f8ce045a4038b6,
+       0x03700dc1a27ef9c9, 0x0372ea0dcb422285, 0x02021988dc65afe3,
+       0x026fe48a16f7855c, 0x02fd1353867f1f0c, 0x013efdbc856e8f68},
+      {1, 0, 0, 0, 0, 0, 0, 0, 0}},
+     {{0x0234d04fe6a3ace5, 0x02d80fa258647077, 0x00007f75ed0f40db,
+       0x02f256c966d6d370, 0x022615f02015e0e6, 0x00c7a8fe37ef2e99,
+       0x03ff824b2ec5433d, 0x00ccb90ac2c39040, 0x011119315060c480},
+      {0x0197ea28045452f1, 0x019e33dc7cfdcee6, 0x03ddc41e9328e80b,
+       0x01bb9abc708d294a, 0x01b44215e7b7f265, 0x002900a2f10e016e,
+       0x02476e23aa734f2f, 0x0033df8f1c91e508, 0x01f16dc2e8b068c6},
+      {1, 0, 0, 0, 0, 0, 0, 0, 0}},
+     {{0x001691027b7dc837, 0x0065d52d43ac7105, 0x0092ad7e6741b2d7,
+       0x0076f20928e013d0, 0x02c8e20bcf1d0a7f, 0x0286076c15c2c815,
+       0x03b508a6732e3b9d, 0x001249e2018db829, 0x004511af502cc9f7},
+      {0x03820d94c56f4ffa, 0x008168b13c303e82, 0x03d4ea1a0606a1c6,
+       0x0199e6cc5bee67cc, 0x02e4f240fc1bab64, 0x00b5f710c16a8214,
+       0x023c07322539b789, 0x0198cc0d95fc481b, 0x005928405280cedb},
+      {1, 0, 0, 0, 0, 0, 0, 0, 0}},
+     {{0x00d087114397760c, 0x0082dd8727f341a4, 0x007fa987e24f7b90,
+       0x0281488cd6831ffb, 0x01ae21ca100e33b8, 0x02c0c8881cf6fabf,
+       0x0145da6458c060a3, 0x018bbe6e71cee3b8, 0x00aa31c661e527ff},
+      {0x03518eb081430b5e, 0x03e73a943b835a6b, 0x030b5aa6ebe8bb32,
+       0x03ca7f875a243b36, 0x031a59cc9a1f15f7, 0x022aca98f3975a3c,
+       0x007ce54f4d679940, 0x001ddba16c73bd0d, 0x01768ff423c0286d},
+      {1, 0, 0, 0, 0, 0, 0, 0, 0}},
+     {{0x03d8ce7b5a53c22b, 0x00cff35f2ad11a86, 0x024e248acb394787,
+       0x007a8e31e43f1132, 0x0315c34237a9888b, 0x02dc0818cdabedba,
+       0x03508fab913b8a8f, 0x01ccacd2ddf31645, 0x0050a931d7a7f9e4},
+      {0x010a429056d21d18, 0x0198c1d56d04286a, 0x00a8b894a6b05826,
+       0x018e0a33dd72d1a1, 0x02127702a38a1ade, 0x037dedc253ecbe16,
+       0x00d1db683ff7d05a, 0x03357074fd6a4a9a, 0x00f5243ce1dbc093},
+      {1, 0, 0, 0, 0, 0, 0, 0, 0}},
+     {{0x03c183c3d37d7891, 0x0140527f6197b2a3, 0x003d68f21844117b,
+       0x0095681fd9603db9, 0x03ad303202af51ec, 0x0019dbbd63f969b2,
+       0x00e000c95de68f31, 0x014951d4238c7f29, 0x0159783e5a957773},
+      {0x001db5712e537ad9, 0x01c44b4d6fa73def, 0x02b48d57f9bcb5e8,
+       0x0242a2cf2f1eed48, 0x01e5ecdb5c1eff78, 0x00e1f9fb53cc1b84,
+       0x0321e3d30da83923, 0x0299f13647f3d1c8, 0x009f8487bb62e412},
+      {1, 0, 0, 0, 0, 0, 0, 0, 0}},
+     {{0x01550ab0bd3902fe, 0x0292d2e1aa74ecf6, 0x020a9975cac379bb,
+       0x00c4ccd81770e967, 0x021afc2c58045e87, 0x03be72fc7cb16630,
+       0x0383c4281ff8d6fe, 0x00c7560afb57426f, 0x01579d1d9d5b5281},
+      {0x007da3055519258e, 0x014e7e409f78aa1a, 0x01747d6a230d673f,
+       0x008d7d745a11a7ea, 0x035f7e41f5ab1aeb, 0x01a9ffacd6effa51,
+       0x02d5187bd546abb1, 0x014f74abef53a385, 0x01607437be13bcc9},
+      {1, 0, 0, 0, 0, 0, 0, 0, 0}},
+     {{0x01f165a9ee9755a3, 0x035686ae0b26ac55, 0x0245aab6b97e60c8,
+       0x02c2ac1789c59687, 0x026db0830f3004cd, 0x016b2f7ae7830ed4,
+       0x01e8498aae1ec1a7, 0x0318b904f51211d8, 0x01e9589e09bbb1b9},
+      {0x035120819c72258d, 0x0335cd170564f519, 0x03a7b91c11fdb61d,
+       0x02fe215e4239b189, 0x02530bc68ed1d3e9, 0x02d6d13fe6ab01bf,
+       0x010edd5125c16bb6, 0x036d70e2182edb6e, 0x01aa96fe8b08fbbe},
+      {1, 0, 0, 0, 0, 0, 0, 0, 0}},
+     {{0x02ad2247d181c3f2, 0x034d6fbccdec8fff, 0x03cba74890672915,
+       0x023ff69e8e876d33, 0x0179275686e4f70d, 0x03fc7de7889ad906,
+       0x01fa4e8e80408636, 0x027d8263a12ce73d, 0x00da57aa0be9d8a0},
+      {0x000cecf54efcea66, 0x03cabb2bf1dbebb5, 0x01a48c91585a898d,
+       0x029c4fc02a958fc6, 0x0344b5cb9fb111bd, 0x0149883459a1ebea,
+       0x00b35abc6d5fb126, 0x03134abe54fc6eeb, 0x00ed99709370ff94},
+      {1, 0, 0, 0, 0, 0, 0, 0, 0}},
+     {{0x009f56e068b54c89, 0x03305f739cdf08ab, 0x0283fab089b5308e,
+       0x00a550fef46c823b, 0x00844dd706b0f3a1, 0x03b0b90346c8133e,
+       0x019914a80975c89d, 0x0137dc22c046ba4e, 0x00176b4ba1707467},
+      {0x01216ea98fdfc175, 0x01ff18df83d6c31c, 0x0285fceb33a3477b,
+       0x013c088faade2340, 0x0351c6d922b67981, 0x0304fd47641e1c82,
+       0x02d60b55859d5a49, 0x032acb9a7e142feb, 0x005c2499a8446d0c},
+      {1, 0, 0, 0, 0, 0, 0, 0, 0}},
+     {{0x02456e58108ce13f, 0x03f163438e5e04d9, 0x0284bea3949e9b5b,
+       0x02f1d6bd99f412da, 0x00a891566bea9b66, 0x03d856569f2d35b7,
+       0x02e25201b3cecf0b, 0x0297e90c4b1cf400, 0x014b81d768986135},
+      {0x0047bc25841078ec, 0x02a72585e7115350, 0x006094851f8fc75a,
+       0x00fb38d0247da858, 0x0088e54102998d4e, 0x036a2b17a6a7d9c1,
+       0x02c230cbf280f885, 0x02ddd71932b2823f, 0x002b0ac864b05094},
+      {1, 0, 0, 0, 0, 0, 0, 0, 0}},
+     {{0x03606e398f5daf7f, 0x02152244249d419a, 0x01c5c08c58a72483,
+       0x0343243cfb8e8895, 0x0008795f022f362f, 0x01097d6ab258cebd,
+       0x006dbfb71710bd10, 0x02ef370805f817b0, 0x01c8d9c7dc82c1b8},
+      {0x01b41fdf18b8bed9, 0x020cc238e88c495f, 0x01de77291c4bbe94,
+       0x00ad05122abef3e4, 0x03c44da4629b0b97, 0x006fd428a577f18c,
+       0x01e313190b9c4630, 0x02ab6462d9bdde1a, 0x00f5a8a4e2fa121b},
+      {1, 0, 0, 0, 0, 0, 0, 0, 0}}},
+    {{{0, 0, 0, 0, 0, 0, 0, 0, 0},
+      {0, 0, 0, 0, 0, 0, 0, 0, 0},
+      {0, 0, 0, 0, 0, 0, 0, 0, 0}},
+     {{0x003986670f0ccb51, 0x0387404d9525d2a0, 0x00f21b2b29ed9b87,
+       0x02aa8eb74cddfd63, 0x00e9d08ffb06c0e9, 0x019d8589fc4ecd74,
+       0x00a3ef4dd8bf44c9, 0x00eb6e92863051d6, 0x013e96a576dda004},
+      {0x03de24f8632d95a3, 0x0057bc5314920a4a, 0x0063e9bdaba1979f,
+       0x03d2a58adc1eab76, 0x0214258d98dde053, 0x018708d7316628b7,
+       0x03fd32c9fa5a19d0, 0x033ab03b519443a3, 0x01852aea9dd1ef78},
+      {1, 0, 0, 0, 0, 0, 0, 0, 0}},
+     {{0x01b51bb04bee80d7, 0x03da87dda4b79a58, 0x0246ca0ebc3bd0e1,
+       0x029e4c1913c20de7, 0x03390db0771c0bff, 0x02b6873a65f19ee1,
+       0x014b512095c33e1f, 0x021958f1402b76b1, 0x00b0c231d360d311},
+      {0x0228929839bcab2f, 0x0019e01937488281, 0x02084763dc2a0c0c,
+       0x01cc64e30f8c18bd, 0x0152e46eb988e9da, 0x0297783f5a6fa3cb,
+       0x02c0e26e55c8d2d6, 0x03fd5fce8ff58f6c, 0x014a899c6d9f1e4b},
+      {1, 0, 0, 0, 0, 0, 0, 0, 0}},
+     {{0x00c7c4a8ae4d0f28, 0x02957bd59b401bba, 0x01f65066e40233a8,
+       0x02d574c86dd8de61, 0x02b8351b078decca, 0x01f5522ace2e59b5,
+       0x031ab0b2e889e535, 0x014dedea7a38bf98, 0x005945c60f95e75c},
+      {0x00a27d347867d79c, 0x0182c5607206602f, 0x019ab976b8c517f4,
+       0x021986e47b65fb0b, 0x01d9c1d15ffcd044, 0x0253276e5cc29e89,
+       0x02c5a3b8a2cf259f, 0x00c7ba39e12e1d77, 0x0004062526073e51},
+      {1, 0, 0, 0, 0, 0, 0, 0, 0}},
+     {{0x006119f6a1c88f3c, 0x0397fb0bb1a5129b, 0x02c605742ff2a924,
+       0x007b76c8b1f1322a, 0x00fa5d25bb60adde, 0x03045f7825ca24e3,
+       0x02929c1fa5ac4f7e, 0x0257d507cd6add20, 0x0180d1c4e8f90afd},
+      {0x03c4e73da7cd8358, 0x018695fca872480b, 0x03130ad94d288393,
+       0x0198ada9e38bdbcb, 0x0379c262cde37e24, 0x006d65ee42eaffe2,
+       0x00d4e646cae01ef6, 0x03e1167078cfc298, 0x000e52a42280dd01},
+      {1, 0, 0, 0, 0, 0, 0, 0, 0}},
+     {{0x005db629e9068656, 0x02f5c327fb7937fb, 0x015bdfcd45546623,
+       0x03498a469d071e2b, 0x02761e688ef7981d, 0x016e49cbceb14f64,
+       0x0146fec6a96892a5, 0x00bd59085f9ee019, 0x015e793c03cbab9e},
+      {0x00fd95436eff39be, 0x02bc1fb6ffd3da02, 0x03abdb02416165a1,
+       0x03f751e600a60f51, 0x0060b2e6fb37c5d2, 0x03a36e662761b65e,
+       0x028b9bbe3e3284ec, 0x0062ce7c127ad761, 0x018e3b3e8a789dad},
+      {1, 0, 0, 0, 0, 0, 0, 0, 0}},
+     {{0x005f297d8b481bf7, 0x00a8f90a84ce0f33, 0x0128cdc40b96c06a,
+       0x017c462768f27851, 0x016cd57fa79a2bf3, 0x00d5f4caee2b6e62,
+       0x0176fadc1a4935c9, 0x00f78547ec96030b, 0x01ba98721eb424f2},
+      {0x0002daaf52a4b397, 0x017d330342d39523, 0x00db37b7e79cdc3c,
+       0x03b2cce5c2d8a6f9, 0x0092808c7ff34336, 0x008a236c7b4f72df,
+       0x02ed59aec290eff0, 0x03e97ca91e7547a5, 0x00929d7ed87076d8},
+      {1, 0, 0, 0, 0, 0, 0, 0, 0}},
+     {{0x00cbd9d5bf5caa87, 0x03f183da37632763, 0x00dbbc7d4dede17b,
+       0x011609c2d6fd8fad, 0x01cc098fe7bf6e59, 0x0175ee3d621c4de9,
+       0x025a533ca5eb6870, 0x0029b12df7bbb92c, 0x00ef8e045c324a70},
+      {0x020c1c9270cf52bc, 0x00fd8ea43318a605, 0x0021cbf3028fb4bf,
+       0x035d48efbfc57ffd, 0x038b9ce1050a8102, 0x019886c7bfccc268,
+       0x00a78078e9da4d00, 0x02184a5dd7e27f30, 0x00eb590448650017},
+      {1, 0, 0, 0, 0, 0, 0, 0, 0}},
+     {{0x01bf4f9faf2ed12f, 0x0346793ce03f62ab, 0x03db5a39e81aece1,
+       0x008589bbdaf0255e, 0x020cf5b28df98333, 0x000e4b350442b97a,
+       0x0067855ab1594502, 0x0187199f12621daf, 0x004ace7e5938a3fd},
+      {0x01c5b9ef28c7dea9, 0x03e56e829a9c6116, 0x002578202769cd02,
+       0x00225375a2580d37, 0x03b5dea95a213b0b, 0x005f2a2240dcc2df,
+       0x01ba052fe243ed06, 0x025b685b3d345fec, 0x01c0d8691d6b226f},
+      {1, 0, 0, 0, 0, 0, 0, 0, 0}},
+     {{0x019f7df053053af7, 0x0011d96ca2873d2f, 0x038fc7ce90438603,
+       0x01bab2317775105d, 0x03fb59ec618fbed3, 0x006c6fb3c9ec4c4e,
+       0x01973a99d2656ffa, 0x02d654cd384d1651, 0x018c3261888cc362},
+      {0x0013a414aa7f6ff8, 0x02bae20feadf1ebd, 0x0086b7cc307ba092,
+       0x00948d18403be876, 0x0302140c93dc81c1, 0x0184120d64f5349c,
+       0x01795f3a1ed7e3ce, 0x03505b8ae47b3f7c, 0x0191160dc11a369e},
+      {1, 0, 0, 0, 0, 0, 0, 0, 0}},
+     {{0x00fa3c0f16c386ee, 0x02c11a7530260e48, 0x01722876a3136b33,
+       0x0248f101b019e783, 0x024debe27d343c0a, 0x025bc03abbc8838f,
+       0x029dcff09d7b1e11, 0x034215283d776092, 0x01e253582ec599c1},
+      {0x008ef2625138c7ed, 0x010c651951fe2373, 0x013addd0a9488dec,
+       0x03ea095faf70adb9, 0x031f08c989eb9f1e, 0x00058dda3160f1ba,
+       0x0020e3df17369114, 0x0145398a0bfe2f6f, 0x00d526b810059cbd},
+      {1, 0, 0, 0, 0, 0, 0, 0, 0}},
+     {{0x009f8576943cc612, 0x010c67a0cacc71e9, 0x02297cccadebdc91,
+       0x010ac18660864897, 0x0025b1cc7c4918fb, 0x0191b97c2b32cc21,
+       0x00e3e22751d3347a, 0x000023abed2ab964, 0x0151821460382c4a},
+      {0x002481dbbf96a461, 0x0048ba6d4a8ee90f, 0x0058e464db08b51c,
+       0x01e1b5a82074870a, 0x00f533cef7b1014b, 0x005517df059f4fb5,
+       0x01b7b9f6cfb32948, 0x030a67a91b4c7112, 0x0081cfad76139621},
+      {1, 0, 0, 0, 0, 0, 0, 0, 0}},
+     {{0x0111d12a1078342a, 0x011c979566841900, 0x01d590fd3ffdd053,
+       0x027c1bc2b07fa916, 0x033e19bc69cf694a, 0x027773403db492b6,
+       0x032dd4e3ce38f5eb, 0x007154e1003d9ad8, 0x0085cab8fdfbe15e},
+      {0x02943f6b8d09422f, 0x00a5d583e6230ec2, 0x001fa2ef2e4d917d,
+       0x00ecd7df04fd5691, 0x03edaad3ff674352, 0x00d1c90b49d34d01,
+       0x038615d594114359, 0x02533472c9cc04ee, 0x007da0437004bd77},
+      {1, 0, 0, 0, 0, 0, 0, 0, 0}},
+     {{0x01f689ac12b3118b, 0x03b8e75b2dba959f, 0x022c2187cd978d06,
+       0x0206354df61f3f30, 0x02e9f56db2b985b6, 0x038263055d611454,
+       0x0212cd20f8398715, 0x00711efa5a9720ec, 0x01fb3dda0338d9ac},
+      {0x006b7fe0cfa0a9b8, 0x022eb1f88b73dd7c, 0x01e04136887c8947,
+       0x037a453152f3ce05, 0x000f51ea64ed811d, 0x0321c15df2309058,
+       0x02bbcb463914d834, 0x03d4bbb493954aa2, 0x00019e5eb9e82644},
+      {1, 0, 0, 0, 0, 0, 0, 0, 0}},
+     {{0x01aeede15af3a8ca, 0x0091e0a970d47b09, 0x023fbf93ec080339,
+       0x03139bd096d1079e, 0x0081e76009b04f93, 0x00603ff1b93b04bb,
+       0x00aef3a797366d45, 0x0076474a4f2ed438, 0x0061a149694468d7},
+      {0x012c541c675a67a1, 0x00e34c23d7fa41bd, 0x03cccf6be988e67d,
+       0x02f861626218a9c2, 0x027067045bae03ec, 0x0032a365bb340985,
+       0x000735d1facdd991, 0x03c871ea842a08c3, 0x00152a27e5543328},
+      {1, 0, 0, 0, 0, 0, 0, 0, 0}},
+     {{0x02ab2d0408e1cc4d, 0x01d634eb4b707b97, 0x03dfe5c9c7393e93,
+       0x02a74cde5a0c33ad, 0x02e24f86d7530d86, 0x002c6ec2fbd4a0f2,
+       0x01b4e3cab5d1a64f, 0x0031665aaaf07d53, 0x01443e3d87cc3bc0},
+      {0x010a82131d60e7b0, 0x02d8a6d74cf40639, 0x02e42fd05338dfc9,
+       0x0303a0871bab152b, 0x0306ac09cb0678f2, 0x00c0637db97275d7,
+       0x038c667833575135, 0x038b760729beb02f, 0x00e17fc8020e9d0a},
+      {1, 0, 0, 0, 0, 0, 0, 0, 0}}}
 };
 
 /*
@@ -1582,7 +1692,7 @@ static void batch_mul(felem x_out, felem y_out, felem z_out,
                       const felem_bytearray scalars[],
                       const unsigned num_points, const u8 *g_scalar,
                       const int mixed, const felem pre_comp[][17][3],
-                      const felem g_pre_comp[16][3])
+                      const felem g_pre_comp[2][16][3])
 {
     int i, skip;
     unsigned num, gen_mul = (g_scalar != NULL);
@@ -1595,26 +1705,25 @@ static void batch_mul(felem x_out, felem y_out, felem z_out,
 
     /*
      * Loop over all scalars msb-to-lsb, interleaving additions of multiples
-     * of the generator (last quarter of rounds) and additions of other
-     * points multiples (every 5th round).
+     * of the generator (two in each of the last 66 rounds) and additions of
+     * other points multiples (every 5th round).
      */
     skip = 1;                   /* save two point operations in the first
                                  * round */
-    for (i = (num_points ? 520 : 130); i >= 0; --i) {
+    for (i = (num_points ? 520 : 65); i >= 0; --i) {
         /* double */
         if (!skip)
             point_double(nq[0], nq[1], nq[2], nq[0], nq[1], nq[2]);
 
         /* add multiples of the generator */
-        if (gen_mul && (i <= 130)) {
-            bits = get_bit(g_scalar, i + 390) << 3;
-            if (i < 130) {
-                bits |= get_bit(g_scalar, i + 260) << 2;
-                bits |= get_bit(g_scalar, i + 130) << 1;
-                bits |= get_bit(g_scalar, i);
-            }
+        if (gen_mul && (i <= 65)) {
+            /* first, look 66 bits upwards */
+            bits = get_bit(g_scalar, i + 462) << 3;
+            bits |= get_bit(g_scalar, i + 330) << 2;
+            bits |= get_bit(g_scalar, i + 198) << 1;
+            bits |= get_bit(g_scalar, i + 66);
             /* select the point to add, in constant time */
-            select_point(bits, 16, g_pre_comp, tmp);
+            select_point(bits, 16, g_pre_comp[1], tmp);
             if (!skip) {
                 /* The 1 argument below is for "mixed" */
                 point_add(nq[0], nq[1], nq[2],
@@ -1623,6 +1732,17 @@ static void batch_mul(felem x_out, felem y_out, felem z_out,
                 memcpy(nq, tmp, 3 * sizeof(felem));
                 skip = 0;
             }
+
+            /* second, look at the current position */
+            bits = get_bit(g_scalar, i + 396) << 3;
+            bits |= get_bit(g_scalar, i + 264) << 2;
+            bits |= get_bit(g_scalar, i + 132) << 1;
+            bits |= get_bit(g_scalar, i);
+            /* select the point to add, in constant time */
+            select_point(bits, 16, g_pre_comp[0], tmp);
+            /* The 1 argument below is for "mixed" */
+            point_add(nq[0], nq[1], nq[2],
+                      nq[0], nq[1], nq[2], 1, tmp[0], tmp[1], tmp[2]);
         }
 
         /* do other additions every 5 doublings */
@@ -1663,7 +1783,7 @@ static void batch_mul(felem x_out, felem y_out, felem z_out,
 
 /* Precomputation for the group generator. */
 struct nistp521_pre_comp_st {
-    felem g_pre_comp[16][3];
+    felem g_pre_comp[2][16][3];
     CRYPTO_REF_COUNT references;
 };
 
@@ -1924,7 +2044,7 @@ int ossl_ec_GFp_nistp521_points_mul(const EC_GROUP *group, EC_POINT *r,
     size_t num_points = num;
     felem x_in, y_in, z_in, x_out, y_out, z_out;
     NISTP521_PRE_COMP *pre = NULL;
-    felem(*g_pre_comp)[3] = NULL;
+    felem(*g_pre_comp)[16][3] = NULL;
     EC_POINT *generator = NULL;
     const EC_POINT *p = NULL;
     const BIGNUM *p_scalar = NULL;
@@ -1944,14 +2064,14 @@ int ossl_ec_GFp_nistp521_points_mul(const EC_GROUP *group, EC_POINT *r,
             g_pre_comp = &pre->g_pre_comp[0];
         else
             /* try to use the standard precomputation */
-            g_pre_comp = (felem(*)[3]) gmul;
+            g_pre_comp = (felem(*)[16][3]) gmul;
         generator = EC_POINT_new(group);
         if (generator == NULL)
             goto err;
         /* get the generator from precomputation */
-        if (!felem_to_BN(x, g_pre_comp[1][0]) ||
-            !felem_to_BN(y, g_pre_comp[1][1]) ||
-            !felem_to_BN(z, g_pre_comp[1][2])) {
+        if (!felem_to_BN(x, g_pre_comp[0][1][0]) ||
+            !felem_to_BN(y, g_pre_comp[0][1][1]) ||
+            !felem_to_BN(z, g_pre_comp[0][1][2])) {
             ERR_raise(ERR_LIB_EC, ERR_R_BN_LIB);
             goto err;
         }
@@ -2077,7 +2197,7 @@ int ossl_ec_GFp_nistp521_points_mul(const EC_GROUP *group, EC_POINT *r,
                   (const felem_bytearray(*))secrets, num_points,
                   g_secret,
                   mixed, (const felem(*)[17][3])pre_comp,
-                  (const felem(*)[3])g_pre_comp);
+                  (const felem(*)[16][3])g_pre_comp);
     } else {
         /* do the multiplication without generator precomputation */
         batch_mul(x_out, y_out, z_out,
@@ -2112,7 +2232,7 @@ int ossl_ec_GFp_nistp521_precompute_mult(EC_GROUP *group, BN_CTX *ctx)
     int i, j;
     BIGNUM *x, *y;
     EC_POINT *generator = NULL;
-    felem tmp_felems[16];
+    felem tmp_felems[32];
 #ifndef FIPS_MODULE
     BN_CTX *new_ctx = NULL;
 #endif
@@ -2151,61 +2271,83 @@ int ossl_ec_GFp_nistp521_precompute_mult(EC_GROUP *group, BN_CTX *ctx)
         memcpy(pre->g_pre_comp, gmul, sizeof(pre->g_pre_comp));
         goto done;
     }
-    if ((!BN_to_felem(pre->g_pre_comp[1][0], group->generator->X)) ||
-        (!BN_to_felem(pre->g_pre_comp[1][1], group->generator->Y)) ||
-        (!BN_to_felem(pre->g_pre_comp[1][2], group->generator->Z)))
+    if ((!BN_to_felem(pre->g_pre_comp[0][1][0], group->generator->X)) ||
+        (!BN_to_felem(pre->g_pre_comp[0][1][1], group->generator->Y)) ||
+        (!BN_to_felem(pre->g_pre_comp[0][1][2], group->generator->Z)))
         goto err;
-    /* compute 2^130*G, 2^260*G, 2^390*G */
-    for (i = 1; i <= 4; i <<= 1) {
-        point_double(pre->g_pre_comp[2 * i][0], pre->g_pre_comp[2 * i][1],
-                     pre->g_pre_comp[2 * i][2], pre->g_pre_comp[i][0],
-                     pre->g_pre_comp[i][1], pre->g_pre_comp[i][2]);
-        for (j = 0; j < 129; ++j) {
-            point_double(pre->g_pre_comp[2 * i][0],
-                         pre->g_pre_comp[2 * i][1],
-                         pre->g_pre_comp[2 * i][2],
-                         pre->g_pre_comp[2 * i][0],
-                         pre->g_pre_comp[2 * i][1],
-                         pre->g_pre_comp[2 * i][2]);
+    /*
+     * compute 2^132*G, 2^264*G, 2^396*G for the first table, 2^66*G,
+     * 2^198*G, 2^330*G, 2^462*G for the second one
+     */
+    for (i = 1; i <= 8; i <<= 1) {
+        point_double(pre->g_pre_comp[1][i][0], pre->g_pre_comp[1][i][1],
+                     pre->g_pre_comp[1][i][2], pre->g_pre_comp[0][i][0],
+                     pre->g_pre_comp[0][i][1], pre->g_pre_comp[0][i][2]);
+        for (j = 0; j < 65; ++j) {
+            point_double(pre->g_pre_comp[1][i][0],
+                         pre->g_pre_comp[1][i][1],
+                         pre->g_pre_comp[1][i][2],
+                         pre->g_pre_comp[1][i][0],
+                         pre->g_pre_comp[1][i][1],
+                         pre->g_pre_comp[1][i][2]);
+        }
+        if (i == 8)
+            break;
+        point_double(pre->g_pre_comp[0][2 * i][0],
+                     pre->g_pre_comp[0][2 * i][1],
+                     pre->g_pre_comp[0][2 * i][2],
+                     pre->g_pre_comp[1][i][0], pre->g_pre_comp[1][i][1],
+                     pre->g_pre_comp[1][i][2]);
+        for (j = 0; j < 65; ++j) {
+            point_double(pre->g_pre_comp[0][2 * i][0],
+                         pre->g_pre_comp[0][2 * i][1],
+                         pre->g_pre_comp[0][2 * i][2],
+                         pre->g_pre_comp[0][2 * i][0],
+                         pre->g_pre_comp[0][2 * i][1],
+                         pre->g_pre_comp[0][2 * i][2]);
         }
     }
-    /* g_pre_comp[0] is the point at infinity */
-    memset(pre->g_pre_comp[0], 0, sizeof(pre->g_pre_comp[0]));
-    /* the remaining multiples */
-    /* 2^130*G + 2^260*G */
-    point_add(pre->g_pre_comp[6][0], pre->g_pre_comp[6][1],
-              pre->g_pre_comp[6][2], pre->g_pre_comp[4][0],
-              pre->g_pre_comp[4][1], pre->g_pre_comp[4][2],
-              0, pre->g_pre_comp[2][0], pre->g_pre_comp[2][1],
-              pre->g_pre_comp[2][2]);
-    /* 2^130*G + 2^390*G */
-    point_add(pre->g_pre_comp[10][0], pre->g_pre_comp[10][1],
-              pre->g_pre_comp[10][2], pre->g_pre_comp[8][0],
-              pre->g_pre_comp[8][1], pre->g_pre_comp[8][2],
-              0, pre->g_pre_comp[2][0], pre->g_pre_comp[2][1],
-              pre->g_pre_comp[2][2]);
-    /* 2^260*G + 2^390*G */
-    point_add(pre->g_pre_comp[12][0], pre->g_pre_comp[12][1],
-              pre->g_pre_comp[12][2], pre->g_pre_comp[8][0],
-              pre->g_pre_comp[8][1], pre->g_pre_comp[8][2],
-              0, pre->g_pre_comp[4][0], pre->g_pre_comp[4][1],
-              pre->g_pre_comp[4][2]);
-    /* 2^130*G + 2^260*G + 2^390*G */
-    point_add(pre->g_pre_comp[14][0], pre->g_pre_comp[14][1],
-              pre->g_pre_comp[14][2], pre->g_pre_comp[12][0],
-              pre->g_pre_comp[12][1], pre->g_pre_comp[12][2],
-              0, pre->g_pre_comp[2][0], pre->g_pre_comp[2][1],
-              pre->g_pre_comp[2][2]);
-    for (i = 1; i < 8; ++i) {
-        /* odd multiples: add G */
-        point_add(pre->g_pre_comp[2 * i + 1][0],
-                  pre->g_pre_comp[2 * i + 1][1],
-                  pre->g_pre_comp[2 * i + 1][2], pre->g_pre_comp[2 * i][0],
-                  pre->g_pre_comp[2 * i][1], pre->g_pre_comp[2 * i][2], 0,
-                  pre->g_pre_comp[1][0], pre->g_pre_comp[1][1],
-                  pre->g_pre_comp[1][2]);
+    for (i = 0; i < 2; i++) {
+        /* g_pre_comp[i][0] is the point at infinity */
+        memset(pre->g_pre_comp[i][0], 0, sizeof(pre->g_pre_comp[i][0]));
+        /* the remaining multiples */
+        /* 2^132*G + 2^264*G resp. 2^198*G + 2^330*G */
+        point_add(pre->g_pre_comp[i][6][0], pre->g_pre_comp[i][6][1],
+                  pre->g_pre_comp[i][6][2], pre->g_pre_comp[i][4][0],
+                  pre->g_pre_comp[i][4][1], pre->g_pre_comp[i][4][2],
+                  0, pre->g_pre_comp[i][2][0], pre->g_pre_comp[i][2][1],
+                  pre->g_pre_comp[i][2][2]);
+        /* 2^132*G + 2^396*G resp. 2^198*G + 2^462*G */
+        point_add(pre->g_pre_comp[i][10][0], pre->g_pre_comp[i][10][1],
+                  pre->g_pre_comp[i][10][2], pre->g_pre_comp[i][8][0],
+                  pre->g_pre_comp[i][8][1], pre->g_pre_comp[i][8][2],
+                  0, pre->g_pre_comp[i][2][0], pre->g_pre_comp[i][2][1],
+                  pre->g_pre_comp[i][2][2]);
+        /* 2^264*G + 2^396*G resp. 2^330*G + 2^462*G */
+        point_add(pre->g_pre_comp[i][12][0], pre->g_pre_comp[i][12][1],
+                  pre->g_pre_comp[i][12][2], pre->g_pre_comp[i][8][0],
+                  pre->g_pre_comp[i][8][1], pre->g_pre_comp[i][8][2],
+                  0, pre->g_pre_comp[i][4][0], pre->g_pre_comp[i][4][1],
+                  pre->g_pre_comp[i][4][2]);
+        /* 2^132*G + 2^264*G + 2^396*G resp. 2^198*G + 2^330*G + 2^462*G */
+        point_add(pre->g_pre_comp[i][14][0], pre->g_pre_comp[i][14][1],
+                  pre->g_pre_comp[i][14][2], pre->g_pre_comp[i][12][0],
+                  pre->g_pre_comp[i][12][1], pre->g_pre_comp[i][12][2],
+                  0, pre->g_pre_comp[i][2][0], pre->g_pre_comp[i][2][1],
+                  pre->g_pre_comp[i][2][2]);
+        for (j = 1; j < 8; ++j) {
+            /* odd multiples: add G resp. 2^66*G */
+            point_add(pre->g_pre_comp[i][2 * j + 1][0],
+                      pre->g_pre_comp[i][2 * j + 1][1],
+                      pre->g_pre_comp[i][2 * j + 1][2],
+                      pre->g_pre_comp[i][2 * j][0],
+                      pre->g_pre_comp[i][2 * j][1],
+                      pre->g_pre_comp[i][2 * j][2], 0,
+                      pre->g_pre_comp[i][1][0], pre->g_pre_comp[i][1][1],
+                      pre->g_pre_comp[i][1][2]);
+        }
     }
-    make_points_affine(15, &(pre->g_pre_comp[1]), tmp_felems);
+    make_points_affine(31, &(pre->g_pre_comp[0][1]), tmp_felems);
 
  done:
     SETPRECOMP(group, nistp521, pre);
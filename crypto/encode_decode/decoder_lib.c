@@ -723,6 +723,7 @@ static int decoder_process(const OSSL_PARAM params[], void *arg)
     struct decoder_process_data_st new_data;
     const char *data_type = NULL;
     const char *data_structure = NULL;
+    int data_type_id = 0;
 
     /*
      * This is an indicator up the call stack that something was indeed
@@ -917,9 +918,11 @@ static int decoder_process(const OSSL_PARAM params[], void *arg)
 
         /*
          * If the previous decoder gave us a data type, we check to see
-         * if that matches the decoder we're currently considering.
+         * if that matches the decoder we're currently considering.  The
+         * data type is only looked up in the namemap once for all of them.
          */
-        if (data_type != NULL && !OSSL_DECODER_is_a(new_decoder, data_type)) {
+        if (data_type != NULL
+            && !ossl_decoder_fast_is_a(new_decoder, data_type, &data_type_id)) {
             OSSL_TRACE_BEGIN(DECODER) {
                 BIO_printf(trc_out,
                            "(ctx %p) %s [%u] the previous decoder's data type doesn't match the name of the considered decoder, skipping...\n",
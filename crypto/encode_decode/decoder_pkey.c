@@ -22,6 +22,11 @@
 #include "encoder_local.h"
 #include "internal/namemap.h"
 #include "internal/sizes.h"
+#include "internal/thread.h"
+
+#if defined(OPENSSL_THREADS) && !defined(OPENSSL_NO_THREAD_POOL)
+# define DECODER_BULK_THREADS
+#endif
 
 int OSSL_DECODER_CTX_set_passphrase(OSSL_DECODER_CTX *ctx,
                                     const unsigned char *kstr,
@@ -877,3 +882,139 @@ OSSL_DECODER_CTX_new_for_pkey(EVP_PKEY **pkey,
     OSSL_DECODER_CTX_free(ctx);
     return NULL;
 }
+
+/*
+ * Support for OSSL_DECODER_pkeys_from_data:
+ * Every thread taking part gets its own OSSL_DECODER_CTX, which it reuses for
+ * all the keys it decodes, and picks the next key to decode from a shared
+ * counter until there are none left.
+ */
+struct decoder_bulk_data_st {
+    EVP_PKEY **pkeys;
+    const unsigned char **data;
+    const size_t *data_len;
+    uint64_t num;
+
+    const char *input_type;
+    const char *input_struct;
+    const char *keytype;
+    int selection;
+    OSSL_LIB_CTX *libctx;
+    const char *propquery;
+
+    CRYPTO_RWLOCK *lock;        /* Used if there are no atomics */
+    uint64_t next;              /* Number of keys handed out so far */
+    uint64_t decoded;           /* Number of keys successfully decoded */
+};
+
+static CRYPTO_THREAD_RETVAL decoder_bulk_worker(void *arg)
+{
+    struct decoder_bulk_data_st *bulk = arg;
+    OSSL_DECODER_CTX *dctx;
+    EVP_PKEY *pkey = NULL;
+    uint64_t i, decoded = 0;
+
+    dctx = OSSL_DECODER_CTX_new_for_pkey(&pkey, bulk->input_type,
+                                         bulk->input_struct, bulk->keytype,
+                                         bulk->selection, bulk->libctx,
+                                         bulk->propquery);
+    if (dctx == NULL)
+        return 0;
+
+    while (CRYPTO_atomic_add64(&bulk->next, 1, &i, bulk->lock)
+           && i <= bulk->num) {
+        const unsigned char *p = bulk->data[i - 1];
+        size_t len = bulk->data_len[i - 1];
+
+        /* A key that doesn't decode is reported through its NULL slot */
+        ERR_set_mark();
+        if (p != NULL && OSSL_DECODER_from_data(dctx, &p, &len)
+                && pkey != NULL) {
+            bulk->pkeys[i - 1] = pkey;
+            decoded++;
+        } else {
+            EVP_PKEY_free(pkey);
+        }
+        ERR_pop_to_mark();
+        pkey = NULL;
+    }
+    OSSL_DECODER_CTX_free(dctx);
+
+    return CRYPTO_atomic_add64(&bulk->decoded, decoded, &i, bulk->lock);
+}
+
+size_t OSSL_DECODER_pkeys_from_data(EVP_PKEY **pkeys, size_t num,
+                                    const unsigned char **data,
+                                    const size_t *data_len,
+                                    const char *input_type,
+                                    const char *input_struct,
+                                    const char *keytype, int selection,
+                                    OSSL_LIB_CTX *libctx,
+                                    const char *propquery)
+{
+    struct decoder_bulk_data_st bulk;
+    size_t i;
+#ifdef DECODER_BULK_THREADS
+    void **threads = NULL;
+    size_t nthreads = 0;
+    uint64_t avail;
+#endif
+
+    if (pkeys == NULL || data == NULL || data_len == NULL) {
+        ERR_raise(ERR_LIB_OSSL_DECODER, ERR_R_PASSED_NULL_PARAMETER);
+        return 0;
+    }
+    for (i = 0; i < num; i++)
+        pkeys[i] = NULL;
+    if (num == 0)
+        return 0;
+
+    memset(&bulk, 0, sizeof(bulk));
+    bulk.pkeys = pkeys;
+    bulk.data = data;
+    bulk.data_len = data_len;
+    bulk.num = num;
+    bulk.input_type = input_type;
+    bulk.input_struct = input_struct;
+    bulk.keytype = keytype;
+    bulk.selection = selection;
+    bulk.libctx = libctx;
+    bulk.propquery = propquery;
+    if ((bulk.lock = CRYPTO_THREAD_lock_new()) == NULL) {
+        ERR_raise(ERR_LIB_OSSL_DECODER, ERR_R_CRYPTO_LIB);
+        return 0;
+    }
+
+#ifdef DECODER_BULK_THREADS
+    /*
+     * Use as many threads from the library context's thread pool as are
+     * available (see OSSL_set_max_threads(3)), this thread included.
+     */
+    avail = ossl_get_avail_threads(libctx);
+    if (avail > num - 1)
+        avail = num - 1;
+    if (avail > 0
+            && (threads = OPENSSL_malloc(avail * sizeof(*threads))) != NULL) {
+        for (nthreads = 0; nthreads < avail; nthreads++) {
+            threads[nthreads] = ossl_crypto_thread_start(libctx,
+                                                         decoder_bulk_worker,
+                                                         &bulk);
+            if (threads[nthreads] == NULL)
+                break;
+        }
+    }
+#endif
+
+    (void)decoder_bulk_worker(&bulk);
+
+#ifdef DECODER_BULK_THREADS
+    for (i = 0; i < nthreads; i++) {
+        (void)ossl_crypto_thread_join(threads[i], NULL);
+        (void)ossl_crypto_thread_clean(threads[i]);
+    }
+    OPENSSL_free(threads);
+#endif
+
+    CRYPTO_THREAD_lock_free(bulk.lock);
+    return (size_t)bulk.decoded;
+}
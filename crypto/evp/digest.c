@@ -612,6 +612,21 @@ int EVP_MD_CTX_copy_ex(EVP_MD_CTX *out, const EVP_MD_CTX *in)
             || (in->flags & EVP_MD_CTX_FLAG_NO_INIT) != 0)
         goto legacy;
 
+    /*
+     * If |out| is already set up for the same digest, copy the state into
+     * its existing provider side context instead of allocating a new one.
+     */
+    if (out->digest == in->digest
+            && in->digest->copyctx != NULL
+            && in->algctx != NULL
+            && out->algctx != NULL
+            && out->pctx == NULL) {
+        in->digest->copyctx(out->algctx, in->algctx);
+        out->flags = in->flags;
+        out->update = in->update;
+        goto clone_pkey;
+    }
+
     if (in->digest->dupctx == NULL) {
         ERR_raise(ERR_LIB_EVP, EVP_R_NOT_ABLE_TO_COPY_CTX);
         return 0;
@@ -1077,6 +1092,10 @@ static void *evp_md_from_algorithm(int name_id,
             if (md->dupctx == NULL)
                 md->dupctx = OSSL_FUNC_digest_dupctx(fns);
             break;
+        case OSSL_FUNC_DIGEST_COPYCTX:
+            if (md->copyctx == NULL)
+                md->copyctx = OSSL_FUNC_digest_copyctx(fns);
+            break;
         case OSSL_FUNC_DIGEST_GET_PARAMS:
             if (md->get_params == NULL)
                 md->get_params = OSSL_FUNC_digest_get_params(fns);
@@ -118,6 +118,7 @@ struct evp_keymgmt_st {
     OSSL_FUNC_keymgmt_gen_set_params_fn *gen_set_params;
     OSSL_FUNC_keymgmt_gen_settable_params_fn *gen_settable_params;
     OSSL_FUNC_keymgmt_gen_fn *gen;
+    OSSL_FUNC_keymgmt_gen_batch_fn *gen_batch;
     OSSL_FUNC_keymgmt_gen_cleanup_fn *gen_cleanup;
 
     OSSL_FUNC_keymgmt_load_fn *load;
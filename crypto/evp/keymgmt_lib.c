@@ -119,8 +119,6 @@ void *evp_keymgmt_util_export_to_provider(EVP_PKEY *pk, EVP_KEYMGMT *keymgmt,
             && pk->keymgmt->prov == keymgmt->prov))
         return pk->keydata;
 
-    if (!CRYPTO_THREAD_read_lock(pk->lock))
-        return NULL;
     /*
      * If the provider native "origin" hasn't changed since last time, we
      * try to find our keymgmt in the operation cache.  If it has changed
@@ -128,15 +126,11 @@ void *evp_keymgmt_util_export_to_provider(EVP_PKEY *pk, EVP_KEYMGMT *keymgmt,
      */
     if (pk->dirty_cnt == pk->dirty_cnt_copy) {
         /* If this key is already exported to |keymgmt|, no more to do */
-        op = evp_keymgmt_util_find_operation_cache(pk, keymgmt, selection);
-        if (op != NULL && op->keymgmt != NULL) {
-            void *ret = op->keydata;
+        void *ret = evp_keymgmt_util_lookup_keydata(pk, keymgmt, selection);
 
-            CRYPTO_THREAD_unlock(pk->lock);
+        if (ret != NULL)
             return ret;
-        }
     }
-    CRYPTO_THREAD_unlock(pk->lock);
 
     /* If the "origin" |keymgmt| doesn't support exporting, give up */
     if (pk->keymgmt->export == NULL)
@@ -222,6 +216,8 @@ static void op_cache_free(OP_CACHE_ELEM *e)
 int evp_keymgmt_util_clear_operation_cache(EVP_PKEY *pk)
 {
     if (pk != NULL) {
+        if (!CRYPTO_atomic_store(&pk->op_cache_fast_num, 0, NULL))
+            pk->op_cache_fast_num = 0;
         sk_OP_CACHE_ELEM_pop_free(pk->operation_cache, op_cache_free);
         pk->operation_cache = NULL;
     }
@@ -229,6 +225,49 @@ int evp_keymgmt_util_clear_operation_cache(EVP_PKEY *pk)
     return 1;
 }
 
+static ossl_inline int op_cache_match(const OP_CACHE_ELEM *p,
+                                      const EVP_KEYMGMT *keymgmt,
+                                      int selection)
+{
+    return (p->selection & selection) == selection
+        && (keymgmt == p->keymgmt
+            || (keymgmt->name_id == p->keymgmt->name_id
+                && keymgmt->prov == p->keymgmt->prov));
+}
+
+/*
+ * Find the keydata that |pk| was exported to |keymgmt| as, or NULL.  The
+ * caller is expected to have checked that the cache is current.
+ *
+ * The entries in |pk->op_cache_fast| are looked up without the lock.  This is
+ * safe because entries are only removed when the key is modified or freed,
+ * which must not happen while other threads are using it anyway.  Only if the
+ * cache has outgrown the fast entries is the lock taken for the rest.
+ */
+void *evp_keymgmt_util_lookup_keydata(EVP_PKEY *pk, EVP_KEYMGMT *keymgmt,
+                                      int selection)
+{
+    OP_CACHE_ELEM *op;
+    void *ret = NULL;
+    uint64_t i, n;
+
+    if (CRYPTO_atomic_load(&pk->op_cache_fast_num, &n, NULL)) {
+        for (i = 0; i < n; i++)
+            if (op_cache_match(pk->op_cache_fast[i], keymgmt, selection))
+                return pk->op_cache_fast[i]->keydata;
+        if (n < OP_CACHE_FAST)
+            return NULL;
+    }
+
+    if (!CRYPTO_THREAD_read_lock(pk->lock))
+        return NULL;
+    op = evp_keymgmt_util_find_operation_cache(pk, keymgmt, selection);
+    if (op != NULL)
+        ret = op->keydata;
+    CRYPTO_THREAD_unlock(pk->lock);
+    return ret;
+}
+
 OP_CACHE_ELEM *evp_keymgmt_util_find_operation_cache(EVP_PKEY *pk,
                                                      EVP_KEYMGMT *keymgmt,
                                                      int selection)
@@ -244,10 +283,7 @@ OP_CACHE_ELEM *evp_keymgmt_util_find_operation_cache(EVP_PKEY *pk,
      */
     for (i = 0; i < end; i++) {
         p = sk_OP_CACHE_ELEM_value(pk->operation_cache, i);
-        if ((p->selection & selection) == selection
-                && (keymgmt == p->keymgmt
-                    || (keymgmt->name_id == p->keymgmt->name_id
-                        && keymgmt->prov == p->keymgmt->prov)))
+        if (op_cache_match(p, keymgmt, selection))
             return p;
     }
     return NULL;
@@ -257,6 +293,7 @@ int evp_keymgmt_util_cache_keydata(EVP_PKEY *pk, EVP_KEYMGMT *keymgmt,
                                    void *keydata, int selection)
 {
     OP_CACHE_ELEM *p = NULL;
+    uint64_t n;
 
     if (keydata != NULL) {
         if (pk->operation_cache == NULL) {
@@ -282,6 +319,13 @@ int evp_keymgmt_util_cache_keydata(EVP_PKEY *pk, EVP_KEYMGMT *keymgmt,
             OPENSSL_free(p);
             return 0;
         }
+
+        /* Publish it for lock free lookups, if there is room */
+        n = pk->op_cache_fast_num;
+        if (n < OP_CACHE_FAST) {
+            pk->op_cache_fast[n] = p;
+            CRYPTO_atomic_store(&pk->op_cache_fast_num, n + 1, NULL);
+        }
     }
     return 1;
 }
@@ -119,6 +119,10 @@ static void *keymgmt_from_algorithm(int name_id,
             if (keymgmt->gen == NULL)
                 keymgmt->gen = OSSL_FUNC_keymgmt_gen(fns);
             break;
+        case OSSL_FUNC_KEYMGMT_GEN_BATCH:
+            if (keymgmt->gen_batch == NULL)
+                keymgmt->gen_batch = OSSL_FUNC_keymgmt_gen_batch(fns);
+            break;
         case OSSL_FUNC_KEYMGMT_GEN_CLEANUP:
             if (keymgmt->gen_cleanup == NULL)
                 keymgmt->gen_cleanup = OSSL_FUNC_keymgmt_gen_cleanup(fns);
@@ -245,7 +249,8 @@ static void *keymgmt_from_algorithm(int name_id,
         || (exportfncnt != 0 && exportfncnt != 2)
         || (keymgmt->gen != NULL
             && (keymgmt->gen_init == NULL
-                || keymgmt->gen_cleanup == NULL))) {
+                || keymgmt->gen_cleanup == NULL))
+        || (keymgmt->gen_batch != NULL && keymgmt->gen == NULL)) {
         EVP_KEYMGMT_free(keymgmt);
         ERR_raise(ERR_LIB_EVP, EVP_R_INVALID_PROVIDER_FUNCTIONS);
         return NULL;
@@ -446,6 +451,34 @@ void *evp_keymgmt_gen(const EVP_KEYMGMT *keymgmt, void *genctx,
     return keymgmt->gen(genctx, cb, cbarg);
 }
 
+/*
+ * Generate |num| keys at once.  Implementations that have no batch function
+ * get their gen function called once per key instead, so this always works
+ * when evp_keymgmt_gen() would.  On failure, no key is left behind in |keys|.
+ */
+int evp_keymgmt_gen_batch(const EVP_KEYMGMT *keymgmt, void *genctx,
+                          void *keys[], size_t num,
+                          OSSL_CALLBACK *cb, void *cbarg)
+{
+    size_t i;
+
+    if (keymgmt->gen_batch != NULL)
+        return keymgmt->gen_batch(genctx, keys, num, cb, cbarg);
+    if (keymgmt->gen == NULL)
+        return 0;
+
+    for (i = 0; i < num; i++) {
+        if ((keys[i] = keymgmt->gen(genctx, cb, cbarg)) == NULL) {
+            while (i-- > 0) {
+                evp_keymgmt_freedata(keymgmt, keys[i]);
+                keys[i] = NULL;
+            }
+            return 0;
+        }
+    }
+    return 1;
+}
+
 void evp_keymgmt_gen_cleanup(const EVP_KEYMGMT *keymgmt, void *genctx)
 {
     if (keymgmt->gen_cleanup != NULL)
@@ -1906,31 +1906,24 @@ void *evp_pkey_export_to_provider(EVP_PKEY *pk, OSSL_LIB_CTX *libctx,
          * |i| remains zero, and we will clear the cache further down.
          */
         if (pk->ameth->dirty_cnt(pk) == pk->dirty_cnt_copy) {
-            if (!CRYPTO_THREAD_read_lock(pk->lock))
-                goto end;
-            op = evp_keymgmt_util_find_operation_cache(pk, tmp_keymgmt,
-                                                       selection);
-
             /*
              * If |tmp_keymgmt| is present in the operation cache, it means
              * that export doesn't need to be redone.  In that case, we take
              * token copies of the cached pointers, to have token success
              * values to return. It is possible (e.g. in a no-cached-fetch
-             * build), for op->keymgmt to be a different pointer to tmp_keymgmt
-             * even though the name/provider must be the same. In other words
-             * the keymgmt instance may be different but still equivalent, i.e.
-             * same algorithm/provider instance - but we make the simplifying
-             * assumption that the keydata can be used with either keymgmt
-             * instance. Not doing so introduces significant complexity and
-             * probably requires refactoring - since we would have to ripple
-             * the change in keymgmt instance up the call chain.
+             * build), for the cached keymgmt to be a different pointer to
+             * tmp_keymgmt even though the name/provider must be the same. In
+             * other words the keymgmt instance may be different but still
+             * equivalent, i.e. same algorithm/provider instance - but we make
+             * the simplifying assumption that the keydata can be used with
+             * either keymgmt instance. Not doing so introduces significant
+             * complexity and probably requires refactoring - since we would
+             * have to ripple the change in keymgmt instance up the call chain.
              */
-            if (op != NULL && op->keymgmt != NULL) {
-                keydata = op->keydata;
-                CRYPTO_THREAD_unlock(pk->lock);
+            keydata = evp_keymgmt_util_lookup_keydata(pk, tmp_keymgmt,
+                                                      selection);
+            if (keydata != NULL)
                 goto end;
-            }
-            CRYPTO_THREAD_unlock(pk->lock);
         }
 
         /* Make sure that the keymgmt key type matches the legacy NID */
@@ -2020,6 +2013,21 @@ void *evp_pkey_export_to_provider(EVP_PKEY *pk, OSSL_LIB_CTX *libctx,
 }
 
 #ifndef FIPS_MODULE
+int EVP_PKEY_prepare_for_provider(EVP_PKEY *pkey, OSSL_LIB_CTX *libctx,
+                                  const char *propquery)
+{
+    if (pkey == NULL) {
+        ERR_raise(ERR_LIB_EVP, ERR_R_PASSED_NULL_PARAMETER);
+        return 0;
+    }
+
+    /*
+     * The export lands in the key's operation cache, which is where every
+     * later operation in |libctx| with |propquery| will look first.
+     */
+    return evp_pkey_export_to_provider(pkey, libctx, NULL, propquery) != NULL;
+}
+
 int evp_pkey_copy_downgraded(EVP_PKEY **dest, const EVP_PKEY *src)
 {
     EVP_PKEY *allocpkey = NULL;
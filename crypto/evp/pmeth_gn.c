@@ -274,6 +274,94 @@ int EVP_PKEY_keygen(EVP_PKEY_CTX *ctx, EVP_PKEY **ppkey)
     return EVP_PKEY_generate(ctx, ppkey);
 }
 
+int EVP_PKEY_keygen_batch(EVP_PKEY_CTX *ctx, EVP_PKEY **ppkeys, size_t num)
+{
+    void **keydata = NULL;
+    size_t i;
+    int ret = 0;
+    /* Legacy compatible keygen callback info, only used with provider impls */
+    int gentmp[2];
+
+    if (ppkeys == NULL)
+        return -1;
+    for (i = 0; i < num; i++)
+        ppkeys[i] = NULL;
+
+    if (ctx == NULL || ctx->operation != EVP_PKEY_OP_KEYGEN) {
+        ERR_raise(ERR_LIB_EVP, EVP_R_OPERATION_NOT_INITIALIZED);
+        return -1;
+    }
+    if (num == 0)
+        return 1;
+
+    /*
+     * Legacy implementations know nothing about batches, so they get one
+     * call per key.
+     */
+    if (ctx->op.keymgmt.genctx == NULL) {
+        for (i = 0; i < num; i++)
+            if ((ret = EVP_PKEY_generate(ctx, &ppkeys[i])) <= 0)
+                goto end;
+        return 1;
+    }
+
+    if ((keydata = OPENSSL_zalloc(num * sizeof(*keydata))) == NULL)
+        return -1;
+
+    ctx->keygen_info = gentmp;
+    ctx->keygen_info_count = 2;
+
+    ret = 1;
+    if (ctx->pkey != NULL) {
+        EVP_KEYMGMT *tmp_keymgmt = ctx->keymgmt;
+        void *templ =
+            evp_pkey_export_to_provider(ctx->pkey, ctx->libctx,
+                                        &tmp_keymgmt, ctx->propquery);
+
+        if (tmp_keymgmt == NULL) {
+            ctx->keygen_info = NULL;
+            ERR_raise(ERR_LIB_EVP,
+                      EVP_R_OPERATION_NOT_SUPPORTED_FOR_THIS_KEYTYPE);
+            ret = -2;
+            goto end;
+        }
+        ret = evp_keymgmt_gen_set_template(ctx->keymgmt,
+                                           ctx->op.keymgmt.genctx, templ);
+    }
+
+    ret = ret
+        && evp_keymgmt_gen_batch(ctx->keymgmt, ctx->op.keymgmt.genctx,
+                                 keydata, num,
+                                 ossl_callback_to_pkey_gencb, ctx);
+
+    ctx->keygen_info = NULL;
+
+    for (i = 0; ret && i < num; i++) {
+        if ((ppkeys[i] = EVP_PKEY_new()) == NULL
+            || !evp_keymgmt_util_assign_pkey(ppkeys[i], ctx->keymgmt,
+                                             keydata[i])) {
+            ERR_raise(ERR_LIB_EVP, ERR_R_EVP_LIB);
+            ret = 0;
+            break;
+        }
+        /* Ownership of the key data has moved to the EVP_PKEY */
+        keydata[i] = NULL;
+        ppkeys[i]->type = ctx->legacy_keytype;
+    }
+
+ end:
+    if (ret <= 0) {
+        for (i = 0; i < num; i++) {
+            if (keydata != NULL && keydata[i] != NULL)
+                evp_keymgmt_freedata(ctx->keymgmt, keydata[i]);
+            EVP_PKEY_free(ppkeys[i]);
+            ppkeys[i] = NULL;
+        }
+    }
+    OPENSSL_free(keydata);
+    return ret;
+}
+
 void EVP_PKEY_CTX_set_cb(EVP_PKEY_CTX *ctx, EVP_PKEY_gen_cb *cb)
 {
     ctx->pkey_gencb = cb;
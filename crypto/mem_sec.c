@@ -88,41 +88,122 @@ VirtualLock(
 #endif
 
 #ifndef OPENSSL_NO_SECURE_MEMORY
-static size_t secure_mem_used;
+/*
+ * The secure heap is made up of one or more arenas, each with its own lock,
+ * so that threads allocating at the same time are spread out rather than all
+ * queueing on one lock.  Each thread is given a home arena the first time it
+ * allocates, round robin, and only falls back to the others once that one is
+ * full.  Memory is always returned to the arena it came from.
+ */
+typedef struct sh_st SH;
+
+typedef struct sec_arena_st {
+    SH *sh;
+    CRYPTO_RWLOCK *lock;
+    size_t used;
+} SEC_ARENA;
+
+static SEC_ARENA *sec_arenas;
+static size_t sec_num_arenas;
 
 static int secure_mem_initialized;
 
 static CRYPTO_RWLOCK *sec_malloc_lock = NULL;
+static CRYPTO_THREAD_LOCAL sec_home_key;
+static int sec_next_home;
 
 /*
  * These are the functions that must be implemented by a secure heap (sh).
  */
-static int sh_init(size_t size, size_t minsize);
-static void *sh_malloc(size_t size);
-static void sh_free(void *ptr);
-static void sh_done(void);
-static size_t sh_actual_size(char *ptr);
-static int sh_allocated(const char *ptr);
+static SH *sh_init(size_t size, size_t minsize, int *result);
+static void *sh_malloc(SH *sh, size_t size);
+static void sh_free(SH *sh, void *ptr);
+static void sh_done(SH *sh);
+static size_t sh_actual_size(SH *sh, char *ptr);
+static int sh_allocated(SH *sh, const char *ptr);
+static void sh_release(SH *sh, void *ptr, size_t list);
+
+static void sec_arenas_free(void)
+{
+    size_t i;
+
+    for (i = 0; i < sec_num_arenas; i++) {
+        if (sec_arenas[i].sh != NULL)
+            sh_done(sec_arenas[i].sh);
+        CRYPTO_THREAD_lock_free(sec_arenas[i].lock);
+    }
+    OPENSSL_free(sec_arenas);
+    sec_arenas = NULL;
+    sec_num_arenas = 0;
+    CRYPTO_THREAD_cleanup_local(&sec_home_key);
+    CRYPTO_THREAD_lock_free(sec_malloc_lock);
+    sec_malloc_lock = NULL;
+}
+
+static size_t sec_home_arena(void)
+{
+    SEC_ARENA *home;
+    int n;
+
+    if (sec_num_arenas == 1)
+        return 0;
+    if ((home = CRYPTO_THREAD_get_local(&sec_home_key)) == NULL) {
+        if (!CRYPTO_atomic_add(&sec_next_home, 1, &n, sec_malloc_lock))
+            return 0;
+        home = &sec_arenas[(unsigned int)n % sec_num_arenas];
+        CRYPTO_THREAD_set_local(&sec_home_key, home);
+    }
+    return home - sec_arenas;
+}
+
+/* The arena |ptr| was allocated from, or NULL if it is not secure memory */
+static SEC_ARENA *sec_arena_of(const void *ptr)
+{
+    size_t i;
+
+    for (i = 0; i < sec_num_arenas; i++)
+        if (sh_allocated(sec_arenas[i].sh, ptr))
+            return &sec_arenas[i];
+    return NULL;
+}
 #endif
 
 int CRYPTO_secure_malloc_init(size_t size, size_t minsize)
+{
+    return CRYPTO_secure_malloc_init_ex(size, minsize, 1);
+}
+
+int CRYPTO_secure_malloc_init_ex(size_t size, size_t minsize, size_t arenas)
 {
 #ifndef OPENSSL_NO_SECURE_MEMORY
-    int ret = 0;
+    int ret = 0, result;
+    size_t i;
 
-    if (!secure_mem_initialized) {
-        sec_malloc_lock = CRYPTO_THREAD_lock_new();
-        if (sec_malloc_lock == NULL)
-            return 0;
-        if ((ret = sh_init(size, minsize)) != 0) {
-            secure_mem_initialized = 1;
-        } else {
-            CRYPTO_THREAD_lock_free(sec_malloc_lock);
-            sec_malloc_lock = NULL;
-        }
-    }
+    if (secure_mem_initialized
+            || arenas == 0 || arenas > SIZE_MAX / sizeof(*sec_arenas))
+        return 0;
+    if (!CRYPTO_THREAD_init_local(&sec_home_key, NULL))
+        return 0;
+    if ((sec_malloc_lock = CRYPTO_THREAD_lock_new()) == NULL
+            || (sec_arenas = OPENSSL_zalloc(arenas * sizeof(*sec_arenas))) == NULL)
+        goto err;
+    sec_num_arenas = arenas;
 
+    ret = 1;
+    for (i = 0; i < arenas; i++) {
+        if ((sec_arenas[i].lock = CRYPTO_THREAD_lock_new()) == NULL
+                || (sec_arenas[i].sh = sh_init(size, minsize, &result)) == NULL)
+            goto err;
+        if (result == 2)
+            ret = 2;
+    }
+    sec_next_home = 0;
+    secure_mem_initialized = 1;
     return ret;
+
+ err:
+    sec_arenas_free();
+    return 0;
 #else
     return 0;
 #endif /* OPENSSL_NO_SECURE_MEMORY */
@@ -131,15 +212,19 @@ int CRYPTO_secure_malloc_init(size_t size, size_t minsize)
 int CRYPTO_secure_malloc_done(void)
 {
 #ifndef OPENSSL_NO_SECURE_MEMORY
-    if (secure_mem_used == 0) {
-        sh_done();
-        secure_mem_initialized = 0;
-        CRYPTO_THREAD_lock_free(sec_malloc_lock);
-        sec_malloc_lock = NULL;
-        return 1;
-    }
-#endif /* OPENSSL_NO_SECURE_MEMORY */
+    size_t i;
+
+    if (!secure_mem_initialized)
+        return 0;
+    for (i = 0; i < sec_num_arenas; i++)
+        if (sec_arenas[i].used != 0)
+            return 0;
+    sec_arenas_free();
+    secure_mem_initialized = 0;
+    return 1;
+#else
     return 0;
+#endif /* OPENSSL_NO_SECURE_MEMORY */
 }
 
 int CRYPTO_secure_malloc_initialized(void)
@@ -155,20 +240,25 @@ void *CRYPTO_secure_malloc(size_t num, const char *file, int line)
 {
 #ifndef OPENSSL_NO_SECURE_MEMORY
     void *ret = NULL;
-    size_t actual_size;
+    SEC_ARENA *a;
+    size_t home, i;
     int reason = CRYPTO_R_SECURE_MALLOC_FAILURE;
 
     if (!secure_mem_initialized) {
         return CRYPTO_malloc(num, file, line);
     }
-    if (!CRYPTO_THREAD_write_lock(sec_malloc_lock)) {
-        reason = ERR_R_CRYPTO_LIB;
-        goto err;
+    home = sec_home_arena();
+    for (i = 0; i < sec_num_arenas && ret == NULL; i++) {
+        a = &sec_arenas[(home + i) % sec_num_arenas];
+        if (!CRYPTO_THREAD_write_lock(a->lock)) {
+            reason = ERR_R_CRYPTO_LIB;
+            goto err;
+        }
+        ret = sh_malloc(a->sh, num);
+        if (ret != NULL)
+            a->used += sh_actual_size(a->sh, ret);
+        CRYPTO_THREAD_unlock(a->lock);
     }
-    ret = sh_malloc(num);
-    actual_size = ret ? sh_actual_size(ret) : 0;
-    secure_mem_used += actual_size;
-    CRYPTO_THREAD_unlock(sec_malloc_lock);
  err:
     if (ret == NULL && (file != NULL || line != 0)) {
         ERR_new();
@@ -194,21 +284,22 @@ void *CRYPTO_secure_zalloc(size_t num, const char *file, int line)
 void CRYPTO_secure_free(void *ptr, const char *file, int line)
 {
 #ifndef OPENSSL_NO_SECURE_MEMORY
+    SEC_ARENA *a;
     size_t actual_size;
 
     if (ptr == NULL)
         return;
-    if (!CRYPTO_secure_allocated(ptr)) {
+    if (!secure_mem_initialized || (a = sec_arena_of(ptr)) == NULL) {
         CRYPTO_free(ptr, file, line);
         return;
     }
-    if (!CRYPTO_THREAD_write_lock(sec_malloc_lock))
+    if (!CRYPTO_THREAD_write_lock(a->lock))
         return;
-    actual_size = sh_actual_size(ptr);
+    actual_size = sh_actual_size(a->sh, ptr);
     CLEAR(ptr, actual_size);
-    secure_mem_used -= actual_size;
-    sh_free(ptr);
-    CRYPTO_THREAD_unlock(sec_malloc_lock);
+    a->used -= actual_size;
+    sh_free(a->sh, ptr);
+    CRYPTO_THREAD_unlock(a->lock);
 #else
     CRYPTO_free(ptr, file, line);
 #endif /* OPENSSL_NO_SECURE_MEMORY */
@@ -218,22 +309,23 @@ void CRYPTO_secure_clear_free(void *ptr, size_t num,
                               const char *file, int line)
 {
 #ifndef OPENSSL_NO_SECURE_MEMORY
+    SEC_ARENA *a;
     size_t actual_size;
 
     if (ptr == NULL)
         return;
-    if (!CRYPTO_secure_allocated(ptr)) {
+    if (!secure_mem_initialized || (a = sec_arena_of(ptr)) == NULL) {
         OPENSSL_cleanse(ptr, num);
         CRYPTO_free(ptr, file, line);
         return;
     }
-    if (!CRYPTO_THREAD_write_lock(sec_malloc_lock))
+    if (!CRYPTO_THREAD_write_lock(a->lock))
         return;
-    actual_size = sh_actual_size(ptr);
+    actual_size = sh_actual_size(a->sh, ptr);
     CLEAR(ptr, actual_size);
-    secure_mem_used -= actual_size;
-    sh_free(ptr);
-    CRYPTO_THREAD_unlock(sec_malloc_lock);
+    a->used -= actual_size;
+    sh_free(a->sh, ptr);
+    CRYPTO_THREAD_unlock(a->lock);
 #else
     if (ptr == NULL)
         return;
@@ -248,11 +340,11 @@ int CRYPTO_secure_allocated(const void *ptr)
     if (!secure_mem_initialized)
         return 0;
     /*
-     * Only read accesses to the arena take place in sh_allocated() and this
-     * is only changed by the sh_init() and sh_done() calls which are not
+     * Only read accesses to the arenas take place in sh_allocated() and they
+     * are only changed by the sh_init() and sh_done() calls which are not
      * locked.  Hence, it is safe to make this check without a lock too.
      */
-    return sh_allocated(ptr);
+    return sec_arena_of(ptr) != NULL;
 #else
     return 0;
 #endif /* OPENSSL_NO_SECURE_MEMORY */
@@ -263,12 +355,16 @@ size_t CRYPTO_secure_used(void)
     size_t ret = 0;
 
 #ifndef OPENSSL_NO_SECURE_MEMORY
-    if (!CRYPTO_THREAD_read_lock(sec_malloc_lock))
-        return 0;
-
-    ret = secure_mem_used;
+    size_t i;
 
-    CRYPTO_THREAD_unlock(sec_malloc_lock);
+    if (!secure_mem_initialized)
+        return 0;
+    for (i = 0; i < sec_num_arenas; i++) {
+        if (!CRYPTO_THREAD_read_lock(sec_arenas[i].lock))
+            return 0;
+        ret += sec_arenas[i].used;
+        CRYPTO_THREAD_unlock(sec_arenas[i].lock);
+    }
 #endif /* OPENSSL_NO_SECURE_MEMORY */
     return ret;
 }
@@ -276,12 +372,15 @@ size_t CRYPTO_secure_used(void)
 size_t CRYPTO_secure_actual_size(void *ptr)
 {
 #ifndef OPENSSL_NO_SECURE_MEMORY
+    SEC_ARENA *a;
     size_t actual_size;
 
-    if (!CRYPTO_THREAD_write_lock(sec_malloc_lock))
+    if (!secure_mem_initialized || (a = sec_arena_of(ptr)) == NULL)
         return 0;
-    actual_size = sh_actual_size(ptr);
-    CRYPTO_THREAD_unlock(sec_malloc_lock);
+    if (!CRYPTO_THREAD_write_lock(a->lock))
+        return 0;
+    actual_size = sh_actual_size(a->sh, ptr);
+    CRYPTO_THREAD_unlock(a->lock);
     return actual_size;
 #else
     return 0;
@@ -302,7 +401,7 @@ size_t CRYPTO_secure_actual_size(void *ptr)
  * Free'd memory is zero'd or otherwise cleansed.
  *
  * This is a pretty standard buddy allocator.  We keep areas in a multiple
- * of "sh.minsize" units.  The freelist and bitmaps are kept separately,
+ * of "sh->minsize" units.  The freelist and bitmaps are kept separately,
  * so all (and only) data is kept in the mmap'd heap.
  *
  * This code assumes eight-bit bytes.  The numbers 3 and 7 are all over the
@@ -315,10 +414,17 @@ size_t CRYPTO_secure_actual_size(void *ptr)
 # define SETBIT(t, b)   (t[(b) >> 3] |= (ONE << ((b) & 7)))
 # define CLEARBIT(t, b) (t[(b) >> 3] &= (0xFF & ~(ONE << ((b) & 7))))
 
+/*
+ * Freed blocks of up to (minsize << (SH_CACHE_CLASSES - 1)) bytes, which
+ * covers the BIGNUM sizes in common use, are cached up to SH_CACHE_DEPTH deep
+ */
+#define SH_CACHE_CLASSES 8
+#define SH_CACHE_DEPTH   32
+
 #define WITHIN_ARENA(p) \
-    ((char*)(p) >= sh.arena && (char*)(p) < &sh.arena[sh.arena_size])
+    ((char*)(p) >= sh->arena && (char*)(p) < &sh->arena[sh->arena_size])
 #define WITHIN_FREELIST(p) \
-    ((char*)(p) >= (char*)sh.freelist && (char*)(p) < (char*)&sh.freelist[sh.freelist_size])
+    ((char*)(p) >= (char*)sh->freelist && (char*)(p) < (char*)&sh->freelist[sh->freelist_size])
 
 
 typedef struct sh_list_st {
@@ -326,7 +432,7 @@ typedef struct sh_list_st {
     struct sh_list_st **p_next;
 } SH_LIST;
 
-typedef struct sh_st {
+struct sh_st {
     char* map_result;
     size_t map_size;
     char *arena;
@@ -337,17 +443,19 @@ typedef struct sh_st {
     unsigned char *bittable;
     unsigned char *bitmalloc;
     size_t bittable_size; /* size in bits */
-} SH;
+    /* Freed small blocks held back from coalescing, see sh_cache_put() */
+    char *cache[SH_CACHE_CLASSES];
+    size_t cache_count[SH_CACHE_CLASSES];
+};
 
-static SH sh;
 
-static size_t sh_getlist(char *ptr)
+static size_t sh_getlist(SH *sh, char *ptr)
 {
-    ossl_ssize_t list = sh.freelist_size - 1;
-    size_t bit = (sh.arena_size + ptr - sh.arena) / sh.minsize;
+    ossl_ssize_t list = sh->freelist_size - 1;
+    size_t bit = (sh->arena_size + ptr - sh->arena) / sh->minsize;
 
     for (; bit; bit >>= 1, list--) {
-        if (TESTBIT(sh.bittable, bit))
+        if (TESTBIT(sh->bittable, bit))
             break;
         OPENSSL_assert((bit & 1) == 0);
     }
@@ -356,42 +464,42 @@ static size_t sh_getlist(char *ptr)
 }
 
 
-static int sh_testbit(char *ptr, int list, unsigned char *table)
+static int sh_testbit(SH *sh, char *ptr, int list, unsigned char *table)
 {
     size_t bit;
 
-    OPENSSL_assert(list >= 0 && list < sh.freelist_size);
-    OPENSSL_assert(((ptr - sh.arena) & ((sh.arena_size >> list) - 1)) == 0);
-    bit = (ONE << list) + ((ptr - sh.arena) / (sh.arena_size >> list));
-    OPENSSL_assert(bit > 0 && bit < sh.bittable_size);
+    OPENSSL_assert(list >= 0 && list < sh->freelist_size);
+    OPENSSL_assert(((ptr - sh->arena) & ((sh->arena_size >> list) - 1)) == 0);
+    bit = (ONE << list) + ((ptr - sh->arena) / (sh->arena_size >> list));
+    OPENSSL_assert(bit > 0 && bit < sh->bittable_size);
     return TESTBIT(table, bit);
 }
 
-static void sh_clearbit(char *ptr, int list, unsigned char *table)
+static void sh_clearbit(SH *sh, char *ptr, int list, unsigned char *table)
 {
     size_t bit;
 
-    OPENSSL_assert(list >= 0 && list < sh.freelist_size);
-    OPENSSL_assert(((ptr - sh.arena) & ((sh.arena_size >> list) - 1)) == 0);
-    bit = (ONE << list) + ((ptr - sh.arena) / (sh.arena_size >> list));
-    OPENSSL_assert(bit > 0 && bit < sh.bittable_size);
+    OPENSSL_assert(list >= 0 && list < sh->freelist_size);
+    OPENSSL_assert(((ptr - sh->arena) & ((sh->arena_size >> list) - 1)) == 0);
+    bit = (ONE << list) + ((ptr - sh->arena) / (sh->arena_size >> list));
+    OPENSSL_assert(bit > 0 && bit < sh->bittable_size);
     OPENSSL_assert(TESTBIT(table, bit));
     CLEARBIT(table, bit);
 }
 
-static void sh_setbit(char *ptr, int list, unsigned char *table)
+static void sh_setbit(SH *sh, char *ptr, int list, unsigned char *table)
 {
     size_t bit;
 
-    OPENSSL_assert(list >= 0 && list < sh.freelist_size);
-    OPENSSL_assert(((ptr - sh.arena) & ((sh.arena_size >> list) - 1)) == 0);
-    bit = (ONE << list) + ((ptr - sh.arena) / (sh.arena_size >> list));
-    OPENSSL_assert(bit > 0 && bit < sh.bittable_size);
+    OPENSSL_assert(list >= 0 && list < sh->freelist_size);
+    OPENSSL_assert(((ptr - sh->arena) & ((sh->arena_size >> list) - 1)) == 0);
+    bit = (ONE << list) + ((ptr - sh->arena) / (sh->arena_size >> list));
+    OPENSSL_assert(bit > 0 && bit < sh->bittable_size);
     OPENSSL_assert(!TESTBIT(table, bit));
     SETBIT(table, bit);
 }
 
-static void sh_add_to_list(char **list, char *ptr)
+static void sh_add_to_list(SH *sh, char **list, char *ptr)
 {
     SH_LIST *temp;
 
@@ -411,7 +519,7 @@ static void sh_add_to_list(char **list, char *ptr)
     *list = ptr;
 }
 
-static void sh_remove_from_list(char *ptr)
+static void sh_remove_from_list(SH *sh, char *ptr)
 {
     SH_LIST *temp, *temp2;
 
@@ -427,8 +535,9 @@ static void sh_remove_from_list(char *ptr)
 }
 
 
-static int sh_init(size_t size, size_t minsize)
+static SH *sh_init(size_t size, size_t minsize, int *result)
 {
+    SH *sh;
     int ret;
     size_t i;
     size_t pgsize;
@@ -438,7 +547,8 @@ static int sh_init(size_t size, size_t minsize)
     SYSTEM_INFO systemInfo;
 #endif
 
-    memset(&sh, 0, sizeof(sh));
+    if ((sh = OPENSSL_zalloc(sizeof(*sh))) == NULL)
+        return NULL;
 
     /* make sure size is a powers of 2 */
     OPENSSL_assert(size > 0);
@@ -468,31 +578,31 @@ static int sh_init(size_t size, size_t minsize)
               goto err;
     }
 
-    sh.arena_size = size;
-    sh.minsize = minsize;
-    sh.bittable_size = (sh.arena_size / sh.minsize) * 2;
+    sh->arena_size = size;
+    sh->minsize = minsize;
+    sh->bittable_size = (sh->arena_size / sh->minsize) * 2;
 
     /* Prevent allocations of size 0 later on */
-    if (sh.bittable_size >> 3 == 0)
+    if (sh->bittable_size >> 3 == 0)
         goto err;
 
-    sh.freelist_size = -1;
-    for (i = sh.bittable_size; i; i >>= 1)
-        sh.freelist_size++;
+    sh->freelist_size = -1;
+    for (i = sh->bittable_size; i; i >>= 1)
+        sh->freelist_size++;
 
-    sh.freelist = OPENSSL_zalloc(sh.freelist_size * sizeof(char *));
-    OPENSSL_assert(sh.freelist != NULL);
-    if (sh.freelist == NULL)
+    sh->freelist = OPENSSL_zalloc(sh->freelist_size * sizeof(char *));
+    OPENSSL_assert(sh->freelist != NULL);
+    if (sh->freelist == NULL)
         goto err;
 
-    sh.bittable = OPENSSL_zalloc(sh.bittable_size >> 3);
-    OPENSSL_assert(sh.bittable != NULL);
-    if (sh.bittable == NULL)
+    sh->bittable = OPENSSL_zalloc(sh->bittable_size >> 3);
+    OPENSSL_assert(sh->bittable != NULL);
+    if (sh->bittable == NULL)
         goto err;
 
-    sh.bitmalloc = OPENSSL_zalloc(sh.bittable_size >> 3);
-    OPENSSL_assert(sh.bitmalloc != NULL);
-    if (sh.bitmalloc == NULL)
+    sh->bitmalloc = OPENSSL_zalloc(sh->bittable_size >> 3);
+    OPENSSL_assert(sh->bitmalloc != NULL);
+    if (sh->bitmalloc == NULL)
         goto err;
 
     /* Allocate space for heap, and two extra pages as guards */
@@ -514,177 +624,236 @@ static int sh_init(size_t size, size_t minsize)
 #else
     pgsize = PAGE_SIZE;
 #endif
-    sh.map_size = pgsize + sh.arena_size + pgsize;
+    sh->map_size = pgsize + sh->arena_size + pgsize;
 
 #if !defined(_WIN32)
 # ifdef MAP_ANON
-    sh.map_result = mmap(NULL, sh.map_size,
+    sh->map_result = mmap(NULL, sh->map_size,
                          PROT_READ|PROT_WRITE, MAP_ANON|MAP_PRIVATE|MAP_CONCEAL, -1, 0);
 # else
     {
         int fd;
 
-        sh.map_result = MAP_FAILED;
+        sh->map_result = MAP_FAILED;
         if ((fd = open("/dev/zero", O_RDWR)) >= 0) {
-            sh.map_result = mmap(NULL, sh.map_size,
+            sh->map_result = mmap(NULL, sh->map_size,
                                  PROT_READ|PROT_WRITE, MAP_PRIVATE, fd, 0);
             close(fd);
         }
     }
 # endif
-    if (sh.map_result == MAP_FAILED)
+    if (sh->map_result == MAP_FAILED)
         goto err;
 #else
-    sh.map_result = VirtualAlloc(NULL, sh.map_size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+    sh->map_result = VirtualAlloc(NULL, sh->map_size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
 
-    if (sh.map_result == NULL)
+    if (sh->map_result == NULL)
             goto err;
 #endif
 
-    sh.arena = (char *)(sh.map_result + pgsize);
-    sh_setbit(sh.arena, 0, sh.bittable);
-    sh_add_to_list(&sh.freelist[0], sh.arena);
+    sh->arena = (char *)(sh->map_result + pgsize);
+    sh_setbit(sh, sh->arena, 0, sh->bittable);
+    sh_add_to_list(sh, &sh->freelist[0], sh->arena);
 
     /* Now try to add guard pages and lock into memory. */
     ret = 1;
 
 #if !defined(_WIN32)
     /* Starting guard is already aligned from mmap. */
-    if (mprotect(sh.map_result, pgsize, PROT_NONE) < 0)
+    if (mprotect(sh->map_result, pgsize, PROT_NONE) < 0)
         ret = 2;
 #else
-    if (VirtualProtect(sh.map_result, pgsize, PAGE_NOACCESS, &flOldProtect) == FALSE)
+    if (VirtualProtect(sh->map_result, pgsize, PAGE_NOACCESS, &flOldProtect) == FALSE)
         ret = 2;
 #endif
 
     /* Ending guard page - need to round up to page boundary */
-    aligned = (pgsize + sh.arena_size + (pgsize - 1)) & ~(pgsize - 1);
+    aligned = (pgsize + sh->arena_size + (pgsize - 1)) & ~(pgsize - 1);
 #if !defined(_WIN32)
-    if (mprotect(sh.map_result + aligned, pgsize, PROT_NONE) < 0)
+    if (mprotect(sh->map_result + aligned, pgsize, PROT_NONE) < 0)
         ret = 2;
 #else
-    if (VirtualProtect(sh.map_result + aligned, pgsize, PAGE_NOACCESS, &flOldProtect) == FALSE)
+    if (VirtualProtect(sh->map_result + aligned, pgsize, PAGE_NOACCESS, &flOldProtect) == FALSE)
         ret = 2;
 #endif
 
 #if defined(OPENSSL_SYS_LINUX) && defined(MLOCK_ONFAULT) && defined(SYS_mlock2)
-    if (syscall(SYS_mlock2, sh.arena, sh.arena_size, MLOCK_ONFAULT) < 0) {
+    if (syscall(SYS_mlock2, sh->arena, sh->arena_size, MLOCK_ONFAULT) < 0) {
         if (errno == ENOSYS) {
-            if (mlock(sh.arena, sh.arena_size) < 0)
+            if (mlock(sh->arena, sh->arena_size) < 0)
                 ret = 2;
         } else {
             ret = 2;
         }
     }
 #elif defined(_WIN32)
-    if (VirtualLock(sh.arena, sh.arena_size) == FALSE)
+    if (VirtualLock(sh->arena, sh->arena_size) == FALSE)
         ret = 2;
 #else
-    if (mlock(sh.arena, sh.arena_size) < 0)
+    if (mlock(sh->arena, sh->arena_size) < 0)
         ret = 2;
 #endif
 #ifndef NO_MADVISE
-    if (madvise(sh.arena, sh.arena_size, MADV_DONTDUMP) < 0)
+    if (madvise(sh->arena, sh->arena_size, MADV_DONTDUMP) < 0)
         ret = 2;
 #endif
 
-    return ret;
+    *result = ret;
+    return sh;
 
  err:
-    sh_done();
-    return 0;
+    sh_done(sh);
+    return NULL;
 }
 
-static void sh_done(void)
+static void sh_done(SH *sh)
 {
-    OPENSSL_free(sh.freelist);
-    OPENSSL_free(sh.bittable);
-    OPENSSL_free(sh.bitmalloc);
+    OPENSSL_free(sh->freelist);
+    OPENSSL_free(sh->bittable);
+    OPENSSL_free(sh->bitmalloc);
 #if !defined(_WIN32)
-    if (sh.map_result != MAP_FAILED && sh.map_size)
-        munmap(sh.map_result, sh.map_size);
+    if (sh->map_result != MAP_FAILED && sh->map_size)
+        munmap(sh->map_result, sh->map_size);
 #else
-    if (sh.map_result != NULL && sh.map_size)
-        VirtualFree(sh.map_result, 0, MEM_RELEASE);
+    if (sh->map_result != NULL && sh->map_size)
+        VirtualFree(sh->map_result, 0, MEM_RELEASE);
 #endif
-    memset(&sh, 0, sizeof(sh));
+    OPENSSL_free(sh);
 }
 
-static int sh_allocated(const char *ptr)
+static int sh_allocated(SH *sh, const char *ptr)
 {
     return WITHIN_ARENA(ptr) ? 1 : 0;
 }
 
-static char *sh_find_my_buddy(char *ptr, int list)
+static char *sh_find_my_buddy(SH *sh, char *ptr, int list)
 {
     size_t bit;
     char *chunk = NULL;
 
-    bit = (ONE << list) + (ptr - sh.arena) / (sh.arena_size >> list);
+    bit = (ONE << list) + (ptr - sh->arena) / (sh->arena_size >> list);
     bit ^= 1;
 
-    if (TESTBIT(sh.bittable, bit) && !TESTBIT(sh.bitmalloc, bit))
-        chunk = sh.arena + ((bit & ((ONE << list) - 1)) * (sh.arena_size >> list));
+    if (TESTBIT(sh->bittable, bit) && !TESTBIT(sh->bitmalloc, bit))
+        chunk = sh->arena + ((bit & ((ONE << list) - 1)) * (sh->arena_size >> list));
 
     return chunk;
 }
 
-static void *sh_malloc(size_t size)
+/*
+ * A freed small block is likely to be wanted again soon, at the same size,
+ * so rather than merging it straight back into the heap, only for the next
+ * allocation to split it off again, it is parked on a cache for its size.
+ * Cached blocks stay marked as allocated and have already been cleansed,
+ * only their first word is used for the cache link.  The whole arena is
+ * never cached.
+ */
+static int sh_cache_put(SH *sh, char *ptr, size_t list)
+{
+    ossl_ssize_t c = sh->freelist_size - 1 - (ossl_ssize_t)list;
+
+    if (list == 0 || c >= SH_CACHE_CLASSES
+            || sh->cache_count[c] >= SH_CACHE_DEPTH)
+        return 0;
+    *(char **)ptr = sh->cache[c];
+    sh->cache[c] = ptr;
+    sh->cache_count[c]++;
+    return 1;
+}
+
+static char *sh_cache_get(SH *sh, ossl_ssize_t list)
+{
+    ossl_ssize_t c = sh->freelist_size - 1 - list;
+    char *ptr;
+
+    if (c >= SH_CACHE_CLASSES || (ptr = sh->cache[c]) == NULL)
+        return NULL;
+    sh->cache[c] = *(char **)ptr;
+    sh->cache_count[c]--;
+    *(char **)ptr = NULL;
+    return ptr;
+}
+
+/* Release every cached block to the heap, returns 0 if there were none */
+static int sh_cache_flush(SH *sh)
+{
+    ossl_ssize_t c;
+    char *ptr;
+    int ret = 0;
+
+    for (c = 0; c < SH_CACHE_CLASSES && c < sh->freelist_size; c++) {
+        while ((ptr = sh_cache_get(sh, sh->freelist_size - 1 - c)) != NULL) {
+            sh_release(sh, ptr, sh->freelist_size - 1 - c);
+            ret = 1;
+        }
+    }
+    return ret;
+}
+
+static void *sh_malloc(SH *sh, size_t size)
 {
     ossl_ssize_t list, slist;
     size_t i;
     char *chunk;
 
-    if (size > sh.arena_size)
+    if (size > sh->arena_size)
         return NULL;
 
-    list = sh.freelist_size - 1;
-    for (i = sh.minsize; i < size; i <<= 1)
+    list = sh->freelist_size - 1;
+    for (i = sh->minsize; i < size; i <<= 1)
         list--;
     if (list < 0)
         return NULL;
 
-    /* try to find a larger entry to split */
-    for (slist = list; slist >= 0; slist--)
-        if (sh.freelist[slist] != NULL)
+    if ((chunk = sh_cache_get(sh, list)) != NULL)
+        return chunk;
+
+    for (;;) {
+        /* try to find a larger entry to split */
+        for (slist = list; slist >= 0; slist--)
+            if (sh->freelist[slist] != NULL)
+                break;
+        if (slist >= 0)
             break;
-    if (slist < 0)
-        return NULL;
+        /* out of space, give back whatever is cached and look again */
+        if (!sh_cache_flush(sh))
+            return NULL;
+    }
 
     /* split larger entry */
     while (slist != list) {
-        char *temp = sh.freelist[slist];
+        char *temp = sh->freelist[slist];
 
         /* remove from bigger list */
-        OPENSSL_assert(!sh_testbit(temp, slist, sh.bitmalloc));
-        sh_clearbit(temp, slist, sh.bittable);
-        sh_remove_from_list(temp);
-        OPENSSL_assert(temp != sh.freelist[slist]);
+        OPENSSL_assert(!sh_testbit(sh, temp, slist, sh->bitmalloc));
+        sh_clearbit(sh, temp, slist, sh->bittable);
+        sh_remove_from_list(sh, temp);
+        OPENSSL_assert(temp != sh->freelist[slist]);
 
         /* done with bigger list */
         slist++;
 
         /* add to smaller list */
-        OPENSSL_assert(!sh_testbit(temp, slist, sh.bitmalloc));
-        sh_setbit(temp, slist, sh.bittable);
-        sh_add_to_list(&sh.freelist[slist], temp);
-        OPENSSL_assert(sh.freelist[slist] == temp);
+        OPENSSL_assert(!sh_testbit(sh, temp, slist, sh->bitmalloc));
+        sh_setbit(sh, temp, slist, sh->bittable);
+        sh_add_to_list(sh, &sh->freelist[slist], temp);
+        OPENSSL_assert(sh->freelist[slist] == temp);
 
         /* split in 2 */
-        temp += sh.arena_size >> slist;
-        OPENSSL_assert(!sh_testbit(temp, slist, sh.bitmalloc));
-        sh_setbit(temp, slist, sh.bittable);
-        sh_add_to_list(&sh.freelist[slist], temp);
-        OPENSSL_assert(sh.freelist[slist] == temp);
+        temp += sh->arena_size >> slist;
+        OPENSSL_assert(!sh_testbit(sh, temp, slist, sh->bitmalloc));
+        sh_setbit(sh, temp, slist, sh->bittable);
+        sh_add_to_list(sh, &sh->freelist[slist], temp);
+        OPENSSL_assert(sh->freelist[slist] == temp);
 
-        OPENSSL_assert(temp-(sh.arena_size >> slist) == sh_find_my_buddy(temp, slist));
+        OPENSSL_assert(temp-(sh->arena_size >> slist) == sh_find_my_buddy(sh, temp, slist));
     }
 
     /* peel off memory to hand back */
-    chunk = sh.freelist[list];
-    OPENSSL_assert(sh_testbit(chunk, list, sh.bittable));
-    sh_setbit(chunk, list, sh.bitmalloc);
-    sh_remove_from_list(chunk);
+    chunk = sh->freelist[list];
+    OPENSSL_assert(sh_testbit(sh, chunk, list, sh->bittable));
+    sh_setbit(sh, chunk, list, sh->bitmalloc);
+    sh_remove_from_list(sh, chunk);
 
     OPENSSL_assert(WITHIN_ARENA(chunk));
 
@@ -694,10 +863,9 @@ static void *sh_malloc(size_t size)
     return chunk;
 }
 
-static void sh_free(void *ptr)
+static void sh_free(SH *sh, void *ptr)
 {
     size_t list;
-    void *buddy;
 
     if (ptr == NULL)
         return;
@@ -705,21 +873,30 @@ static void sh_free(void *ptr)
     if (!WITHIN_ARENA(ptr))
         return;
 
-    list = sh_getlist(ptr);
-    OPENSSL_assert(sh_testbit(ptr, list, sh.bittable));
-    sh_clearbit(ptr, list, sh.bitmalloc);
-    sh_add_to_list(&sh.freelist[list], ptr);
+    list = sh_getlist(sh, ptr);
+    OPENSSL_assert(sh_testbit(sh, ptr, list, sh->bittable));
+    if (!sh_cache_put(sh, ptr, list))
+        sh_release(sh, ptr, list);
+}
+
+/* Return an allocated block of the given list to the heap */
+static void sh_release(SH *sh, void *ptr, size_t list)
+{
+    void *buddy;
+
+    sh_clearbit(sh, ptr, list, sh->bitmalloc);
+    sh_add_to_list(sh, &sh->freelist[list], ptr);
 
     /* Try to coalesce two adjacent free areas. */
-    while ((buddy = sh_find_my_buddy(ptr, list)) != NULL) {
-        OPENSSL_assert(ptr == sh_find_my_buddy(buddy, list));
+    while ((buddy = sh_find_my_buddy(sh, ptr, list)) != NULL) {
+        OPENSSL_assert(ptr == sh_find_my_buddy(sh, buddy, list));
         OPENSSL_assert(ptr != NULL);
-        OPENSSL_assert(!sh_testbit(ptr, list, sh.bitmalloc));
-        sh_clearbit(ptr, list, sh.bittable);
-        sh_remove_from_list(ptr);
-        OPENSSL_assert(!sh_testbit(ptr, list, sh.bitmalloc));
-        sh_clearbit(buddy, list, sh.bittable);
-        sh_remove_from_list(buddy);
+        OPENSSL_assert(!sh_testbit(sh, ptr, list, sh->bitmalloc));
+        sh_clearbit(sh, ptr, list, sh->bittable);
+        sh_remove_from_list(sh, ptr);
+        OPENSSL_assert(!sh_testbit(sh, ptr, list, sh->bitmalloc));
+        sh_clearbit(sh, buddy, list, sh->bittable);
+        sh_remove_from_list(sh, buddy);
 
         list--;
 
@@ -728,22 +905,22 @@ static void sh_free(void *ptr)
         if (ptr > buddy)
             ptr = buddy;
 
-        OPENSSL_assert(!sh_testbit(ptr, list, sh.bitmalloc));
-        sh_setbit(ptr, list, sh.bittable);
-        sh_add_to_list(&sh.freelist[list], ptr);
-        OPENSSL_assert(sh.freelist[list] == ptr);
+        OPENSSL_assert(!sh_testbit(sh, ptr, list, sh->bitmalloc));
+        sh_setbit(sh, ptr, list, sh->bittable);
+        sh_add_to_list(sh, &sh->freelist[list], ptr);
+        OPENSSL_assert(sh->freelist[list] == ptr);
     }
 }
 
-static size_t sh_actual_size(char *ptr)
+static size_t sh_actual_size(SH *sh, char *ptr)
 {
     int list;
 
     OPENSSL_assert(WITHIN_ARENA(ptr));
     if (!WITHIN_ARENA(ptr))
         return 0;
-    list = sh_getlist(ptr);
-    OPENSSL_assert(sh_testbit(ptr, list, sh.bittable));
-    return sh.arena_size / (ONE << list);
+    list = sh_getlist(sh, ptr);
+    OPENSSL_assert(sh_testbit(sh, ptr, list, sh->bittable));
+    return sh->arena_size / (ONE << list);
 }
 #endif /* OPENSSL_NO_SECURE_MEMORY */
@@ -80,7 +80,7 @@
  * activatecnt value.
  *
  * The provider optbits_lock: Used to control access to the provider's
- * operation_bits and operation_bits_sz fields.
+ * operation_bits, operation_bits_sz, name_bits and name_bits_sz fields.
  *
  * The store default_path_lock: Used to control access to the provider store's
  * default search path value (default_path)
@@ -184,6 +184,12 @@ struct ossl_provider_st {
      */
     unsigned char *operation_bits;
     size_t operation_bits_sz;
+    /*
+     * The same for single names within an operation, for methods that are
+     * constructed on demand.  See ossl_provider_set_name_bit().
+     */
+    unsigned char *name_bits;
+    size_t name_bits_sz;
     CRYPTO_RWLOCK *opbits_lock;
 
 #ifndef FIPS_MODULE
@@ -731,6 +737,9 @@ void ossl_provider_free(OSSL_PROVIDER *prov)
                 OPENSSL_free(prov->operation_bits);
                 prov->operation_bits = NULL;
                 prov->operation_bits_sz = 0;
+                OPENSSL_free(prov->name_bits);
+                prov->name_bits = NULL;
+                prov->name_bits_sz = 0;
                 prov->flag_initialized = 0;
             }
 
@@ -1278,6 +1287,9 @@ static int provider_remove_store_methods(OSSL_PROVIDER *prov)
         OPENSSL_free(prov->operation_bits);
         prov->operation_bits = NULL;
         prov->operation_bits_sz = 0;
+        OPENSSL_free(prov->name_bits);
+        prov->name_bits = NULL;
+        prov->name_bits_sz = 0;
         CRYPTO_THREAD_unlock(prov->opbits_lock);
 
         acc = evp_method_store_remove_all_provided(prov)
@@ -1681,33 +1693,32 @@ void ossl_provider_unquery_operation(const OSSL_PROVIDER *prov,
         prov->unquery_operation(prov->provctx, operation_id, algs);
 }
 
-int ossl_provider_set_operation_bit(OSSL_PROVIDER *provider, size_t bitnum)
+static int set_bit(OSSL_PROVIDER *provider, unsigned char **bits,
+                   size_t *bits_sz, size_t bitnum)
 {
     size_t byte = bitnum / 8;
     unsigned char bit = (1 << (bitnum % 8)) & 0xFF;
 
     if (!CRYPTO_THREAD_write_lock(provider->opbits_lock))
         return 0;
-    if (provider->operation_bits_sz <= byte) {
-        unsigned char *tmp = OPENSSL_realloc(provider->operation_bits,
-                                             byte + 1);
+    if (*bits_sz <= byte) {
+        unsigned char *tmp = OPENSSL_realloc(*bits, byte + 1);
 
         if (tmp == NULL) {
             CRYPTO_THREAD_unlock(provider->opbits_lock);
             return 0;
         }
-        provider->operation_bits = tmp;
-        memset(provider->operation_bits + provider->operation_bits_sz,
-               '\0', byte + 1 - provider->operation_bits_sz);
-        provider->operation_bits_sz = byte + 1;
+        *bits = tmp;
+        memset(*bits + *bits_sz, '\0', byte + 1 - *bits_sz);
+        *bits_sz = byte + 1;
     }
-    provider->operation_bits[byte] |= bit;
+    (*bits)[byte] |= bit;
     CRYPTO_THREAD_unlock(provider->opbits_lock);
     return 1;
 }
 
-int ossl_provider_test_operation_bit(OSSL_PROVIDER *provider, size_t bitnum,
-                                     int *result)
+static int test_bit(OSSL_PROVIDER *provider, unsigned char *const *bits,
+                    const size_t *bits_sz, size_t bitnum, int *result)
 {
     size_t byte = bitnum / 8;
     unsigned char bit = (1 << (bitnum % 8)) & 0xFF;
@@ -1720,12 +1731,49 @@ int ossl_provider_test_operation_bit(OSSL_PROVIDER *provider, size_t bitnum,
     *result = 0;
     if (!CRYPTO_THREAD_read_lock(provider->opbits_lock))
         return 0;
-    if (provider->operation_bits_sz > byte)
-        *result = ((provider->operation_bits[byte] & bit) != 0);
+    if (*bits_sz > byte)
+        *result = (((*bits)[byte] & bit) != 0);
     CRYPTO_THREAD_unlock(provider->opbits_lock);
     return 1;
 }
 
+int ossl_provider_set_operation_bit(OSSL_PROVIDER *provider, size_t bitnum)
+{
+    return set_bit(provider, &provider->operation_bits,
+                   &provider->operation_bits_sz, bitnum);
+}
+
+int ossl_provider_test_operation_bit(OSSL_PROVIDER *provider, size_t bitnum,
+                                     int *result)
+{
+    return test_bit(provider, &provider->operation_bits,
+                    &provider->operation_bits_sz, bitnum, result);
+}
+
+/* There is one name bit for each combination of name identity and operation */
+#define NAME_BITNUM(operation_id, name_id) \
+    ((size_t)(name_id) * (OSSL_OP__HIGHEST + 1) + (size_t)(operation_id))
+
+int ossl_provider_set_name_bit(OSSL_PROVIDER *provider, int operation_id,
+                               int name_id)
+{
+    if (!ossl_assert(operation_id > 0 && operation_id <= OSSL_OP__HIGHEST
+                     && name_id > 0))
+        return 0;
+    return set_bit(provider, &provider->name_bits, &provider->name_bits_sz,
+                   NAME_BITNUM(operation_id, name_id));
+}
+
+int ossl_provider_test_name_bit(OSSL_PROVIDER *provider, int operation_id,
+                                int name_id, int *result)
+{
+    if (!ossl_assert(operation_id > 0 && operation_id <= OSSL_OP__HIGHEST
+                     && name_id > 0))
+        return 0;
+    return test_bit(provider, &provider->name_bits, &provider->name_bits_sz,
+                    NAME_BITNUM(operation_id, name_id), result);
+}
+
 #ifndef FIPS_MODULE
 const OSSL_CORE_HANDLE *ossl_provider_get_parent(OSSL_PROVIDER *prov)
 {
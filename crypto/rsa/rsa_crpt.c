@@ -59,10 +59,19 @@ int RSA_flags(const RSA *r)
     return r == NULL ? 0 : r->meth->flags;
 }
 
+void ossl_rsa_free_blindings(RSA *rsa)
+{
+    size_t i;
+
+    for (i = 0; i < OSSL_NELEM(rsa->blindings); i++) {
+        BN_BLINDING_free(rsa->blindings[i].b);
+        rsa->blindings[i].b = NULL;
+    }
+}
+
 void RSA_blinding_off(RSA *rsa)
 {
-    BN_BLINDING_free(rsa->blinding);
-    rsa->blinding = NULL;
+    ossl_rsa_free_blindings(rsa);
     rsa->flags &= ~RSA_FLAG_BLINDING;
     rsa->flags |= RSA_FLAG_NO_BLINDING;
 }
@@ -71,11 +80,10 @@ int RSA_blinding_on(RSA *rsa, BN_CTX *ctx)
 {
     int ret = 0;
 
-    if (rsa->blinding != NULL)
-        RSA_blinding_off(rsa);
+    ossl_rsa_free_blindings(rsa);
 
-    rsa->blinding = RSA_setup_blinding(rsa, ctx);
-    if (rsa->blinding == NULL)
+    rsa->blindings[0].b = RSA_setup_blinding(rsa, ctx);
+    if (rsa->blindings[0].b == NULL)
         goto err;
 
     rsa->flags |= RSA_FLAG_BLINDING;
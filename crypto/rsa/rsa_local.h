@@ -15,6 +15,17 @@
 
 #define RSA_MAX_PRIME_NUM       5
 
+/*
+ * The number of blindings kept per key for concurrent private key operations.
+ * An operation that finds them all in use sets up a blinding just for itself.
+ */
+#define RSA_BLINDING_SLOTS      8
+
+typedef struct rsa_blinding_slot_st {
+    int in_use;                 /* only changed atomically */
+    BN_BLINDING *b;             /* only accessed by the slot's user */
+} RSA_BLINDING_SLOT;
+
 typedef struct rsa_prime_info_st {
     BIGNUM *r;
     BIGNUM *d;
@@ -93,8 +104,11 @@ struct rsa_st {
     BN_MONT_CTX *_method_mod_n;
     BN_MONT_CTX *_method_mod_p;
     BN_MONT_CTX *_method_mod_q;
-    BN_BLINDING *blinding;
-    BN_BLINDING *mt_blinding;
+    /*
+     * An operation takes a slot for its duration, so converting and
+     * inverting with the slot's blinding needs no lock.
+     */
+    RSA_BLINDING_SLOT blindings[RSA_BLINDING_SLOTS];
     CRYPTO_RWLOCK *lock;
 
     int dirty_cnt;
@@ -164,6 +178,7 @@ void ossl_rsa_multip_info_free_ex(RSA_PRIME_INFO *pinfo);
 void ossl_rsa_multip_info_free(RSA_PRIME_INFO *pinfo);
 RSA_PRIME_INFO *ossl_rsa_multip_info_new(void);
 int ossl_rsa_multip_calc_product(RSA *rsa);
+void ossl_rsa_free_blindings(RSA *rsa);
 int ossl_rsa_multip_cap(int bits);
 
 int ossl_rsa_sp800_56b_validate_strength(int nbits, int strength);
@@ -207,97 +207,61 @@ static int rsa_ossl_public_encrypt(int flen, const unsigned char *from,
     return r;
 }
 
-static BN_BLINDING *rsa_get_blinding(RSA *rsa, int *local, BN_CTX *ctx)
+static void rsa_put_blinding(RSA *rsa, BN_BLINDING *b, RSA_BLINDING_SLOT *slot)
 {
-    BN_BLINDING *ret;
+    int n;
 
-    if (!CRYPTO_THREAD_read_lock(rsa->lock))
-        return NULL;
+    if (slot == NULL)
+        BN_BLINDING_free(b);
+    else
+        CRYPTO_atomic_add(&slot->in_use, -1, &n, rsa->lock);
+}
 
-    if (rsa->blinding == NULL) {
-        /*
-         * This dance with upgrading the lock from read to write will be
-         * slower in cases of a single use RSA object, but should be
-         * significantly better in multi-thread cases (e.g. servers). It's
-         * probably worth it.
-         */
-        CRYPTO_THREAD_unlock(rsa->lock);
-        if (!CRYPTO_THREAD_write_lock(rsa->lock))
+/*
+ * Returns a blinding that only the caller uses until it hands it back with
+ * rsa_put_blinding(). It is the blinding of a free slot of |rsa|, set up by
+ * the first operation to take the slot and then updated by squaring. Slots
+ * are taken with atomic operations, so concurrent private key operations
+ * with one key take no lock. If every slot is in use, *|slot| is set to NULL
+ * and the caller gets a new blinding for just this operation.
+ */
+static BN_BLINDING *rsa_get_blinding(RSA *rsa, BN_CTX *ctx,
+                                     RSA_BLINDING_SLOT **slot)
+{
+    RSA_BLINDING_SLOT *s;
+    size_t i;
+    int n;
+
+    for (i = 0; i < OSSL_NELEM(rsa->blindings); i++) {
+        s = &rsa->blindings[i];
+        if (!CRYPTO_atomic_load_int(&s->in_use, &n, rsa->lock) || n != 0
+                || !CRYPTO_atomic_add(&s->in_use, 1, &n, rsa->lock))
+            continue;
+        if (n != 1) {
+            /* Another operation took it first */
+            CRYPTO_atomic_add(&s->in_use, -1, &n, rsa->lock);
+            continue;
+        }
+        if (s->b == NULL && (s->b = RSA_setup_blinding(rsa, ctx)) == NULL) {
+            rsa_put_blinding(rsa, NULL, s);
             return NULL;
-        if (rsa->blinding == NULL)
-            rsa->blinding = RSA_setup_blinding(rsa, ctx);
-    }
-
-    ret = rsa->blinding;
-    if (ret == NULL)
-        goto err;
-
-    if (BN_BLINDING_is_current_thread(ret)) {
-        /* rsa->blinding is ours! */
-
-        *local = 1;
-    } else {
-        /* resort to rsa->mt_blinding instead */
-
-        /*
-         * instructs rsa_blinding_convert(), rsa_blinding_invert() that the
-         * BN_BLINDING is shared, meaning that accesses require locks, and
-         * that the blinding factor must be stored outside the BN_BLINDING
-         */
-        *local = 0;
-
-        if (rsa->mt_blinding == NULL) {
-            CRYPTO_THREAD_unlock(rsa->lock);
-            if (!CRYPTO_THREAD_write_lock(rsa->lock))
-                return NULL;
-            if (rsa->mt_blinding == NULL)
-                rsa->mt_blinding = RSA_setup_blinding(rsa, ctx);
         }
-        ret = rsa->mt_blinding;
+        *slot = s;
+        return s->b;
     }
 
- err:
-    CRYPTO_THREAD_unlock(rsa->lock);
-    return ret;
+    *slot = NULL;
+    return RSA_setup_blinding(rsa, ctx);
 }
 
-static int rsa_blinding_convert(BN_BLINDING *b, BIGNUM *f, BIGNUM *unblind,
-                                BN_CTX *ctx)
-{
-    if (unblind == NULL) {
-        /*
-         * Local blinding: store the unblinding factor in BN_BLINDING.
-         */
-        return BN_BLINDING_convert_ex(f, NULL, b, ctx);
-    } else {
-        /*
-         * Shared blinding: store the unblinding factor outside BN_BLINDING.
-         */
-        int ret;
-
-        if (!BN_BLINDING_lock(b))
-            return 0;
-
-        ret = BN_BLINDING_convert_ex(f, unblind, b, ctx);
-        BN_BLINDING_unlock(b);
-
-        return ret;
-    }
-}
-
-static int rsa_blinding_invert(BN_BLINDING *b, BIGNUM *f, BIGNUM *unblind,
-                               BN_CTX *ctx)
+static int rsa_blinding_invert(BN_BLINDING *b, BIGNUM *f, BN_CTX *ctx)
 {
     /*
-     * For local blinding, unblind is set to NULL, and BN_BLINDING_invert_ex
-     * will use the unblinding factor stored in BN_BLINDING. If BN_BLINDING
-     * is shared between threads, unblind must be non-null:
-     * BN_BLINDING_invert_ex will then use the local unblinding factor, and
-     * will only read the modulus from BN_BLINDING. In both cases it's safe
-     * to access the blinding without a lock.
+     * Nothing else uses the blinding during this operation, so
+     * BN_BLINDING_invert_ex can use the unblinding factor stored in it.
      */
     BN_set_flags(f, BN_FLG_CONSTTIME);
-    return BN_BLINDING_invert_ex(f, unblind, b, ctx);
+    return BN_BLINDING_invert_ex(f, NULL, b, ctx);
 }
 
 /* signing */
@@ -308,14 +272,8 @@ static int rsa_ossl_private_encrypt(int flen, const unsigned char *from,
     int i, num = 0, r = -1;
     unsigned char *buf = NULL;
     BN_CTX *ctx = NULL;
-    int local_blinding = 0;
-    /*
-     * Used only if the blinding structure is shared. A non-NULL unblind
-     * instructs rsa_blinding_convert() and rsa_blinding_invert() to store
-     * the unblinding factor outside the blinding structure.
-     */
-    BIGNUM *unblind = NULL;
     BN_BLINDING *blinding = NULL;
+    RSA_BLINDING_SLOT *blinding_slot = NULL;
 
     if ((ctx = BN_CTX_new_ex(rsa->libctx)) == NULL)
         goto err;
@@ -359,21 +317,15 @@ static int rsa_ossl_private_encrypt(int flen, const unsigned char *from,
             goto err;
 
     if (!(rsa->flags & RSA_FLAG_NO_BLINDING)) {
-        blinding = rsa_get_blinding(rsa, &local_blinding, ctx);
+        blinding = rsa_get_blinding(rsa, ctx, &blinding_slot);
         if (blinding == NULL) {
             ERR_raise(ERR_LIB_RSA, ERR_R_INTERNAL_ERROR);
             goto err;
         }
     }
 
-    if (blinding != NULL) {
-        if (!local_blinding && ((unblind = BN_CTX_get(ctx)) == NULL)) {
-            ERR_raise(ERR_LIB_RSA, ERR_R_BN_LIB);
-            goto err;
-        }
-        if (!rsa_blinding_convert(blinding, f, unblind, ctx))
-            goto err;
-    }
+    if (blinding != NULL && !BN_BLINDING_convert_ex(f, NULL, blinding, ctx))
+        goto err;
 
     if ((rsa->flags & RSA_FLAG_EXT_PKEY) ||
         (rsa->version == RSA_ASN1_VERSION_MULTI) ||
@@ -405,7 +357,7 @@ static int rsa_ossl_private_encrypt(int flen, const unsigned char *from,
     }
 
     if (blinding)
-        if (!rsa_blinding_invert(blinding, ret, unblind, ctx))
+        if (!rsa_blinding_invert(blinding, ret, ctx))
             goto err;
 
     if (padding == RSA_X931_PADDING) {
@@ -425,6 +377,8 @@ static int rsa_ossl_private_encrypt(int flen, const unsigned char *from,
      */
     r = BN_bn2binpad(res, to, num);
  err:
+    if (blinding != NULL)
+        rsa_put_blinding(rsa, blinding, blinding_slot);
     BN_CTX_end(ctx);
     BN_CTX_free(ctx);
     OPENSSL_clear_free(buf, num);
@@ -524,14 +478,8 @@ static int rsa_ossl_private_decrypt(int flen, const unsigned char *from,
     unsigned char *buf = NULL;
     unsigned char kdk[SHA256_DIGEST_LENGTH] = {0};
     BN_CTX *ctx = NULL;
-    int local_blinding = 0;
-    /*
-     * Used only if the blinding structure is shared. A non-NULL unblind
-     * instructs rsa_blinding_convert() and rsa_blinding_invert() to store
-     * the unblinding factor outside the blinding structure.
-     */
-    BIGNUM *unblind = NULL;
     BN_BLINDING *blinding = NULL;
+    RSA_BLINDING_SLOT *blinding_slot = NULL;
 
     /*
      * we need the value of the private exponent to perform implicit rejection
@@ -606,21 +554,15 @@ static int rsa_ossl_private_decrypt(int flen, const unsigned char *from,
             goto err;
 
     if (!(rsa->flags & RSA_FLAG_NO_BLINDING)) {
-        blinding = rsa_get_blinding(rsa, &local_blinding, ctx);
+        blinding = rsa_get_blinding(rsa, ctx, &blinding_slot);
         if (blinding == NULL) {
             ERR_raise(ERR_LIB_RSA, ERR_R_INTERNAL_ERROR);
             goto err;
         }
     }
 
-    if (blinding != NULL) {
-        if (!local_blinding && ((unblind = BN_CTX_get(ctx)) == NULL)) {
-            ERR_raise(ERR_LIB_RSA, ERR_R_BN_LIB);
-            goto err;
-        }
-        if (!rsa_blinding_convert(blinding, f, unblind, ctx))
-            goto err;
-    }
+    if (blinding != NULL && !BN_BLINDING_convert_ex(f, NULL, blinding, ctx))
+        goto err;
 
     /* do the decrypt */
     if ((rsa->flags & RSA_FLAG_EXT_PKEY) ||
@@ -652,7 +594,7 @@ static int rsa_ossl_private_decrypt(int flen, const unsigned char *from,
     }
 
     if (blinding)
-        if (!rsa_blinding_invert(blinding, ret, unblind, ctx))
+        if (!rsa_blinding_invert(blinding, ret, ctx))
             goto err;
 
     /*
@@ -696,6 +638,8 @@ static int rsa_ossl_private_decrypt(int flen, const unsigned char *from,
 #endif
 
  err:
+    if (blinding != NULL)
+        rsa_put_blinding(rsa, blinding, blinding_slot);
     BN_CTX_end(ctx);
     BN_CTX_free(ctx);
     OPENSSL_clear_free(buf, num);
@@ -802,6 +746,61 @@ static int rsa_ossl_public_decrypt(int flen, const unsigned char *from,
     return r;
 }
 
+#ifndef FIPS_MODULE
+/*
+ * Computes the per-prime exponentiations of a multi-prime private key
+ * operation: m1 = I^dmq1 mod q, r0 = I^dmp1 mod p and m[i] = I^d_i mod r_i.
+ * They are independent of each other, so run them as one batch in which
+ * those of equal size share the dual exponentiation kernel.
+ */
+static int rsa_multip_mod_exp_batch(BIGNUM *r0, BIGNUM *m1, BIGNUM *m[],
+                                    const BIGNUM *I, RSA *rsa, int ex_primes,
+                                    BN_CTX *ctx)
+{
+    BIGNUM *res[RSA_MAX_PRIME_NUM], *c, *t;
+    const BIGNUM *base[RSA_MAX_PRIME_NUM], *exp[RSA_MAX_PRIME_NUM];
+    const BIGNUM *mod[RSA_MAX_PRIME_NUM];
+    BN_MONT_CTX *mont[RSA_MAX_PRIME_NUM];
+    RSA_PRIME_INFO *pinfo;
+    int i, ret = 0;
+
+    res[0] = m1;
+    exp[0] = rsa->dmq1;
+    mod[0] = rsa->q;
+    mont[0] = rsa->_method_mod_q;
+    res[1] = r0;
+    exp[1] = rsa->dmp1;
+    mod[1] = rsa->p;
+    mont[1] = rsa->_method_mod_p;
+    for (i = 0; i < ex_primes; i++) {
+        pinfo = sk_RSA_PRIME_INFO_value(rsa->prime_infos, i);
+        res[i + 2] = m[i];
+        exp[i + 2] = pinfo->d;
+        mod[i + 2] = pinfo->r;
+        mont[i + 2] = pinfo->m;
+    }
+
+    if ((c = BN_new()) == NULL)
+        return 0;
+    BN_with_flags(c, I, BN_FLG_CONSTTIME);
+
+    BN_CTX_start(ctx);
+    for (i = 0; i < ex_primes + 2; i++) {
+        if ((t = BN_CTX_get(ctx)) == NULL || !BN_mod(t, c, mod[i], ctx))
+            goto err;
+        base[i] = t;
+    }
+
+    ret = ossl_bn_mod_exp_mont_consttime_batch(res, base, exp, mod, mont,
+                                               ex_primes + 2, ctx);
+ err:
+    BN_CTX_end(ctx);
+    /* We MUST free c before any further use of I */
+    BN_free(c);
+    return ret;
+}
+#endif
+
 static int rsa_ossl_mod_exp(BIGNUM *r0, const BIGNUM *I, RSA *rsa, BN_CTX *ctx)
 {
     BIGNUM *r1, *m1, *vrfy;
@@ -922,6 +921,17 @@ static int rsa_ossl_mod_exp(BIGNUM *r0, const BIGNUM *I, RSA *rsa, BN_CTX *ctx)
         goto tail;
     }
 
+#ifndef FIPS_MODULE
+    if (ex_primes > 0 && rsa->meth->bn_mod_exp == BN_mod_exp_mont) {
+        for (i = 0; i < ex_primes; i++)
+            if ((m[i] = BN_CTX_get(ctx)) == NULL)
+                goto err;
+        if (!rsa_multip_mod_exp_batch(r0, m1, m, I, rsa, ex_primes, ctx))
+            goto err;
+        goto combine;
+    }
+#endif
+
     /* compute I mod q */
     {
         BIGNUM *c = BN_new();
@@ -1018,8 +1028,9 @@ static int rsa_ossl_mod_exp(BIGNUM *r0, const BIGNUM *I, RSA *rsa, BN_CTX *ctx)
         BN_free(cc);
         BN_free(di);
     }
-#endif
 
+ combine:
+#endif
     if (!BN_sub(r0, r0, m1))
         goto err;
     /*
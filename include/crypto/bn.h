@@ -61,6 +61,11 @@ void bn_set_static_words(BIGNUM *a, const BN_ULONG *words, int size);
  */
 int bn_set_words(BIGNUM *a, const BN_ULONG *words, int num_words);
 
+int ossl_bn_mod_exp_mont_consttime_batch(BIGNUM *rr[], const BIGNUM *a[],
+                                          const BIGNUM *p[], const BIGNUM *m[],
+                                          BN_MONT_CTX *mont[], size_t num,
+                                          BN_CTX *ctx);
+
 /*
  * Some BIGNUM functions assume most significant limb to be non-zero, which
  * is customarily arranged by bn_correct_top. Output from below functions
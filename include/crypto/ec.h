@@ -97,6 +97,7 @@ char *ossl_ec_check_group_type_id2name(int flags);
 int ossl_ec_set_check_group_type_from_name(EC_KEY *ec, const char *name);
 int ossl_ec_generate_key_dhkem(EC_KEY *eckey,
                                const unsigned char *ikm, size_t ikmlen);
+int ossl_ec_key_generate_batch(EC_KEY *keys[], size_t num);
 int ossl_ecdsa_deterministic_sign(const unsigned char *dgst, int dlen,
                                   unsigned char *sig, unsigned int *siglen,
                                   EC_KEY *eckey, unsigned int nonce_type,
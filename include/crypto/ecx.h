@@ -90,6 +90,9 @@ int ossl_x25519(uint8_t out_shared_key[32], const uint8_t private_key[32],
                 const uint8_t peer_public_value[32]);
 void ossl_x25519_public_from_private(uint8_t out_public_value[32],
                                      const uint8_t private_key[32]);
+int ossl_x25519_public_from_private_batch(uint8_t *out_public_values[],
+                                          const uint8_t *private_keys[],
+                                          size_t num);
 
 int
 ossl_ed25519_public_from_private(OSSL_LIB_CTX *ctx, uint8_t out_public_key[32],
@@ -286,6 +286,7 @@ struct evp_md_st {
     OSSL_FUNC_digest_digest_fn *digest;
     OSSL_FUNC_digest_freectx_fn *freectx;
     OSSL_FUNC_digest_dupctx_fn *dupctx;
+    OSSL_FUNC_digest_copyctx_fn *copyctx;
     OSSL_FUNC_digest_get_params_fn *get_params;
     OSSL_FUNC_digest_set_ctx_params_fn *set_ctx_params;
     OSSL_FUNC_digest_get_ctx_params_fn *get_ctx_params;
@@ -712,6 +713,17 @@ struct evp_pkey_st {
      */
     STACK_OF(OP_CACHE_ELEM) *operation_cache;
 
+    /*
+     * The first OP_CACHE_FAST entries of the operation cache are also
+     * published here, so that a key that is only ever used with a handful of
+     * providers can be looked up without taking |lock|.  Entries are only
+     * ever appended under the write lock, |op_cache_fast_num| is updated
+     * atomically after the entry is in place.
+     */
+# define OP_CACHE_FAST 4
+    OP_CACHE_ELEM *op_cache_fast[OP_CACHE_FAST];
+    uint64_t op_cache_fast_num;
+
     /*
      * We keep a copy of that "origin"'s dirty count, so we know if the
      * operation cache needs flushing.
@@ -786,6 +798,8 @@ void *evp_keymgmt_util_export_to_provider(EVP_PKEY *pk, EVP_KEYMGMT *keymgmt,
 OP_CACHE_ELEM *evp_keymgmt_util_find_operation_cache(EVP_PKEY *pk,
                                                      EVP_KEYMGMT *keymgmt,
                                                      int selection);
+void *evp_keymgmt_util_lookup_keydata(EVP_PKEY *pk, EVP_KEYMGMT *keymgmt,
+                                      int selection);
 int evp_keymgmt_util_clear_operation_cache(EVP_PKEY *pk);
 int evp_keymgmt_util_cache_keydata(EVP_PKEY *pk, EVP_KEYMGMT *keymgmt,
                                    void *keydata, int selection);
@@ -822,6 +836,9 @@ int evp_keymgmt_gen_get_params(const EVP_KEYMGMT *keymgmt,
                                void *genctx, OSSL_PARAM params[]);
 void *evp_keymgmt_gen(const EVP_KEYMGMT *keymgmt, void *genctx,
                       OSSL_CALLBACK *cb, void *cbarg);
+int evp_keymgmt_gen_batch(const EVP_KEYMGMT *keymgmt, void *genctx,
+                          void *keys[], size_t num,
+                          OSSL_CALLBACK *cb, void *cbarg);
 void evp_keymgmt_gen_cleanup(const EVP_KEYMGMT *keymgmt, void *genctx);
 
 int evp_keymgmt_has_load(const EVP_KEYMGMT *keymgmt);
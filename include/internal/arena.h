@@ -0,0 +1,47 @@
+/*
+ * Copyright 2025 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+#ifndef OSSL_INTERNAL_ARENA_H
+# define OSSL_INTERNAL_ARENA_H
+# pragma once
+
+# include <stddef.h>
+
+/*
+ * A region allocator for data that has a clearly bounded lifetime, such as
+ * everything parsed during a single handshake.  Allocation bumps a pointer
+ * within a chunk, there is no per allocation free, and everything is released
+ * at once with ossl_arena_reset() or ossl_arena_free().
+ *
+ * Chunks come from an OSSL_ARENA_POOL, which keeps released chunks around for
+ * the next arena to use, so that a busy server does not go back to the
+ * system allocator for every handshake.  A pool may be shared between
+ * threads, an arena may not.
+ */
+typedef struct ossl_arena_pool_st OSSL_ARENA_POOL;
+typedef struct ossl_arena_st OSSL_ARENA;
+
+/* Cleanse memory before it is reused or released, for secret data */
+# define OSSL_ARENA_FLAG_CLEAR   0x1
+
+OSSL_ARENA_POOL *ossl_arena_pool_new(size_t max_chunks);
+void ossl_arena_pool_free(OSSL_ARENA_POOL *pool);
+
+OSSL_ARENA *ossl_arena_new(OSSL_ARENA_POOL *pool, unsigned int flags);
+void ossl_arena_free(OSSL_ARENA *arena);
+void ossl_arena_reset(OSSL_ARENA *arena);
+
+void *ossl_arena_alloc(OSSL_ARENA *arena, size_t num);
+void *ossl_arena_zalloc(OSSL_ARENA *arena, size_t num);
+int ossl_arena_owns(const OSSL_ARENA *arena, const void *ptr);
+
+/* The highest number of bytes the arena has handed out at once */
+size_t ossl_arena_get_peak(const OSSL_ARENA *arena);
+
+#endif
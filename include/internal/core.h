@@ -1,5 +1,5 @@
 /*
- * Copyright 2019-2022 The OpenSSL Project Authors. All Rights Reserved.
+ * Copyright 2019-2025 The OpenSSL Project Authors. All Rights Reserved.
  *
  * Licensed under the Apache License 2.0 (the "License").  You may not use
  * this file except in compliance with the License.  You can obtain a copy
@@ -46,8 +46,13 @@ typedef struct ossl_method_construct_method_st {
     void (*destruct)(void *method, void *data);
 } OSSL_METHOD_CONSTRUCT_METHOD;
 
+/*
+ * When |name| is given, only the methods that go by that name are
+ * constructed, otherwise all methods for |operation_id| are.
+ */
 void *ossl_method_construct(OSSL_LIB_CTX *ctx, int operation_id,
-                            OSSL_PROVIDER **provider_rw, int force_cache,
+                            const char *name, OSSL_PROVIDER **provider_rw,
+                            int force_cache,
                             OSSL_METHOD_CONSTRUCT_METHOD *mcm, void *mcm_data);
 
 void ossl_algorithm_do_all(OSSL_LIB_CTX *libctx, int operation_id,
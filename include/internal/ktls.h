@@ -427,6 +427,52 @@ static ossl_inline int ktls_read_record(int fd, void *data, size_t length)
     return ret;
 }
 
+#    ifdef _GNU_SOURCE
+#     include <fcntl.h>
+#     include <unistd.h>
+#     define OPENSSL_KTLS_RECVFILE
+
+/*
+ * KTLS enables the splice system call to move decrypted application data from
+ * the socket into a file without it passing through userspace. The data is
+ * moved via a pipe in two steps, so that a failure to write to the file is not
+ * mistaken for a failure to read from the socket, and does not lose data.
+ *
+ * ktls_splice_read() moves at most one record from the socket @s into the pipe
+ * @p. Only application data can be spliced: if the next record is a control
+ * record then this fails with EINVAL, and that record must be read with
+ * ktls_read_record() instead.
+ *
+ * ktls_splice_write() moves up to @size bytes from the pipe @p into @fd. If
+ * @off is NULL then the data is written at the current position of @fd, which
+ * may itself be a pipe, otherwise it is written at *@off, which is advanced.
+ * Any error is an error of @fd.
+ *
+ * @flags are passed through to splice.
+ */
+static ossl_inline ossl_ssize_t ktls_splice_read(int s, int p, size_t size,
+                                                 int flags)
+{
+    return splice(s, NULL, p, NULL, size, flags);
+}
+
+static ossl_inline ossl_ssize_t ktls_splice_write(int p, int fd, off_t *off,
+                                                  size_t size, int flags)
+{
+    loff_t pos;
+    ossl_ssize_t ret;
+
+    if (off == NULL)
+        return splice(p, NULL, fd, NULL, size, flags);
+
+    pos = *off;
+    ret = splice(p, NULL, fd, &pos, size, flags);
+    if (ret > 0)
+        *off = pos;
+    return ret;
+}
+#    endif /* _GNU_SOURCE */
+
 #   endif /* OPENSSL_NO_KTLS_RX */
 
 #  endif /* OPENSSL_SYS_LINUX */
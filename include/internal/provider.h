@@ -102,6 +102,14 @@ void ossl_provider_unquery_operation(const OSSL_PROVIDER *prov,
 int ossl_provider_set_operation_bit(OSSL_PROVIDER *provider, size_t bitnum);
 int ossl_provider_test_operation_bit(OSSL_PROVIDER *provider, size_t bitnum,
                                      int *result);
+/*
+ * The same, for the methods with one particular name identity in an
+ * operation, when methods are constructed on demand rather than all at once.
+ */
+int ossl_provider_set_name_bit(OSSL_PROVIDER *provider, int operation_id,
+                               int name_id);
+int ossl_provider_test_name_bit(OSSL_PROVIDER *provider, int operation_id,
+                                int name_id, int *result);
 
 /* Configuration */
 void ossl_provider_add_conf_module(void);
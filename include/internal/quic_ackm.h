@@ -282,6 +282,14 @@ int ossl_ackm_get_largest_unacked(OSSL_ACKM *ackm, int pkt_space, QUIC_PN *pn);
 int ossl_ackm_mark_packet_pseudo_lost(OSSL_ACKM *ackm,
                                       int pkt_space, QUIC_PN pn);
 
+/*
+ * As for ossl_ackm_mark_packet_pseudo_lost, but for every packet in the given
+ * PN space which has not yet been acknowledged or declared lost. This is used
+ * when a server rejects 0-RTT data, so that its contents are resent in 1-RTT
+ * packets.
+ */
+int ossl_ackm_mark_pkt_space_pseudo_lost(OSSL_ACKM *ackm, int pkt_space);
+
 /*
  * Returns the PTO duration as currently calculated. This is a quantity of time.
  * This duration is used in various parts of QUIC besides the ACKM.
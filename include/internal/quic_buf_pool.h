@@ -0,0 +1,106 @@
+/*
+ * Copyright 2024 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+#ifndef OSSL_QUIC_BUF_POOL_H
+# define OSSL_QUIC_BUF_POOL_H
+
+# include <openssl/ssl.h>
+# include "internal/quic_predef.h"
+
+# ifndef OPENSSL_NO_QUIC
+
+/*
+ * QUIC Datagram Buffer Pool
+ * =========================
+ *
+ * A pool of fixed-size, cache-line aligned buffers used to hold datagrams. It
+ * is shared by all DEMUX (URXE) and QTX (TXE) instances in a QUIC event domain
+ * so that buffers released by one connection can be reused by another without
+ * going back to the allocator.
+ *
+ * Requests no larger than the pool's buffer size are satisfied from the pool.
+ * Larger requests are satisfied directly from the heap, but must still be
+ * released to the pool they were allocated from.
+ *
+ * Buffers which are released are cached for reuse. The number of cached
+ * buffers is trimmed by ossl_quic_buf_pool_trim() so that it does not exceed
+ * what was needed to cover the peak demand seen since the previous trim.
+ *
+ * The pool is not thread safe; the caller must provide any necessary locking.
+ * A NULL pool may be passed to the allocation functions, in which case they
+ * behave like their OPENSSL_* equivalents.
+ */
+
+/* Default pool buffer size, which accommodates a URXE or TXE at common MTUs. */
+#  define QUIC_BUF_POOL_DEFAULT_BUF_LEN     2048
+
+typedef struct quic_buf_pool_stats_st {
+    /* Number of allocations made from the pool. */
+    uint64_t    num_alloc;
+    /* Number of allocations satisfied by a cached buffer. */
+    uint64_t    num_alloc_cached;
+    /* Number of allocations too large for the pool, served from the heap. */
+    uint64_t    num_alloc_oversize;
+    /* Number of cached buffers freed by trimming. */
+    uint64_t    num_trimmed;
+    /* Number of pool buffers currently handed out. */
+    size_t      num_in_use;
+    /* Number of pool buffers currently cached for reuse. */
+    size_t      num_cached;
+    /* The largest value num_in_use has ever reached. */
+    size_t      high_water;
+} QUIC_BUF_POOL_STATS;
+
+/*
+ * Creates a new pool of buffers which are each at least buf_len bytes in size.
+ */
+QUIC_BUF_POOL *ossl_quic_buf_pool_new(size_t buf_len);
+
+/*
+ * Frees the pool and all cached buffers. All buffers allocated from the pool
+ * must have been released first.
+ */
+void ossl_quic_buf_pool_free(QUIC_BUF_POOL *pool);
+
+/* Returns the size of the buffers managed by the pool. */
+size_t ossl_quic_buf_pool_get_buf_len(const QUIC_BUF_POOL *pool);
+
+/*
+ * Allocates a buffer of at least len bytes. The returned buffer is aligned to
+ * at least a cache line unless pool is NULL. Returns NULL on failure.
+ */
+void *ossl_quic_buf_pool_alloc(QUIC_BUF_POOL *pool, size_t len);
+
+/*
+ * Resizes a buffer previously returned by ossl_quic_buf_pool_alloc() to at
+ * least new_len bytes, preserving its contents up to the lesser of the old and
+ * new lengths. The buffer may move. On failure, NULL is returned and the
+ * original buffer remains valid. old_len must be the length originally
+ * requested for the buffer.
+ */
+void *ossl_quic_buf_pool_realloc(QUIC_BUF_POOL *pool, void *buf,
+                                 size_t old_len, size_t new_len);
+
+/* Releases a buffer back to the pool it was allocated from. No-op if NULL. */
+void ossl_quic_buf_pool_release(QUIC_BUF_POOL *pool, void *buf);
+
+/*
+ * Frees cached buffers in excess of those which were needed to satisfy the
+ * peak demand since the last call to this function. Intended to be called
+ * periodically.
+ */
+void ossl_quic_buf_pool_trim(QUIC_BUF_POOL *pool);
+
+/* Retrieves pool usage statistics. */
+void ossl_quic_buf_pool_get_stats(const QUIC_BUF_POOL *pool,
+                                  QUIC_BUF_POOL_STATS *stats);
+
+# endif
+
+#endif
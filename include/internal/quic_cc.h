@@ -89,7 +89,9 @@ struct ossl_cc_method_st {
     void (*free)(OSSL_CC_DATA *ccdata);
 
     /*
-     * Reset of state.
+     * Reset of state, for example when the path to the peer changes. The count
+     * of bytes in flight is not reset, as packets which are already in flight
+     * will still be passed to on_data_acked or on_data_lost later.
      */
     void (*reset)(OSSL_CC_DATA *ccdata);
 
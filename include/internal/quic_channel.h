@@ -269,13 +269,31 @@ void ossl_quic_channel_on_remote_conn_close(QUIC_CHANNEL *ch,
                                             OSSL_QUIC_FRAME_CONN_CLOSE *f);
 void ossl_quic_channel_on_new_conn_id(QUIC_CHANNEL *ch,
                                       OSSL_QUIC_FRAME_NEW_CONN_ID *f);
+void ossl_quic_channel_on_retire_conn_id(QUIC_CHANNEL *ch, uint64_t seq_num);
+void ossl_quic_channel_on_path_response(QUIC_CHANNEL *ch, uint64_t data);
+int ossl_quic_channel_on_path_challenge(QUIC_CHANNEL *ch, uint64_t data);
+
+/*
+ * Client only: Called when the local address used to communicate with the
+ * peer is known to have changed, for example because the application has
+ * supplied a new network BIO after the handshake. Switches to an unused
+ * remote CID so that the new path cannot be linked to the old one, resets
+ * congestion control and RTT estimation and validates the new path (RFC 9000
+ * s. 9.2). If the peer has not given us a spare CID, the current one continues
+ * to be used. Returns 1 on success and 0 if the connection is not in a state
+ * where it can migrate (for example, the handshake is not yet confirmed).
+ */
+int ossl_quic_channel_migrate(QUIC_CHANNEL *ch);
+
+/* Returns 1 if we are waiting for a PATH_RESPONSE from the peer. */
+int ossl_quic_channel_is_validating_path(const QUIC_CHANNEL *ch);
 
 /* Temporarily exposed during QUIC_PORT transition. */
 int ossl_quic_channel_on_new_conn(QUIC_CHANNEL *ch, const BIO_ADDR *peer,
                                   const QUIC_CONN_ID *peer_scid,
                                   const QUIC_CONN_ID *peer_dcid);
 
-/* For use by QUIC_PORT. You should not need to call this directly. */
+/* For use by QUIC_ENGINE. You should not need to call this directly. */
 void ossl_quic_channel_subtick(QUIC_CHANNEL *ch, QUIC_TICK_RESULT *r,
                                uint32_t flags);
 
@@ -287,6 +305,14 @@ void ossl_quic_channel_on_stateless_reset(QUIC_CHANNEL *ch);
 
 void ossl_quic_channel_inject(QUIC_CHANNEL *ch, QUIC_URXE *e);
 
+/*
+ * Ensures the channel is ticked on the next engine tick even if none of its
+ * timers have expired and no datagrams have arrived for it. This must be called
+ * after the channel's state has been changed from outside the tick (e.g. by an
+ * application API call) so that any resulting work is performed.
+ */
+void ossl_quic_channel_schedule_tick(QUIC_CHANNEL *ch);
+
 /*
  * Queries and Accessors
  * =====================
@@ -325,6 +351,18 @@ int ossl_quic_channel_is_active(const QUIC_CHANNEL *ch);
 int ossl_quic_channel_is_handshake_complete(const QUIC_CHANNEL *ch);
 int ossl_quic_channel_is_handshake_confirmed(const QUIC_CHANNEL *ch);
 
+/*
+ * Enables the sending of 0-RTT data if the session being resumed allows it.
+ * Must be called before the channel is started.
+ */
+void ossl_quic_channel_set_early_data_enabled(QUIC_CHANNEL *ch, int enabled);
+
+/*
+ * Returns 1 if the handshake is still in progress and stream data written now
+ * can be sent in 0-RTT packets.
+ */
+int ossl_quic_channel_can_send_early_data(QUIC_CHANNEL *ch);
+
 QUIC_PORT *ossl_quic_channel_get0_port(QUIC_CHANNEL *ch);
 QUIC_ENGINE *ossl_quic_channel_get0_engine(QUIC_CHANNEL *ch);
 QUIC_DEMUX *ossl_quic_channel_get0_demux(QUIC_CHANNEL *ch);
@@ -206,6 +206,13 @@ QUIC_DEMUX *ossl_quic_demux_new(BIO *net_bio,
  */
 void ossl_quic_demux_free(QUIC_DEMUX *demux);
 
+/*
+ * Sets a buffer pool from which URXEs are allocated and to which surplus URXEs
+ * are returned. Must be called before the demuxer is first used. If no pool is
+ * set, URXEs are allocated from the heap.
+ */
+void ossl_quic_demux_set_buf_pool(QUIC_DEMUX *demux, QUIC_BUF_POOL *pool);
+
 /*
  * Changes the BIO which the demuxer reads from. This also sets the MTU if the
  * BIO supports querying the MTU.
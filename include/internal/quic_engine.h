@@ -79,6 +79,12 @@ void ossl_quic_engine_set_inhibit_tick(QUIC_ENGINE *qeng, int inhibit);
 /* Gets the reactor which can be used to tick/poll on the port. */
 QUIC_REACTOR *ossl_quic_engine_get0_reactor(QUIC_ENGINE *qeng);
 
+/*
+ * Gets the datagram buffer pool shared by all ports and channels of the
+ * engine. Its statistics may be used to size the pool.
+ */
+QUIC_BUF_POOL *ossl_quic_engine_get0_buf_pool(QUIC_ENGINE *qeng);
+
 # endif
 
 #endif
@@ -54,6 +54,14 @@ QUIC_TXFC *ossl_quic_txfc_get_parent(QUIC_TXFC *txfc);
  */
 int ossl_quic_txfc_bump_cwm(QUIC_TXFC *txfc, uint64_t cwm);
 
+/*
+ * Forget all credit granted and consumed so far, returning the TXFC to its
+ * initial state. This is used when the peer has discarded everything sent
+ * under it, which is the case when 0-RTT data is rejected. Data sent before
+ * the reset consumes credit again as it is retransmitted.
+ */
+void ossl_quic_txfc_reset(QUIC_TXFC *txfc);
+
 /*
  * Get the number of bytes by which we are in credit. This is the number of
  * controlled bytes we are allowed to send. (Thus if this function returns 0, we
@@ -37,6 +37,7 @@ typedef struct quic_srtm_st QUIC_SRTM;
 typedef struct quic_lcidm_st QUIC_LCIDM;
 typedef struct quic_urxe_st QUIC_URXE;
 typedef struct quic_engine_st QUIC_ENGINE;
+typedef struct quic_buf_pool_st QUIC_BUF_POOL;
 
 # endif
 
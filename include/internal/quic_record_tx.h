@@ -52,6 +52,13 @@ typedef struct ossl_qtx_args_st {
     /* Callback returning QLOG instance to use, or NULL. */
     QLOG           *(*get_qlog_cb)(void *arg);
     void           *get_qlog_cb_arg;
+
+    /*
+     * Optional pool to allocate TXEs from. If set, TXEs are returned to the
+     * pool once their datagram has been transmitted rather than being kept
+     * for reuse by this QTX.
+     */
+    QUIC_BUF_POOL  *buf_pool;
 } OSSL_QTX_ARGS;
 
 /* Instantiates a new QTX. */
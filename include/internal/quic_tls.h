@@ -95,6 +95,21 @@ int ossl_quic_tls_set_transport_params(QUIC_TLS *qtls,
                                        const unsigned char *transport_params,
                                        size_t transport_params_len);
 
+/*
+ * Enables or disables sending of 0-RTT data by a client. Must be called before
+ * the first call to ossl_quic_tls_tick(). Early data is only actually offered
+ * if the session being resumed permits it.
+ */
+void ossl_quic_tls_set_early_data_enabled(QUIC_TLS *qtls, int enabled);
+
+/*
+ * Retrieves the peer transport parameters remembered in the session set on the
+ * TLS object, if any. Returns 1 if they are available and 0 otherwise.
+ */
+int ossl_quic_tls_get0_remembered_transport_params(QUIC_TLS *qtls,
+                                                   const unsigned char **params,
+                                                   size_t *params_len);
+
 int ossl_quic_tls_get_error(QUIC_TLS *qtls,
                             uint64_t *error_code,
                             const char **error_msg,
@@ -211,6 +211,14 @@ int ossl_quic_tserver_new_ticket(QUIC_TSERVER *srv);
 int ossl_quic_tserver_set_max_early_data(QUIC_TSERVER *srv,
                                          uint32_t max_early_data);
 
+/*
+ * Set the callback used to decide whether to accept 0-RTT data offered by a
+ * client, e.g. as an application-level replay check.
+ */
+void ossl_quic_tserver_set_allow_early_data_cb(QUIC_TSERVER *srv,
+                                               SSL_allow_early_data_cb_fn cb,
+                                               void *arg);
+
 /* Set the find session callback for getting a server PSK */
 void ossl_quic_tserver_set_psk_find_session_cb(QUIC_TSERVER *srv,
                                                SSL_psk_find_session_cb_func cb);
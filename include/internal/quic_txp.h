@@ -78,6 +78,31 @@ void ossl_quic_tx_packetiser_free(OSSL_QUIC_TX_PACKETISER *txp);
 void ossl_quic_tx_packetiser_record_received_closing_bytes(
         OSSL_QUIC_TX_PACKETISER *txp, size_t n);
 
+/*
+ * Until the peer's address has been validated, we must not send more than
+ * three times the number of bytes received from it (RFC 9000 s. 8, 9.3).
+ * ossl_quic_tx_packetiser_set_amplification_limited() turns this limit on or
+ * off, and turning it on resets both counts. While the limit is on, the
+ * number of bytes received from the peer's address must be reported with
+ * ossl_quic_tx_packetiser_record_received_path_bytes().
+ */
+void ossl_quic_tx_packetiser_set_amplification_limited(
+        OSSL_QUIC_TX_PACKETISER *txp, int limited);
+void ossl_quic_tx_packetiser_record_received_path_bytes(
+        OSSL_QUIC_TX_PACKETISER *txp, size_t n);
+
+/*
+ * Sends a 1-RTT packet containing only a PATH_RESPONSE frame for |data| to
+ * |peer| straight away, padded to |min_dgram_len| bytes. RFC 9000 s. 8.2.2
+ * requires the response to a PATH_CHALLENGE to be sent on the path the
+ * challenge arrived on, which may not be the path used for everything else.
+ * Returns 1 on success.
+ */
+int ossl_quic_tx_packetiser_send_path_response(OSSL_QUIC_TX_PACKETISER *txp,
+                                               const BIO_ADDR *peer,
+                                               uint64_t data,
+                                               size_t min_dgram_len);
+
 /*
  * Generates a datagram by polling the various ELs to determine if they want to
  * generate any frames, and generating a datagram which coalesces packets for
@@ -126,6 +126,14 @@ OSSL_DECODER_CTX_new_for_pkey(EVP_PKEY **pkey,
                               const char *input_struct,
                               const char *keytype, int selection,
                               OSSL_LIB_CTX *libctx, const char *propquery);
+size_t OSSL_DECODER_pkeys_from_data(EVP_PKEY **pkeys, size_t num,
+                                    const unsigned char **data,
+                                    const size_t *data_len,
+                                    const char *input_type,
+                                    const char *input_struct,
+                                    const char *keytype, int selection,
+                                    OSSL_LIB_CTX *libctx,
+                                    const char *propquery);
 
 # ifdef __cplusplus
 }
@@ -148,6 +148,9 @@ int ossl_gcm_get_ctx_params(void *vctx, OSSL_PARAM params[])
     size_t sz;
     int type;
 
+    if (params == NULL)
+        return 1;
+
     for (p = params; p->key != NULL; p++) {
         type = ossl_param_find_pidx(p->key);
         switch (type) {
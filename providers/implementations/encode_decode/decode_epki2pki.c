@@ -7,6 +7,7 @@
  * https://www.openssl.org/source/license.html
  */
 
+#include <string.h>
 #include <openssl/core.h>
 #include <openssl/core_dispatch.h>
 #include <openssl/core_names.h>
@@ -19,6 +20,7 @@
 #include <openssl/proverr.h>
 #include "internal/asn1.h"
 #include "internal/sizes.h"
+#include "crypto/ec.h"
 #include "prov/bio.h"
 #include "prov/implementations.h"
 #include "endecoder_local.h"
@@ -26,11 +28,13 @@
 static OSSL_FUNC_decoder_newctx_fn epki2pki_newctx;
 static OSSL_FUNC_decoder_freectx_fn epki2pki_freectx;
 static OSSL_FUNC_decoder_decode_fn epki2pki_decode;
+static OSSL_FUNC_decoder_decode_fn pki2typepki_decode;
 static OSSL_FUNC_decoder_settable_ctx_params_fn epki2pki_settable_ctx_params;
 static OSSL_FUNC_decoder_set_ctx_params_fn epki2pki_set_ctx_params;
 
 /*
- * Context used for EncryptedPrivateKeyInfo to PrivateKeyInfo decoding.
+ * Context used for EncryptedPrivateKeyInfo to PrivateKeyInfo decoding, and
+ * for PrivateKeyInfo to type specific PrivateKeyInfo decoding.
  */
 struct epki2pki_ctx_st {
     PROV_CTX *provctx;
@@ -75,6 +79,56 @@ static int epki2pki_set_ctx_params(void *vctx, const OSSL_PARAM params[])
     return 1;
 }
 
+/*
+ * If |der| is a PrivateKeyInfo, pass it on with the key type taken from its
+ * algorithm identifier, so that only the decoders for that key type need to
+ * be tried next.  Anything else is left alone, which is not an error.
+ */
+static int pki2typepki(const unsigned char *der, long der_len,
+                       OSSL_CALLBACK *data_cb, void *data_cbarg)
+{
+    const unsigned char *pder = der;
+    PKCS8_PRIV_KEY_INFO *p8inf = NULL;
+    const X509_ALGOR *alg = NULL;
+    int ok = 1;
+
+    ERR_set_mark();
+    p8inf = d2i_PKCS8_PRIV_KEY_INFO(NULL, &pder, der_len);
+    ERR_pop_to_mark();
+
+    if (p8inf != NULL && PKCS8_pkey_get0(NULL, NULL, NULL, &alg, p8inf)) {
+        /*
+         * We have something and recognised it as PrivateKeyInfo, so let's
+         * pass all the applicable data to the callback.
+         */
+        char keytype[OSSL_MAX_NAME_SIZE];
+        OSSL_PARAM params[5], *p = params;
+        int objtype = OSSL_OBJECT_PKEY;
+
+#ifndef OPENSSL_NO_EC
+        /* SM2 abuses the EC oid, so this could actually be SM2 */
+        if (OBJ_obj2nid(alg->algorithm) == NID_X9_62_id_ecPublicKey
+                && ossl_x509_algor_is_sm2(alg))
+            strcpy(keytype, "SM2");
+        else
+#endif
+            OBJ_obj2txt(keytype, sizeof(keytype), alg->algorithm, 0);
+
+        *p++ = OSSL_PARAM_construct_utf8_string(OSSL_OBJECT_PARAM_DATA_TYPE,
+                                                keytype, 0);
+        *p++ = OSSL_PARAM_construct_utf8_string(OSSL_OBJECT_PARAM_DATA_STRUCTURE,
+                                                "PrivateKeyInfo", 0);
+        *p++ = OSSL_PARAM_construct_octet_string(OSSL_OBJECT_PARAM_DATA,
+                                                 (unsigned char *)der, der_len);
+        *p++ = OSSL_PARAM_construct_int(OSSL_OBJECT_PARAM_TYPE, &objtype);
+        *p = OSSL_PARAM_construct_end();
+
+        ok = data_cb(params, data_cbarg);
+    }
+    PKCS8_PRIV_KEY_INFO_free(p8inf);
+    return ok;
+}
+
 /*
  * The selection parameter in epki2pki_decode() is not used by this function
  * because it's not relevant just to decode EncryptedPrivateKeyInfo to
@@ -90,7 +144,6 @@ static int epki2pki_decode(void *vctx, OSSL_CORE_BIO *cin, int selection,
     const unsigned char *pder = NULL;
     long der_len = 0;
     X509_SIG *p8 = NULL;
-    PKCS8_PRIV_KEY_INFO *p8inf = NULL;
     const X509_ALGOR *alg = NULL;
     BIO *in = ossl_bio_new_from_core_bio(ctx->provctx, cin);
     int ok = 0;
@@ -144,34 +197,26 @@ static int epki2pki_decode(void *vctx, OSSL_CORE_BIO *cin, int selection,
         ERR_pop_to_mark();
     }
 
-    ERR_set_mark();
-    pder = der;
-    p8inf = d2i_PKCS8_PRIV_KEY_INFO(NULL, &pder, der_len);
-    ERR_pop_to_mark();
-
-    if (p8inf != NULL && PKCS8_pkey_get0(NULL, NULL, NULL, &alg, p8inf)) {
-        /*
-         * We have something and recognised it as PrivateKeyInfo, so let's
-         * pass all the applicable data to the callback.
-         */
-        char keytype[OSSL_MAX_NAME_SIZE];
-        OSSL_PARAM params[5], *p = params;
-        int objtype = OSSL_OBJECT_PKEY;
+    if (ok)
+        ok = pki2typepki(der, der_len, data_cb, data_cbarg);
+    OPENSSL_free(der);
+    return ok;
+}
 
-        OBJ_obj2txt(keytype, sizeof(keytype), alg->algorithm, 0);
+static int pki2typepki_decode(void *vctx, OSSL_CORE_BIO *cin, int selection,
+                              OSSL_CALLBACK *data_cb, void *data_cbarg,
+                              OSSL_PASSPHRASE_CALLBACK *pw_cb, void *pw_cbarg)
+{
+    struct epki2pki_ctx_st *ctx = vctx;
+    unsigned char *der = NULL;
+    long der_len = 0;
+    int ok;
 
-        *p++ = OSSL_PARAM_construct_utf8_string(OSSL_OBJECT_PARAM_DATA_TYPE,
-                                                keytype, 0);
-        *p++ = OSSL_PARAM_construct_utf8_string(OSSL_OBJECT_PARAM_DATA_STRUCTURE,
-                                                "PrivateKeyInfo", 0);
-        *p++ = OSSL_PARAM_construct_octet_string(OSSL_OBJECT_PARAM_DATA,
-                                                 der, der_len);
-        *p++ = OSSL_PARAM_construct_int(OSSL_OBJECT_PARAM_TYPE, &objtype);
-        *p = OSSL_PARAM_construct_end();
+    /* We return "empty handed".  This is not an error. */
+    if (!ossl_read_der(ctx->provctx, cin, &der, &der_len))
+        return 1;
 
-        ok = data_cb(params, data_cbarg);
-    }
-    PKCS8_PRIV_KEY_INFO_free(p8inf);
+    ok = pki2typepki(der, der_len, data_cb, data_cbarg);
     OPENSSL_free(der);
     return ok;
 }
@@ -186,3 +231,14 @@ const OSSL_DISPATCH ossl_EncryptedPrivateKeyInfo_der_to_der_decoder_functions[]
       (void (*)(void))epki2pki_set_ctx_params },
     OSSL_DISPATCH_END
 };
+
+const OSSL_DISPATCH ossl_PrivateKeyInfo_der_to_der_decoder_functions[] = {
+    { OSSL_FUNC_DECODER_NEWCTX, (void (*)(void))epki2pki_newctx },
+    { OSSL_FUNC_DECODER_FREECTX, (void (*)(void))epki2pki_freectx },
+    { OSSL_FUNC_DECODER_DECODE, (void (*)(void))pki2typepki_decode },
+    { OSSL_FUNC_DECODER_SETTABLE_CTX_PARAMS,
+      (void (*)(void))epki2pki_settable_ctx_params },
+    { OSSL_FUNC_DECODER_SET_CTX_PARAMS,
+      (void (*)(void))epki2pki_set_ctx_params },
+    OSSL_DISPATCH_END
+};
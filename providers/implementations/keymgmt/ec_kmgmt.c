@@ -42,6 +42,9 @@ static OSSL_FUNC_keymgmt_gen_settable_params_fn ec_gen_settable_params;
 static OSSL_FUNC_keymgmt_gen_get_params_fn ec_gen_get_params;
 static OSSL_FUNC_keymgmt_gen_gettable_params_fn ec_gen_gettable_params;
 static OSSL_FUNC_keymgmt_gen_fn ec_gen;
+#ifndef FIPS_MODULE
+static OSSL_FUNC_keymgmt_gen_batch_fn ec_gen_batch;
+#endif
 static OSSL_FUNC_keymgmt_gen_cleanup_fn ec_gen_cleanup;
 static OSSL_FUNC_keymgmt_load_fn ec_load;
 static OSSL_FUNC_keymgmt_free_fn ec_freedata;
@@ -1344,6 +1347,46 @@ err:
     return NULL;
 }
 
+#ifndef FIPS_MODULE
+/*
+ * ec_gen() sets up every key with its group and flags, but leaves the key
+ * pairs to ossl_ec_key_generate_batch(), which generates them all at once.
+ * DHKEM derivation has nothing to share between keys, so that stays in
+ * ec_gen().
+ */
+static int ec_gen_batch(void *genctx, void *keys[], size_t num,
+                        OSSL_CALLBACK *osslcb, void *cbarg)
+{
+    struct ec_gen_ctx *gctx = genctx;
+    int selection, keypair, ret = 1;
+    size_t i;
+
+    if (!ossl_prov_is_running() || gctx == NULL)
+        return 0;
+    for (i = 0; i < num; i++)
+        keys[i] = NULL;
+
+    selection = gctx->selection;
+    keypair = (selection & OSSL_KEYMGMT_SELECT_KEYPAIR) != 0
+        && (gctx->dhkem_ikm == NULL || gctx->dhkem_ikmlen == 0);
+    if (keypair)
+        gctx->selection &= ~OSSL_KEYMGMT_SELECT_KEYPAIR;
+    for (i = 0; ret && i < num; i++)
+        ret = (keys[i] = ec_gen(gctx, osslcb, cbarg)) != NULL;
+    gctx->selection = selection;
+
+    if (ret && keypair)
+        ret = ossl_ec_key_generate_batch((EC_KEY **)keys, num);
+    if (!ret) {
+        for (i = 0; i < num; i++) {
+            EC_KEY_free(keys[i]);
+            keys[i] = NULL;
+        }
+    }
+    return ret;
+}
+#endif
+
 #ifndef FIPS_MODULE
 # ifndef OPENSSL_NO_SM2
 /*
@@ -1471,6 +1514,9 @@ const OSSL_DISPATCH ossl_ec_keymgmt_functions[] = {
     { OSSL_FUNC_KEYMGMT_GEN_GETTABLE_PARAMS,
       (void (*)(void))ec_gen_gettable_params },
     { OSSL_FUNC_KEYMGMT_GEN, (void (*)(void))ec_gen },
+#ifndef FIPS_MODULE
+    { OSSL_FUNC_KEYMGMT_GEN_BATCH, (void (*)(void))ec_gen_batch },
+#endif
     { OSSL_FUNC_KEYMGMT_GEN_CLEANUP, (void (*)(void))ec_gen_cleanup },
     { OSSL_FUNC_KEYMGMT_LOAD, (void (*)(void))ec_load },
     { OSSL_FUNC_KEYMGMT_FREE, (void (*)(void))ec_freedata },
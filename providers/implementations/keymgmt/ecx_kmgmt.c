@@ -42,6 +42,7 @@ static OSSL_FUNC_keymgmt_gen_fn x25519_gen;
 static OSSL_FUNC_keymgmt_gen_fn x448_gen;
 static OSSL_FUNC_keymgmt_gen_fn ed25519_gen;
 static OSSL_FUNC_keymgmt_gen_fn ed448_gen;
+static OSSL_FUNC_keymgmt_gen_batch_fn ecx_gen_batch;
 static OSSL_FUNC_keymgmt_gen_cleanup_fn ecx_gen_cleanup;
 static OSSL_FUNC_keymgmt_gen_set_params_fn ecx_gen_set_params;
 static OSSL_FUNC_keymgmt_gen_settable_params_fn ecx_gen_settable_params;
@@ -839,6 +840,97 @@ static void *ed448_gen(void *genctx, OSSL_CALLBACK *osslcb, void *cbarg)
     return key;
 }
 
+/*
+ * Of the ECX key types only X25519 has anything to share between key pairs:
+ * each public key ends with a field inversion, which
+ * ossl_x25519_public_from_private_batch() does once for the whole batch.
+ * Everything else is generated one key at a time.
+ */
+static int ecx_gen_batch(void *genctx, void *keys[], size_t num,
+                         OSSL_CALLBACK *osslcb, void *cbarg)
+{
+    struct ecx_gen_ctx *gctx = genctx;
+    OSSL_FUNC_keymgmt_gen_fn *gen;
+    uint8_t **pubkeys = NULL;
+    const uint8_t **privkeys = NULL;
+    int ret = 1;
+    size_t i;
+
+    if (!ossl_prov_is_running() || gctx == NULL)
+        return 0;
+    for (i = 0; i < num; i++)
+        keys[i] = NULL;
+
+    switch (gctx->type) {
+    case ECX_KEY_TYPE_X25519:
+        gen = x25519_gen;
+        break;
+    case ECX_KEY_TYPE_X448:
+        gen = x448_gen;
+        break;
+    case ECX_KEY_TYPE_ED25519:
+        gen = ed25519_gen;
+        break;
+    default:
+        gen = ed448_gen;
+        break;
+    }
+
+    if (gctx->type != ECX_KEY_TYPE_X25519
+        || (gctx->selection & OSSL_KEYMGMT_SELECT_KEYPAIR) == 0
+        || (gctx->dhkem_ikm != NULL && gctx->dhkem_ikmlen != 0)
+#ifdef S390X_EC_ASM
+        || (OPENSSL_s390xcap_P.pcc[1]
+            & S390X_CAPBIT(S390X_SCALAR_MULTIPLY_X25519)) != 0
+#endif
+        ) {
+        for (i = 0; ret && i < num; i++)
+            ret = (keys[i] = gen(genctx, osslcb, cbarg)) != NULL;
+        goto end;
+    }
+
+    if ((pubkeys = OPENSSL_malloc(num * sizeof(*pubkeys))) == NULL
+        || (privkeys = OPENSSL_malloc(num * sizeof(*privkeys))) == NULL) {
+        ret = 0;
+        goto end;
+    }
+
+    for (i = 0; ret && i < num; i++) {
+        ECX_KEY *key;
+        unsigned char *privkey;
+
+        keys[i] = key = ossl_ecx_key_new(gctx->libctx, gctx->type, 0,
+                                         gctx->propq);
+        if (key == NULL
+            || (privkey = ossl_ecx_key_allocate_privkey(key)) == NULL
+            || RAND_priv_bytes_ex(gctx->libctx, privkey, key->keylen, 0) <= 0) {
+            ERR_raise(ERR_LIB_PROV, ERR_R_EC_LIB);
+            ret = 0;
+            break;
+        }
+        privkey[0] &= 248;
+        privkey[X25519_KEYLEN - 1] &= 127;
+        privkey[X25519_KEYLEN - 1] |= 64;
+        privkeys[i] = privkey;
+        pubkeys[i] = key->pubkey;
+    }
+
+    ret = ret && ossl_x25519_public_from_private_batch(pubkeys, privkeys, num);
+    for (i = 0; ret && i < num; i++)
+        ((ECX_KEY *)keys[i])->haspubkey = 1;
+
+ end:
+    if (!ret) {
+        for (i = 0; i < num; i++) {
+            ossl_ecx_key_free(keys[i]);
+            keys[i] = NULL;
+        }
+    }
+    OPENSSL_free(pubkeys);
+    OPENSSL_free(privkeys);
+    return ret;
+}
+
 static void ecx_gen_cleanup(void *genctx)
 {
     struct ecx_gen_ctx *gctx = genctx;
@@ -1011,6 +1103,7 @@ static int ed448_validate(const void *keydata, int selection, int checktype)
         { OSSL_FUNC_KEYMGMT_GEN_SETTABLE_PARAMS, \
           (void (*)(void))ecx_gen_settable_params }, \
         { OSSL_FUNC_KEYMGMT_GEN, (void (*)(void))alg##_gen }, \
+        { OSSL_FUNC_KEYMGMT_GEN_BATCH, (void (*)(void))ecx_gen_batch }, \
         { OSSL_FUNC_KEYMGMT_GEN_CLEANUP, (void (*)(void))ecx_gen_cleanup }, \
         { OSSL_FUNC_KEYMGMT_LOAD, (void (*)(void))ecx_load }, \
         { OSSL_FUNC_KEYMGMT_DUP, (void (*)(void))ecx_dup }, \
@@ -98,8 +98,12 @@ static void newreno_reset(OSSL_CC_DATA *cc)
     nr->k_loss_reduction_factor_den     = 2;
     nr->persistent_cong_thresh          = 3;
 
+    /*
+     * bytes_in_flight is deliberately preserved; packets sent before the reset
+     * (e.g. on the old path after a connection migration) are still
+     * outstanding and will be reported to us as acknowledged or lost.
+     */
     nr->cong_wnd                    = nr->k_init_wnd;
-    nr->bytes_in_flight             = 0;
     nr->bytes_acked                 = 0;
     nr->slow_start_thresh           = UINT64_MAX;
     nr->cong_recovery_start_time    = ossl_time_zero();
@@ -1693,6 +1693,42 @@ int ossl_ackm_mark_packet_pseudo_lost(OSSL_ACKM *ackm,
     return 1;
 }
 
+int ossl_ackm_mark_pkt_space_pseudo_lost(OSSL_ACKM *ackm, int pkt_space)
+{
+    struct tx_pkt_history_st *h = get_tx_history(ackm, pkt_space);
+    OSSL_ACKM_TX_PKT *pkt, *pnext, *lost = NULL, **plost = &lost;
+    uint64_t num_bytes_invalidated = 0;
+
+    for (pkt = ossl_list_tx_history_head(&h->packets);
+         pkt != NULL; pkt = pnext) {
+        pnext = ossl_list_tx_history_next(pkt);
+
+        if (pkt->is_inflight)
+            num_bytes_invalidated += pkt->num_bytes;
+
+        tx_pkt_history_remove(h, pkt->pkt_num);
+        pkt->lnext = NULL;
+        *plost = pkt;
+        plost = &pkt->lnext;
+    }
+
+    if (lost == NULL)
+        return 1;
+
+    ackm_on_pkts_lost(ackm, pkt_space, lost, /*pseudo=*/1);
+
+    /*
+     * Pseudo-loss is not reported to the congestion controller as loss, but
+     * it must stop counting the bytes as in flight.
+     */
+    if (num_bytes_invalidated > 0)
+        ackm->cc_method->on_data_invalidated(ackm->cc_data,
+                                             num_bytes_invalidated);
+
+    ackm_set_loss_detection_timer(ackm);
+    return 1;
+}
+
 OSSL_TIME ossl_ackm_get_pto_duration(OSSL_ACKM *ackm)
 {
     OSSL_TIME duration;
@@ -0,0 +1,226 @@
+/*
+ * Copyright 2024 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+#include <assert.h>
+#include <string.h>
+#include <openssl/crypto.h>
+#include "internal/quic_buf_pool.h"
+
+/*
+ * Every buffer handed out is preceded by a header. The header occupies a whole
+ * cache line so that the buffer following it is also cache line aligned.
+ */
+#define BUF_POOL_ALIGN      64
+#define BUF_HDR_LEN         BUF_POOL_ALIGN
+
+typedef struct buf_hdr_st BUF_HDR;
+
+struct buf_hdr_st {
+    /* Pointer to pass to OPENSSL_free. */
+    void            *freeptr;
+    /* Next cached buffer, while this buffer is cached. */
+    BUF_HDR         *next;
+    /* 1 if this is a pool buffer, 0 if it is an oversize heap allocation. */
+    unsigned int    pooled : 1;
+};
+
+struct quic_buf_pool_st {
+    size_t              buf_len;
+
+    /* Singly-linked list of cached buffers. */
+    BUF_HDR             *cached;
+
+    /* The highest value of stats.num_in_use since the last trim. */
+    size_t              trim_high_water;
+
+    QUIC_BUF_POOL_STATS stats;
+};
+
+static ossl_inline BUF_HDR *buf_to_hdr(void *buf)
+{
+    return (BUF_HDR *)((unsigned char *)buf - BUF_HDR_LEN);
+}
+
+static ossl_inline void *hdr_to_buf(BUF_HDR *hdr)
+{
+    return (unsigned char *)hdr + BUF_HDR_LEN;
+}
+
+static BUF_HDR *buf_pool_alloc_hdr(size_t len, int pooled)
+{
+    BUF_HDR *hdr;
+    void *freeptr;
+
+    if (len > SIZE_MAX - BUF_HDR_LEN)
+        return NULL;
+
+    hdr = OPENSSL_aligned_alloc(BUF_HDR_LEN + len, BUF_POOL_ALIGN, &freeptr);
+    if (hdr == NULL)
+        return NULL;
+
+    hdr->freeptr    = freeptr;
+    hdr->next       = NULL;
+    hdr->pooled     = (pooled != 0);
+    return hdr;
+}
+
+QUIC_BUF_POOL *ossl_quic_buf_pool_new(size_t buf_len)
+{
+    QUIC_BUF_POOL *pool;
+
+    if (buf_len == 0)
+        return NULL;
+
+    if ((pool = OPENSSL_zalloc(sizeof(*pool))) == NULL)
+        return NULL;
+
+    /* Keep the buffers themselves a multiple of the cache line size. */
+    pool->buf_len = (buf_len + BUF_POOL_ALIGN - 1) & ~(size_t)(BUF_POOL_ALIGN - 1);
+    return pool;
+}
+
+void ossl_quic_buf_pool_free(QUIC_BUF_POOL *pool)
+{
+    BUF_HDR *hdr, *hnext;
+
+    if (pool == NULL)
+        return;
+
+    assert(pool->stats.num_in_use == 0);
+
+    for (hdr = pool->cached; hdr != NULL; hdr = hnext) {
+        hnext = hdr->next;
+        OPENSSL_free(hdr->freeptr);
+    }
+
+    OPENSSL_free(pool);
+}
+
+size_t ossl_quic_buf_pool_get_buf_len(const QUIC_BUF_POOL *pool)
+{
+    return pool->buf_len;
+}
+
+void *ossl_quic_buf_pool_alloc(QUIC_BUF_POOL *pool, size_t len)
+{
+    BUF_HDR *hdr;
+
+    if (pool == NULL)
+        return OPENSSL_malloc(len);
+
+    if (len > pool->buf_len) {
+        if ((hdr = buf_pool_alloc_hdr(len, /*pooled=*/0)) == NULL)
+            return NULL;
+
+        ++pool->stats.num_alloc;
+        ++pool->stats.num_alloc_oversize;
+        return hdr_to_buf(hdr);
+    }
+
+    if (pool->cached != NULL) {
+        hdr = pool->cached;
+        pool->cached = hdr->next;
+        hdr->next = NULL;
+        --pool->stats.num_cached;
+        ++pool->stats.num_alloc_cached;
+    } else if ((hdr = buf_pool_alloc_hdr(pool->buf_len, /*pooled=*/1)) == NULL) {
+        return NULL;
+    }
+
+    ++pool->stats.num_alloc;
+    ++pool->stats.num_in_use;
+
+    if (pool->stats.num_in_use > pool->stats.high_water)
+        pool->stats.high_water = pool->stats.num_in_use;
+
+    if (pool->stats.num_in_use > pool->trim_high_water)
+        pool->trim_high_water = pool->stats.num_in_use;
+
+    return hdr_to_buf(hdr);
+}
+
+void *ossl_quic_buf_pool_realloc(QUIC_BUF_POOL *pool, void *buf,
+                                 size_t old_len, size_t new_len)
+{
+    void *nbuf;
+
+    if (pool == NULL)
+        return OPENSSL_realloc(buf, new_len);
+
+    if (buf == NULL)
+        return ossl_quic_buf_pool_alloc(pool, new_len);
+
+    /* A pool buffer can grow up to the pool buffer size in place. */
+    if (buf_to_hdr(buf)->pooled && new_len <= pool->buf_len)
+        return buf;
+
+    if ((nbuf = ossl_quic_buf_pool_alloc(pool, new_len)) == NULL)
+        return NULL;
+
+    memcpy(nbuf, buf, old_len < new_len ? old_len : new_len);
+    ossl_quic_buf_pool_release(pool, buf);
+    return nbuf;
+}
+
+void ossl_quic_buf_pool_release(QUIC_BUF_POOL *pool, void *buf)
+{
+    BUF_HDR *hdr;
+
+    if (pool == NULL) {
+        OPENSSL_free(buf);
+        return;
+    }
+
+    if (buf == NULL)
+        return;
+
+    hdr = buf_to_hdr(buf);
+    if (!hdr->pooled) {
+        OPENSSL_free(hdr->freeptr);
+        return;
+    }
+
+    assert(pool->stats.num_in_use > 0);
+    --pool->stats.num_in_use;
+
+    hdr->next = pool->cached;
+    pool->cached = hdr;
+    ++pool->stats.num_cached;
+}
+
+void ossl_quic_buf_pool_trim(QUIC_BUF_POOL *pool)
+{
+    BUF_HDR *hdr;
+    size_t max_cached;
+
+    if (pool == NULL)
+        return;
+
+    /*
+     * Keep enough cached buffers that the peak demand seen since the last trim
+     * could be met again without allocating, and free the rest.
+     */
+    max_cached = pool->trim_high_water - pool->stats.num_in_use;
+
+    while (pool->stats.num_cached > max_cached) {
+        hdr = pool->cached;
+        pool->cached = hdr->next;
+        OPENSSL_free(hdr->freeptr);
+        --pool->stats.num_cached;
+        ++pool->stats.num_trimmed;
+    }
+
+    pool->trim_high_water = pool->stats.num_in_use;
+}
+
+void ossl_quic_buf_pool_get_stats(const QUIC_BUF_POOL *pool,
+                                  QUIC_BUF_POOL_STATS *stats)
+{
+    *stats = pool->stats;
+}
@@ -49,6 +49,12 @@
  */
 #define DEFAULT_MAX_ACK_DELAY   QUIC_DEFAULT_MAX_ACK_DELAY
 
+/*
+ * The maximum number of LCIDs we make available to a peer at any one time as
+ * a server, subject to the peer's active_connection_id_limit.
+ */
+#define MAX_ISSUED_LCIDS        4
+
 DEFINE_LIST_OF_IMPL(ch, QUIC_CHANNEL);
 
 static void ch_save_err_state(QUIC_CHANNEL *ch);
@@ -102,6 +108,11 @@ static void ch_on_txp_ack_tx(const OSSL_QUIC_FRAME_ACK *ack, uint32_t pn_space,
 static void ch_rx_handle_version_neg(QUIC_CHANNEL *ch, OSSL_QRX_PKT *pkt);
 static void ch_raise_version_neg_failure(QUIC_CHANNEL *ch);
 static void ch_record_state_transition(QUIC_CHANNEL *ch, uint32_t new_state);
+static void ch_rx_check_peer_addr(QUIC_CHANNEL *ch);
+static void ch_rx_answer_probe_path_challenge(QUIC_CHANNEL *ch);
+static void ch_path_validation_tick(QUIC_CHANNEL *ch, OSSL_TIME now);
+static void ch_issue_local_cids(QUIC_CHANNEL *ch);
+static int bio_addr_eq(const BIO_ADDR *a, const BIO_ADDR *b);
 
 DEFINE_LHASH_OF_EX(QUIC_SRT_ELEM);
 
@@ -185,6 +196,7 @@ static int ch_init(QUIC_CHANNEL *ch)
     qtx_args.get_qlog_cb        = ch_get_qlog_cb;
     qtx_args.get_qlog_cb_arg    = ch;
     qtx_args.mdpl               = QUIC_MIN_INITIAL_DGRAM_LEN;
+    qtx_args.buf_pool           = ch->port->engine->buf_pool;
     ch->rx_max_udp_payload_size = qtx_args.mdpl;
 
     ch->ping_deadline = ossl_time_infinite();
@@ -300,6 +312,11 @@ static int ch_init(QUIC_CHANNEL *ch)
     if ((ch->qrx = ossl_qrx_new(&qrx_args)) == NULL)
         goto err;
 
+    /* Clients never receive 0-RTT packets. */
+    if (!ch->is_server
+        && !ossl_qrx_discard_enc_level(ch->qrx, QUIC_ENC_LEVEL_0RTT))
+        goto err;
+
     if (!ossl_qrx_set_late_validation_cb(ch->qrx,
                                          rx_late_validate,
                                          ch))
@@ -355,6 +372,7 @@ static int ch_init(QUIC_CHANNEL *ch)
     ch_update_idle(ch);
     ossl_list_ch_insert_tail(&ch->port->channel_list, ch);
     ch->on_port_list = 1;
+    ossl_quic_engine_add_channel(ch->port->engine, ch);
     return 1;
 
 err:
@@ -402,6 +420,8 @@ static void ch_cleanup(QUIC_CHANNEL *ch)
     OSSL_ERR_STATE_free(ch->err_state);
     OPENSSL_free(ch->ack_range_scratch);
 
+    ossl_quic_engine_remove_channel(ch->port->engine, ch);
+
     if (ch->on_port_list) {
         ossl_list_ch_remove(&ch->port->channel_list, ch);
         ch->on_port_list = 0;
@@ -563,6 +583,17 @@ int ossl_quic_channel_is_handshake_confirmed(const QUIC_CHANNEL *ch)
     return ch->handshake_confirmed;
 }
 
+void ossl_quic_channel_set_early_data_enabled(QUIC_CHANNEL *ch, int enabled)
+{
+    ossl_quic_tls_set_early_data_enabled(ch->qtls, enabled);
+}
+
+int ossl_quic_channel_can_send_early_data(QUIC_CHANNEL *ch)
+{
+    return !ch->is_server && !ch->handshake_complete
+        && ossl_qtx_is_enc_level_provisioned(ch->qtx, QUIC_ENC_LEVEL_0RTT);
+}
+
 QUIC_DEMUX *ossl_quic_channel_get0_demux(QUIC_CHANNEL *ch)
 {
     return ch->port->demux;
@@ -946,6 +977,150 @@ static int ch_on_crypto_release_record(size_t bytes_read, void *arg)
     return ossl_quic_rstream_release_record(rstream, bytes_read);
 }
 
+/*
+ * Applies the flow control and stream count limits remembered from a previous
+ * connection so that 0-RTT data can be sent before the real transport
+ * parameters arrive (RFC 9000 s. 7.4.1). Everything else is ignored.
+ */
+static int ch_apply_remembered_transport_params(QUIC_CHANNEL *ch)
+{
+    const unsigned char *params;
+    size_t params_len, len;
+    PACKET pkt;
+    uint64_t id, v;
+
+    if (!ossl_quic_tls_get0_remembered_transport_params(ch->qtls, &params,
+                                                        &params_len)
+        || !PACKET_buf_init(&pkt, params, params_len))
+        return 0;
+
+    while (PACKET_remaining(&pkt) > 0) {
+        if (!ossl_quic_wire_peek_transport_param(&pkt, &id))
+            return 0;
+
+        switch (id) {
+        case QUIC_TPARAM_INITIAL_MAX_DATA:
+        case QUIC_TPARAM_INITIAL_MAX_STREAM_DATA_BIDI_LOCAL:
+        case QUIC_TPARAM_INITIAL_MAX_STREAM_DATA_BIDI_REMOTE:
+        case QUIC_TPARAM_INITIAL_MAX_STREAM_DATA_UNI:
+        case QUIC_TPARAM_INITIAL_MAX_STREAMS_BIDI:
+        case QUIC_TPARAM_INITIAL_MAX_STREAMS_UNI:
+            if (!ossl_quic_wire_decode_transport_param_int(&pkt, &id, &v))
+                return 0;
+            break;
+
+        default:
+            if (ossl_quic_wire_decode_transport_param_bytes(&pkt, &id,
+                                                            &len) == NULL)
+                return 0;
+            continue;
+        }
+
+        switch (id) {
+        case QUIC_TPARAM_INITIAL_MAX_DATA:
+            ossl_quic_txfc_bump_cwm(&ch->conn_txfc, v);
+            break;
+        case QUIC_TPARAM_INITIAL_MAX_STREAM_DATA_BIDI_LOCAL:
+            ch->rx_init_max_stream_data_bidi_remote = v;
+            break;
+        case QUIC_TPARAM_INITIAL_MAX_STREAM_DATA_BIDI_REMOTE:
+            ch->rx_init_max_stream_data_bidi_local = v;
+            break;
+        case QUIC_TPARAM_INITIAL_MAX_STREAM_DATA_UNI:
+            ch->rx_init_max_stream_data_uni = v;
+            break;
+        case QUIC_TPARAM_INITIAL_MAX_STREAMS_BIDI:
+            if (v > (((uint64_t)1) << 60))
+                return 0;
+            ch->max_local_streams_bidi = v;
+            break;
+        case QUIC_TPARAM_INITIAL_MAX_STREAMS_UNI:
+            if (v > (((uint64_t)1) << 60))
+                return 0;
+            ch->max_local_streams_uni = v;
+            break;
+        }
+    }
+
+    ch->got_remembered_transport_params = 1;
+    return 1;
+}
+
+/* Called when the 0-RTT traffic secret is available. */
+static int ch_on_0rtt_yield_secret(QUIC_CHANNEL *ch, int direction,
+                                   uint32_t suite_id, EVP_MD *md,
+                                   const unsigned char *secret,
+                                   size_t secret_len)
+{
+    /* Only clients send 0-RTT packets and only servers receive them. */
+    if ((direction != 0) == (ch->is_server != 0))
+        return 0;
+
+    if (direction) {
+        if (!ch_apply_remembered_transport_params(ch))
+            return 0;
+
+        return ossl_qtx_provide_secret(ch->qtx, QUIC_ENC_LEVEL_0RTT,
+                                       suite_id, md, secret, secret_len);
+    }
+
+    if (!ossl_qrx_provide_secret(ch->qrx, QUIC_ENC_LEVEL_0RTT,
+                                 suite_id, md, secret, secret_len))
+        return 0;
+
+    /* Retry any 0-RTT packets which were deferred for want of keys. */
+    ch->have_new_rx_secret = 1;
+    return 1;
+}
+
+/*
+ * Called on a client once the 1-RTT keys are available. No further 0-RTT
+ * packets may be sent; if the server rejected early data, everything we sent
+ * in 0-RTT packets is queued for retransmission in 1-RTT packets
+ * (RFC 9001 s. 4.6.2).
+ */
+static int ch_on_0rtt_done(QUIC_CHANNEL *ch)
+{
+    if (!ossl_qtx_is_enc_level_provisioned(ch->qtx, QUIC_ENC_LEVEL_0RTT))
+        return 1;
+
+    if (SSL_get_early_data_status(ch->tls) != SSL_EARLY_DATA_ACCEPTED
+        && !ossl_ackm_mark_pkt_space_pseudo_lost(ch->ackm,
+                                                 QUIC_PN_SPACE_APP))
+        return 0;
+
+    return ch_discard_el(ch, QUIC_ENC_LEVEL_0RTT);
+}
+
+static void txfc_reset(QUIC_STREAM *s, void *arg)
+{
+    ossl_quic_txfc_reset(&s->txfc);
+}
+
+/*
+ * Called on a client when the server's transport parameters arrive and the
+ * server has rejected 0-RTT. The limits remembered from the previous
+ * connection no longer apply, only those the server has now sent do
+ * (RFC 9000 s. 7.4.1). The server discarded our 0-RTT packets, so what we sent
+ * in them is retransmitted and counted against the new limits afresh; streams
+ * opened beyond the new stream count limit wait for a MAX_STREAMS frame.
+ */
+static int ch_forget_remembered_transport_params(QUIC_CHANNEL *ch)
+{
+    if (!ch_on_0rtt_done(ch))
+        return 0;
+
+    ossl_quic_txfc_reset(&ch->conn_txfc);
+    ossl_quic_stream_map_visit(&ch->qsm, txfc_reset, NULL);
+    ch->rx_init_max_stream_data_bidi_local  = 0;
+    ch->rx_init_max_stream_data_bidi_remote = 0;
+    ch->rx_init_max_stream_data_uni         = 0;
+    ch->max_local_streams_bidi              = 0;
+    ch->max_local_streams_uni               = 0;
+    ch->got_remembered_transport_params     = 0;
+    return 1;
+}
+
 static int ch_on_handshake_yield_secret(uint32_t enc_level, int direction,
                                         uint32_t suite_id, EVP_MD *md,
                                         const unsigned char *secret,
@@ -959,6 +1134,13 @@ static int ch_on_handshake_yield_secret(uint32_t enc_level, int direction,
         /* Invalid EL. */
         return 0;
 
+    /*
+     * The 0-RTT EL is provisioned alongside the others rather than in
+     * sequence with them, so it is not tracked by tx/rx_enc_level.
+     */
+    if (enc_level == QUIC_ENC_LEVEL_0RTT)
+        return ch_on_0rtt_yield_secret(ch, direction, suite_id, md,
+                                       secret, secret_len);
 
     if (direction) {
         /* TX */
@@ -975,6 +1157,10 @@ static int ch_on_handshake_yield_secret(uint32_t enc_level, int direction,
             return 0;
 
         ch->tx_enc_level = enc_level;
+
+        if (!ch->is_server && enc_level == QUIC_ENC_LEVEL_1RTT
+            && !ch_on_0rtt_done(ch))
+            return 0;
     } else {
         /* RX */
         if (enc_level <= ch->rx_enc_level)
@@ -1186,12 +1372,27 @@ static int ch_on_transport_params(const unsigned char *params,
     ossl_unused uint64_t rx_max_idle_timeout = 0;
     ossl_unused const void *stateless_reset_token_p = NULL;
     QUIC_PREFERRED_ADDR pfa;
+    int early_data_rejected = 0;
 
     if (ch->got_remote_transport_params) {
         reason = "multiple transport parameter extensions";
         goto malformed;
     }
 
+    /*
+     * The early_data extension is processed before this one, so we already
+     * know whether the server accepted 0-RTT.
+     */
+    if (ch->got_remembered_transport_params
+        && SSL_get_early_data_status(ch->tls) != SSL_EARLY_DATA_ACCEPTED) {
+        if (!ch_forget_remembered_transport_params(ch)) {
+            ossl_quic_channel_raise_protocol_error(ch, OSSL_QUIC_ERR_INTERNAL_ERROR, 0,
+                                                   "internal error (0-RTT rejection)");
+            return 0;
+        }
+        early_data_rejected = 1;
+    }
+
     if (!PACKET_buf_init(&pkt, params, params_len)) {
         ossl_quic_channel_raise_protocol_error(ch, OSSL_QUIC_ERR_INTERNAL_ERROR, 0,
                                                "internal error (packet buf init)");
@@ -1312,8 +1513,12 @@ static int ch_on_transport_params(const unsigned char *params,
             /*
              * This is correct; the BIDI_LOCAL TP governs streams created by
              * the endpoint which sends the TP, i.e., our peer.
+             *
+             * As with the TXFC credit, a value remembered for accepted 0-RTT
+             * is never reduced.
              */
-            ch->rx_init_max_stream_data_bidi_remote = v;
+            if (v > ch->rx_init_max_stream_data_bidi_remote)
+                ch->rx_init_max_stream_data_bidi_remote = v;
             got_initial_max_stream_data_bidi_local = 1;
             break;
 
@@ -1333,7 +1538,8 @@ static int ch_on_transport_params(const unsigned char *params,
              * This is correct; the BIDI_REMOTE TP governs streams created
              * by the endpoint which receives the TP, i.e., us.
              */
-            ch->rx_init_max_stream_data_bidi_local = v;
+            if (v > ch->rx_init_max_stream_data_bidi_local)
+                ch->rx_init_max_stream_data_bidi_local = v;
 
             /* Apply to all existing streams. */
             ossl_quic_stream_map_visit(&ch->qsm, txfc_bump_cwm_bidi, &v);
@@ -1352,7 +1558,8 @@ static int ch_on_transport_params(const unsigned char *params,
                 goto malformed;
             }
 
-            ch->rx_init_max_stream_data_uni = v;
+            if (v > ch->rx_init_max_stream_data_uni)
+                ch->rx_init_max_stream_data_uni = v;
 
             /* Apply to all existing streams. */
             ossl_quic_stream_map_visit(&ch->qsm, txfc_bump_cwm_uni, &v);
@@ -1409,8 +1616,18 @@ static int ch_on_transport_params(const unsigned char *params,
                 goto malformed;
             }
 
-            assert(ch->max_local_streams_bidi == 0);
-            ch->max_local_streams_bidi = v;
+            /*
+             * A limit remembered for 0-RTT is only still in force if the
+             * server accepted 0-RTT, in which case it must not reduce it
+             * (RFC 9000 s. 7.4.1).
+             */
+            if (!ossl_assert(ch->max_local_streams_bidi == 0
+                             || ch->got_remembered_transport_params)) {
+                reason = "internal error (remembered stream limit)";
+                goto malformed;
+            }
+            if (v > ch->max_local_streams_bidi)
+                ch->max_local_streams_bidi = v;
             got_initial_max_streams_bidi = 1;
             break;
 
@@ -1427,8 +1644,13 @@ static int ch_on_transport_params(const unsigned char *params,
                 goto malformed;
             }
 
-            assert(ch->max_local_streams_uni == 0);
-            ch->max_local_streams_uni = v;
+            if (!ossl_assert(ch->max_local_streams_uni == 0
+                             || ch->got_remembered_transport_params)) {
+                reason = "internal error (remembered stream limit)";
+                goto malformed;
+            }
+            if (v > ch->max_local_streams_uni)
+                ch->max_local_streams_uni = v;
             got_initial_max_streams_uni = 1;
             break;
 
@@ -1560,7 +1782,11 @@ static int ch_on_transport_params(const unsigned char *params,
             break;
 
         case QUIC_TPARAM_DISABLE_ACTIVE_MIGRATION:
-            /* We do not currently handle migration, so nothing to do. */
+            /*
+             * We only migrate when the application gives us a new network BIO,
+             * in which case our address has already changed and we have no
+             * choice, so nothing to do.
+             */
             if (got_disable_active_migration) {
                 /* must not appear more than once */
                 reason = TP_REASON_DUP("DISABLE_ACTIVE_MIGRATION");
@@ -1674,9 +1900,11 @@ static int ch_on_transport_params(const unsigned char *params,
 #endif
 
     if (got_initial_max_data || got_initial_max_stream_data_bidi_remote
-        || got_initial_max_streams_bidi || got_initial_max_streams_uni)
+        || got_initial_max_streams_bidi || got_initial_max_streams_uni
+        || early_data_rejected)
         /*
-         * If FC credit was bumped, we may now be able to send. Update all
+         * If FC credit was bumped, we may now be able to send, and after a
+         * 0-RTT rejection some streams may no longer be able to. Update all
          * streams.
          */
         ossl_quic_stream_map_visit(&ch->qsm, do_update, ch);
@@ -1720,8 +1948,13 @@ static int ch_generate_transport_params(QUIC_CHANNEL *ch)
 
     wpkt_valid = 1;
 
-    if (ossl_quic_wire_encode_transport_param_bytes(&wpkt, QUIC_TPARAM_DISABLE_ACTIVE_MIGRATION,
-                                                    NULL, 0) == NULL)
+    /*
+     * As a server we support connection migration by the client. As a client
+     * we never expect the server to move, as we do not use preferred_address.
+     */
+    if (!ch->is_server
+        && ossl_quic_wire_encode_transport_param_bytes(&wpkt, QUIC_TPARAM_DISABLE_ACTIVE_MIGRATION,
+                                                       NULL, 0) == NULL)
         goto err;
 
     if (ch->is_server) {
@@ -1800,7 +2033,7 @@ static int ch_generate_transport_params(QUIC_CHANNEL *ch)
 #ifndef OPENSSL_NO_QLOG
     QLOG_EVENT_BEGIN(ch_get_qlog(ch), transport, parameters_set)
         QLOG_STR("owner", "local");
-        QLOG_BOOL("disable_active_migration", 1);
+        QLOG_BOOL("disable_active_migration", !ch->is_server);
         if (ch->is_server) {
             QLOG_CID("original_destination_connection_id", &ch->init_dcid);
             QLOG_CID("initial_source_connection_id", &ch->cur_local_cid);
@@ -1957,6 +2190,10 @@ void ossl_quic_channel_subtick(QUIC_CHANNEL *ch, QUIC_TICK_RESULT *res,
             ch_update_ping_deadline(ch);
         }
 
+        /* Handle path validation timeouts and keep the peer supplied with CIDs. */
+        ch_path_validation_tick(ch, now);
+        ch_issue_local_cids(ch);
+
         /* Queue any data to be sent for transmission. */
         ch_tx(ch);
 
@@ -2058,6 +2295,14 @@ static int ch_rx(QUIC_CHANNEL *ch, int channel_only)
             ossl_quic_tx_packetiser_record_received_closing_bytes(
                     ch->txp, ch->qrx_pkt->hdr->len);
 
+        /* Track the amount of data received from an unvalidated address */
+        if (ch->is_server
+            && ch->path_validation_in_progress
+            && ch->qrx_pkt->peer != NULL
+            && bio_addr_eq(ch->qrx_pkt->peer, &ch->cur_peer_addr))
+            ossl_quic_tx_packetiser_record_received_path_bytes(
+                    ch->txp, ch->qrx_pkt->hdr->len);
+
         if (!handled_any) {
             ch_update_idle(ch);
             ch_update_ping_deadline(ch);
@@ -2089,7 +2334,16 @@ static int ch_rx(QUIC_CHANNEL *ch, int channel_only)
     return 1;
 }
 
-static int bio_addr_eq(const BIO_ADDR *a, const BIO_ADDR *b)
+static int bio_addr_is_inet(const BIO_ADDR *a)
+{
+    return BIO_ADDR_family(a) == AF_INET
+#if OPENSSL_USE_IPV6
+        || BIO_ADDR_family(a) == AF_INET6
+#endif
+        ;
+}
+
+static int bio_addr_eq_ex(const BIO_ADDR *a, const BIO_ADDR *b, int cmp_port)
 {
     if (BIO_ADDR_family(a) != BIO_ADDR_family(b))
         return 0;
@@ -2099,13 +2353,13 @@ static int bio_addr_eq(const BIO_ADDR *a, const BIO_ADDR *b)
             return !memcmp(&a->s_in.sin_addr,
                            &b->s_in.sin_addr,
                            sizeof(a->s_in.sin_addr))
-                && a->s_in.sin_port == b->s_in.sin_port;
+                && (!cmp_port || a->s_in.sin_port == b->s_in.sin_port);
 #if OPENSSL_USE_IPV6
         case AF_INET6:
             return !memcmp(&a->s_in6.sin6_addr,
                            &b->s_in6.sin6_addr,
                            sizeof(a->s_in6.sin6_addr))
-                && a->s_in6.sin6_port == b->s_in6.sin6_port;
+                && (!cmp_port || a->s_in6.sin6_port == b->s_in6.sin6_port);
 #endif
         default:
             return 0; /* not supported */
@@ -2114,6 +2368,11 @@ static int bio_addr_eq(const BIO_ADDR *a, const BIO_ADDR *b)
     return 1;
 }
 
+static int bio_addr_eq(const BIO_ADDR *a, const BIO_ADDR *b)
+{
+    return bio_addr_eq_ex(a, b, 1);
+}
+
 /* Handles the packet currently in ch->qrx_pkt->hdr. */
 static void ch_rx_handle_packet(QUIC_CHANNEL *ch, int channel_only)
 {
@@ -2161,12 +2420,7 @@ static void ch_rx_handle_packet(QUIC_CHANNEL *ch, int channel_only)
      */
     if (!ch->is_server
         && ch->qrx_pkt->peer != NULL
-        && (
-               BIO_ADDR_family(&ch->cur_peer_addr) == AF_INET
-#if OPENSSL_USE_IPV6
-            || BIO_ADDR_family(&ch->cur_peer_addr) == AF_INET6
-#endif
-        )
+        && bio_addr_is_inet(&ch->cur_peer_addr)
         && !bio_addr_eq(ch->qrx_pkt->peer, &ch->cur_peer_addr))
         return;
 
@@ -2263,10 +2517,11 @@ static void ch_rx_handle_packet(QUIC_CHANNEL *ch, int channel_only)
             return;
 
         /*
-         * TODO(QUIC 0RTT): Implement 0-RTT on the server side. We currently
-         * do not need to implement this as a client can only do 0-RTT if we
-         * have given it permission to in a previous session.
+         * The QRX only yields 0-RTT packets once TLS has accepted early data
+         * and provisioned the keys; their frames are handled like those of
+         * 1-RTT packets, subject to the frame type checks in the RXDP.
          */
+        ossl_quic_handle_frames(ch, ch->qrx_pkt); /* best effort */
         break;
 
     case QUIC_PKT_TYPE_INITIAL:
@@ -2279,6 +2534,14 @@ static void ch_rx_handle_packet(QUIC_CHANNEL *ch, int channel_only)
              */
             ch_discard_el(ch, QUIC_ENC_LEVEL_INITIAL);
 
+        if (ch->is_server && ch->qrx_pkt->hdr->type == QUIC_PKT_TYPE_1RTT)
+            /*
+             * RFC 9001 s. 4.9.3: Servers MAY discard 0-RTT keys as soon as
+             * they receive a 1-RTT packet. This also drops any 0-RTT packets
+             * still deferred because early data was rejected.
+             */
+            ch_discard_el(ch, QUIC_ENC_LEVEL_0RTT);
+
         if (ch->rxku_in_progress
             && ch->qrx_pkt->hdr->type == QUIC_PKT_TYPE_1RTT
             && ch->qrx_pkt->pn >= ch->rxku_trigger_pn
@@ -2324,6 +2587,12 @@ static void ch_rx_handle_packet(QUIC_CHANNEL *ch, int channel_only)
         /* This packet contains frames, pass to the RXDP. */
         ossl_quic_handle_frames(ch, ch->qrx_pkt); /* best effort */
 
+        if (ch->qrx_pkt->hdr->type == QUIC_PKT_TYPE_1RTT)
+            ch_rx_check_peer_addr(ch);
+
+        if (ch->have_probe_path_challenge)
+            ch_rx_answer_probe_path_challenge(ch);
+
         if (ch->did_crypto_frame)
             ch_tick_tls(ch, channel_only);
 
@@ -2547,6 +2816,12 @@ static OSSL_TIME ch_determine_next_tick_deadline(QUIC_CHANNEL *ch)
     if (ch->rxku_in_progress)
         deadline = ossl_time_min(deadline, ch->rxku_update_end_deadline);
 
+    /* When do we need to resend or give up on a PATH_CHALLENGE? */
+    if (ch->path_validation_in_progress)
+        deadline = ossl_time_min(deadline,
+                                 ossl_time_min(ch->path_challenge_resend_time,
+                                               ch->path_validation_deadline));
+
     return deadline;
 }
 
@@ -2617,6 +2892,7 @@ int ossl_quic_channel_start(QUIC_CHANNEL *ch)
     if (!ch_tick_tls(ch, /*channel_only=*/0))
         return 0;
 
+    ossl_quic_channel_schedule_tick(ch);
     ossl_quic_reactor_tick(ossl_quic_port_get0_reactor(ch->port), 0); /* best effort */
     return 1;
 }
@@ -2772,6 +3048,16 @@ int ossl_quic_channel_on_handshake_confirmed(QUIC_CHANNEL *ch)
     ch->handshake_confirmed = 1;
     ch_record_state_transition(ch, ch->state);
     ossl_ackm_on_handshake_confirmed(ch->ackm);
+
+    if (ch->is_server) {
+        /*
+         * The client cannot still be using the ODCID once the handshake is
+         * confirmed. Retire it so that it does not count against the LCIDs we
+         * issue for use in migration.
+         */
+        ossl_quic_lcidm_retire_odcid(ch->lcidm, ch);
+        ch->need_new_local_cids = 1;
+    }
     return 1;
 }
 
@@ -2869,6 +3155,17 @@ static void ch_start_terminating(QUIC_CHANNEL *ch,
     case QUIC_CHANNEL_STATE_ACTIVE:
         copy_tcause(&ch->terminate_cause, tcause);
 
+        /*
+         * An orderly QUIC connection close is authenticated and so plays the
+         * role of a TLS close_notify. Mark the TLS object as shut down so the
+         * session is not removed from the session cache when it is freed,
+         * which would otherwise make stateful (0-RTT capable) tickets
+         * unusable.
+         */
+        if (ch->handshake_complete
+            && (tcause->app || tcause->error_code == OSSL_QUIC_ERR_NO_ERROR))
+            SSL_set_shutdown(ch->tls, SSL_SENT_SHUTDOWN | SSL_RECEIVED_SHUTDOWN);
+
         ossl_qlog_event_connectivity_connection_closed(ch_get_qlog(ch), tcause);
 
         if (!force_immediate) {
@@ -3007,13 +3304,16 @@ err:
 void ossl_quic_channel_on_new_conn_id(QUIC_CHANNEL *ch,
                                       OSSL_QUIC_FRAME_NEW_CONN_ID *f)
 {
-    uint64_t new_remote_seq_num = ch->cur_remote_seq_num;
-    uint64_t new_retire_prior_to = ch->cur_retire_prior_to;
+    uint64_t max_remote_seq_num, new_remote_seq_num, new_retire_prior_to;
+    int have_new = 0;
 
     if (!ossl_quic_channel_is_active(ch))
         return;
 
-    /* We allow only two active connection ids; first check some constraints */
+    /*
+     * We allow only two active connection ids: the one in use and, optionally,
+     * a spare we can switch to on migration. First check some constraints.
+     */
     if (ch->cur_remote_dcid.id_len == 0) {
         /* Changing from 0 length connection id is disallowed */
         ossl_quic_channel_raise_protocol_error(ch,
@@ -3024,6 +3324,11 @@ void ossl_quic_channel_on_new_conn_id(QUIC_CHANNEL *ch,
         return;
     }
 
+    max_remote_seq_num = ch->have_spare_remote_dcid
+        ? ch->spare_remote_seq_num : ch->cur_remote_seq_num;
+    new_remote_seq_num = max_remote_seq_num;
+    new_retire_prior_to = ch->cur_retire_prior_to;
+
     if (f->seq_num > new_remote_seq_num)
         new_remote_seq_num = f->seq_num;
     if (f->retire_prior_to > new_retire_prior_to)
@@ -3071,7 +3376,7 @@ void ossl_quic_channel_on_new_conn_id(QUIC_CHANNEL *ch,
         return;
     }
 
-    if (new_remote_seq_num > ch->cur_remote_seq_num) {
+    if (new_remote_seq_num > max_remote_seq_num) {
         /* Add new stateless reset token */
         if (!ossl_quic_srtm_add(ch->srtm, ch, new_remote_seq_num,
                                 &f->stateless_reset)) {
@@ -3082,11 +3387,40 @@ void ossl_quic_channel_on_new_conn_id(QUIC_CHANNEL *ch,
 
             return;
         }
-        ch->cur_remote_seq_num = new_remote_seq_num;
-        ch->cur_remote_dcid = f->conn_id;
+        have_new = 1;
+    }
+
+    /*
+     * If the CID we are using is being retired, switch to the lowest-numbered
+     * CID which remains active. Otherwise keep using the current CID and hold
+     * the new one in reserve for migration. The limit check above ensures that
+     * the current, spare and new CIDs cannot all remain active.
+     */
+    if (ch->cur_remote_seq_num < new_retire_prior_to) {
+        if (ch->have_spare_remote_dcid
+            && ch->spare_remote_seq_num >= new_retire_prior_to) {
+            ch->cur_remote_seq_num      = ch->spare_remote_seq_num;
+            ch->cur_remote_dcid         = ch->spare_remote_dcid;
+            ch->have_spare_remote_dcid  = 0;
+        } else if (have_new) {
+            ch->cur_remote_seq_num      = new_remote_seq_num;
+            ch->cur_remote_dcid         = f->conn_id;
+            have_new                    = 0;
+        }
+
         ossl_quic_tx_packetiser_set_cur_dcid(ch->txp, &ch->cur_remote_dcid);
     }
 
+    if (ch->have_spare_remote_dcid
+        && ch->spare_remote_seq_num < new_retire_prior_to)
+        ch->have_spare_remote_dcid = 0;
+
+    if (have_new) {
+        ch->spare_remote_seq_num    = new_remote_seq_num;
+        ch->spare_remote_dcid       = f->conn_id;
+        ch->have_spare_remote_dcid  = 1;
+    }
+
     /*
      * RFC 9000-5.1.2: Upon receipt of an increased Retire Prior To
      * field, the peer MUST stop using the corresponding connection IDs
@@ -3114,6 +3448,442 @@ void ossl_quic_channel_on_new_conn_id(QUIC_CHANNEL *ch,
     }
 }
 
+/* Called by the RXDP when the peer retires one of our LCIDs. */
+void ossl_quic_channel_on_retire_conn_id(QUIC_CHANNEL *ch, uint64_t seq_num)
+{
+    QUIC_CONN_ID retired_lcid;
+    uint64_t retired_seq_num, bit;
+    int did_retire;
+
+    if (!ossl_quic_channel_is_active(ch))
+        return;
+
+    /*
+     * RFC 9000 s. 19.16: "Receipt of a RETIRE_CONNECTION_ID frame containing a
+     * sequence number greater than any previously sent to the peer MUST be
+     * treated as a connection error of type PROTOCOL_VIOLATION."
+     */
+    if (seq_num > ch->max_local_cid_seq_num) {
+        ossl_quic_channel_raise_protocol_error(ch,
+                                               OSSL_QUIC_ERR_PROTOCOL_VIOLATION,
+                                               OSSL_QUIC_FRAME_TYPE_RETIRE_CONN_ID,
+                                               "retired LCID was never issued");
+        return;
+    }
+
+    if (seq_num < ch->local_cid_retire_prior_to)
+        return; /* already retired */
+
+    /*
+     * The LCIDM retires LCIDs in sequence number order, so if the peer retires
+     * LCIDs out of order, remember the retirement until the gap is filled. We
+     * never have more than MAX_ISSUED_LCIDS LCIDs outstanding so the bitmap is
+     * always large enough.
+     */
+    bit = seq_num - ch->local_cid_retire_prior_to;
+    if (!ossl_assert(bit < sizeof(ch->local_cid_retired_mask) * 8))
+        return;
+
+    ch->local_cid_retired_mask |= ((uint64_t)1) << bit;
+
+    while ((ch->local_cid_retired_mask & 1) != 0) {
+        if (!ossl_quic_lcidm_retire(ch->lcidm, ch,
+                                    ch->local_cid_retire_prior_to + 1,
+                                    &ch->qrx_pkt->hdr->dst_conn_id,
+                                    &retired_lcid, &retired_seq_num,
+                                    &did_retire))
+            /*
+             * RFC 9000 s. 19.16: "The sequence number specified in a
+             * RETIRE_CONNECTION_ID frame MUST NOT refer to the Destination
+             * Connection ID field of the packet in which the frame is
+             * contained. The peer MAY treat this as a connection error of type
+             * PROTOCOL_VIOLATION." We are lenient and keep the LCID, since the
+             * peer is evidently still using it; the retirement remains pending
+             * and is reattempted when the next RETIRE_CONNECTION_ID frame
+             * arrives.
+             */
+            return;
+
+        ch->local_cid_retired_mask >>= 1;
+        ++ch->local_cid_retire_prior_to;
+    }
+
+    ch->need_new_local_cids = 1;
+}
+
+static int ch_enqueue_new_conn_id(QUIC_CHANNEL *ch,
+                                  const OSSL_QUIC_FRAME_NEW_CONN_ID *f)
+{
+    BUF_MEM *buf_mem = NULL;
+    WPACKET wpkt;
+    size_t l;
+
+    if ((buf_mem = BUF_MEM_new()) == NULL)
+        goto err;
+
+    if (!WPACKET_init(&wpkt, buf_mem))
+        goto err;
+
+    if (!ossl_quic_wire_encode_frame_new_conn_id(&wpkt, f)) {
+        WPACKET_cleanup(&wpkt);
+        goto err;
+    }
+
+    WPACKET_finish(&wpkt);
+    if (!WPACKET_get_total_written(&wpkt, &l))
+        goto err;
+
+    if (ossl_quic_cfq_add_frame(ch->cfq, 1, QUIC_PN_SPACE_APP,
+                                OSSL_QUIC_FRAME_TYPE_NEW_CONN_ID, 0,
+                                (unsigned char *)buf_mem->data, l,
+                                free_frame_data, NULL) == NULL)
+        goto err;
+
+    buf_mem->data = NULL;
+    BUF_MEM_free(buf_mem);
+    return 1;
+
+err:
+    ossl_quic_channel_raise_protocol_error(ch,
+                                           OSSL_QUIC_ERR_INTERNAL_ERROR,
+                                           OSSL_QUIC_FRAME_TYPE_NEW_CONN_ID,
+                                           "internal error enqueueing new conn id");
+    BUF_MEM_free(buf_mem);
+    return 0;
+}
+
+/*
+ * Server only: Issue LCIDs to the peer until it has as many as it (and we) are
+ * willing to track, so that it has spare CIDs to use when migrating (RFC 9000
+ * s. 5.1.1).
+ */
+static void ch_issue_local_cids(QUIC_CHANNEL *ch)
+{
+    OSSL_QUIC_FRAME_NEW_CONN_ID ncid;
+    uint64_t limit = ch->rx_active_conn_id_limit;
+
+    if (!ch->need_new_local_cids || !ossl_quic_channel_is_active(ch))
+        return;
+
+    ch->need_new_local_cids = 0;
+
+    /* We cannot issue new CIDs if we use zero-length CIDs. */
+    if (ossl_quic_lcidm_get_lcid_len(ch->lcidm) == 0)
+        return;
+
+    if (limit > MAX_ISSUED_LCIDS)
+        limit = MAX_ISSUED_LCIDS;
+
+    while (ossl_quic_lcidm_get_num_active_lcid(ch->lcidm, ch) < limit) {
+        if (!ossl_quic_lcidm_generate(ch->lcidm, ch, &ncid)
+            || RAND_bytes_ex(ch->port->engine->libctx,
+                             ncid.stateless_reset.token,
+                             sizeof(ncid.stateless_reset.token), 0) != 1) {
+            ossl_quic_channel_raise_protocol_error(ch,
+                                                   OSSL_QUIC_ERR_INTERNAL_ERROR,
+                                                   OSSL_QUIC_FRAME_TYPE_NEW_CONN_ID,
+                                                   "cannot generate LCID");
+            return;
+        }
+
+        ch->max_local_cid_seq_num = ncid.seq_num;
+        if (!ch_enqueue_new_conn_id(ch, &ncid))
+            return;
+    }
+}
+
+/*
+ * QUIC Channel: Path Validation and Migration
+ * ===========================================
+ */
+
+static int ch_enqueue_path_challenge(QUIC_CHANNEL *ch, OSSL_TIME now)
+{
+    unsigned char *encoded = NULL;
+    size_t encoded_len = sizeof(uint64_t) + 1;
+    WPACKET wpkt;
+
+    if ((encoded = OPENSSL_malloc(encoded_len)) == NULL)
+        goto err;
+
+    if (!WPACKET_init_static_len(&wpkt, encoded, encoded_len, 0))
+        goto err;
+
+    if (!ossl_quic_wire_encode_frame_path_challenge(&wpkt,
+                                                    ch->path_challenge_data)) {
+        WPACKET_cleanup(&wpkt);
+        goto err;
+    }
+
+    WPACKET_finish(&wpkt);
+
+    /*
+     * PATH_CHALLENGE frames are not retransmitted as such; if the challenge
+     * is lost, we send a new PATH_CHALLENGE frame after a PTO (RFC 9000 s.
+     * 13.3).
+     */
+    if (ossl_quic_cfq_add_frame(ch->cfq, 0, QUIC_PN_SPACE_APP,
+                                OSSL_QUIC_FRAME_TYPE_PATH_CHALLENGE,
+                                QUIC_CFQ_ITEM_FLAG_UNRELIABLE,
+                                encoded, encoded_len,
+                                free_frame_data, NULL) == NULL)
+        goto err;
+
+    ch->path_challenge_resend_time
+        = ossl_time_add(now, ossl_ackm_get_pto_duration(ch->ackm));
+    return 1;
+
+err:
+    OPENSSL_free(encoded);
+    ossl_quic_channel_raise_protocol_error(ch, OSSL_QUIC_ERR_INTERNAL_ERROR,
+                                           OSSL_QUIC_FRAME_TYPE_PATH_CHALLENGE,
+                                           "internal error");
+    return 0;
+}
+
+/* Begins validation of the current path (RFC 9000 s. 8.2). */
+static int ch_start_path_validation(QUIC_CHANNEL *ch)
+{
+    OSSL_TIME now = get_time(ch);
+
+    if (RAND_bytes_ex(ch->port->engine->libctx,
+                      (unsigned char *)&ch->path_challenge_data,
+                      sizeof(ch->path_challenge_data), 0) != 1)
+        return 0;
+
+    /*
+     * RFC 9000 s. 8.2.4: A value of three times the larger of the current PTO
+     * or the PTO for the new path (using kInitialRtt) is recommended. Our
+     * callers reset the RTT estimate when the new path may have different
+     * characteristics, so the current PTO suffices.
+     */
+    ch->path_validation_deadline
+        = ossl_time_add(now,
+                        ossl_time_multiply(ossl_ackm_get_pto_duration(ch->ackm),
+                                           3));
+    ch->path_validation_in_progress = 1;
+    return ch_enqueue_path_challenge(ch, now);
+}
+
+/*
+ * RFC 9000 s. 9.4: The congestion controller and RTT estimate must be reset
+ * when moving to a new path, unless only the peer's port number has changed.
+ */
+static void ch_reset_path_state(QUIC_CHANNEL *ch)
+{
+    ch->cc_method->reset(ch->cc_data);
+    ossl_statm_init(&ch->statm);
+}
+
+static void ch_path_validation_tick(QUIC_CHANNEL *ch, OSSL_TIME now)
+{
+    if (!ch->path_validation_in_progress || !ossl_quic_channel_is_active(ch))
+        return;
+
+    if (ossl_time_compare(now, ch->path_validation_deadline) >= 0) {
+        ch->path_validation_in_progress = 0;
+
+        /*
+         * RFC 9000 s. 9.3.2: "If an endpoint has no state about the last
+         * validated peer address, it MUST close the connection silently by
+         * discarding all connection state." Otherwise, it reverts to the last
+         * validated address. A client has nothing to revert to; its peer
+         * address has not changed and the new local address is all it has.
+         */
+        if (ch->is_server) {
+            ch->cur_peer_addr = ch->validated_peer_addr;
+            ossl_quic_tx_packetiser_set_peer(ch->txp, &ch->cur_peer_addr);
+            ossl_quic_tx_packetiser_set_amplification_limited(ch->txp, 0);
+            ch_reset_path_state(ch);
+        }
+
+        return;
+    }
+
+    if (ossl_time_compare(now, ch->path_challenge_resend_time) >= 0)
+        ch_enqueue_path_challenge(ch, now);
+}
+
+/* Called by the RXDP when a PATH_RESPONSE frame is received. */
+void ossl_quic_channel_on_path_response(QUIC_CHANNEL *ch, uint64_t data)
+{
+    /*
+     * RFC 9000 s. 8.2.3: "Path validation succeeds when a PATH_RESPONSE frame
+     * is received that contains the data that was sent in a previous
+     * PATH_CHALLENGE frame." Responses to earlier challenges are not expected
+     * as we use new data only when validating a new path.
+     */
+    if (ch->path_validation_in_progress && data == ch->path_challenge_data) {
+        ch->path_validation_in_progress = 0;
+        ossl_quic_tx_packetiser_set_amplification_limited(ch->txp, 0);
+    }
+}
+
+/*
+ * Called by the RXDP when a PATH_CHALLENGE frame is received. Returns 1 if the
+ * challenge came from an address other than the current peer address, in
+ * which case the channel answers it on that path (RFC 9000 s. 8.2.2), or 0 if
+ * the RXDP should queue the response for the current path.
+ */
+int ossl_quic_channel_on_path_challenge(QUIC_CHANNEL *ch, uint64_t data)
+{
+    const OSSL_QRX_PKT *pkt = ch->qrx_pkt;
+
+    if (!ch->is_server
+        || pkt == NULL
+        || pkt->hdr->type != QUIC_PKT_TYPE_1RTT
+        || pkt->peer == NULL
+        || !bio_addr_is_inet(&ch->cur_peer_addr)
+        || bio_addr_eq(pkt->peer, &ch->cur_peer_addr))
+        return 0;
+
+    ch->probe_path_challenge_data = data;
+    ch->have_probe_path_challenge = 1;
+    return 1;
+}
+
+/*
+ * Answers a PATH_CHALLENGE received on another path once the packet which
+ * carried it has been processed. The response is padded to 1200 bytes, but
+ * to no more than three times the size of that packet, as the address may
+ * not have been validated (RFC 9000 s. 8.2.2, 9.3.1).
+ */
+static void ch_rx_answer_probe_path_challenge(QUIC_CHANNEL *ch)
+{
+    const OSSL_QRX_PKT *pkt = ch->qrx_pkt;
+    size_t min_dgram_len = QUIC_MIN_INITIAL_DGRAM_LEN;
+
+    ch->have_probe_path_challenge = 0;
+
+    if (pkt->hdr->len < min_dgram_len / 3)
+        min_dgram_len = pkt->hdr->len * 3;
+
+    /* Best effort; the peer will send a new challenge if this is lost. */
+    ossl_quic_tx_packetiser_send_path_response(ch->txp, pkt->peer,
+                                               ch->probe_path_challenge_data,
+                                               min_dgram_len);
+}
+
+int ossl_quic_channel_is_validating_path(const QUIC_CHANNEL *ch)
+{
+    return ch->path_validation_in_progress;
+}
+
+/*
+ * Server only: Called when the highest-numbered non-probing packet arrives
+ * from a new peer address (RFC 9000 s. 9.3).
+ */
+static void ch_on_peer_addr_changed(QUIC_CHANNEL *ch, const BIO_ADDR *peer)
+{
+    int same_host = bio_addr_eq_ex(peer, &ch->cur_peer_addr, 0);
+
+    if (!ch->path_validation_in_progress) {
+        ch->validated_peer_addr = ch->cur_peer_addr;
+    } else if (bio_addr_eq(peer, &ch->validated_peer_addr)) {
+        /* The peer has returned to the last validated address. */
+        ch->path_validation_in_progress = 0;
+        ch->cur_peer_addr = *peer;
+        ossl_quic_tx_packetiser_set_peer(ch->txp, &ch->cur_peer_addr);
+        ossl_quic_tx_packetiser_set_amplification_limited(ch->txp, 0);
+        if (!same_host)
+            ch_reset_path_state(ch);
+        return;
+    }
+
+    ch->cur_peer_addr = *peer;
+    ossl_quic_tx_packetiser_set_peer(ch->txp, &ch->cur_peer_addr);
+
+    /*
+     * RFC 9000 s. 9.3: Until the new address is validated, we must not send
+     * more than three times the amount of data received from it, starting
+     * with the packet which moved us there.
+     */
+    ossl_quic_tx_packetiser_set_amplification_limited(ch->txp, 1);
+    ossl_quic_tx_packetiser_record_received_path_bytes(ch->txp,
+                                                       ch->qrx_pkt->hdr->len);
+
+    if (!same_host)
+        ch_reset_path_state(ch);
+
+    /*
+     * RFC 9000 s. 9.3: "Receiving a packet from a new peer address containing
+     * a non-probing frame indicates that the peer has migrated to that
+     * address." ... "an endpoint MUST perform path validation if it detects
+     * any change to its peer's address".
+     */
+    if (!ch_start_path_validation(ch))
+        ossl_quic_channel_raise_protocol_error(ch, OSSL_QUIC_ERR_INTERNAL_ERROR,
+                                               0, "cannot start path validation");
+}
+
+/* Called after the frames of a 1-RTT packet have been processed. */
+static void ch_rx_check_peer_addr(QUIC_CHANNEL *ch)
+{
+    const OSSL_QRX_PKT *pkt = ch->qrx_pkt;
+    int is_largest = !ch->have_rx_1rtt_pn || pkt->pn > ch->rx_largest_1rtt_pn;
+
+    if (is_largest) {
+        ch->rx_largest_1rtt_pn  = pkt->pn;
+        ch->have_rx_1rtt_pn     = 1;
+    }
+
+    /*
+     * RFC 9000 s. 9: "An endpoint MUST NOT initiate connection migration
+     * before the handshake is confirmed". As with the client-side check in
+     * ch_rx_handle_packet, only act on real AF_INET or AF_INET6 addresses.
+     */
+    if (!ch->is_server
+        || !ch->handshake_confirmed
+        || !ossl_quic_channel_is_active(ch)
+        || pkt->peer == NULL
+        || !bio_addr_is_inet(&ch->cur_peer_addr)
+        || bio_addr_eq(pkt->peer, &ch->cur_peer_addr))
+        return;
+
+    /*
+     * RFC 9000 s. 9.3: "An endpoint only changes the address to which it
+     * sends packets in response to the highest-numbered non-probing packet."
+     */
+    if (!is_largest || !ch->did_non_probing_frame)
+        return;
+
+    ch_on_peer_addr_changed(ch, pkt->peer);
+}
+
+int ossl_quic_channel_migrate(QUIC_CHANNEL *ch)
+{
+    uint64_t old_seq_num;
+
+    if (ch->is_server
+        || !ch->handshake_confirmed
+        || !ossl_quic_channel_is_active(ch))
+        return 0;
+
+    /*
+     * RFC 9000 s. 9.5: "An endpoint MUST NOT reuse a connection ID when
+     * sending from more than one local address". Switch to the spare CID and
+     * retire the old one. If the peer has not given us a spare, we have no
+     * choice but to continue with the current CID.
+     */
+    if (ch->have_spare_remote_dcid) {
+        old_seq_num = ch->cur_remote_seq_num;
+
+        ch->cur_remote_seq_num      = ch->spare_remote_seq_num;
+        ch->cur_remote_dcid         = ch->spare_remote_dcid;
+        ch->have_spare_remote_dcid  = 0;
+        ossl_quic_tx_packetiser_set_cur_dcid(ch->txp, &ch->cur_remote_dcid);
+
+        while (ch->cur_retire_prior_to <= old_seq_num) {
+            if (!ch_enqueue_retire_conn_id(ch, ch->cur_retire_prior_to))
+                return 0;
+            ++ch->cur_retire_prior_to;
+        }
+    }
+
+    ch_reset_path_state(ch);
+    return ch_start_path_validation(ch);
+}
+
 static void ch_save_err_state(QUIC_CHANNEL *ch)
 {
     if (ch->err_state == NULL)
@@ -3128,6 +3898,12 @@ static void ch_save_err_state(QUIC_CHANNEL *ch)
 void ossl_quic_channel_inject(QUIC_CHANNEL *ch, QUIC_URXE *e)
 {
     ossl_qrx_inject_urxe(ch->qrx, e);
+    ossl_quic_channel_schedule_tick(ch);
+}
+
+void ossl_quic_channel_schedule_tick(QUIC_CHANNEL *ch)
+{
+    ossl_quic_engine_schedule_channel(ch->port->engine, ch);
 }
 
 void ossl_quic_channel_on_stateless_reset(QUIC_CHANNEL *ch)
@@ -3137,6 +3913,7 @@ void ossl_quic_channel_on_stateless_reset(QUIC_CHANNEL *ch)
     tcause.error_code   = OSSL_QUIC_ERR_NO_ERROR;
     tcause.remote       = 1;
     ch_start_terminating(ch, &tcause, 0);
+    ossl_quic_channel_schedule_tick(ch);
 }
 
 void ossl_quic_channel_raise_net_error(QUIC_CHANNEL *ch)
@@ -3157,6 +3934,7 @@ void ossl_quic_channel_raise_net_error(QUIC_CHANNEL *ch)
      * send CONNECTION_CLOSE if we cannot communicate.
      */
     ch_start_terminating(ch, &tcause, 1);
+    ossl_quic_channel_schedule_tick(ch);
 }
 
 int ossl_quic_channel_net_error(QUIC_CHANNEL *ch)
@@ -3345,6 +4123,7 @@ int ossl_quic_channel_on_new_conn(QUIC_CHANNEL *ch, const BIO_ADDR *peer,
 
     /* Note our newly learnt peer address and CIDs. */
     ch->cur_peer_addr   = *peer;
+    ch->addressed_mode  = (BIO_ADDR_family(peer) != AF_UNSPEC);
     ch->init_dcid       = *peer_dcid;
     ch->cur_remote_dcid = *peer_scid;
 
@@ -3406,11 +4185,12 @@ static int ch_init_new_stream(QUIC_CHANNEL *ch, QUIC_STREAM *qs,
     if (!ossl_quic_txfc_init(&qs->txfc, &ch->conn_txfc))
         goto err;
 
-    if (ch->got_remote_transport_params) {
+    if (ch->got_remote_transport_params
+        || ch->got_remembered_transport_params) {
         /*
-         * If we already got peer TPs we need to apply the initial CWM credit
-         * now. If we didn't already get peer TPs this will be done
-         * automatically for all extant streams when we do.
+         * If we already got peer TPs (or remembered them for 0-RTT) we need to
+         * apply the initial CWM credit now. If we didn't already get peer TPs
+         * this will be done automatically for all extant streams when we do.
          */
         if (can_send) {
             uint64_t cwm;
@@ -3492,6 +4272,10 @@ uint64_t ossl_quic_channel_get_local_stream_count_avail(const QUIC_CHANNEL *ch,
                                                            is_uni);
     p_max           = ch_get_local_stream_max_ptr(ch, is_uni);
 
+    /* A rejection of 0-RTT may leave us with more streams than allowed */
+    if (*p_next_ordinal >= *p_max)
+        return 0;
+
     return *p_max - *p_next_ordinal;
 }
 
@@ -36,6 +36,16 @@ struct quic_channel_st {
      */
     OSSL_LIST_MEMBER(ch, struct quic_channel_st);
 
+    /*
+     * QUIC_ENGINE keeps channels which must be ticked at the next opportunity
+     * on a list, and channels with a finite tick deadline in a priority queue
+     * ordered by tick_deadline. tick_pq_idx is SIZE_MAX while the channel is
+     * not in the priority queue.
+     */
+    OSSL_LIST_MEMBER(ch_tick, struct quic_channel_st);
+    size_t                          tick_pq_idx;
+    OSSL_TIME                       tick_deadline;
+
     /*
      * The associated TLS 1.3 connection data. Used to provide the handshake
      * layer; its 'network' side is plugged into the crypto stream for each EL
@@ -61,6 +71,14 @@ struct quic_channel_st {
     /* Our current L4 peer address, if any. */
     BIO_ADDR                        cur_peer_addr;
 
+    /*
+     * Server only: The last peer address which we know to be valid. If the
+     * peer migrates and validation of the new path fails, we revert to this
+     * address (RFC 9000 s. 9.3.2). Only meaningful while
+     * path_validation_in_progress is set.
+     */
+    BIO_ADDR                        validated_peer_addr;
+
     /*
      * Subcomponents of the connection. All of these components are instantiated
      * and owned by us.
@@ -129,6 +147,51 @@ struct quic_channel_st {
     uint64_t                        cur_remote_seq_num;
     uint64_t                        cur_retire_prior_to;
 
+    /*
+     * An unused DCID provided by the peer in a NEW_CONNECTION_ID frame, kept in
+     * reserve so that we can switch to it when migrating to a new path (RFC
+     * 9000 s. 9.5). Valid if have_spare_remote_dcid is set.
+     */
+    QUIC_CONN_ID                    spare_remote_dcid;
+    uint64_t                        spare_remote_seq_num;
+
+    /*
+     * Server only: The highest sequence number of any LCID we have issued to
+     * the peer in a NEW_CONNECTION_ID frame.
+     */
+    uint64_t                        max_local_cid_seq_num;
+
+    /*
+     * Server only: LCIDs with sequence numbers below local_cid_retire_prior_to
+     * have been retired by the peer. local_cid_retired_mask records LCIDs the
+     * peer has retired out of order, relative to local_cid_retire_prior_to.
+     */
+    uint64_t                        local_cid_retire_prior_to;
+    uint64_t                        local_cid_retired_mask;
+
+    /*
+     * Path validation state (RFC 9000 s. 8.2). path_challenge_data is the
+     * payload of our outstanding PATH_CHALLENGE frame. The challenge is resent
+     * at path_challenge_resend_time and validation is abandoned if no matching
+     * PATH_RESPONSE has been received by path_validation_deadline.
+     */
+    uint64_t                        path_challenge_data;
+    OSSL_TIME                       path_challenge_resend_time;
+    OSSL_TIME                       path_validation_deadline;
+
+    /*
+     * Server only: The payload of a PATH_CHALLENGE frame received from an
+     * address other than cur_peer_addr, which is answered on that path once
+     * the packet containing it has been processed.
+     */
+    uint64_t                        probe_path_challenge_data;
+
+    /*
+     * The largest PN of any 1-RTT packet received so far. Used to ensure that
+     * only the highest-numbered packet triggers migration (RFC 9000 s. 9.3).
+     */
+    QUIC_PN                         rx_largest_1rtt_pn;
+
     /* Transport parameter values we send to our peer. */
     uint64_t                        tx_init_max_stream_data_bidi_local;
     uint64_t                        tx_init_max_stream_data_bidi_remote;
@@ -294,6 +357,11 @@ struct quic_channel_st {
     unsigned int                    got_remote_transport_params    : 1;
     /* We have generated our local transport parameters. */
     unsigned int                    got_local_transport_params     : 1;
+    /*
+     * We have applied peer transport parameters remembered from a previous
+     * connection so that 0-RTT data can be sent (clients only).
+     */
+    unsigned int                    got_remembered_transport_params : 1;
 
     /*
      * This monotonically transitions to 1 once the TLS state machine is
@@ -362,6 +430,11 @@ struct quic_channel_st {
     unsigned int                    did_tls_tick            : 1;
     /* Has any CRYPTO frame been processed during this tick? */
     unsigned int                    did_crypto_frame        : 1;
+    /*
+     * Did the packet just processed contain a non-probing frame (RFC 9000 s.
+     * 9.1)?
+     */
+    unsigned int                    did_non_probing_frame   : 1;
 
     /*
      * Have we sent an ack-eliciting packet since the last successful packet
@@ -434,9 +507,37 @@ struct quic_channel_st {
     /* Are we on the QUIC_PORT linked list of channels? */
     unsigned int                    on_port_list                        : 1;
 
+    /* Are we registered with the QUIC_ENGINE tick scheduler? */
+    unsigned int                    on_engine                           : 1;
+
+    /* Are we on the QUIC_ENGINE list of channels to tick? */
+    unsigned int                    on_engine_tick_list                 : 1;
+
+    /* Did our last tick want to read from or write to the network? */
+    unsigned int                    net_read_desired                    : 1;
+    unsigned int                    net_write_desired                   : 1;
+
     /* Has qlog been requested? */
     unsigned int                    use_qlog                            : 1;
 
+    /* Is spare_remote_dcid valid? */
+    unsigned int                    have_spare_remote_dcid              : 1;
+
+    /* Is rx_largest_1rtt_pn valid? */
+    unsigned int                    have_rx_1rtt_pn                     : 1;
+
+    /* Are we waiting for a PATH_RESPONSE to our PATH_CHALLENGE? */
+    unsigned int                    path_validation_in_progress         : 1;
+
+    /* Is probe_path_challenge_data waiting to be answered? */
+    unsigned int                    have_probe_path_challenge           : 1;
+
+    /*
+     * Server only: Do we need to issue NEW_CONNECTION_ID frames to bring the
+     * number of LCIDs available to the peer back up?
+     */
+    unsigned int                    need_new_local_cids                 : 1;
+
     /* Saved error stack in case permanent error was encountered */
     ERR_STATE                       *err_state;
 
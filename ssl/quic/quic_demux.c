@@ -9,6 +9,7 @@
 
 #include "internal/quic_demux.h"
 #include "internal/quic_wire_pkt.h"
+#include "internal/quic_buf_pool.h"
 #include "internal/common.h"
 #include <openssl/lhash.h>
 #include <openssl/err.h>
@@ -64,6 +65,13 @@ struct quic_demux_st {
      */
     QUIC_URXE_LIST              urx_pending;
 
+    /*
+     * Optional pool URXEs are allocated from. Only DEMUX_MAX_MSGS_PER_CALL
+     * URXEs are kept on the free list when a pool is in use; the rest are
+     * returned to the pool so they can be used elsewhere.
+     */
+    QUIC_BUF_POOL              *buf_pool;
+
     /* Whether to use local address support. */
     char                        use_local_addr;
 };
@@ -94,14 +102,14 @@ QUIC_DEMUX *ossl_quic_demux_new(BIO *net_bio,
     return demux;
 }
 
-static void demux_free_urxl(QUIC_URXE_LIST *l)
+static void demux_free_urxl(QUIC_DEMUX *demux, QUIC_URXE_LIST *l)
 {
     QUIC_URXE *e, *enext;
 
     for (e = ossl_list_urxe_head(l); e != NULL; e = enext) {
         enext = ossl_list_urxe_next(e);
         ossl_list_urxe_remove(l, e);
-        OPENSSL_free(e);
+        ossl_quic_buf_pool_release(demux->buf_pool, e);
     }
 }
 
@@ -111,8 +119,8 @@ void ossl_quic_demux_free(QUIC_DEMUX *demux)
         return;
 
     /* Free all URXEs we are holding. */
-    demux_free_urxl(&demux->urx_free);
-    demux_free_urxl(&demux->urx_pending);
+    demux_free_urxl(demux, &demux->urx_free);
+    demux_free_urxl(demux, &demux->urx_pending);
 
     OPENSSL_free(demux);
 }
@@ -144,6 +152,14 @@ int ossl_quic_demux_set_mtu(QUIC_DEMUX *demux, unsigned int mtu)
     return 1;
 }
 
+void ossl_quic_demux_set_buf_pool(QUIC_DEMUX *demux, QUIC_BUF_POOL *pool)
+{
+    assert(ossl_list_urxe_num(&demux->urx_free) == 0
+           && ossl_list_urxe_num(&demux->urx_pending) == 0);
+
+    demux->buf_pool = pool;
+}
+
 void ossl_quic_demux_set_default_handler(QUIC_DEMUX *demux,
                                          ossl_quic_demux_cb_fn *cb,
                                          void *cb_arg)
@@ -152,14 +168,15 @@ void ossl_quic_demux_set_default_handler(QUIC_DEMUX *demux,
     demux->default_cb_arg   = cb_arg;
 }
 
-static QUIC_URXE *demux_alloc_urxe(size_t alloc_len)
+static QUIC_URXE *demux_alloc_urxe(QUIC_DEMUX *demux, size_t alloc_len)
 {
     QUIC_URXE *e;
 
     if (alloc_len >= SIZE_MAX - sizeof(QUIC_URXE))
         return NULL;
 
-    e = OPENSSL_malloc(sizeof(QUIC_URXE) + alloc_len);
+    e = ossl_quic_buf_pool_alloc(demux->buf_pool,
+                                 sizeof(QUIC_URXE) + alloc_len);
     if (e == NULL)
         return NULL;
 
@@ -181,7 +198,9 @@ static QUIC_URXE *demux_resize_urxe(QUIC_DEMUX *demux, QUIC_URXE *e,
     prev = ossl_list_urxe_prev(e);
     ossl_list_urxe_remove(&demux->urx_free, e);
 
-    e2 = OPENSSL_realloc(e, sizeof(QUIC_URXE) + new_alloc_len);
+    e2 = ossl_quic_buf_pool_realloc(demux->buf_pool, e,
+                                    sizeof(QUIC_URXE) + e->alloc_len,
+                                    sizeof(QUIC_URXE) + new_alloc_len);
     if (e2 == NULL) {
         /* Failed to resize, abort. */
         if (prev == NULL)
@@ -207,12 +226,25 @@ static QUIC_URXE *demux_reserve_urxe(QUIC_DEMUX *demux, QUIC_URXE *e,
     return e->alloc_len < alloc_len ? demux_resize_urxe(demux, e, alloc_len) : e;
 }
 
+/* Return a URXE which is not on any list to the free list or the pool. */
+static void demux_free_urxe(QUIC_DEMUX *demux, QUIC_URXE *e)
+{
+    if (demux->buf_pool != NULL
+        && ossl_list_urxe_num(&demux->urx_free) >= DEMUX_MAX_MSGS_PER_CALL) {
+        ossl_quic_buf_pool_release(demux->buf_pool, e);
+        return;
+    }
+
+    ossl_list_urxe_insert_tail(&demux->urx_free, e);
+    e->demux_state = URXE_DEMUX_STATE_FREE;
+}
+
 static int demux_ensure_free_urxe(QUIC_DEMUX *demux, size_t min_num_free)
 {
     QUIC_URXE *e;
 
     while (ossl_list_urxe_num(&demux->urx_free) < min_num_free) {
-        e = demux_alloc_urxe(demux->mtu);
+        e = demux_alloc_urxe(demux, demux->mtu);
         if (e == NULL)
             return 0;
 
@@ -353,8 +385,7 @@ static int demux_process_pending_urxe(QUIC_DEMUX *demux, QUIC_URXE *e)
                           dst_conn_id_ok ? &dst_conn_id : NULL);
     } else {
         /* Discard. */
-        ossl_list_urxe_insert_tail(&demux->urx_free, e);
-        e->demux_state = URXE_DEMUX_STATE_FREE;
+        demux_free_urxe(demux, e);
     }
 
     return 1; /* keep processing pending URXEs */
@@ -454,8 +485,7 @@ void ossl_quic_demux_release_urxe(QUIC_DEMUX *demux,
 {
     assert(ossl_list_urxe_prev(e) == NULL && ossl_list_urxe_next(e) == NULL);
     assert(e->demux_state == URXE_DEMUX_STATE_ISSUED);
-    ossl_list_urxe_insert_tail(&demux->urx_free, e);
-    e->demux_state = URXE_DEMUX_STATE_FREE;
+    demux_free_urxe(demux, e);
 }
 
 void ossl_quic_demux_reinject_urxe(QUIC_DEMUX *demux,
@@ -11,6 +11,7 @@
 #include "internal/quic_port.h"
 #include "quic_engine_local.h"
 #include "quic_port_local.h"
+#include "quic_channel_local.h"
 #include "../ssl_local.h"
 
 /*
@@ -20,8 +21,10 @@
 static int qeng_init(QUIC_ENGINE *qeng);
 static void qeng_cleanup(QUIC_ENGINE *qeng);
 static void qeng_tick(QUIC_TICK_RESULT *res, void *arg, uint32_t flags);
+static int qeng_ch_deadline_cmp(const QUIC_CHANNEL *a, const QUIC_CHANNEL *b);
 
 DEFINE_LIST_OF_IMPL(port, QUIC_PORT);
+DEFINE_LIST_OF_IMPL(ch_tick, QUIC_CHANNEL);
 
 QUIC_ENGINE *ossl_quic_engine_new(const QUIC_ENGINE_ARGS *args)
 {
@@ -53,8 +56,22 @@ void ossl_quic_engine_free(QUIC_ENGINE *qeng)
     OPENSSL_free(qeng);
 }
 
+/* How often the datagram buffer pool is trimmed. */
+#define QENG_BUF_POOL_TRIM_PERIOD   ossl_seconds2time(5)
+
 static int qeng_init(QUIC_ENGINE *qeng)
 {
+    if ((qeng->ch_deadline_pq
+            = ossl_pqueue_QUIC_CHANNEL_new(qeng_ch_deadline_cmp)) == NULL)
+        return 0;
+
+    if ((qeng->buf_pool
+            = ossl_quic_buf_pool_new(QUIC_BUF_POOL_DEFAULT_BUF_LEN)) == NULL) {
+        ossl_pqueue_QUIC_CHANNEL_free(qeng->ch_deadline_pq);
+        qeng->ch_deadline_pq = NULL;
+        return 0;
+    }
+
     ossl_quic_reactor_init(&qeng->rtor, qeng_tick, qeng, ossl_time_zero());
     return 1;
 }
@@ -62,6 +79,13 @@ static int qeng_init(QUIC_ENGINE *qeng)
 static void qeng_cleanup(QUIC_ENGINE *qeng)
 {
     assert(ossl_list_port_num(&qeng->port_list) == 0);
+    assert(ossl_list_ch_tick_num(&qeng->ch_tick_list) == 0);
+
+    ossl_pqueue_QUIC_CHANNEL_free(qeng->ch_deadline_pq);
+    qeng->ch_deadline_pq = NULL;
+
+    ossl_quic_buf_pool_free(qeng->buf_pool);
+    qeng->buf_pool = NULL;
 }
 
 QUIC_REACTOR *ossl_quic_engine_get0_reactor(QUIC_ENGINE *qeng)
@@ -69,6 +93,11 @@ QUIC_REACTOR *ossl_quic_engine_get0_reactor(QUIC_ENGINE *qeng)
     return &qeng->rtor;
 }
 
+QUIC_BUF_POOL *ossl_quic_engine_get0_buf_pool(QUIC_ENGINE *qeng)
+{
+    return qeng->buf_pool;
+}
+
 CRYPTO_MUTEX *ossl_quic_engine_get0_mutex(QUIC_ENGINE *qeng)
 {
     return qeng->mutex;
@@ -108,6 +137,108 @@ QUIC_PORT *ossl_quic_engine_create_port(QUIC_ENGINE *qeng,
     return ossl_quic_port_new(&largs);
 }
 
+/*
+ * QUIC Engine: Channel Tick Scheduling
+ * ====================================
+ *
+ * Rather than ticking every channel on every engine tick, the engine only ticks
+ * those channels which need it: channels whose tick deadline has expired, and
+ * channels which have been explicitly scheduled (e.g. because datagrams have
+ * been routed to them, or because the application has acted on them).
+ */
+static int qeng_ch_deadline_cmp(const QUIC_CHANNEL *a, const QUIC_CHANNEL *b)
+{
+    return ossl_time_compare(a->tick_deadline, b->tick_deadline);
+}
+
+static void qeng_ch_deadline_remove(QUIC_ENGINE *qeng, QUIC_CHANNEL *ch)
+{
+    if (ch->tick_pq_idx == SIZE_MAX)
+        return;
+
+    ossl_pqueue_QUIC_CHANNEL_remove(qeng->ch_deadline_pq, ch->tick_pq_idx);
+    ch->tick_pq_idx = SIZE_MAX;
+}
+
+static void qeng_set_ch_net_desired(QUIC_ENGINE *qeng, QUIC_CHANNEL *ch,
+                                    int net_read_desired,
+                                    int net_write_desired)
+{
+    qeng->num_ch_net_read_desired  -= ch->net_read_desired;
+    qeng->num_ch_net_write_desired -= ch->net_write_desired;
+
+    ch->net_read_desired  = (net_read_desired != 0);
+    ch->net_write_desired = (net_write_desired != 0);
+
+    qeng->num_ch_net_read_desired  += ch->net_read_desired;
+    qeng->num_ch_net_write_desired += ch->net_write_desired;
+}
+
+void ossl_quic_engine_add_channel(QUIC_ENGINE *qeng, QUIC_CHANNEL *ch)
+{
+    if (!ossl_assert(!ch->on_engine))
+        return;
+
+    ossl_list_ch_tick_init_elem(ch);
+    ch->tick_pq_idx         = SIZE_MAX;
+    ch->tick_deadline       = ossl_time_infinite();
+    ch->on_engine           = 1;
+    ch->on_engine_tick_list = 0;
+    ch->net_read_desired    = 0;
+    ch->net_write_desired   = 0;
+
+    ossl_quic_engine_schedule_channel(qeng, ch);
+}
+
+void ossl_quic_engine_remove_channel(QUIC_ENGINE *qeng, QUIC_CHANNEL *ch)
+{
+    if (!ch->on_engine)
+        return;
+
+    if (ch->on_engine_tick_list) {
+        ossl_list_ch_tick_remove(&qeng->ch_tick_list, ch);
+        ch->on_engine_tick_list = 0;
+    }
+
+    qeng_ch_deadline_remove(qeng, ch);
+    qeng_set_ch_net_desired(qeng, ch, 0, 0);
+    ch->on_engine = 0;
+}
+
+void ossl_quic_engine_schedule_channel(QUIC_ENGINE *qeng, QUIC_CHANNEL *ch)
+{
+    if (!ch->on_engine || ch->on_engine_tick_list)
+        return;
+
+    ossl_list_ch_tick_insert_tail(&qeng->ch_tick_list, ch);
+    ch->on_engine_tick_list = 1;
+}
+
+/* Called after a channel has been ticked to record the result. */
+static void qeng_on_ch_ticked(QUIC_ENGINE *qeng, QUIC_CHANNEL *ch,
+                              const QUIC_TICK_RESULT *subr)
+{
+    qeng_set_ch_net_desired(qeng, ch, subr->net_read_desired,
+                            subr->net_write_desired);
+
+    qeng_ch_deadline_remove(qeng, ch);
+    ch->tick_deadline = subr->tick_deadline;
+    if (!ossl_time_is_infinite(ch->tick_deadline)
+        && !ossl_pqueue_QUIC_CHANNEL_push(qeng->ch_deadline_pq, ch,
+                                          &ch->tick_pq_idx)) {
+        /* Allocation failure; fall back to ticking the channel every time. */
+        ch->tick_pq_idx = SIZE_MAX;
+        ossl_quic_engine_schedule_channel(qeng, ch);
+    }
+
+    /*
+     * A channel which has datagrams queued which it could not yet send must be
+     * ticked again once the network becomes writeable.
+     */
+    if (ch->net_write_desired)
+        ossl_quic_engine_schedule_channel(qeng, ch);
+}
+
 /*
  * QUIC Engine: Ticker-Mutator
  * ==========================
@@ -122,6 +253,8 @@ static void qeng_tick(QUIC_TICK_RESULT *res, void *arg, uint32_t flags)
 {
     QUIC_ENGINE *qeng = arg;
     QUIC_PORT *port;
+    QUIC_CHANNEL *ch, *last;
+    OSSL_TIME now;
 
     res->net_read_desired   = 0;
     res->net_write_desired  = 0;
@@ -130,11 +263,64 @@ static void qeng_tick(QUIC_TICK_RESULT *res, void *arg, uint32_t flags)
     if (qeng->inhibit_tick)
         return;
 
-    /* Iterate through all ports and service them. */
+    /*
+     * Iterate through all ports and service them. This routes any incoming
+     * datagrams to the channels they are destined for and schedules those
+     * channels.
+     */
     OSSL_LIST_FOREACH(port, port, &qeng->port_list) {
         QUIC_TICK_RESULT subr = {0};
 
         ossl_quic_port_subtick(port, &subr, flags);
         ossl_quic_tick_result_merge_into(res, &subr);
     }
+
+    /* Schedule all channels whose tick deadline has expired. */
+    now = ossl_quic_engine_get_time(qeng);
+    while ((ch = ossl_pqueue_QUIC_CHANNEL_peek(qeng->ch_deadline_pq)) != NULL
+           && ossl_time_compare(ch->tick_deadline, now) <= 0) {
+        qeng_ch_deadline_remove(qeng, ch);
+        ossl_quic_engine_schedule_channel(qeng, ch);
+    }
+
+    /*
+     * Service all scheduled channels. Channels which get scheduled again while
+     * we do this are added after the current tail of the list and are serviced
+     * on the next tick.
+     */
+    last = ossl_list_ch_tick_tail(&qeng->ch_tick_list);
+    while (last != NULL
+           && (ch = ossl_list_ch_tick_head(&qeng->ch_tick_list)) != NULL) {
+        QUIC_TICK_RESULT subr = {0};
+
+        ossl_list_ch_tick_remove(&qeng->ch_tick_list, ch);
+        ch->on_engine_tick_list = 0;
+
+        ossl_quic_channel_subtick(ch, &subr, flags);
+        qeng_on_ch_ticked(qeng, ch, &subr);
+
+        if (ch == last)
+            break;
+    }
+
+    res->net_read_desired  |= (qeng->num_ch_net_read_desired > 0);
+    res->net_write_desired |= (qeng->num_ch_net_write_desired > 0);
+
+    if ((ch = ossl_pqueue_QUIC_CHANNEL_peek(qeng->ch_deadline_pq)) != NULL)
+        res->tick_deadline = ossl_time_min(res->tick_deadline,
+                                           ch->tick_deadline);
+
+    /* Channels still scheduled want to be serviced again straight away. */
+    if (!ossl_list_ch_tick_is_empty(&qeng->ch_tick_list))
+        res->tick_deadline = ossl_time_zero();
+
+    /*
+     * Periodically release pooled datagram buffers which were not needed
+     * recently. This is opportunistic and does not affect our tick deadline.
+     */
+    if (ossl_time_compare(now, qeng->buf_pool_trim_time) >= 0) {
+        ossl_quic_buf_pool_trim(qeng->buf_pool);
+        qeng->buf_pool_trim_time = ossl_time_add(now,
+                                                 QENG_BUF_POOL_TRIM_PERIOD);
+    }
 }
@@ -12,6 +12,8 @@
 
 # include "internal/quic_engine.h"
 # include "internal/quic_reactor.h"
+# include "internal/priority_queue.h"
+# include "internal/quic_buf_pool.h"
 
 # ifndef OPENSSL_NO_QUIC
 
@@ -26,6 +28,8 @@
  * Other components should not include this header.
  */
 DECLARE_LIST_OF(port, QUIC_PORT);
+DECLARE_LIST_OF(ch_tick, QUIC_CHANNEL);
+DEFINE_PRIORITY_QUEUE_OF(QUIC_CHANNEL);
 
 struct quic_engine_st {
     /* All objects in a QUIC event domain share the same (libctx, propq). */
@@ -50,10 +54,55 @@ struct quic_engine_st {
     /* List of all child ports. */
     OSSL_LIST(port)                 port_list;
 
+    /*
+     * Datagram buffer pool shared by the DEMUX and QTX instances of all child
+     * ports and channels, and the time at which it is next trimmed.
+     */
+    QUIC_BUF_POOL                   *buf_pool;
+    OSSL_TIME                       buf_pool_trim_time;
+
+    /*
+     * Channels which must be ticked on the next engine tick regardless of
+     * their tick deadline; for example, because datagrams have been routed to
+     * them or because the application has acted on them.
+     */
+    OSSL_LIST(ch_tick)              ch_tick_list;
+
+    /*
+     * All channels with a finite tick deadline, ordered by that deadline. This
+     * covers every timer a channel has (loss detection, ACK delay, idle,
+     * keepalive, etc.) as a channel's tick deadline is the earliest of them.
+     * The engine's own tick deadline is therefore found in O(1) and only those
+     * channels whose deadline has expired are ticked.
+     */
+    PRIORITY_QUEUE_OF(QUIC_CHANNEL) *ch_deadline_pq;
+
+    /*
+     * The number of channels which, as of their last tick, wanted to read
+     * from or write to the network.
+     */
+    size_t                          num_ch_net_read_desired;
+    size_t                          num_ch_net_write_desired;
+
     /* Inhibit tick for testing purposes? */
     unsigned int                    inhibit_tick                    : 1;
 };
 
+/*
+ * Registers a channel with the engine's tick scheduler. The channel is ticked
+ * on the next engine tick.
+ */
+void ossl_quic_engine_add_channel(QUIC_ENGINE *qeng, QUIC_CHANNEL *ch);
+
+/* Unregisters a channel from the engine's tick scheduler. */
+void ossl_quic_engine_remove_channel(QUIC_ENGINE *qeng, QUIC_CHANNEL *ch);
+
+/*
+ * Requests that a channel be ticked on the next engine tick regardless of its
+ * tick deadline. Idempotent.
+ */
+void ossl_quic_engine_schedule_channel(QUIC_ENGINE *qeng, QUIC_CHANNEL *ch);
+
 # endif
 
 #endif
@@ -46,6 +46,13 @@ int ossl_quic_txfc_bump_cwm(QUIC_TXFC *txfc, uint64_t cwm)
     return 1;
 }
 
+void ossl_quic_txfc_reset(QUIC_TXFC *txfc)
+{
+    txfc->swm                   = 0;
+    txfc->cwm                   = 0;
+    txfc->has_become_blocked    = 0;
+}
+
 uint64_t ossl_quic_txfc_get_credit_local(QUIC_TXFC *txfc, uint64_t consumed)
 {
     assert((txfc->swm + consumed) <= txfc->cwm);
@@ -30,6 +30,7 @@ static void quic_lock(QUIC_CONNECTION *qc);
 static void quic_unlock(QUIC_CONNECTION *qc);
 static void quic_lock_for_io(QCTX *ctx);
 static int quic_do_handshake(QCTX *ctx);
+static int quic_do_handshake_ex(QCTX *ctx, int allow_early);
 static void qc_update_reject_policy(QUIC_CONNECTION *qc);
 static void qc_touch_default_xso(QUIC_CONNECTION *qc);
 static void qc_set_default_xso(QUIC_CONNECTION *qc, QUIC_XSO *xso, int touch);
@@ -48,6 +49,43 @@ static int qctx_should_autotick(QCTX *ctx);
  * ========================================
  */
 
+/*
+ * Tick the engine on behalf of the application. The engine only ticks channels
+ * which need it, so the channel is explicitly scheduled first to ensure that
+ * any state changes made by the calling API function are acted on.
+ *
+ * Precondition: Must have a channel.
+ * Precondition: Must hold channel lock (unchecked).
+ */
+QUIC_NEEDS_LOCK
+static void qc_tick(QUIC_CONNECTION *qc)
+{
+    ossl_quic_channel_schedule_tick(qc->ch);
+    ossl_quic_reactor_tick(ossl_quic_channel_get_reactor(qc->ch), 0);
+}
+
+struct block_pred_args {
+    QUIC_CONNECTION *qc;
+    int             (*pred)(void *arg);
+    void            *pred_arg;
+};
+
+/*
+ * Blocking predicates may change channel state (e.g. by appending more data to
+ * a stream), so ensure the channel is ticked before the predicate is evaluated
+ * again.
+ */
+static int block_pred(void *arg)
+{
+    struct block_pred_args *args = arg;
+    int res;
+
+    if ((res = args->pred(args->pred_arg)) == 0)
+        ossl_quic_channel_schedule_tick(args->qc->ch);
+
+    return res;
+}
+
 /*
  * Block until a predicate is met.
  *
@@ -60,6 +98,7 @@ static int block_until_pred(QUIC_CONNECTION *qc,
                             uint32_t flags)
 {
     QUIC_REACTOR *rtor;
+    struct block_pred_args args;
 
     assert(qc->ch != NULL);
 
@@ -69,8 +108,13 @@ static int block_until_pred(QUIC_CONNECTION *qc,
      */
     ossl_quic_engine_set_inhibit_tick(qc->engine, 0);
 
+    args.qc         = qc;
+    args.pred       = pred;
+    args.pred_arg   = pred_arg;
+
+    ossl_quic_channel_schedule_tick(qc->ch);
     rtor = ossl_quic_channel_get_reactor(qc->ch);
-    return ossl_quic_reactor_block_until_pred(rtor, pred, pred_arg, flags,
+    return ossl_quic_reactor_block_until_pred(rtor, block_pred, &args, flags,
                                               qc->mutex);
 }
 
@@ -259,8 +303,12 @@ static int ossl_unused expect_quic_with_stream_lock(const SSL *s, int remote_ini
             goto err;
         }
 
-        /* If we haven't finished the handshake, try to advance it. */
-        if (quic_do_handshake(ctx) < 1)
+        /*
+         * If we haven't finished the handshake, try to advance it. A default
+         * stream used for writing may be created as soon as 0-RTT data can be
+         * sent.
+         */
+        if (quic_do_handshake_ex(ctx, /*allow_early=*/remote_init == 0) < 1)
             /* ossl_quic_do_handshake raised error here */
             goto err;
 
@@ -304,7 +352,9 @@ static int ossl_unused expect_quic_conn_only(const SSL *s, QCTX *ctx)
 
 /*
  * Ensures that the channel mutex is held for a method which touches channel
- * state.
+ * state. As such a method may change channel state in a way which requires the
+ * channel to do work, the channel is also scheduled to be ticked on the next
+ * engine tick.
  *
  * Precondition: Channel mutex is not held (unchecked)
  */
@@ -313,6 +363,9 @@ static void quic_lock(QUIC_CONNECTION *qc)
 #if defined(OPENSSL_THREADS)
     ossl_crypto_mutex_lock(qc->mutex);
 #endif
+
+    if (qc->ch != NULL)
+        ossl_quic_channel_schedule_tick(qc->ch);
 }
 
 static void quic_lock_for_io(QCTX *ctx)
@@ -902,6 +955,7 @@ void ossl_quic_conn_set0_net_rbio(SSL *s, BIO *net_rbio)
 void ossl_quic_conn_set0_net_wbio(SSL *s, BIO *net_wbio)
 {
     QCTX ctx;
+    int is_replacement;
 
     if (!expect_quic(s, &ctx))
         return;
@@ -912,12 +966,25 @@ void ossl_quic_conn_set0_net_wbio(SSL *s, BIO *net_wbio)
     if (!ossl_quic_port_set_net_wbio(ctx.qc->port, net_wbio))
         return;
 
+    is_replacement = (ctx.qc->net_wbio != NULL && net_wbio != NULL);
     BIO_free_all(ctx.qc->net_wbio);
     ctx.qc->net_wbio = net_wbio;
 
     if (net_wbio != NULL)
         BIO_set_nbio(net_wbio, 1); /* best effort autoconfig */
 
+    /*
+     * Replacing the network write BIO of an established connection means we
+     * are now sending from a different local address. Treat this as an active
+     * connection migration (RFC 9000 s. 9.2).
+     */
+    if (is_replacement && !ctx.qc->as_server) {
+        quic_lock(ctx.qc);
+        if (ossl_quic_channel_is_handshake_confirmed(ctx.qc->ch))
+            ossl_quic_channel_migrate(ctx.qc->ch); /* best effort */
+        quic_unlock(ctx.qc);
+    }
+
     /*
      * Determine if the current pair of read/write BIOs now set allows blocking
      * mode to be supported.
@@ -1066,7 +1133,7 @@ int ossl_quic_handle_events(SSL *s)
 
     quic_lock(ctx.qc);
     if (ctx.qc->started)
-        ossl_quic_reactor_tick(ossl_quic_channel_get_reactor(ctx.qc->ch), 0);
+        qc_tick(ctx.qc);
     quic_unlock(ctx.qc);
     return 1;
 }
@@ -1454,6 +1521,7 @@ void ossl_quic_set_accept_state(SSL *s)
 /* SSL_do_handshake */
 struct quic_handshake_wait_args {
     QUIC_CONNECTION     *qc;
+    int                 allow_early;
 };
 
 static int tls_wants_non_io_retry(QUIC_CONNECTION *qc)
@@ -1478,6 +1546,9 @@ static int quic_handshake_wait(void *arg)
     if (ossl_quic_channel_is_handshake_complete(args->qc->ch))
         return 1;
 
+    if (args->allow_early && ossl_quic_channel_can_send_early_data(args->qc->ch))
+        return 1;
+
     if (tls_wants_non_io_retry(args->qc))
         return 1;
 
@@ -1571,8 +1642,13 @@ static int ensure_channel_started(QCTX *ctx)
     return 1;
 }
 
+/*
+ * Advances the handshake. If allow_early is set, returns success as soon as the
+ * client is able to send 0-RTT data, which is the case only if 0-RTT has been
+ * enabled via SSL_VALUE_QUIC_EARLY_DATA and a suitable session was resumed.
+ */
 QUIC_NEEDS_LOCK
-static int quic_do_handshake(QCTX *ctx)
+static int quic_do_handshake_ex(QCTX *ctx, int allow_early)
 {
     int ret;
     QUIC_CONNECTION *qc = ctx->qc;
@@ -1581,6 +1657,11 @@ static int quic_do_handshake(QCTX *ctx)
         /* Handshake already completed. */
         return 1;
 
+    if (allow_early && qc->started
+        && ossl_quic_channel_can_send_early_data(qc->ch))
+        /* 0-RTT data can be sent already. */
+        return 1;
+
     if (!quic_mutation_allowed(qc, /*req_active=*/0))
         return QUIC_RAISE_NON_NORMAL_ERROR(ctx, SSL_R_PROTOCOL_IS_SHUTDOWN, NULL);
 
@@ -1676,16 +1757,18 @@ static int quic_do_handshake(QCTX *ctx)
     if (!ensure_channel_started(ctx)) /* raises on failure */
         return -1; /* Non-protocol error */
 
-    if (ossl_quic_channel_is_handshake_complete(qc->ch))
-        /* The handshake is now done. */
+    if (ossl_quic_channel_is_handshake_complete(qc->ch)
+        || (allow_early && ossl_quic_channel_can_send_early_data(qc->ch)))
+        /* The handshake is now done, or far enough along for 0-RTT. */
         return 1;
 
     if (!qc_blocking_mode(qc)) {
         /* Try to advance the reactor. */
         qctx_maybe_autotick(ctx);
 
-        if (ossl_quic_channel_is_handshake_complete(qc->ch))
-            /* The handshake is now done. */
+        if (ossl_quic_channel_is_handshake_complete(qc->ch)
+            || (allow_early && ossl_quic_channel_can_send_early_data(qc->ch)))
+            /* The handshake is now done, or far enough along for 0-RTT. */
             return 1;
 
         if (ossl_quic_channel_is_term_any(qc->ch)) {
@@ -1712,7 +1795,8 @@ static int quic_do_handshake(QCTX *ctx)
         /* In blocking mode, wait for the handshake to complete. */
         struct quic_handshake_wait_args args;
 
-        args.qc     = qc;
+        args.qc             = qc;
+        args.allow_early    = allow_early;
 
         ret = block_until_pred(qc, quic_handshake_wait, &args, 0);
         if (!quic_mutation_allowed(qc, /*req_active=*/1)) {
@@ -1728,7 +1812,9 @@ static int quic_do_handshake(QCTX *ctx)
             return -1;
         }
 
-        assert(ossl_quic_channel_is_handshake_complete(qc->ch));
+        assert(ossl_quic_channel_is_handshake_complete(qc->ch)
+               || (allow_early
+                   && ossl_quic_channel_can_send_early_data(qc->ch)));
         return 1;
     }
 
@@ -1745,6 +1831,12 @@ static int quic_do_handshake(QCTX *ctx)
     return -1; /* Non-protocol error */
 }
 
+QUIC_NEEDS_LOCK
+static int quic_do_handshake(QCTX *ctx)
+{
+    return quic_do_handshake_ex(ctx, /*allow_early=*/0);
+}
+
 QUIC_TAKES_LOCK
 int ossl_quic_do_handshake(SSL *s)
 {
@@ -2199,7 +2291,7 @@ static void quic_post_write(QUIC_XSO *xso, int did_append,
      * immediately, plus we should eventually consider Nagle's algorithm.
      */
     if (do_tick)
-        ossl_quic_reactor_tick(ossl_quic_channel_get_reactor(xso->conn->ch), 0);
+        qc_tick(xso->conn);
 }
 
 struct quic_write_again_args {
@@ -2560,9 +2652,10 @@ int ossl_quic_write_flags(SSL *s, const void *buf, size_t len,
 
     /*
      * If we haven't finished the handshake, try to advance it.
-     * We don't accept writes until the handshake is completed.
+     * We don't accept writes until the handshake is completed, unless 0-RTT
+     * data can be sent.
      */
-    if (quic_do_handshake(&ctx) < 1) {
+    if (quic_do_handshake_ex(&ctx, /*allow_early=*/1) < 1) {
         ret = 0;
         goto out;
     }
@@ -3347,7 +3440,7 @@ static void qctx_maybe_autotick(QCTX *ctx)
     if (!qctx_should_autotick(ctx))
         return;
 
-    ossl_quic_reactor_tick(ossl_quic_channel_get_reactor(ctx->qc->ch), 0);
+    qc_tick(ctx->qc);
 }
 
 QUIC_TAKES_LOCK
@@ -3434,6 +3527,53 @@ err:
     return ret;
 }
 
+QUIC_TAKES_LOCK
+static int qc_getset_early_data(QCTX *ctx, uint32_t class_,
+                                uint64_t *p_value_out,
+                                uint64_t *p_value_in)
+{
+    int ret = 0;
+    uint64_t value_out = 0;
+
+    quic_lock(ctx->qc);
+
+    if (class_ != SSL_VALUE_CLASS_GENERIC) {
+        QUIC_RAISE_NON_NORMAL_ERROR(ctx, SSL_R_UNSUPPORTED_CONFIG_VALUE_CLASS,
+                                    NULL);
+        goto err;
+    }
+
+    if (p_value_in != NULL) {
+        if (*p_value_in > 1) {
+            QUIC_RAISE_NON_NORMAL_ERROR(ctx, ERR_R_PASSED_INVALID_ARGUMENT,
+                                        NULL);
+            goto err;
+        }
+
+        /* Whether to attempt 0-RTT is decided when the handshake starts. */
+        if (ctx->qc->started) {
+            QUIC_RAISE_NON_NORMAL_ERROR(ctx, SSL_R_FEATURE_NOT_RENEGOTIABLE,
+                                        NULL);
+            goto err;
+        }
+
+        value_out = *p_value_in;
+        ctx->qc->early_data = (value_out != 0);
+        ossl_quic_channel_set_early_data_enabled(ctx->qc->ch,
+                                                 ctx->qc->early_data);
+    } else {
+        value_out = ctx->qc->early_data;
+    }
+
+    ret = 1;
+err:
+    quic_unlock(ctx->qc);
+    if (ret && p_value_out != NULL)
+        *p_value_out = value_out;
+
+    return ret;
+}
+
 QUIC_NEEDS_LOCK
 static int expect_quic_for_value(SSL *s, QCTX *ctx, uint32_t id)
 {
@@ -3477,6 +3617,9 @@ int ossl_quic_get_value_uint(SSL *s, uint32_t class_, uint32_t id,
     case SSL_VALUE_EVENT_HANDLING_MODE:
         return qc_getset_event_handling(&ctx, class_, value, NULL);
 
+    case SSL_VALUE_QUIC_EARLY_DATA:
+        return qc_getset_early_data(&ctx, class_, value, NULL);
+
     case SSL_VALUE_STREAM_WRITE_BUF_SIZE:
         return qc_get_stream_write_buf_stat(&ctx, class_, value,
                                             ossl_quic_sstream_get_buffer_size);
@@ -3511,6 +3654,9 @@ int ossl_quic_set_value_uint(SSL *s, uint32_t class_, uint32_t id,
     case SSL_VALUE_EVENT_HANDLING_MODE:
         return qc_getset_event_handling(&ctx, class_, NULL, &value);
 
+    case SSL_VALUE_QUIC_EARLY_DATA:
+        return qc_getset_early_data(&ctx, class_, NULL, &value);
+
     default:
         return QUIC_RAISE_NON_NORMAL_ERROR(&ctx,
                                            SSL_R_UNSUPPORTED_CONFIG_VALUE, NULL);
@@ -4125,7 +4271,7 @@ int ossl_quic_conn_poll_events(SSL *ssl, uint64_t events, int do_tick,
     }
 
     if (do_tick)
-        ossl_quic_reactor_tick(ossl_quic_channel_get_reactor(ctx.qc->ch), 0);
+        qc_tick(ctx.qc);
 
     if (ctx.xso != NULL) {
         /* SSL object has a stream component. */
@@ -217,6 +217,9 @@ struct quic_conn_st {
     /* Have we probed the BIOs for addressing support? */
     unsigned int                    addressing_probe_done   : 1;
 
+    /* Should we attempt to send 0-RTT data? (SSL_VALUE_QUIC_EARLY_DATA) */
+    unsigned int                    early_data              : 1;
+
     /* Are we using addressed mode (BIO_sendmmsg with non-NULL peer)? */
     unsigned int                    addressed_mode_w        : 1;
     unsigned int                    addressed_mode_r        : 1;
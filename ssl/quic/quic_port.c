@@ -75,6 +75,7 @@ static int port_init(QUIC_PORT *port)
                                            get_time, port)) == NULL)
         goto err;
 
+    ossl_quic_demux_set_buf_pool(port->demux, port->engine->buf_pool);
     ossl_quic_demux_set_default_handler(port->demux,
                                         port_default_packet_handler,
                                         port);
@@ -356,13 +357,13 @@ QUIC_CHANNEL *ossl_quic_port_create_incoming(QUIC_PORT *port, SSL *tls)
 
 /*
  * Tick function for this port. This does everything related to network I/O for
- * this port's network BIOs, and services child channels.
+ * this port's network BIOs. Child channels are serviced by the engine, which
+ * only ticks those channels which have been routed incoming datagrams or whose
+ * tick deadline has expired.
  */
 void ossl_quic_port_subtick(QUIC_PORT *port, QUIC_TICK_RESULT *res,
                             uint32_t flags)
 {
-    QUIC_CHANNEL *ch;
-
     res->net_read_desired   = 0;
     res->net_write_desired  = 0;
     res->tick_deadline      = ossl_time_infinite();
@@ -371,14 +372,6 @@ void ossl_quic_port_subtick(QUIC_PORT *port, QUIC_TICK_RESULT *res,
         /* Handle any incoming data from network. */
         if (ossl_quic_port_is_running(port))
             port_rx_pre(port);
-
-        /* Iterate through all channels and service them. */
-        OSSL_LIST_FOREACH(ch, ch, &port->channel_list) {
-            QUIC_TICK_RESULT subr = {0};
-
-            ossl_quic_channel_subtick(ch, &subr, flags);
-            ossl_quic_tick_result_merge_into(res, &subr);
-        }
     }
 }
 
@@ -573,7 +566,7 @@ static void port_default_packet_handler(QUIC_URXE *e, void *arg,
     port_on_new_conn(port, &e->peer, &hdr.src_conn_id, &hdr.dst_conn_id,
                      &new_ch);
     if (new_ch != NULL)
-        ossl_qrx_inject_urxe(new_ch->qrx, e);
+        ossl_quic_channel_inject(new_ch, e);
 
     return;
 
@@ -501,10 +501,6 @@ static int qrx_validate_hdr_early(OSSL_QRX *qrx, RXE *rxe,
         && rxe->hdr.version != QUIC_VERSION_NONE)
         return 0;
 
-    /* Clients should never receive 0-RTT packets. */
-    if (rxe->hdr.type == QUIC_PKT_TYPE_0RTT)
-        return 0;
-
     /* Version negotiation and retry packets must be the first packet. */
     if (first_dcid != NULL && !ossl_quic_pkt_type_can_share_dgram(rxe->hdr.type))
         return 0;
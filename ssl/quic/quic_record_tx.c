@@ -13,6 +13,7 @@
 #include "internal/common.h"
 #include "quic_record_shared.h"
 #include "internal/list.h"
+#include "internal/quic_buf_pool.h"
 #include "../ssl_local.h"
 
 /*
@@ -68,6 +69,9 @@ struct ossl_qtx_st {
     /* TX maximum datagram payload length. */
     size_t                      mdpl;
 
+    /* Pool TXEs are allocated from, or NULL. */
+    QUIC_BUF_POOL              *buf_pool;
+
     /*
      * List of TXEs which are not currently in use. These are moved to the
      * pending list (possibly via tx_cons first) as they are filled.
@@ -127,17 +131,18 @@ OSSL_QTX *ossl_qtx_new(const OSSL_QTX_ARGS *args)
     qtx->mdpl               = args->mdpl;
     qtx->get_qlog_cb        = args->get_qlog_cb;
     qtx->get_qlog_cb_arg    = args->get_qlog_cb_arg;
+    qtx->buf_pool           = args->buf_pool;
 
     return qtx;
 }
 
-static void qtx_cleanup_txl(TXE_LIST *l)
+static void qtx_cleanup_txl(OSSL_QTX *qtx, TXE_LIST *l)
 {
     TXE *e, *enext;
 
     for (e = ossl_list_txe_head(l); e != NULL; e = enext) {
         enext = ossl_list_txe_next(e);
-        OPENSSL_free(e);
+        ossl_quic_buf_pool_release(qtx->buf_pool, e);
     }
 }
 
@@ -150,9 +155,9 @@ void ossl_qtx_free(OSSL_QTX *qtx)
         return;
 
     /* Free TXE queue data. */
-    qtx_cleanup_txl(&qtx->pending);
-    qtx_cleanup_txl(&qtx->free);
-    OPENSSL_free(qtx->cons);
+    qtx_cleanup_txl(qtx, &qtx->pending);
+    qtx_cleanup_txl(qtx, &qtx->free);
+    ossl_quic_buf_pool_release(qtx->buf_pool, qtx->cons);
 
     /* Drop keying material and crypto resources. */
     for (i = 0; i < QUIC_ENC_LEVEL_NUM; ++i)
@@ -214,14 +219,14 @@ int ossl_qtx_is_enc_level_provisioned(OSSL_QTX *qtx, uint32_t enc_level)
 }
 
 /* Allocate a new TXE. */
-static TXE *qtx_alloc_txe(size_t alloc_len)
+static TXE *qtx_alloc_txe(OSSL_QTX *qtx, size_t alloc_len)
 {
     TXE *txe;
 
     if (alloc_len >= SIZE_MAX - sizeof(TXE))
         return NULL;
 
-    txe = OPENSSL_malloc(sizeof(TXE) + alloc_len);
+    txe = ossl_quic_buf_pool_alloc(qtx->buf_pool, sizeof(TXE) + alloc_len);
     if (txe == NULL)
         return NULL;
 
@@ -246,7 +251,7 @@ static TXE *qtx_ensure_free_txe(OSSL_QTX *qtx, size_t alloc_len)
     if (txe != NULL)
         return txe;
 
-    txe = qtx_alloc_txe(alloc_len);
+    txe = qtx_alloc_txe(qtx, alloc_len);
     if (txe == NULL)
         return NULL;
 
@@ -278,7 +283,9 @@ static TXE *qtx_resize_txe(OSSL_QTX *qtx, TXE_LIST *txl, TXE *txe, size_t n)
      * NOTE: We do not clear old memory, although it does contain decrypted
      * data.
      */
-    txe2 = OPENSSL_realloc(txe, sizeof(TXE) + n);
+    txe2 = ossl_quic_buf_pool_realloc(qtx->buf_pool, txe,
+                                      sizeof(TXE) + txe->alloc_len,
+                                      sizeof(TXE) + n);
     if (txe2 == NULL || txe == txe2) {
         if (p == NULL)
             ossl_list_txe_insert_head(txl, txe);
@@ -312,6 +319,18 @@ static TXE *qtx_reserve_txe(OSSL_QTX *qtx, TXE_LIST *txl,
     return qtx_resize_txe(qtx, txl, txe, n);
 }
 
+/*
+ * Return a TXE not currently in any list to the free list, or to the pool if we
+ * have one.
+ */
+static void qtx_free_txe(OSSL_QTX *qtx, TXE *txe)
+{
+    if (qtx->buf_pool != NULL)
+        ossl_quic_buf_pool_release(qtx->buf_pool, txe);
+    else
+        ossl_list_txe_insert_tail(&qtx->free, txe);
+}
+
 /* Move a TXE from pending to free. */
 static void qtx_pending_to_free(OSSL_QTX *qtx)
 {
@@ -321,7 +340,7 @@ static void qtx_pending_to_free(OSSL_QTX *qtx)
     ossl_list_txe_remove(&qtx->pending, txe);
     --qtx->pending_count;
     qtx->pending_bytes -= txe->data_len;
-    ossl_list_txe_insert_tail(&qtx->free, txe);
+    qtx_free_txe(qtx, txe);
 }
 
 /* Add a TXE not currently in any list to the pending list. */
@@ -907,7 +926,7 @@ void ossl_qtx_finish_dgram(OSSL_QTX *qtx)
          * If we did not put anything in the datagram, just move it back to the
          * free list.
          */
-        ossl_list_txe_insert_tail(&qtx->free, txe);
+        qtx_free_txe(qtx, txe);
     else
         qtx_add_to_pending(qtx, txe);
 
@@ -910,11 +910,7 @@ static int depack_do_frame_retire_conn_id(PACKET *pkt,
      * frame as a connection error of type PROTOCOL_VIOLATION."
      *
      * Since we always use a zero-length SCID as a client, there is no case
-     * where it is valid for a server to send this. Our server support is
-     * currently non-conformant and for internal testing use; simply handle it
-     * as a no-op in this case.
-     *
-     * TODO(QUIC SERVER): Revise and implement correctly for server support.
+     * where it is valid for a server to send this.
      */
     if (!ch->is_server) {
         ossl_quic_channel_raise_protocol_error(ch,
@@ -924,6 +920,7 @@ static int depack_do_frame_retire_conn_id(PACKET *pkt,
         return 0;
     }
 
+    ossl_quic_channel_on_retire_conn_id(ch, seq_num);
     return 1;
 }
 
@@ -952,10 +949,13 @@ static int depack_do_frame_path_challenge(PACKET *pkt,
     /*
      * RFC 9000 s. 8.2.2: On receiving a PATH_CHALLENGE frame, an endpoint MUST
      * respond by echoing the data contained in the PATH_CHALLENGE frame in a
-     * PATH_RESPONSE frame.
-     *
-     * TODO(QUIC FUTURE): We should try to avoid allocation here in the future.
+     * PATH_RESPONSE frame. The response must be sent on the path the challenge
+     * arrived on; if that is not the current path, the channel sends it.
      */
+    if (ossl_quic_channel_on_path_challenge(ch, frame_data))
+        return 1;
+
+    /* TODO(QUIC FUTURE): We should try to avoid allocation here in the future. */
     encoded_len = sizeof(uint64_t) + 1;
     if ((encoded = OPENSSL_malloc(encoded_len)) == NULL)
         goto err;
@@ -1001,7 +1001,7 @@ static int depack_do_frame_path_response(PACKET *pkt,
         return 0;
     }
 
-    /* TODO(QUIC MULTIPATH): ADD CODE to send |frame_data| to the ch manager */
+    ossl_quic_channel_on_path_response(ch, frame_data);
 
     return 1;
 }
@@ -1105,6 +1105,23 @@ static int depack_process_frames(QUIC_CHANNEL *ch, PACKET *pkt,
             break;
         }
 
+        /*
+         * RFC 9000 s. 9.1: PATH_CHALLENGE, PATH_RESPONSE, NEW_CONNECTION_ID and
+         * PADDING frames are "probing frames", and all other frames are
+         * "non-probing frames". Only a packet containing a non-probing frame
+         * can cause the peer's address to be updated.
+         */
+        switch (frame_type) {
+        case OSSL_QUIC_FRAME_TYPE_PADDING:
+        case OSSL_QUIC_FRAME_TYPE_PATH_CHALLENGE:
+        case OSSL_QUIC_FRAME_TYPE_PATH_RESPONSE:
+        case OSSL_QUIC_FRAME_TYPE_NEW_CONN_ID:
+            break;
+        default:
+            ch->did_non_probing_frame = 1;
+            break;
+        }
+
         switch (frame_type) {
         case OSSL_QUIC_FRAME_TYPE_PING:
             /* Allowed in all packet types */
@@ -1424,6 +1441,7 @@ int ossl_quic_handle_frames(QUIC_CHANNEL *ch, OSSL_QRX_PKT *qpacket)
         goto end;
 
     ch->did_crypto_frame = 0;
+    ch->did_non_probing_frame = 0;
 
     /* Initialize |ackm_data| (and reinitialize |ok|)*/
     memset(&ackm_data, 0, sizeof(ackm_data));
@@ -51,6 +51,9 @@ struct quic_tls_st {
 
     /* Set if the handshake has completed */
     unsigned int complete : 1;
+
+    /* Set if the application wants us to attempt 0-RTT (clients only) */
+    unsigned int early_data_enabled : 1;
 };
 
 struct ossl_record_layer_st {
@@ -623,9 +626,27 @@ static int parse_transport_params_cb(SSL *s, unsigned int ext_type,
                                      int *al, void *parse_arg)
 {
     QUIC_TLS *qtls = parse_arg;
+    SSL_CONNECTION *sc = SSL_CONNECTION_FROM_SSL(s);
+
+    if (!qtls->args.got_transport_params_cb(in, inlen,
+                                            qtls->args.got_transport_params_cb_arg))
+        return 0;
 
-    return qtls->args.got_transport_params_cb(in, inlen,
-                                              qtls->args.got_transport_params_cb_arg);
+    /*
+     * Clients remember the parameters in any new session so that 0-RTT data
+     * sent on resumption respects the limits they contain. A resumed session
+     * may be shared with other connections and is left untouched.
+     */
+    if (!qtls->args.is_server && sc != NULL && !sc->hit) {
+        OPENSSL_free(sc->session->ext.quic_transport_params);
+        sc->session->ext.quic_transport_params_len = 0;
+        sc->session->ext.quic_transport_params = OPENSSL_memdup(in, inlen);
+        if (sc->session->ext.quic_transport_params == NULL)
+            return 0;
+        sc->session->ext.quic_transport_params_len = inlen;
+    }
+
+    return 1;
 }
 
 QUIC_TLS *ossl_quic_tls_new(const QUIC_TLS_ARGS *args)
@@ -782,6 +803,16 @@ int ossl_quic_tls_tick(QUIC_TLS *qtls)
         else
             SSL_set_connect_state(qtls->args.s);
 
+        /*
+         * Only offer early data if the session allows it and we know the
+         * transport parameters which bound what we may send (RFC 9001 s. 4.6.1).
+         */
+        if (!qtls->args.is_server && qtls->early_data_enabled
+            && sc->session != NULL
+            && sc->session->ext.max_early_data == 0xffffffff
+            && sc->session->ext.quic_transport_params != NULL)
+            sc->early_data_state = SSL_EARLY_DATA_CONNECTING;
+
         qtls->configured = 1;
     }
 
@@ -837,6 +868,25 @@ int ossl_quic_tls_set_transport_params(QUIC_TLS *qtls,
     return 1;
 }
 
+void ossl_quic_tls_set_early_data_enabled(QUIC_TLS *qtls, int enabled)
+{
+    qtls->early_data_enabled = (enabled != 0);
+}
+
+int ossl_quic_tls_get0_remembered_transport_params(QUIC_TLS *qtls,
+                                                   const unsigned char **params,
+                                                   size_t *params_len)
+{
+    SSL_SESSION *sess = SSL_get0_session(qtls->args.s);
+
+    if (sess == NULL || sess->ext.quic_transport_params == NULL)
+        return 0;
+
+    *params     = sess->ext.quic_transport_params;
+    *params_len = sess->ext.quic_transport_params_len;
+    return 1;
+}
+
 int ossl_quic_tls_get_error(QUIC_TLS *qtls,
                             uint64_t *error_code,
                             const char **error_msg,
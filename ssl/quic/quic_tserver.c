@@ -83,6 +83,7 @@ QUIC_TSERVER *ossl_quic_tserver_new(const QUIC_TSERVER_ARGS *args,
     QUIC_ENGINE_ARGS engine_args = {0};
     QUIC_PORT_ARGS port_args = {0};
     QUIC_CONNECTION *qc = NULL;
+    SSL_CONNECTION *sc;
 
     if (args->net_rbio == NULL || args->net_wbio == NULL)
         goto err;
@@ -116,9 +117,12 @@ QUIC_TSERVER *ossl_quic_tserver_new(const QUIC_TSERVER_ARGS *args,
     SSL_CTX_set_alpn_select_cb(srv->ctx, alpn_select_cb, srv);
 
     srv->tls = SSL_new(srv->ctx);
-    if (srv->tls == NULL)
+    if (srv->tls == NULL || (sc = SSL_CONNECTION_FROM_SSL_ONLY(srv->tls)) == NULL)
         goto err;
 
+    /* Mark the handshake layer as QUIC, as ossl_quic_port does for its own. */
+    sc->s3.flags |= TLS1_FLAGS_QUIC;
+
     engine_args.libctx          = srv->args.libctx;
     engine_args.propq           = srv->args.propq;
     engine_args.mutex           = srv->mutex;
@@ -210,6 +214,7 @@ int ossl_quic_tserver_set_handshake_mutator(QUIC_TSERVER *srv,
 
 int ossl_quic_tserver_tick(QUIC_TSERVER *srv)
 {
+    ossl_quic_channel_schedule_tick(srv->ch);
     ossl_quic_reactor_tick(ossl_quic_channel_get_reactor(srv->ch), 0);
 
     if (ossl_quic_channel_is_active(srv->ch))
@@ -530,6 +535,7 @@ int ossl_quic_tserver_shutdown(QUIC_TSERVER *srv, uint64_t app_error_code)
     if (ossl_quic_channel_is_terminated(srv->ch))
         return 1;
 
+    ossl_quic_channel_schedule_tick(srv->ch);
     ossl_quic_reactor_tick(ossl_quic_channel_get_reactor(srv->ch), 0);
 
     return ossl_quic_channel_is_terminated(srv->ch);
@@ -543,6 +549,7 @@ int ossl_quic_tserver_ping(QUIC_TSERVER *srv)
     if (!ossl_quic_channel_ping(srv->ch))
         return 0;
 
+    ossl_quic_channel_schedule_tick(srv->ch);
     ossl_quic_reactor_tick(ossl_quic_channel_get_reactor(srv->ch), 0);
     return 1;
 }
@@ -576,6 +583,13 @@ int ossl_quic_tserver_set_max_early_data(QUIC_TSERVER *srv,
     return SSL_set_max_early_data(srv->tls, max_early_data);
 }
 
+void ossl_quic_tserver_set_allow_early_data_cb(QUIC_TSERVER *srv,
+                                               SSL_allow_early_data_cb_fn cb,
+                                               void *arg)
+{
+    SSL_set_allow_early_data_cb(srv->tls, cb, arg);
+}
+
 void ossl_quic_tserver_set_psk_find_session_cb(QUIC_TSERVER *srv,
                                                SSL_psk_find_session_cb_func cb)
 {
@@ -96,6 +96,17 @@ struct ossl_quic_tx_packetiser_st {
     uint64_t                        closing_bytes_recv;
     uint64_t                        closing_bytes_xmit;
 
+    /*
+     * Counts of the number of bytes received from and sent to the peer's
+     * address while it is not validated, if amp_limited is set. amp_blocked
+     * is set when the limit stopped us from sending a datagram, and cleared
+     * when more bytes are received.
+     */
+    uint64_t                        amp_bytes_recv;
+    uint64_t                        amp_bytes_xmit;
+    unsigned int                    amp_limited             : 1;
+    unsigned int                    amp_blocked             : 1;
+
     /* Internal state - packet assembly. */
     struct txp_el {
         unsigned char   *scratch;       /* scratch buffer for packet assembly */
@@ -771,6 +782,7 @@ int ossl_quic_tx_packetiser_generate(OSSL_QUIC_TX_PACKETISER *txp,
     size_t pkts_done = 0;
     uint64_t cc_limit = txp->args.cc_method->get_tx_allowance(txp->args.cc_data);
     int need_padding = 0, txpim_pkt_reffed;
+    size_t total_dgram_size = 0;
 
     for (enc_level = QUIC_ENC_LEVEL_INITIAL;
          enc_level < QUIC_ENC_LEVEL_NUM;
@@ -835,9 +847,9 @@ int ossl_quic_tx_packetiser_generate(OSSL_QUIC_TX_PACKETISER *txp,
          */
         need_padding = 1;
 
-    if (need_padding) {
-        size_t total_dgram_size = 0;
-        const size_t min_dpl = QUIC_MIN_INITIAL_DGRAM_LEN;
+    if (need_padding || txp->amp_limited) {
+        size_t min_dpl = need_padding ? QUIC_MIN_INITIAL_DGRAM_LEN : 0;
+        uint64_t amp_allowance = 0;
         uint32_t pad_el = QUIC_ENC_LEVEL_NUM;
 
         for (enc_level = QUIC_ENC_LEVEL_INITIAL;
@@ -858,6 +870,24 @@ int ossl_quic_tx_packetiser_generate(OSSL_QUIC_TX_PACKETISER *txp,
                     + pkt[enc_level].h.bytes_appended;
             }
 
+        if (txp->amp_limited) {
+            uint64_t limit = txp->amp_bytes_recv * 3;
+
+            amp_allowance = limit > txp->amp_bytes_xmit
+                ? limit - txp->amp_bytes_xmit : 0;
+
+            /*
+             * RFC 9000 s. 8.2.1: Datagrams containing a PATH_CHALLENGE frame
+             * are expanded to 1200 bytes "unless the anti-amplification limit
+             * for the path does not permit sending a datagram of this size",
+             * and the same applies to PATH_RESPONSE (s. 8.2.2). Initial
+             * packets always need the full size.
+             */
+            if (!pkt[QUIC_ENC_LEVEL_INITIAL].h_valid
+                && min_dpl > amp_allowance)
+                min_dpl = (size_t)amp_allowance;
+        }
+
         if (pad_el != QUIC_ENC_LEVEL_NUM && total_dgram_size < min_dpl) {
             size_t deficit = min_dpl - total_dgram_size;
 
@@ -884,6 +914,17 @@ int ossl_quic_tx_packetiser_generate(OSSL_QUIC_TX_PACKETISER *txp,
             res = 1;
             goto out;
         }
+
+        /*
+         * RFC 9000 s. 8 and 9.3: Until the peer's address is validated, we
+         * must not send it more than three times the number of bytes we have
+         * received from it. Wait for it to send us more.
+         */
+        if (txp->amp_limited && total_dgram_size > amp_allowance) {
+            txp->amp_blocked = 1;
+            res = 1;
+            goto out;
+        }
     }
 
     /* 4. Commit */
@@ -921,6 +962,9 @@ int ossl_quic_tx_packetiser_generate(OSSL_QUIC_TX_PACKETISER *txp,
         ++pkts_done;
     }
 
+    if (txp->amp_limited)
+        txp->amp_bytes_xmit += total_dgram_size;
+
     /* Flush & Cleanup */
     res = 1;
 out:
@@ -936,6 +980,80 @@ out:
     return res;
 }
 
+int ossl_quic_tx_packetiser_send_path_response(OSSL_QUIC_TX_PACKETISER *txp,
+                                               const BIO_ADDR *peer,
+                                               uint64_t data,
+                                               size_t min_dgram_len)
+{
+    const uint32_t enc_level = QUIC_ENC_LEVEL_1RTT;
+    const uint32_t pn_space = QUIC_PN_SPACE_APP;
+    struct txp_pkt pkt;
+    QUIC_TXPIM_PKT *tpkt;
+    WPACKET *wpkt;
+    BIO_ADDR cur_peer = txp->args.peer;
+    size_t dgram_len;
+    int res = 0, txpim_pkt_reffed = 0;
+
+    pkt.h_valid = 0;
+
+    if (!ossl_qtx_is_enc_level_provisioned(txp->args.qtx, enc_level)
+        || !ossl_quic_pn_valid(txp->next_pn[pn_space]))
+        return 0;
+
+    ossl_qtx_finish_dgram(txp->args.qtx);
+
+    if (!txp_pkt_init(&pkt, txp, enc_level, TX_PACKETISER_ARCHETYPE_NORMAL, 0)
+        || (pkt.tpkt = tpkt = ossl_quic_txpim_pkt_alloc(txp->args.txpim)) == NULL)
+        goto out;
+
+    if ((wpkt = tx_helper_begin(&pkt.h)) == NULL)
+        goto out;
+
+    if (!ossl_quic_wire_encode_frame_path_response(wpkt, data)
+        || !tx_helper_commit(&pkt.h)) {
+        tx_helper_rollback(&pkt.h);
+        goto out;
+    }
+
+    txp_pkt_postgen_update_pkt_overhead(&pkt, txp);
+
+    tpkt->ackm_pkt.num_bytes        = pkt.h.bytes_appended + pkt.geom.pkt_overhead;
+    tpkt->ackm_pkt.pkt_num          = txp->next_pn[pn_space];
+    tpkt->ackm_pkt.largest_acked    = QUIC_PN_INVALID;
+    tpkt->ackm_pkt.pkt_space        = pn_space;
+    tpkt->ackm_pkt.is_inflight      = 1;
+    tpkt->ackm_pkt.is_ack_eliciting = 1;
+    tpkt->ackm_pkt.is_pto_probe     = 0;
+    tpkt->ackm_pkt.is_mtu_probe     = 0;
+    tpkt->ackm_pkt.time             = txp->args.now(txp->args.now_arg);
+    tpkt->pkt_type                  = pkt.phdr.type;
+
+    /* RFC 9000 s. 8.2.2: Pad the datagram as far as we are allowed to. */
+    dgram_len = pkt.h.bytes_appended + pkt.geom.pkt_overhead;
+    if (dgram_len < min_dgram_len
+        && !txp_pkt_append_padding(&pkt, txp, min_dgram_len - dgram_len))
+        goto out;
+
+    dgram_len = tpkt->ackm_pkt.num_bytes;
+
+    /* The packet goes to |peer| but is otherwise an ordinary 1-RTT packet. */
+    txp->args.peer = *peer;
+    res = txp_pkt_commit(txp, &pkt, TX_PACKETISER_ARCHETYPE_NORMAL,
+                         &txpim_pkt_reffed);
+    txp->args.peer = cur_peer;
+
+    if (txpim_pkt_reffed)
+        pkt.tpkt = NULL; /* don't free */
+
+    if (res && txp->amp_limited)
+        txp->amp_bytes_xmit += dgram_len;
+
+out:
+    ossl_qtx_finish_dgram(txp->args.qtx);
+    txp_pkt_cleanup(&pkt, txp);
+    return res;
+}
+
 static const struct archetype_data archetypes[QUIC_ENC_LEVEL_NUM][TX_PACKETISER_ARCHETYPE_NUM] = {
     /* EL 0(INITIAL) */
     {
@@ -1462,7 +1580,12 @@ static int txp_should_try_staging(OSSL_QUIC_TX_PACKETISER *txp,
             }
        }
 
-    if (a.allow_stream_rel && txp->handshake_complete) {
+    /*
+     * Stream data may be sent before the handshake completes only as 0-RTT
+     * data; the 0-RTT EL is discarded as soon as 1-RTT keys are available.
+     */
+    if (a.allow_stream_rel
+        && (txp->handshake_complete || enc_level == QUIC_ENC_LEVEL_0RTT)) {
         QUIC_STREAM_ITER it;
 
         /* If there are any active streams, 0/1-RTT wants to produce a packet.
@@ -1816,6 +1939,25 @@ void ossl_quic_tx_packetiser_record_received_closing_bytes(
     txp->closing_bytes_recv += n;
 }
 
+void ossl_quic_tx_packetiser_set_amplification_limited(
+        OSSL_QUIC_TX_PACKETISER *txp, int limited)
+{
+    txp->amp_limited    = (limited != 0);
+    txp->amp_blocked    = 0;
+    txp->amp_bytes_recv = 0;
+    txp->amp_bytes_xmit = 0;
+}
+
+void ossl_quic_tx_packetiser_record_received_path_bytes(
+        OSSL_QUIC_TX_PACKETISER *txp, size_t n)
+{
+    if (!txp->amp_limited)
+        return;
+
+    txp->amp_bytes_recv += n;
+    txp->amp_blocked    = 0;
+}
+
 static int txp_generate_pre_token(OSSL_QUIC_TX_PACKETISER *txp,
                                   struct txp_pkt *pkt,
                                   int chosen_for_conn_close,
@@ -2744,6 +2886,13 @@ static int txp_generate_for_el(OSSL_QUIC_TX_PACKETISER *txp,
                  */
                 pkt->force_pad = 1;
                 break;
+            case OSSL_QUIC_FRAME_TYPE_PATH_CHALLENGE:
+                if (!a.allow_cfq_other)
+                    continue;
+
+                /* RFC 9000 s. 8.2.1: The same applies to PATH_CHALLENGE. */
+                pkt->force_pad = 1;
+                break;
             default:
                 if (!a.allow_cfq_other)
                     continue;
@@ -2784,7 +2933,8 @@ static int txp_generate_for_el(OSSL_QUIC_TX_PACKETISER *txp,
             goto fatal_err;
 
     /* Stream-specific frames */
-    if (a.allow_stream_rel && txp->handshake_complete)
+    if (a.allow_stream_rel
+        && (txp->handshake_complete || enc_level == QUIC_ENC_LEVEL_0RTT))
         if (!txp_generate_stream_related(txp, pkt,
                                          &have_ack_eliciting,
                                          &pkt->stream_head))
@@ -3146,6 +3296,13 @@ OSSL_TIME ossl_quic_tx_packetiser_get_deadline(OSSL_QUIC_TX_PACKETISER *txp)
                                      ossl_ackm_get_ack_deadline(txp->args.ackm, pn_space));
         }
 
+    /*
+     * If the anti-amplification limit is stopping us from sending, nothing
+     * can be sent until more data arrives from the peer.
+     */
+    if (txp->amp_blocked)
+        deadline = ossl_time_infinite();
+
     /* When will CC let us send more? */
     if (txp->args.cc_method->get_tx_allowance(txp->args.cc_data) == 0)
         deadline = ossl_time_min(deadline,
@@ -297,6 +297,42 @@ static int ktls_set_crypto_state(OSSL_RECORD_LAYER *rl, int level,
                                  COMP_METHOD *comp)
 {
     ktls_crypto_info_t crypto_info;
+    int rekey;
+
+    /*
+     * If the kernel is already protecting this direction of the connection
+     * then this is a TLSv1.3 key update, and we need to hand the new keys to
+     * the kernel. We cannot fall back to another record layer at this point
+     * because the socket has already been committed to KTLS, so any failure is
+     * fatal.
+     */
+    if (rl->direction == OSSL_RECORD_DIRECTION_WRITE)
+        rekey = BIO_get_ktls_send(rl->bio) != 0;
+    else
+        rekey = BIO_get_ktls_recv(rl->bio) != 0;
+
+    if (rekey) {
+        if (rl->version != TLS1_3_VERSION
+                || comp != NULL
+                || rl->max_frag_len != SSL3_RT_MAX_PLAIN_LENGTH
+                || !ktls_int_check_supported_cipher(rl, ciph, md, taglen)
+                || (rl->direction == OSSL_RECORD_DIRECTION_WRITE
+                    && (rl->padding != NULL || rl->block_padding > 0
+                        || BIO_flush(rl->bio) <= 0))
+                || !ktls_configure_crypto(rl->libctx, rl->version, ciph, md,
+                                          rl->sequence, &crypto_info,
+                                          rl->direction
+                                          == OSSL_RECORD_DIRECTION_WRITE,
+                                          iv, ivlen, key, keylen, mackey,
+                                          mackeylen)
+                || !BIO_set_ktls(rl->bio, &crypto_info, rl->direction)) {
+            /* Typically the running kernel does not support key updates */
+            ERR_raise(ERR_LIB_SSL, SSL_R_KTLS_KEY_UPDATE_FAILED);
+            return OSSL_RECORD_RETURN_FATAL;
+        }
+
+        return OSSL_RECORD_RETURN_SUCCESS;
+    }
 
     /*
      * Check if we are suitable for KTLS. If not suitable we return
@@ -366,6 +402,16 @@ static int ktls_read_n(OSSL_RECORD_LAYER *rl, size_t n, size_t max, int extend,
             RLAYERfatal(rl, SSL_AD_PROTOCOL_VERSION,
                         SSL_R_WRONG_VERSION_NUMBER);
             break;
+#ifdef EKEYEXPIRED
+        case EKEYEXPIRED:
+            /*
+             * The kernel has seen a KeyUpdate and will not decrypt any further
+             * records until it has been given the new keys
+             */
+            RLAYERfatal(rl, SSL_AD_INTERNAL_ERROR,
+                        SSL_R_KTLS_KEY_UPDATE_FAILED);
+            break;
+#endif
         default:
             break;
         }
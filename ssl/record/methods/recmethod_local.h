@@ -324,6 +324,17 @@ struct ossl_record_layer_st {
     size_t block_padding;
     size_t hs_padding;
 
+    /*
+     * Dynamic record sizing. Application data records are limited to
+     * dyn_rec_size bytes until dyn_rec_threshold bytes have been sent. The
+     * count is reset if nothing is written for dyn_rec_idle.
+     */
+    size_t dyn_rec_size;
+    size_t dyn_rec_threshold;
+    OSSL_TIME dyn_rec_idle;
+    size_t dyn_rec_sent;
+    OSSL_TIME dyn_rec_last;
+
     /* Only used by SSLv3 */
     unsigned char mac_secret[EVP_MAX_MD_SIZE];
 
@@ -82,9 +82,8 @@ static int tls13_set_crypto_state(OSSL_RECORD_LAYER *rl, int level,
     return OSSL_RECORD_RETURN_SUCCESS;
 }
 
-static int tls13_cipher(OSSL_RECORD_LAYER *rl, TLS_RL_RECORD *recs,
-                        size_t n_recs, int sending, SSL_MAC_BUF *mac,
-                        size_t macsize)
+static int tls13_cipher_record(OSSL_RECORD_LAYER *rl, TLS_RL_RECORD *rec,
+                               int sending)
 {
     EVP_CIPHER_CTX *enc_ctx;
     unsigned char recheader[SSL3_RT_HEADER_LENGTH];
@@ -94,18 +93,11 @@ static int tls13_cipher(OSSL_RECORD_LAYER *rl, TLS_RL_RECORD *recs,
     unsigned char *nonce;
     unsigned char *seq = rl->sequence;
     int lenu, lenf;
-    TLS_RL_RECORD *rec = &recs[0];
     WPACKET wpkt;
     const EVP_CIPHER *cipher;
     EVP_MAC_CTX *mac_ctx = NULL;
     int mode;
 
-    if (n_recs != 1) {
-        /* Should not happen */
-        RLAYERfatal(rl, SSL_AD_INTERNAL_ERROR, ERR_R_INTERNAL_ERROR);
-        return 0;
-    }
-
     enc_ctx = rl->enc_ctx; /* enc_ctx is ignored when rl->mac_ctx != NULL */
     staticiv = rl->iv;
     nonce = rl->nonce;
@@ -248,6 +240,33 @@ static int tls13_cipher(OSSL_RECORD_LAYER *rl, TLS_RL_RECORD *recs,
     return 1;
 }
 
+/*
+ * Every TLSv1.3 record is protected under its own nonce, derived from the
+ * static IV and the record sequence number, so unlike earlier protocol
+ * versions there is no chaining between records and any cipher can be used to
+ * protect several records in one call. They are processed in sequence number
+ * order.
+ */
+static int tls13_cipher(OSSL_RECORD_LAYER *rl, TLS_RL_RECORD *recs,
+                        size_t n_recs, int sending, SSL_MAC_BUF *mac,
+                        size_t macsize)
+{
+    size_t i;
+
+    if (n_recs == 0 || (!sending && n_recs != 1)) {
+        /* Should not happen */
+        RLAYERfatal(rl, SSL_AD_INTERNAL_ERROR, ERR_R_INTERNAL_ERROR);
+        return 0;
+    }
+
+    for (i = 0; i < n_recs; i++) {
+        if (!tls13_cipher_record(rl, &recs[i], sending))
+            return 0;
+    }
+
+    return 1;
+}
+
 static int tls13_validate_record_header(OSSL_RECORD_LAYER *rl,
                                         TLS_RL_RECORD *rec)
 {
@@ -405,6 +424,166 @@ static int tls13_add_record_padding(OSSL_RECORD_LAYER *rl,
     return 1;
 }
 
+static size_t tls13_get_max_records(OSSL_RECORD_LAYER *rl, uint8_t type,
+                                    size_t len, size_t maxfrag,
+                                    size_t *preffrag)
+{
+    size_t pipes;
+
+    /*
+     * Since every record has its own nonce we do not need a pipeline capable
+     * cipher. We only split application data, and only if we have been
+     * configured to use pipelining.
+     */
+    if (rl->max_pipelines <= 1
+            || type != SSL3_RT_APPLICATION_DATA
+            || (rl->enc_ctx == NULL && rl->mac_ctx == NULL)
+            || len == 0)
+        return 1;
+
+    pipes = ((len - 1) / *preffrag) + 1;
+
+    return (pipes < rl->max_pipelines) ? pipes : rl->max_pipelines;
+}
+
+/*
+ * The maximum number of bytes that a TLSv1.3 record built from |templ| can
+ * occupy on the wire, including the header, content type, any padding and the
+ * tag.
+ */
+static size_t tls13_max_record_len(OSSL_RECORD_LAYER *rl,
+                                   OSSL_RECORD_TEMPLATE *templ)
+{
+    size_t len = templ->buflen + 1;
+
+    if ((rl->padding != NULL || rl->block_padding > 0 || rl->hs_padding > 0)
+            && len < rl->max_frag_len)
+        len = rl->max_frag_len;
+
+    return SSL3_RT_HEADER_LENGTH + len + rl->taglen;
+}
+
+/*
+ * When pipelining, all the records for a single write are laid out back to back
+ * in one buffer so that they can be passed to the BIO in a single call, rather
+ * than one call per record.
+ */
+static int tls13_allocate_write_buffers(OSSL_RECORD_LAYER *rl,
+                                        OSSL_RECORD_TEMPLATE *templates,
+                                        size_t numtempl, size_t *prefix)
+{
+    size_t len, maxalign = 0;
+
+    if (rl->max_pipelines <= 1)
+        return tls_allocate_write_buffers_default(rl, templates, numtempl,
+                                                  prefix);
+
+#if defined(SSL3_ALIGN_PAYLOAD) && SSL3_ALIGN_PAYLOAD != 0
+    maxalign = SSL3_ALIGN_PAYLOAD - 1;
+#endif
+
+    /*
+     * Always use the same size regardless of |numtempl| so that the buffer is
+     * reused from one write to the next.
+     */
+    len = maxalign
+          + rl->max_pipelines * (SSL3_RT_HEADER_LENGTH + rl->max_frag_len + 1
+                                 + rl->taglen)
+          + SSL3_RT_SEND_MAX_ENCRYPTED_OVERHEAD;
+
+    if (!tls_setup_write_buffer(rl, 1, len, 0)) {
+        /* RLAYERfatal() already called */
+        return 0;
+    }
+
+    return 1;
+}
+
+static int tls13_initialise_write_packets(OSSL_RECORD_LAYER *rl,
+                                          OSSL_RECORD_TEMPLATE *templates,
+                                          size_t numtempl,
+                                          OSSL_RECORD_TEMPLATE *prefixtempl,
+                                          WPACKET *pkt,
+                                          TLS_BUFFER *bufs,
+                                          size_t *wpinited)
+{
+    TLS_BUFFER *wb = &bufs[0];
+    unsigned char *buf = TLS_BUFFER_get_buf(wb);
+    size_t j, align = 0, offset, reclen;
+
+    if (rl->max_pipelines <= 1)
+        return tls_initialise_write_packets_default(rl, templates, numtempl,
+                                                    prefixtempl, pkt, bufs,
+                                                    wpinited);
+
+#if defined(SSL3_ALIGN_PAYLOAD) && SSL3_ALIGN_PAYLOAD != 0
+    align = (size_t)buf + SSL3_RT_HEADER_LENGTH;
+    align = SSL3_ALIGN_PAYLOAD - 1 - ((align - 1) % SSL3_ALIGN_PAYLOAD);
+#endif
+
+    wb->type = templates[0].type;
+    for (j = 0, offset = align; j < numtempl; j++, offset += reclen) {
+        reclen = tls13_max_record_len(rl, &templates[j]);
+
+        /*
+         * Each packet may reserve up to SSL3_RT_SEND_MAX_ENCRYPTED_OVERHEAD
+         * bytes past the end of its record, overlapping the start of the
+         * next one. That space is never written to.
+         */
+        if (!ossl_assert(offset + reclen + SSL3_RT_SEND_MAX_ENCRYPTED_OVERHEAD
+                         <= TLS_BUFFER_get_len(wb))
+                || !WPACKET_init_static_len(&pkt[j], buf + offset,
+                                            reclen
+                                            + SSL3_RT_SEND_MAX_ENCRYPTED_OVERHEAD,
+                                            0)) {
+            RLAYERfatal(rl, SSL_AD_INTERNAL_ERROR, ERR_R_INTERNAL_ERROR);
+            return 0;
+        }
+        (*wpinited)++;
+
+        /*
+         * Only the first buffer is ever written to the BIO. For the others we
+         * just remember where their record starts.
+         */
+        TLS_BUFFER_set_offset(&bufs[j], offset);
+    }
+
+    return 1;
+}
+
+static int tls13_write_records(OSSL_RECORD_LAYER *rl,
+                               OSSL_RECORD_TEMPLATE *templates,
+                               size_t numtempl)
+{
+    TLS_BUFFER *wb = &rl->wbuf[0], *thiswb;
+    size_t j, end;
+
+    if (!tls_write_records_default(rl, templates, numtempl))
+        return 0;
+
+    if (rl->max_pipelines <= 1)
+        return 1;
+
+    /*
+     * Records only come out shorter than we allowed for if we were expecting
+     * padding. Close up any gaps so the records are contiguous.
+     */
+    end = TLS_BUFFER_get_offset(wb) + TLS_BUFFER_get_left(wb);
+    for (j = 1; j < numtempl; j++) {
+        thiswb = &rl->wbuf[j];
+        if (TLS_BUFFER_get_offset(thiswb) != end)
+            memmove(TLS_BUFFER_get_buf(wb) + end,
+                    TLS_BUFFER_get_buf(wb) + TLS_BUFFER_get_offset(thiswb),
+                    TLS_BUFFER_get_left(thiswb));
+        end += TLS_BUFFER_get_left(thiswb);
+        TLS_BUFFER_set_offset(thiswb, 0);
+        TLS_BUFFER_set_left(thiswb, 0);
+    }
+    TLS_BUFFER_set_left(wb, end - TLS_BUFFER_get_offset(wb));
+
+    return 1;
+}
+
 const struct record_functions_st tls_1_3_funcs = {
     tls13_set_crypto_state,
     tls13_cipher,
@@ -414,10 +593,10 @@ const struct record_functions_st tls_1_3_funcs = {
     tls_get_more_records,
     tls13_validate_record_header,
     tls13_post_process_record,
-    tls_get_max_records_default,
-    tls_write_records_default,
-    tls_allocate_write_buffers_default,
-    tls_initialise_write_packets_default,
+    tls13_get_max_records,
+    tls13_write_records,
+    tls13_allocate_write_buffers,
+    tls13_initialise_write_packets,
     tls13_get_record_type,
     tls_prepare_record_header_default,
     tls13_add_record_padding,
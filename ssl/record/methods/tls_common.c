@@ -1227,6 +1227,29 @@ int tls_set_options(OSSL_RECORD_LAYER *rl, const OSSL_PARAM *options)
             ERR_raise(ERR_LIB_SSL, SSL_R_FAILED_TO_GET_PARAMETER);
             return 0;
         }
+        p = OSSL_PARAM_locate_const(options,
+                                    OSSL_LIBSSL_RECORD_LAYER_PARAM_DYN_REC_SIZE);
+        if (p != NULL && !OSSL_PARAM_get_size_t(p, &rl->dyn_rec_size)) {
+            ERR_raise(ERR_LIB_SSL, SSL_R_FAILED_TO_GET_PARAMETER);
+            return 0;
+        }
+        p = OSSL_PARAM_locate_const(options,
+                                    OSSL_LIBSSL_RECORD_LAYER_PARAM_DYN_REC_THRESHOLD);
+        if (p != NULL && !OSSL_PARAM_get_size_t(p, &rl->dyn_rec_threshold)) {
+            ERR_raise(ERR_LIB_SSL, SSL_R_FAILED_TO_GET_PARAMETER);
+            return 0;
+        }
+        p = OSSL_PARAM_locate_const(options,
+                                    OSSL_LIBSSL_RECORD_LAYER_PARAM_DYN_REC_IDLE);
+        if (p != NULL) {
+            uint64_t idle_ms;
+
+            if (!OSSL_PARAM_get_uint64(p, &idle_ms)) {
+                ERR_raise(ERR_LIB_SSL, SSL_R_FAILED_TO_GET_PARAMETER);
+                return 0;
+            }
+            rl->dyn_rec_idle = ossl_ms2time(idle_ms);
+        }
     }
 
     if (rl->level == OSSL_RECORD_PROTECTION_LEVEL_APPLICATION) {
@@ -1541,7 +1564,37 @@ size_t tls_get_max_records_default(OSSL_RECORD_LAYER *rl, uint8_t type,
 size_t tls_get_max_records(OSSL_RECORD_LAYER *rl, uint8_t type, size_t len,
                            size_t maxfrag, size_t *preffrag)
 {
-    return rl->funcs->get_max_records(rl, type, len, maxfrag, preffrag);
+    size_t numrecs = rl->funcs->get_max_records(rl, type, len, maxfrag,
+                                                preffrag);
+
+    if (rl->dyn_rec_size == 0
+            || rl->isdtls
+            || type != SSL3_RT_APPLICATION_DATA)
+        return numrecs;
+
+    /*
+     * After an idle period the congestion window will have shrunk again, so
+     * start over with small records.
+     */
+    if (rl->dyn_rec_sent > 0
+            && !ossl_time_is_zero(rl->dyn_rec_idle)
+            && ossl_time_compare(ossl_time_subtract(ossl_time_now(),
+                                                    rl->dyn_rec_last),
+                                 rl->dyn_rec_idle) > 0)
+        rl->dyn_rec_sent = 0;
+
+    /*
+     * Until we have sent enough data keep each record small enough to fit in
+     * a single TCP segment, so that the peer can decrypt it as soon as that
+     * segment arrives.
+     */
+    if (rl->dyn_rec_sent < rl->dyn_rec_threshold
+            && *preffrag > rl->dyn_rec_size) {
+        *preffrag = rl->dyn_rec_size;
+        return 1;
+    }
+
+    return numrecs;
 }
 
 int tls_allocate_write_buffers_default(OSSL_RECORD_LAYER *rl,
@@ -1898,6 +1951,18 @@ int tls_write_records(OSSL_RECORD_LAYER *rl, OSSL_RECORD_TEMPLATE *templates,
         return OSSL_RECORD_RETURN_FATAL;
     }
 
+    if (rl->dyn_rec_size > 0) {
+        size_t i;
+
+        for (i = 0; i < numtempl; i++) {
+            if (templates[i].type == SSL3_RT_APPLICATION_DATA
+                    && rl->dyn_rec_sent < rl->dyn_rec_threshold)
+                rl->dyn_rec_sent += templates[i].buflen;
+        }
+        if (!ossl_time_is_zero(rl->dyn_rec_idle))
+            rl->dyn_rec_last = ossl_time_now();
+    }
+
     rl->nextwbuf = 0;
     /* we now just need to write the buffers */
     return tls_retry_write_records(rl);
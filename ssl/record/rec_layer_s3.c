@@ -408,7 +408,10 @@ int ssl3_write_bytes(SSL *ssl, uint8_t type, const void *buf_, size_t len,
         /*
         * Ask the record layer how it would like to split the amount of data
         * that we have, and how many of those records it would like in one go.
+        * It may have lowered the preferred fragment size for the previous
+        * records so start from the configured value every time.
         */
+        split_send_fragment = ssl_get_split_send_fragment(s);
         maxpipes = s->rlayer.wrlmethod->get_max_records(s->rlayer.wrl, type, n,
                                                         max_send_fragment,
                                                         &split_send_fragment);
@@ -1242,7 +1245,7 @@ int ssl_set_new_record_layer(SSL_CONNECTION *s, int version,
                              int mactype, const EVP_MD *md,
                              const SSL_COMP *comp, const EVP_MD *kdfdigest)
 {
-    OSSL_PARAM options[5], *opts = options;
+    OSSL_PARAM options[8], *opts = options;
     OSSL_PARAM settings[6], *set =  settings;
     const OSSL_RECORD_METHOD **thismethod;
     OSSL_RECORD_LAYER **thisrl, *newrl = NULL;
@@ -1292,6 +1295,12 @@ int ssl_set_new_record_layer(SSL_CONNECTION *s, int version,
                                               &s->rlayer.block_padding);
         *opts++ = OSSL_PARAM_construct_size_t(OSSL_LIBSSL_RECORD_LAYER_PARAM_HS_PADDING,
                                               &s->rlayer.hs_padding);
+        *opts++ = OSSL_PARAM_construct_size_t(OSSL_LIBSSL_RECORD_LAYER_PARAM_DYN_REC_SIZE,
+                                              &s->rlayer.dyn_rec_size);
+        *opts++ = OSSL_PARAM_construct_size_t(OSSL_LIBSSL_RECORD_LAYER_PARAM_DYN_REC_THRESHOLD,
+                                              &s->rlayer.dyn_rec_threshold);
+        *opts++ = OSSL_PARAM_construct_uint64(OSSL_LIBSSL_RECORD_LAYER_PARAM_DYN_REC_IDLE,
+                                              &s->rlayer.dyn_rec_idle_ms);
     }
     *opts = OSSL_PARAM_construct_end();
 
@@ -115,6 +115,11 @@ typedef struct record_layer_st {
     size_t block_padding;
     size_t hs_padding;
 
+    /* Dynamic record sizing, disabled if dyn_rec_size is 0 */
+    size_t dyn_rec_size;
+    size_t dyn_rec_threshold;
+    uint64_t dyn_rec_idle_ms;
+
     /* How many records we have read from the record layer */
     size_t num_recs;
     /* The next record from the record layer that we need to process */
@@ -46,6 +46,7 @@ typedef struct {
     ASN1_OCTET_STRING *ticket_appdata;
     uint32_t kex_group;
     ASN1_OCTET_STRING *peer_rpk;
+    ASN1_OCTET_STRING *quic_transport_params;
 } SSL_SESSION_ASN1;
 
 ASN1_SEQUENCE(SSL_SESSION_ASN1) = {
@@ -78,7 +79,8 @@ ASN1_SEQUENCE(SSL_SESSION_ASN1) = {
     ASN1_EXP_OPT_EMBED(SSL_SESSION_ASN1, tlsext_max_fragment_len_mode, ZUINT32, 17),
     ASN1_EXP_OPT(SSL_SESSION_ASN1, ticket_appdata, ASN1_OCTET_STRING, 18),
     ASN1_EXP_OPT_EMBED(SSL_SESSION_ASN1, kex_group, UINT32, 19),
-    ASN1_EXP_OPT(SSL_SESSION_ASN1, peer_rpk, ASN1_OCTET_STRING, 20)
+    ASN1_EXP_OPT(SSL_SESSION_ASN1, peer_rpk, ASN1_OCTET_STRING, 20),
+    ASN1_EXP_OPT(SSL_SESSION_ASN1, quic_transport_params, ASN1_OCTET_STRING, 21)
 } static_ASN1_SEQUENCE_END(SSL_SESSION_ASN1)
 
 IMPLEMENT_STATIC_ASN1_ENCODE_FUNCTIONS(SSL_SESSION_ASN1)
@@ -129,6 +131,7 @@ int i2d_SSL_SESSION(const SSL_SESSION *in, unsigned char **pp)
     ASN1_OCTET_STRING alpn_selected;
     ASN1_OCTET_STRING ticket_appdata;
     ASN1_OCTET_STRING peer_rpk;
+    ASN1_OCTET_STRING quic_transport_params;
 
     long l;
     int ret;
@@ -217,6 +220,13 @@ int i2d_SSL_SESSION(const SSL_SESSION *in, unsigned char **pp)
         ssl_session_oinit(&as.ticket_appdata, &ticket_appdata,
                           in->ticket_appdata, in->ticket_appdata_len);
 
+    if (in->ext.quic_transport_params == NULL)
+        as.quic_transport_params = NULL;
+    else
+        ssl_session_oinit(&as.quic_transport_params, &quic_transport_params,
+                          in->ext.quic_transport_params,
+                          in->ext.quic_transport_params_len);
+
     ret = i2d_SSL_SESSION_ASN1(&as, pp);
     OPENSSL_free(peer_rpk.data);
     return ret;
@@ -418,6 +428,16 @@ SSL_SESSION *d2i_SSL_SESSION_ex(SSL_SESSION **a, const unsigned char **pp,
         ret->ticket_appdata_len = 0;
     }
 
+    OPENSSL_free(ret->ext.quic_transport_params);
+    if (as->quic_transport_params != NULL) {
+        ret->ext.quic_transport_params = as->quic_transport_params->data;
+        ret->ext.quic_transport_params_len = as->quic_transport_params->length;
+        as->quic_transport_params->data = NULL;
+    } else {
+        ret->ext.quic_transport_params = NULL;
+        ret->ext.quic_transport_params_len = 0;
+    }
+
     M_ASN1_free_of(as, SSL_SESSION_ASN1);
 
     if ((a != NULL) && (*a == NULL))
@@ -11,6 +11,7 @@
 #include "ssl_local.h"
 #include "internal/e_os.h"
 #include "internal/refcount.h"
+#include "internal/thread_once.h"
 
 size_t ossl_calculate_comp_expansion(int alg, size_t length)
 {
@@ -191,19 +192,17 @@ static int ssl_set_cert_comp_pref(int *prefs, int *algs, size_t len)
     return found;
 }
 
-static size_t ssl_get_cert_to_compress(SSL *ssl, CERT_PKEY *cpk, unsigned char **data)
+/*
+ * Encodes the certificate chain in |cpk| the way it is sent in a Certificate
+ * message, which is the input to certificate compression.
+ */
+static size_t ssl_encode_cert_to_compress(SSL_CONNECTION *sc, CERT_PKEY *cpk,
+                                          unsigned char **data)
 {
-    SSL_CONNECTION *sc = SSL_CONNECTION_FROM_SSL(ssl);
     WPACKET tmppkt;
     BUF_MEM buf = { 0 };
     size_t ret = 0;
 
-    if (sc == NULL
-            || cpk == NULL
-            || !sc->server
-            || !SSL_in_before(ssl))
-        return 0;
-
     /* Use the |tmppkt| for the to-be-compressed data */
     if (!WPACKET_init(&tmppkt, &buf))
         goto out;
@@ -229,6 +228,181 @@ static size_t ssl_get_cert_to_compress(SSL *ssl, CERT_PKEY *cpk, unsigned char *
     return ret;
 }
 
+static size_t ssl_get_cert_to_compress(SSL *ssl, CERT_PKEY *cpk, unsigned char **data)
+{
+    SSL_CONNECTION *sc = SSL_CONNECTION_FROM_SSL(ssl);
+
+    if (sc == NULL
+            || cpk == NULL
+            || !sc->server
+            || !SSL_in_before(ssl))
+        return 0;
+
+    return ssl_encode_cert_to_compress(sc, cpk, data);
+}
+
+/*
+ * Compressing a certificate chain is expensive, and servers commonly use the
+ * same chain in many SSL_CTXs and SSL objects. Compressed chains are
+ * therefore cached globally, keyed on the algorithm and the uncompressed
+ * chain, and shared by reference count. Chains that do not shrink are
+ * cached too, so that they are not compressed again just to be discarded.
+ */
+typedef struct {
+    int alg;
+    unsigned char *data;
+    size_t len;
+    unsigned long hash;
+    OSSL_COMP_CERT *comp_cert;
+} COMP_CERT_CACHE_ENTRY;
+
+DEFINE_LHASH_OF_EX(COMP_CERT_CACHE_ENTRY);
+
+#define COMP_CERT_CACHE_MAX     128
+
+static CRYPTO_ONCE comp_cert_cache_once = CRYPTO_ONCE_STATIC_INIT;
+static CRYPTO_RWLOCK *comp_cert_cache_lock = NULL;
+static LHASH_OF(COMP_CERT_CACHE_ENTRY) *comp_cert_cache = NULL;
+
+static unsigned long comp_cert_cache_entry_hash(const COMP_CERT_CACHE_ENTRY *e)
+{
+    return e->hash;
+}
+
+static int comp_cert_cache_entry_cmp(const COMP_CERT_CACHE_ENTRY *a,
+                                     const COMP_CERT_CACHE_ENTRY *b)
+{
+    if (a->alg != b->alg || a->len != b->len)
+        return 1;
+    return memcmp(a->data, b->data, a->len);
+}
+
+static void comp_cert_cache_entry_free(COMP_CERT_CACHE_ENTRY *e)
+{
+    OPENSSL_free(e->data);
+    OSSL_COMP_CERT_free(e->comp_cert);
+    OPENSSL_free(e);
+}
+
+static void comp_cert_cache_free(void)
+{
+    lh_COMP_CERT_CACHE_ENTRY_doall(comp_cert_cache, comp_cert_cache_entry_free);
+    lh_COMP_CERT_CACHE_ENTRY_free(comp_cert_cache);
+    comp_cert_cache = NULL;
+    CRYPTO_THREAD_lock_free(comp_cert_cache_lock);
+    comp_cert_cache_lock = NULL;
+}
+
+DEFINE_RUN_ONCE_STATIC(do_comp_cert_cache_init)
+{
+    comp_cert_cache_lock = CRYPTO_THREAD_lock_new();
+    comp_cert_cache = lh_COMP_CERT_CACHE_ENTRY_new(comp_cert_cache_entry_hash,
+                                                   comp_cert_cache_entry_cmp);
+    if (comp_cert_cache_lock == NULL || comp_cert_cache == NULL
+            || !OPENSSL_atexit(comp_cert_cache_free)) {
+        comp_cert_cache_free();
+        return 0;
+    }
+    return 1;
+}
+
+/* Removes entries that are no longer used by any CERT_PKEY */
+static void comp_cert_cache_flush_unused(COMP_CERT_CACHE_ENTRY *e)
+{
+    int refs;
+
+    if (CRYPTO_GET_REF(&e->comp_cert->references, &refs) && refs == 1) {
+        (void)lh_COMP_CERT_CACHE_ENTRY_delete(comp_cert_cache, e);
+        comp_cert_cache_entry_free(e);
+    }
+}
+
+/* Adds |comp_cert| to the cache. Failures are silently ignored. */
+static void comp_cert_cache_add(const COMP_CERT_CACHE_ENTRY *key,
+                                OSSL_COMP_CERT *comp_cert)
+{
+    COMP_CERT_CACHE_ENTRY *e;
+    unsigned long down_load;
+
+    if (comp_cert_cache == NULL
+            || (e = OPENSSL_memdup(key, sizeof(*key))) == NULL)
+        return;
+
+    e->comp_cert = NULL;
+    if ((e->data = OPENSSL_memdup(key->data, key->len)) == NULL
+            || !OSSL_COMP_CERT_up_ref(comp_cert)) {
+        comp_cert_cache_entry_free(e);
+        return;
+    }
+    e->comp_cert = comp_cert;
+
+    if (!CRYPTO_THREAD_write_lock(comp_cert_cache_lock)) {
+        comp_cert_cache_entry_free(e);
+        return;
+    }
+    if (lh_COMP_CERT_CACHE_ENTRY_num_items(comp_cert_cache)
+            >= COMP_CERT_CACHE_MAX) {
+        /* Don't let the hash table contract while we are deleting */
+        down_load = lh_COMP_CERT_CACHE_ENTRY_get_down_load(comp_cert_cache);
+        lh_COMP_CERT_CACHE_ENTRY_set_down_load(comp_cert_cache, 0);
+        lh_COMP_CERT_CACHE_ENTRY_doall(comp_cert_cache,
+                                       comp_cert_cache_flush_unused);
+        lh_COMP_CERT_CACHE_ENTRY_set_down_load(comp_cert_cache, down_load);
+    }
+    if (lh_COMP_CERT_CACHE_ENTRY_num_items(comp_cert_cache)
+            >= COMP_CERT_CACHE_MAX
+            || lh_COMP_CERT_CACHE_ENTRY_retrieve(comp_cert_cache, e) != NULL) {
+        CRYPTO_THREAD_unlock(comp_cert_cache_lock);
+        comp_cert_cache_entry_free(e);
+        return;
+    }
+    (void)lh_COMP_CERT_CACHE_ENTRY_insert(comp_cert_cache, e);
+    if (lh_COMP_CERT_CACHE_ENTRY_error(comp_cert_cache) > 0) {
+        CRYPTO_THREAD_unlock(comp_cert_cache_lock);
+        comp_cert_cache_entry_free(e);
+        return;
+    }
+    CRYPTO_THREAD_unlock(comp_cert_cache_lock);
+}
+
+/*
+ * Returns a reference to the compressed form of the |len| bytes at |data|,
+ * either from the cache or by compressing them, or NULL on failure.
+ */
+static OSSL_COMP_CERT *ssl_comp_cert_get(unsigned char *data, size_t len,
+                                         int alg)
+{
+    COMP_CERT_CACHE_ENTRY key, *e;
+    OSSL_COMP_CERT *ret = NULL;
+    size_t i;
+
+    key.alg = alg;
+    key.data = data;
+    key.len = len;
+    /* FNV-1a */
+    key.hash = 2166136261UL;
+    for (i = 0; i < len; i++)
+        key.hash = ((key.hash ^ data[i]) * 16777619UL) & 0xffffffffUL;
+    key.hash ^= (unsigned long)alg;
+    key.comp_cert = NULL;
+
+    if (RUN_ONCE(&comp_cert_cache_once, do_comp_cert_cache_init)
+            && comp_cert_cache != NULL
+            && CRYPTO_THREAD_read_lock(comp_cert_cache_lock)) {
+        e = lh_COMP_CERT_CACHE_ENTRY_retrieve(comp_cert_cache, &key);
+        if (e != NULL && OSSL_COMP_CERT_up_ref(e->comp_cert))
+            ret = e->comp_cert;
+        CRYPTO_THREAD_unlock(comp_cert_cache_lock);
+        if (ret != NULL)
+            return ret;
+    }
+
+    ret = OSSL_COMP_CERT_from_uncompressed_data(data, len, alg);
+    if (ret != NULL)
+        comp_cert_cache_add(&key, ret);
+    return ret;
+}
+
 static int ssl_compress_one_cert(SSL *ssl, CERT_PKEY *cpk, int alg)
 {
     unsigned char *cert_data = NULL;
@@ -242,7 +416,7 @@ static int ssl_compress_one_cert(SSL *ssl, CERT_PKEY *cpk, int alg)
 
     if ((length = ssl_get_cert_to_compress(ssl, cpk, &cert_data)) == 0)
         return 0;
-    comp_cert = OSSL_COMP_CERT_from_uncompressed_data(cert_data, length, alg);
+    comp_cert = ssl_comp_cert_get(cert_data, length, alg);
     OPENSSL_free(cert_data);
     if (comp_cert == NULL)
         return 0;
@@ -318,20 +492,52 @@ static size_t ssl_get_compressed_cert(SSL *ssl, CERT_PKEY *cpk, int alg, unsigne
     if ((cert_len = ssl_get_cert_to_compress(ssl, cpk, &cert_data)) == 0)
         goto err;
 
-    comp_cert = OSSL_COMP_CERT_from_uncompressed_data(cert_data, cert_len, alg);
+    comp_cert = ssl_comp_cert_get(cert_data, cert_len, alg);
     OPENSSL_free(cert_data);
     if (comp_cert == NULL)
         goto err;
 
+    /* The compressed data may be shared, so hand out a copy */
+    if ((*data = OPENSSL_memdup(comp_cert->data, comp_cert->len)) == NULL)
+        goto err;
     comp_len = comp_cert->len;
     *orig_len = comp_cert->orig_len;
-    *data = comp_cert->data;
-    comp_cert->data = NULL;
  err:
     OSSL_COMP_CERT_free(comp_cert);
     return comp_len;
 }
 
+/*
+ * Called by a server with SSL_OP_AUTO_CERTIFICATE_COMPRESSION set when the
+ * certificate in |cpk| has not been compressed with |alg| in advance.
+ * Returns 1 if |cpk| has a usable compressed certificate for |alg| on return.
+ */
+int ossl_ssl_auto_compress_cert(SSL_CONNECTION *sc, CERT_PKEY *cpk, int alg)
+{
+    unsigned char *cert_data = NULL;
+    OSSL_COMP_CERT *comp_cert;
+    size_t length;
+
+    if (cpk == NULL || cpk->x509 == NULL || !ossl_comp_has_alg(alg))
+        return 0;
+    if (cpk->comp_cert[alg] != NULL)
+        return 1;
+
+    if ((length = ssl_encode_cert_to_compress(sc, cpk, &cert_data)) == 0)
+        return 0;
+    comp_cert = ssl_comp_cert_get(cert_data, length, alg);
+    OPENSSL_free(cert_data);
+    if (comp_cert == NULL)
+        return 0;
+
+    if (comp_cert->len >= comp_cert->orig_len) {
+        OSSL_COMP_CERT_free(comp_cert);
+        return 0;
+    }
+    cpk->comp_cert[alg] = comp_cert;
+    return 1;
+}
+
 static int ossl_set1_compressed_cert(CERT *cert, int algorithm,
                                      unsigned char *comp_data, size_t comp_length,
                                      size_t orig_length)
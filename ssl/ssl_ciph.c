@@ -964,7 +964,8 @@ static int ssl_cipher_strength_sort(CIPHER_ORDER **head_p,
 static int ssl_cipher_process_rulestr(const char *rule_str,
                                       CIPHER_ORDER **head_p,
                                       CIPHER_ORDER **tail_p,
-                                      const SSL_CIPHER **ca_list, CERT *c)
+                                      const SSL_CIPHER **ca_list,
+                                      int *sec_level)
 {
     uint32_t alg_mkey, alg_auth, alg_enc, alg_mac, algo_strength;
     int min_tls;
@@ -1195,7 +1196,7 @@ static int ssl_cipher_process_rulestr(const char *rule_str,
                 if (level < 0 || level > 5) {
                     ERR_raise(ERR_LIB_SSL, SSL_R_INVALID_COMMAND);
                 } else {
-                    c->sec_level = level;
+                    *sec_level = level;
                     ok = 1;
                 }
             } else {
@@ -1420,39 +1421,171 @@ int SSL_set_ciphersuites(SSL *s, const char *str)
     return ret;
 }
 
-STACK_OF(SSL_CIPHER) *ssl_create_cipher_list(SSL_CTX *ctx,
-                                             STACK_OF(SSL_CIPHER) *tls13_ciphersuites,
-                                             STACK_OF(SSL_CIPHER) **cipher_list,
-                                             STACK_OF(SSL_CIPHER) **cipher_list_by_id,
-                                             const char *rule_str,
-                                             CERT *c)
+/*
+ * Building the ordered cipher list from a rule string is expensive. Servers
+ * that create many SSL_CTXs typically use the same few rule strings, so the
+ * result is cached. The list only depends on the rule string, the set of
+ * ciphers offered by the method and the ciphers that are disabled because
+ * their algorithms are not available in the SSL_CTX's library context. The
+ * cached SSL_CIPHER pointers refer to the static cipher tables, so entries
+ * can be shared by all SSL_CTXs regardless of their library context.
+ */
+typedef struct {
+    char *rule_str;
+    const SSL_CIPHER *(*get_cipher)(unsigned int ncipher);
+    int dtls;
+    uint32_t disabled_mkey;
+    uint32_t disabled_auth;
+    uint32_t disabled_enc;
+    uint32_t disabled_mac;
+    /* Security level set with @SECLEVEL in the rule string or -1 if none */
+    int sec_level;
+    STACK_OF(SSL_CIPHER) *ciphers;
+} CIPHER_LIST_CACHE_ENTRY;
+
+DEFINE_LHASH_OF_EX(CIPHER_LIST_CACHE_ENTRY);
+
+/* Rule strings are not expected to vary much, so keep the cache small */
+#define CIPHER_LIST_CACHE_MAX   64
+
+static CRYPTO_ONCE cipher_list_cache_once = CRYPTO_ONCE_STATIC_INIT;
+static CRYPTO_RWLOCK *cipher_list_cache_lock = NULL;
+static LHASH_OF(CIPHER_LIST_CACHE_ENTRY) *cipher_list_cache = NULL;
+
+static unsigned long cipher_list_cache_entry_hash(const CIPHER_LIST_CACHE_ENTRY *e)
 {
-    int ok, num_of_ciphers, num_of_alias_max, num_of_group_aliases, i;
-    uint32_t disabled_mkey, disabled_auth, disabled_enc, disabled_mac;
-    STACK_OF(SSL_CIPHER) *cipherstack;
-    const char *rule_p;
-    CIPHER_ORDER *co_list = NULL, *head = NULL, *tail = NULL, *curr;
-    const SSL_CIPHER **ca_list = NULL;
-    const SSL_METHOD *ssl_method = ctx->method;
+    unsigned long hash = OPENSSL_LH_strhash(e->rule_str);
 
-    /*
-     * Return with error if nothing to do.
-     */
-    if (rule_str == NULL || cipher_list == NULL || cipher_list_by_id == NULL)
+    hash = (hash * 23) + e->disabled_mkey;
+    hash = (hash * 23) + e->disabled_auth;
+    hash = (hash * 23) + e->disabled_enc;
+    hash = (hash * 23) + e->disabled_mac;
+    return hash ^ e->dtls;
+}
+
+static int cipher_list_cache_entry_cmp(const CIPHER_LIST_CACHE_ENTRY *a,
+                                       const CIPHER_LIST_CACHE_ENTRY *b)
+{
+    if (a->get_cipher != b->get_cipher
+            || a->dtls != b->dtls
+            || a->disabled_mkey != b->disabled_mkey
+            || a->disabled_auth != b->disabled_auth
+            || a->disabled_enc != b->disabled_enc
+            || a->disabled_mac != b->disabled_mac)
+        return 1;
+    return strcmp(a->rule_str, b->rule_str);
+}
+
+static void cipher_list_cache_entry_free(CIPHER_LIST_CACHE_ENTRY *e)
+{
+    OPENSSL_free(e->rule_str);
+    sk_SSL_CIPHER_free(e->ciphers);
+    OPENSSL_free(e);
+}
+
+static void cipher_list_cache_free(void)
+{
+    lh_CIPHER_LIST_CACHE_ENTRY_doall(cipher_list_cache,
+                                     cipher_list_cache_entry_free);
+    lh_CIPHER_LIST_CACHE_ENTRY_free(cipher_list_cache);
+    cipher_list_cache = NULL;
+    CRYPTO_THREAD_lock_free(cipher_list_cache_lock);
+    cipher_list_cache_lock = NULL;
+}
+
+DEFINE_RUN_ONCE_STATIC(do_cipher_list_cache_init)
+{
+    cipher_list_cache_lock = CRYPTO_THREAD_lock_new();
+    cipher_list_cache = lh_CIPHER_LIST_CACHE_ENTRY_new(cipher_list_cache_entry_hash,
+                                                       cipher_list_cache_entry_cmp);
+    if (cipher_list_cache_lock == NULL || cipher_list_cache == NULL
+            || !OPENSSL_atexit(cipher_list_cache_free)) {
+        cipher_list_cache_free();
+        return 0;
+    }
+    return 1;
+}
+
+/*
+ * Returns a copy of the cached cipher list matching |key| and sets
+ * |key->sec_level|, or NULL if there is none.
+ */
+static STACK_OF(SSL_CIPHER) *cipher_list_cache_get(CIPHER_LIST_CACHE_ENTRY *key)
+{
+    CIPHER_LIST_CACHE_ENTRY *e;
+    STACK_OF(SSL_CIPHER) *ret = NULL;
+
+    if (!RUN_ONCE(&cipher_list_cache_once, do_cipher_list_cache_init)
+            || cipher_list_cache == NULL)
         return NULL;
 
-    if (!check_suiteb_cipher_list(ssl_method, c, &rule_str))
+    if (!CRYPTO_THREAD_read_lock(cipher_list_cache_lock))
         return NULL;
+    e = lh_CIPHER_LIST_CACHE_ENTRY_retrieve(cipher_list_cache, key);
+    if (e != NULL) {
+        ret = sk_SSL_CIPHER_dup(e->ciphers);
+        key->sec_level = e->sec_level;
+    }
+    CRYPTO_THREAD_unlock(cipher_list_cache_lock);
 
-    /*
-     * To reduce the work to do we only want to process the compiled
-     * in algorithms, so we first get the mask of disabled ciphers.
-     */
+    return ret;
+}
+
+/* Adds a copy of |ciphers| to the cache. Failures are silently ignored. */
+static void cipher_list_cache_add(const CIPHER_LIST_CACHE_ENTRY *key,
+                                  const STACK_OF(SSL_CIPHER) *ciphers)
+{
+    CIPHER_LIST_CACHE_ENTRY *e;
+
+    if (cipher_list_cache == NULL
+            || (e = OPENSSL_memdup(key, sizeof(*key))) == NULL)
+        return;
+
+    e->rule_str = OPENSSL_strdup(key->rule_str);
+    e->ciphers = sk_SSL_CIPHER_dup(ciphers);
+    if (e->rule_str == NULL || e->ciphers == NULL) {
+        cipher_list_cache_entry_free(e);
+        return;
+    }
+
+    if (!CRYPTO_THREAD_write_lock(cipher_list_cache_lock)) {
+        cipher_list_cache_entry_free(e);
+        return;
+    }
+    if (lh_CIPHER_LIST_CACHE_ENTRY_num_items(cipher_list_cache)
+            >= CIPHER_LIST_CACHE_MAX
+            || lh_CIPHER_LIST_CACHE_ENTRY_retrieve(cipher_list_cache, e) != NULL) {
+        CRYPTO_THREAD_unlock(cipher_list_cache_lock);
+        cipher_list_cache_entry_free(e);
+        return;
+    }
+    (void)lh_CIPHER_LIST_CACHE_ENTRY_insert(cipher_list_cache, e);
+    if (lh_CIPHER_LIST_CACHE_ENTRY_error(cipher_list_cache) > 0) {
+        CRYPTO_THREAD_unlock(cipher_list_cache_lock);
+        cipher_list_cache_entry_free(e);
+        return;
+    }
+    CRYPTO_THREAD_unlock(cipher_list_cache_lock);
+}
 
-    disabled_mkey = ctx->disabled_mkey_mask;
-    disabled_auth = ctx->disabled_auth_mask;
-    disabled_enc = ctx->disabled_enc_mask;
-    disabled_mac = ctx->disabled_mac_mask;
+/*
+ * Build the list of TLSv1.2 and below ciphers selected by |rule_str| in order
+ * of preference. If the rule string sets a security level it is returned in
+ * |*sec_level|.
+ */
+static STACK_OF(SSL_CIPHER) *ssl_cipher_build_list(const SSL_METHOD *ssl_method,
+                                                   uint32_t disabled_mkey,
+                                                   uint32_t disabled_auth,
+                                                   uint32_t disabled_enc,
+                                                   uint32_t disabled_mac,
+                                                   const char *rule_str,
+                                                   int *sec_level)
+{
+    int ok, num_of_ciphers, num_of_alias_max, num_of_group_aliases;
+    STACK_OF(SSL_CIPHER) *cipherstack;
+    const char *rule_p;
+    CIPHER_ORDER *co_list = NULL, *head = NULL, *tail = NULL, *curr;
+    const SSL_CIPHER **ca_list = NULL;
 
     /*
      * Now we have to collect the available ciphers from the compiled
@@ -1590,14 +1723,14 @@ STACK_OF(SSL_CIPHER) *ssl_create_cipher_list(SSL_CTX *ctx,
     rule_p = rule_str;
     if (HAS_PREFIX(rule_str, "DEFAULT")) {
         ok = ssl_cipher_process_rulestr(OSSL_default_cipher_list(),
-                                        &head, &tail, ca_list, c);
+                                        &head, &tail, ca_list, sec_level);
         rule_p += 7;
         if (*rule_p == ':')
             rule_p++;
     }
 
     if (ok && (rule_p[0] != '\0'))
-        ok = ssl_cipher_process_rulestr(rule_p, &head, &tail, ca_list, c);
+        ok = ssl_cipher_process_rulestr(rule_p, &head, &tail, ca_list, sec_level);
 
     OPENSSL_free(ca_list);      /* Not needed anymore */
 
@@ -1606,12 +1739,78 @@ STACK_OF(SSL_CIPHER) *ssl_create_cipher_list(SSL_CTX *ctx,
         return NULL;
     }
 
+    if ((cipherstack = sk_SSL_CIPHER_new_null()) == NULL) {
+        OPENSSL_free(co_list);
+        return NULL;
+    }
+
+    for (curr = head; curr != NULL; curr = curr->next) {
+        if (curr->active && !sk_SSL_CIPHER_push(cipherstack, curr->cipher)) {
+            OPENSSL_free(co_list);
+            sk_SSL_CIPHER_free(cipherstack);
+            return NULL;
+        }
+    }
+    OPENSSL_free(co_list);      /* Not needed any longer */
+
+    return cipherstack;
+}
+
+STACK_OF(SSL_CIPHER) *ssl_create_cipher_list(SSL_CTX *ctx,
+                                             STACK_OF(SSL_CIPHER) *tls13_ciphersuites,
+                                             STACK_OF(SSL_CIPHER) **cipher_list,
+                                             STACK_OF(SSL_CIPHER) **cipher_list_by_id,
+                                             const char *rule_str,
+                                             CERT *c)
+{
+    int i;
+    STACK_OF(SSL_CIPHER) *cipherstack, *tls12_ciphers;
+    const SSL_METHOD *ssl_method = ctx->method;
+    CIPHER_LIST_CACHE_ENTRY key;
+
+    /*
+     * Return with error if nothing to do.
+     */
+    if (rule_str == NULL || cipher_list == NULL || cipher_list_by_id == NULL)
+        return NULL;
+
+    if (!check_suiteb_cipher_list(ssl_method, c, &rule_str))
+        return NULL;
+
+    /*
+     * To reduce the work to do we only want to process the compiled
+     * in algorithms, so we first get the mask of disabled ciphers.
+     */
+    key.rule_str = (char *)rule_str;
+    key.get_cipher = ssl_method->get_cipher;
+    key.dtls = (ssl_method->ssl3_enc->enc_flags & SSL_ENC_FLAG_DTLS) != 0;
+    key.disabled_mkey = ctx->disabled_mkey_mask;
+    key.disabled_auth = ctx->disabled_auth_mask;
+    key.disabled_enc = ctx->disabled_enc_mask;
+    key.disabled_mac = ctx->disabled_mac_mask;
+    key.sec_level = -1;
+    key.ciphers = NULL;
+
+    tls12_ciphers = cipher_list_cache_get(&key);
+    if (tls12_ciphers == NULL) {
+        tls12_ciphers = ssl_cipher_build_list(ssl_method, key.disabled_mkey,
+                                              key.disabled_auth,
+                                              key.disabled_enc,
+                                              key.disabled_mac, rule_str,
+                                              &key.sec_level);
+        if (tls12_ciphers == NULL)
+            return NULL;
+        cipher_list_cache_add(&key, tls12_ciphers);
+    }
+    if (key.sec_level >= 0)
+        c->sec_level = key.sec_level;
+
     /*
      * Allocate new "cipherstack" for the result, return with error
      * if we cannot get one.
      */
     if ((cipherstack = sk_SSL_CIPHER_new_null()) == NULL) {
-        OPENSSL_free(co_list);
+        sk_SSL_CIPHER_free(tls12_ciphers);
         return NULL;
     }
 
@@ -1620,7 +1819,7 @@ STACK_OF(SSL_CIPHER) *ssl_create_cipher_list(SSL_CTX *ctx,
         const SSL_CIPHER *sslc = sk_SSL_CIPHER_value(tls13_ciphersuites, i);
 
         /* Don't include any TLSv1.3 ciphers that are disabled */
-        if ((sslc->algorithm_enc & disabled_enc) != 0
+        if ((sslc->algorithm_enc & key.disabled_enc) != 0
                 || (ssl_cipher_table_mac[sslc->algorithm2
                                          & SSL_HANDSHAKE_MAC_MASK].mask
                     & ctx->disabled_mac_mask) != 0) {
@@ -1630,7 +1829,7 @@ STACK_OF(SSL_CIPHER) *ssl_create_cipher_list(SSL_CTX *ctx,
         }
 
         if (!sk_SSL_CIPHER_push(cipherstack, sslc)) {
-            OPENSSL_free(co_list);
+            sk_SSL_CIPHER_free(tls12_ciphers);
             sk_SSL_CIPHER_free(cipherstack);
             return NULL;
         }
@@ -1643,19 +1842,19 @@ STACK_OF(SSL_CIPHER) *ssl_create_cipher_list(SSL_CTX *ctx,
      * The cipher selection for the list is done. The ciphers are added
      * to the resulting precedence to the STACK_OF(SSL_CIPHER).
      */
-    for (curr = head; curr != NULL; curr = curr->next) {
-        if (curr->active) {
-            if (!sk_SSL_CIPHER_push(cipherstack, curr->cipher)) {
-                OPENSSL_free(co_list);
-                sk_SSL_CIPHER_free(cipherstack);
-                OSSL_TRACE_CANCEL(TLS_CIPHER);
-                return NULL;
-            }
-            if (trc_out != NULL)
-                BIO_printf(trc_out, "<%s>\n", curr->cipher->name);
+    for (i = 0; i < sk_SSL_CIPHER_num(tls12_ciphers); i++) {
+        const SSL_CIPHER *sslc = sk_SSL_CIPHER_value(tls12_ciphers, i);
+
+        if (!sk_SSL_CIPHER_push(cipherstack, sslc)) {
+            sk_SSL_CIPHER_free(tls12_ciphers);
+            sk_SSL_CIPHER_free(cipherstack);
+            OSSL_TRACE_CANCEL(TLS_CIPHER);
+            return NULL;
         }
+        if (trc_out != NULL)
+            BIO_printf(trc_out, "<%s>\n", sslc->name);
     }
-    OPENSSL_free(co_list);      /* Not needed any longer */
+    sk_SSL_CIPHER_free(tls12_ciphers);
     OSSL_TRACE_END(TLS_CIPHER);
 
     if (!update_cipher_list_by_id(cipher_list_by_id, cipherstack)) {
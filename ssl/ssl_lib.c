@@ -615,6 +615,8 @@ int ossl_ssl_connection_reset(SSL *s)
     sc->first_packet = 0;
 
     sc->key_update = SSL_KEY_UPDATE_NONE;
+    sc->writev_done = 0;
+    ossl_ssl_recvfile_free(sc);
     memset(sc->ext.compress_certificate_from_peer, 0,
            sizeof(sc->ext.compress_certificate_from_peer));
     sc->ext.compress_certificate_sent = 0;
@@ -790,6 +792,9 @@ SSL *ossl_ssl_connection_new_int(SSL_CTX *ctx, const SSL_METHOD *method)
     s->rlayer.record_padding_arg = ctx->record_padding_arg;
     s->rlayer.block_padding = ctx->block_padding;
     s->rlayer.hs_padding = ctx->hs_padding;
+    s->rlayer.dyn_rec_size = ctx->dyn_rec_size;
+    s->rlayer.dyn_rec_threshold = ctx->dyn_rec_threshold;
+    s->rlayer.dyn_rec_idle_ms = ctx->dyn_rec_idle_ms;
     s->sid_ctx_length = ctx->sid_ctx_length;
     if (!ossl_assert(s->sid_ctx_length <= sizeof(s->sid_ctx)))
         goto err;
@@ -1418,6 +1423,8 @@ void ossl_ssl_connection_free(SSL *ssl)
     RECORD_LAYER_clear(&s->rlayer);
 
     BUF_MEM_free(s->init_buf);
+    OPENSSL_free(s->writev_buf);
+    ossl_ssl_recvfile_free(s);
 
     /* add extra stuff */
     sk_SSL_CIPHER_free(s->cipher_list);
@@ -1438,6 +1445,11 @@ void ossl_ssl_connection_free(SSL *ssl)
     /* Free up if allocated */
 
     OPENSSL_free(s->ext.hostname);
+    if (s->clienthello != NULL)
+        ssl_hs_free(s, s->clienthello->pre_proc_exts);
+    ssl_hs_free(s, s->clienthello);
+    /* The arena goes back to the session context's pool, so free it first */
+    ossl_arena_free(s->hs_arena);
     SSL_CTX_free(s->session_ctx);
     OPENSSL_free(s->ext.ecpointformats);
     OPENSSL_free(s->ext.peer_ecpointformats);
@@ -1454,9 +1466,6 @@ void ossl_ssl_connection_free(SSL *ssl)
     OPENSSL_free(s->ext.ocsp.resp);
     OPENSSL_free(s->ext.alpn);
     OPENSSL_free(s->ext.tls13_cookie);
-    if (s->clienthello != NULL)
-        OPENSSL_free(s->clienthello->pre_proc_exts);
-    OPENSSL_free(s->clienthello);
     OPENSSL_free(s->pha_context);
     EVP_MD_CTX_free(s->pha_dgst);
 
@@ -2411,9 +2420,9 @@ int SSL_read_early_data(SSL *s, void *buf, size_t num, size_t *readbytes)
 
 int SSL_get_early_data_status(const SSL *s)
 {
-    const SSL_CONNECTION *sc = SSL_CONNECTION_FROM_CONST_SSL_ONLY(s);
+    /* For QUIC this reports the fate of any 0-RTT data sent */
+    const SSL_CONNECTION *sc = SSL_CONNECTION_FROM_CONST_SSL(s);
 
-    /* TODO(QUIC 0RTT): 0-RTT support */
     if (sc == NULL)
         return 0;
 
@@ -2503,6 +2512,13 @@ int ssl_write_internal(SSL *s, const void *buf, size_t num,
     if (sc == NULL)
         return 0;
 
+    /*
+     * Any interrupted SSL_writev_ex() call is abandoned by a write of
+     * something else. SSL_writev_ex() itself records its progress again once
+     * this returns.
+     */
+    sc->writev_done = 0;
+
     if (sc->handshake_func == NULL) {
         ERR_raise(ERR_LIB_SSL, SSL_R_UNINITIALIZED);
         return -1;
@@ -2652,6 +2668,115 @@ int SSL_write_ex2(SSL *s, const void *buf, size_t num, uint64_t flags,
     return ret;
 }
 
+/*
+ * Find the next piece of an SSL_writev_ex() call to pass to the record layer,
+ * starting |off| bytes into the data. Data is sent straight from the caller's
+ * buffers in multiples of the record size. Anything smaller is gathered, along
+ * with the data which follows it, into a staging buffer, so that it shares a
+ * record rather than going out in a short record of its own. The result only
+ * depends on |off|, so an interrupted call picks up the same piece again when
+ * it is retried.
+ */
+static size_t ssl_writev_next(SSL_CONNECTION *sc, const SSL_IOVEC *iov,
+                              size_t iovcnt, size_t off, size_t frag,
+                              const unsigned char **seg)
+{
+    size_t i, j, rem, len, n;
+
+    for (i = 0; off >= iov[i].data_len; i++)
+        off -= iov[i].data_len;
+
+    rem = iov[i].data_len - off;
+    for (j = i + 1; j < iovcnt && iov[j].data_len == 0; j++)
+        continue;
+
+    if (j == iovcnt || rem >= frag) {
+        *seg = (const unsigned char *)iov[i].data + off;
+        return j == iovcnt ? rem : rem - rem % frag;
+    }
+
+    if (sc->writev_buf == NULL
+            && (sc->writev_buf = OPENSSL_malloc(SSL3_RT_MAX_PLAIN_LENGTH)) == NULL)
+        return 0;
+
+    for (len = 0; i < iovcnt && len < frag; i++, off = 0) {
+        n = iov[i].data_len - off;
+        if (n > frag - len)
+            n = frag - len;
+        memcpy(sc->writev_buf + len, (const unsigned char *)iov[i].data + off,
+               n);
+        len += n;
+    }
+    *seg = sc->writev_buf;
+    return len;
+}
+
+int SSL_writev_ex(SSL *s, const SSL_IOVEC *iov, size_t iovcnt,
+                  size_t *written)
+{
+    SSL_CONNECTION *sc = SSL_CONNECTION_FROM_SSL_ONLY(s);
+    const unsigned char *seg;
+    size_t i, total = 0, off, frag, seglen, segwritten;
+
+    if (sc == NULL) {
+        ERR_raise(ERR_LIB_SSL, ERR_R_UNSUPPORTED);
+        return 0;
+    }
+
+    if (iov == NULL && iovcnt > 0) {
+        ERR_raise(ERR_LIB_SSL, ERR_R_PASSED_NULL_PARAMETER);
+        return 0;
+    }
+
+    for (i = 0; i < iovcnt; i++) {
+        if ((iov[i].data == NULL && iov[i].data_len > 0)
+                || iov[i].data_len > SIZE_MAX - total) {
+            ERR_raise(ERR_LIB_SSL, ERR_R_PASSED_INVALID_ARGUMENT);
+            return 0;
+        }
+        total += iov[i].data_len;
+    }
+
+    off = sc->writev_done;
+    if (off > 0 && (total != sc->writev_total || iovcnt != sc->writev_iovcnt)) {
+        /* Not a retry with the same arguments */
+        sc->writev_done = 0;
+        ERR_raise(ERR_LIB_SSL, SSL_R_BAD_WRITE_RETRY);
+        return 0;
+    }
+
+    frag = ssl_get_max_send_fragment(sc);
+    while (off < total) {
+        seglen = ssl_writev_next(sc, iov, iovcnt, off, frag, &seg);
+        if (seglen == 0) {
+            sc->writev_done = 0;
+            return 0;
+        }
+
+        if (ssl_write_internal(s, seg, seglen, 0, &segwritten) <= 0) {
+            /*
+             * Remember how far we got so that the call can be repeated with
+             * the same arguments
+             */
+            if (SSL_want(s) != SSL_NOTHING) {
+                sc->writev_done = off;
+                sc->writev_total = total;
+                sc->writev_iovcnt = iovcnt;
+            }
+            return 0;
+        }
+        off += segwritten;
+
+        /* Only happens with SSL_MODE_ENABLE_PARTIAL_WRITE */
+        if (segwritten < seglen)
+            break;
+    }
+
+    sc->writev_done = 0;
+    *written = off;
+    return 1;
+}
+
 int SSL_write_early_data(SSL *s, const void *buf, size_t num, size_t *written)
 {
     int ret, early_data_state;
@@ -3926,8 +4051,239 @@ static void do_sslkeylogfile(const SSL *ssl, const char *line)
  * via ssl.h.
  */
 
-SSL_CTX *SSL_CTX_new_ex(OSSL_LIB_CTX *libctx, const char *propq,
-                        const SSL_METHOD *meth)
+/*
+ * Share the tables that are derived from the providers in the library context,
+ * and the cipher lists, with the template |tmpl|. These are never modified
+ * after creation, so there is no need to copy them.
+ */
+static int ssl_ctx_share_template(SSL_CTX *ctx, SSL_CTX *tmpl)
+{
+    size_t i;
+
+    if (!SSL_CTX_up_ref(tmpl))
+        return 0;
+    ctx->tmpl = tmpl;
+
+    for (i = 0; i < SSL_ENC_NUM_IDX; i++) {
+        if (tmpl->ssl_cipher_methods[i] != NULL
+                && !ssl_evp_cipher_up_ref(tmpl->ssl_cipher_methods[i]))
+            return 0;
+        ctx->ssl_cipher_methods[i] = tmpl->ssl_cipher_methods[i];
+    }
+    for (i = 0; i < SSL_MD_NUM_IDX; i++) {
+        if (tmpl->ssl_digest_methods[i] != NULL
+                && !ssl_evp_md_up_ref(tmpl->ssl_digest_methods[i]))
+            return 0;
+        ctx->ssl_digest_methods[i] = tmpl->ssl_digest_methods[i];
+    }
+    memcpy(ctx->ssl_mac_pkey_id, tmpl->ssl_mac_pkey_id,
+           sizeof(ctx->ssl_mac_pkey_id));
+    memcpy(ctx->ssl_mac_secret_size, tmpl->ssl_mac_secret_size,
+           sizeof(ctx->ssl_mac_secret_size));
+    ctx->disabled_enc_mask = tmpl->disabled_enc_mask;
+    ctx->disabled_mac_mask = tmpl->disabled_mac_mask;
+    ctx->disabled_mkey_mask = tmpl->disabled_mkey_mask;
+    ctx->disabled_auth_mask = tmpl->disabled_auth_mask;
+
+    ctx->group_list = tmpl->group_list;
+    ctx->group_list_len = tmpl->group_list_len;
+    ctx->group_list_max_len = tmpl->group_list_max_len;
+    ctx->sigalg_list = tmpl->sigalg_list;
+    ctx->sigalg_list_len = tmpl->sigalg_list_len;
+    ctx->sigalg_list_max_len = tmpl->sigalg_list_max_len;
+    ctx->ssl_cert_info = tmpl->ssl_cert_info;
+    ctx->sigalg_lookup_cache = tmpl->sigalg_lookup_cache;
+    ctx->tls12_sigalgs = tmpl->tls12_sigalgs;
+    ctx->tls12_sigalgs_len = tmpl->tls12_sigalgs_len;
+
+    if (tmpl->ext.supported_groups_default != NULL) {
+        ctx->ext.supported_groups_default
+            = OPENSSL_memdup(tmpl->ext.supported_groups_default,
+                             tmpl->ext.supported_groups_default_len
+                             * sizeof(*tmpl->ext.supported_groups_default));
+        if (ctx->ext.supported_groups_default == NULL)
+            return 0;
+        ctx->ext.supported_groups_default_len
+            = tmpl->ext.supported_groups_default_len;
+    }
+
+    /* The stacks only hold pointers to the static cipher tables */
+    if ((ctx->tls13_ciphersuites
+             = sk_SSL_CIPHER_dup(tmpl->tls13_ciphersuites)) == NULL
+            || (ctx->cipher_list = sk_SSL_CIPHER_dup(tmpl->cipher_list)) == NULL
+            || (ctx->cipher_list_by_id
+                    = sk_SSL_CIPHER_dup(tmpl->cipher_list_by_id)) == NULL)
+        return 0;
+
+    /* Keep the certificate settings but not the certificates and keys */
+    if ((ctx->cert = ssl_cert_dup(tmpl->cert)) == NULL)
+        return 0;
+    ssl_cert_clear_certs(ctx->cert);
+
+    if ((tmpl->md5 != NULL && !ssl_evp_md_up_ref(tmpl->md5))
+            || (tmpl->sha1 != NULL && !ssl_evp_md_up_ref(tmpl->sha1)))
+        return 0;
+    ctx->md5 = tmpl->md5;
+    ctx->sha1 = tmpl->sha1;
+
+    return 1;
+}
+
+/* Copy the configuration of the template |tmpl| which is not per tenant */
+static int ssl_ctx_copy_template_settings(SSL_CTX *ctx, const SSL_CTX *tmpl)
+{
+    X509_STORE *store = tmpl->cert_store;
+
+    ctx->options = tmpl->options;
+    ctx->mode = tmpl->mode;
+    ctx->min_proto_version = tmpl->min_proto_version;
+    ctx->max_proto_version = tmpl->max_proto_version;
+    ctx->max_cert_list = tmpl->max_cert_list;
+    ctx->read_ahead = tmpl->read_ahead;
+    ctx->msg_callback = tmpl->msg_callback;
+    ctx->msg_callback_arg = tmpl->msg_callback_arg;
+    ctx->info_callback = tmpl->info_callback;
+    ctx->verify_mode = tmpl->verify_mode;
+    ctx->default_verify_callback = tmpl->default_verify_callback;
+    ctx->session_cache_mode = tmpl->session_cache_mode;
+    ctx->session_cache_size = tmpl->session_cache_size;
+    ctx->session_timeout = tmpl->session_timeout;
+    ctx->quiet_shutdown = tmpl->quiet_shutdown;
+    ctx->split_send_fragment = tmpl->split_send_fragment;
+    ctx->max_send_fragment = tmpl->max_send_fragment;
+    ctx->max_pipelines = tmpl->max_pipelines;
+    ctx->default_read_buf_len = tmpl->default_read_buf_len;
+    ctx->client_hello_cb = tmpl->client_hello_cb;
+    ctx->client_hello_cb_arg = tmpl->client_hello_cb_arg;
+    ctx->ext.servername_cb = tmpl->ext.servername_cb;
+    ctx->ext.servername_arg = tmpl->ext.servername_arg;
+    ctx->ext.status_type = tmpl->ext.status_type;
+    ctx->ext.max_fragment_len_mode = tmpl->ext.max_fragment_len_mode;
+    ctx->ext.alpn_select_cb = tmpl->ext.alpn_select_cb;
+    ctx->ext.alpn_select_cb_arg = tmpl->ext.alpn_select_cb_arg;
+    ctx->max_early_data = tmpl->max_early_data;
+    ctx->recv_max_early_data = tmpl->recv_max_early_data;
+    ctx->record_padding_cb = tmpl->record_padding_cb;
+    ctx->record_padding_arg = tmpl->record_padding_arg;
+    ctx->block_padding = tmpl->block_padding;
+    ctx->hs_padding = tmpl->hs_padding;
+    ctx->dyn_rec_size = tmpl->dyn_rec_size;
+    ctx->dyn_rec_threshold = tmpl->dyn_rec_threshold;
+    ctx->dyn_rec_idle_ms = tmpl->dyn_rec_idle_ms;
+    ctx->num_tickets = tmpl->num_tickets;
+    ctx->pha_enabled = tmpl->pha_enabled;
+#ifndef OPENSSL_NO_PSK
+    ctx->psk_client_callback = tmpl->psk_client_callback;
+    ctx->psk_server_callback = tmpl->psk_server_callback;
+#endif
+    ctx->psk_find_session_cb = tmpl->psk_find_session_cb;
+    ctx->psk_use_session_cb = tmpl->psk_use_session_cb;
+    ctx->keylog_callback = tmpl->keylog_callback;
+    ctx->default_passwd_callback = tmpl->default_passwd_callback;
+    ctx->default_passwd_callback_userdata =
+        tmpl->default_passwd_callback_userdata;
+    ctx->sid_ctx_length = tmpl->sid_ctx_length;
+    memcpy(ctx->sid_ctx, tmpl->sid_ctx, sizeof(ctx->sid_ctx));
+#ifndef OPENSSL_NO_COMP_ALG
+    memcpy(ctx->cert_comp_prefs, tmpl->cert_comp_prefs,
+           sizeof(ctx->cert_comp_prefs));
+#endif
+
+    if (!X509_VERIFY_PARAM_set1(ctx->param, tmpl->param))
+        return 0;
+
+    /* The trust store is usually the same for all tenants, so share it */
+    if (!X509_STORE_up_ref(store))
+        return 0;
+    X509_STORE_free(ctx->cert_store);
+    ctx->cert_store = store;
+
+    if (tmpl->ext.ecpointformats != NULL) {
+        ctx->ext.ecpointformats = OPENSSL_memdup(tmpl->ext.ecpointformats,
+                                                 tmpl->ext.ecpointformats_len);
+        if (ctx->ext.ecpointformats == NULL)
+            return 0;
+        ctx->ext.ecpointformats_len = tmpl->ext.ecpointformats_len;
+    }
+    if (tmpl->ext.supportedgroups != NULL) {
+        ctx->ext.supportedgroups
+            = OPENSSL_memdup(tmpl->ext.supportedgroups,
+                             tmpl->ext.supportedgroups_len
+                             * sizeof(*tmpl->ext.supportedgroups));
+        if (ctx->ext.supportedgroups == NULL)
+            return 0;
+        ctx->ext.supportedgroups_len = tmpl->ext.supportedgroups_len;
+    }
+    if (tmpl->ext.alpn != NULL) {
+        ctx->ext.alpn = OPENSSL_memdup(tmpl->ext.alpn, tmpl->ext.alpn_len);
+        if (ctx->ext.alpn == NULL)
+            return 0;
+        ctx->ext.alpn_len = tmpl->ext.alpn_len;
+    }
+
+    return 1;
+}
+
+/*
+ * Load the tables derived from the providers in the library context and set up
+ * the default cipher lists and certificate settings.
+ */
+static int ssl_ctx_load_tables(SSL_CTX *ret)
+{
+    /* initialize cipher/digest methods table */
+    if (!ssl_load_ciphers(ret)) {
+        ERR_raise(ERR_LIB_SSL, ERR_R_SSL_LIB);
+        return 0;
+    }
+
+    if (!ssl_load_groups(ret)) {
+        ERR_raise(ERR_LIB_SSL, ERR_R_SSL_LIB);
+        return 0;
+    }
+
+    /* load provider sigalgs */
+    if (!ssl_load_sigalgs(ret)) {
+        ERR_raise(ERR_LIB_SSL, ERR_R_SSL_LIB);
+        return 0;
+    }
+
+    /* initialise sig algs */
+    if (!ssl_setup_sigalgs(ret)) {
+        ERR_raise(ERR_LIB_SSL, ERR_R_SSL_LIB);
+        return 0;
+    }
+
+    if (!SSL_CTX_set_ciphersuites(ret, OSSL_default_ciphersuites())) {
+        ERR_raise(ERR_LIB_SSL, ERR_R_SSL_LIB);
+        return 0;
+    }
+
+    if ((ret->cert = ssl_cert_new(SSL_PKEY_NUM + ret->sigalg_list_len)) == NULL) {
+        ERR_raise(ERR_LIB_SSL, ERR_R_SSL_LIB);
+        return 0;
+    }
+
+    if (!ssl_create_cipher_list(ret,
+                                ret->tls13_ciphersuites,
+                                &ret->cipher_list, &ret->cipher_list_by_id,
+                                OSSL_default_cipher_list(), ret->cert)
+        || sk_SSL_CIPHER_num(ret->cipher_list) <= 0) {
+        ERR_raise(ERR_LIB_SSL, SSL_R_LIBRARY_HAS_NO_CIPHERS);
+        return 0;
+    }
+
+    /*
+     * If these aren't available from the provider we'll get NULL returns.
+     * That's fine but will cause errors later if SSLv3 is negotiated
+     */
+    ret->md5 = ssl_evp_md_fetch(ret->libctx, NID_md5, ret->propq);
+    ret->sha1 = ssl_evp_md_fetch(ret->libctx, NID_sha1, ret->propq);
+
+    return 1;
+}
+
+static SSL_CTX *ssl_ctx_new_int(OSSL_LIB_CTX *libctx, const char *propq,
+                                const SSL_METHOD *meth, SSL_CTX *tmpl)
 {
     SSL_CTX *ret = NULL;
 #ifndef OPENSSL_NO_SSLKEYLOG
@@ -4011,45 +4367,12 @@ SSL_CTX *SSL_CTX_new_ex(OSSL_LIB_CTX *libctx, const char *propq,
     }
 #endif
 
-    /* initialize cipher/digest methods table */
-    if (!ssl_load_ciphers(ret)) {
-        ERR_raise(ERR_LIB_SSL, ERR_R_SSL_LIB);
-        goto err;
-    }
-
-    if (!ssl_load_groups(ret)) {
-        ERR_raise(ERR_LIB_SSL, ERR_R_SSL_LIB);
-        goto err;
-    }
-
-    /* load provider sigalgs */
-    if (!ssl_load_sigalgs(ret)) {
-        ERR_raise(ERR_LIB_SSL, ERR_R_SSL_LIB);
-        goto err;
-    }
-
-    /* initialise sig algs */
-    if (!ssl_setup_sigalgs(ret)) {
-        ERR_raise(ERR_LIB_SSL, ERR_R_SSL_LIB);
-        goto err;
-    }
-
-    if (!SSL_CTX_set_ciphersuites(ret, OSSL_default_ciphersuites())) {
-        ERR_raise(ERR_LIB_SSL, ERR_R_SSL_LIB);
-        goto err;
-    }
-
-    if ((ret->cert = ssl_cert_new(SSL_PKEY_NUM + ret->sigalg_list_len)) == NULL) {
-        ERR_raise(ERR_LIB_SSL, ERR_R_SSL_LIB);
-        goto err;
-    }
-
-    if (!ssl_create_cipher_list(ret,
-                                ret->tls13_ciphersuites,
-                                &ret->cipher_list, &ret->cipher_list_by_id,
-                                OSSL_default_cipher_list(), ret->cert)
-        || sk_SSL_CIPHER_num(ret->cipher_list) <= 0) {
-        ERR_raise(ERR_LIB_SSL, SSL_R_LIBRARY_HAS_NO_CIPHERS);
+    if (tmpl != NULL) {
+        if (!ssl_ctx_share_template(ret, tmpl)) {
+            ERR_raise(ERR_LIB_SSL, ERR_R_SSL_LIB);
+            goto err;
+        }
+    } else if (!ssl_ctx_load_tables(ret)) {
         goto err;
     }
 
@@ -4059,13 +4382,6 @@ SSL_CTX *SSL_CTX_new_ex(OSSL_LIB_CTX *libctx, const char *propq,
         goto err;
     }
 
-    /*
-     * If these aren't available from the provider we'll get NULL returns.
-     * That's fine but will cause errors later if SSLv3 is negotiated
-     */
-    ret->md5 = ssl_evp_md_fetch(libctx, NID_md5, propq);
-    ret->sha1 = ssl_evp_md_fetch(libctx, NID_sha1, propq);
-
     if ((ret->ca_names = sk_X509_NAME_new_null()) == NULL) {
         ERR_raise(ERR_LIB_SSL, ERR_R_CRYPTO_LIB);
         goto err;
@@ -4188,7 +4504,13 @@ SSL_CTX *SSL_CTX_new_ex(OSSL_LIB_CTX *libctx, const char *propq,
     /* By default we send two session tickets automatically in TLSv1.3 */
     ret->num_tickets = 2;
 
-    if (!ssl_ctx_system_config(ret)) {
+    if (tmpl != NULL) {
+        /* The system configuration has already been applied to |tmpl| */
+        if (!ssl_ctx_copy_template_settings(ret, tmpl)) {
+            ERR_raise(ERR_LIB_SSL, ERR_R_SSL_LIB);
+            goto err;
+        }
+    } else if (!ssl_ctx_system_config(ret)) {
         ERR_raise(ERR_LIB_SSL, SSL_R_ERROR_IN_SYSTEM_DEFAULT_CONFIG);
         goto err;
     }
@@ -4241,11 +4563,27 @@ out:
     return NULL;
 }
 
+SSL_CTX *SSL_CTX_new_ex(OSSL_LIB_CTX *libctx, const char *propq,
+                        const SSL_METHOD *meth)
+{
+    return ssl_ctx_new_int(libctx, propq, meth, NULL);
+}
+
 SSL_CTX *SSL_CTX_new(const SSL_METHOD *meth)
 {
     return SSL_CTX_new_ex(NULL, NULL, meth);
 }
 
+SSL_CTX *SSL_CTX_new_from_template(SSL_CTX *tmpl)
+{
+    if (tmpl == NULL) {
+        ERR_raise(ERR_LIB_SSL, ERR_R_PASSED_NULL_PARAMETER);
+        return NULL;
+    }
+
+    return ssl_ctx_new_int(tmpl->libctx, tmpl->propq, tmpl->method, tmpl);
+}
+
 int SSL_CTX_up_ref(SSL_CTX *ctx)
 {
     int i;
@@ -4258,6 +4596,35 @@ int SSL_CTX_up_ref(SSL_CTX *ctx)
     return ((i > 1) ? 1 : 0);
 }
 
+/* Free the tables that are not shared with a template */
+static void ssl_ctx_free_tables(SSL_CTX *a)
+{
+    size_t j;
+
+    for (j = 0; j < a->group_list_len; j++) {
+        OPENSSL_free(a->group_list[j].tlsname);
+        OPENSSL_free(a->group_list[j].realname);
+        OPENSSL_free(a->group_list[j].algorithm);
+    }
+    OPENSSL_free(a->group_list);
+    for (j = 0; j < a->sigalg_list_len; j++) {
+        OPENSSL_free(a->sigalg_list[j].name);
+        OPENSSL_free(a->sigalg_list[j].sigalg_name);
+        OPENSSL_free(a->sigalg_list[j].sigalg_oid);
+        OPENSSL_free(a->sigalg_list[j].sig_name);
+        OPENSSL_free(a->sigalg_list[j].sig_oid);
+        OPENSSL_free(a->sigalg_list[j].hash_name);
+        OPENSSL_free(a->sigalg_list[j].hash_oid);
+        OPENSSL_free(a->sigalg_list[j].keytype);
+        OPENSSL_free(a->sigalg_list[j].keytype_oid);
+    }
+    OPENSSL_free(a->sigalg_list);
+    OPENSSL_free(a->ssl_cert_info);
+
+    OPENSSL_free(a->sigalg_lookup_cache);
+    OPENSSL_free(a->tls12_sigalgs);
+}
+
 void SSL_CTX_free(SSL_CTX *a)
 {
     int i;
@@ -4333,31 +4700,14 @@ void SSL_CTX_free(SSL_CTX *a)
         ssl_evp_cipher_free(a->ssl_cipher_methods[j]);
     for (j = 0; j < SSL_MD_NUM_IDX; j++)
         ssl_evp_md_free(a->ssl_digest_methods[j]);
-    for (j = 0; j < a->group_list_len; j++) {
-        OPENSSL_free(a->group_list[j].tlsname);
-        OPENSSL_free(a->group_list[j].realname);
-        OPENSSL_free(a->group_list[j].algorithm);
-    }
-    OPENSSL_free(a->group_list);
-    for (j = 0; j < a->sigalg_list_len; j++) {
-        OPENSSL_free(a->sigalg_list[j].name);
-        OPENSSL_free(a->sigalg_list[j].sigalg_name);
-        OPENSSL_free(a->sigalg_list[j].sigalg_oid);
-        OPENSSL_free(a->sigalg_list[j].sig_name);
-        OPENSSL_free(a->sigalg_list[j].sig_oid);
-        OPENSSL_free(a->sigalg_list[j].hash_name);
-        OPENSSL_free(a->sigalg_list[j].hash_oid);
-        OPENSSL_free(a->sigalg_list[j].keytype);
-        OPENSSL_free(a->sigalg_list[j].keytype_oid);
-    }
-    OPENSSL_free(a->sigalg_list);
-    OPENSSL_free(a->ssl_cert_info);
-
-    OPENSSL_free(a->sigalg_lookup_cache);
-    OPENSSL_free(a->tls12_sigalgs);
+    if (a->tmpl == NULL)
+        ssl_ctx_free_tables(a);
+    else
+        SSL_CTX_free(a->tmpl);
 
     OPENSSL_free(a->client_cert_type);
     OPENSSL_free(a->server_cert_type);
+    ossl_arena_pool_free(a->hs_arena_pool);
 
     CRYPTO_THREAD_lock_free(a->lock);
     CRYPTO_FREE_REF(&a->references);
@@ -5933,6 +6283,52 @@ int SSL_set_block_padding(SSL *ssl, size_t block_size)
     return SSL_set_block_padding_ex(ssl, block_size, block_size);
 }
 
+int SSL_CTX_set_dynamic_record_size(SSL_CTX *ctx, size_t init_len,
+                                    size_t threshold, uint64_t idle_ms)
+{
+    if (IS_QUIC_CTX(ctx) && init_len > 0)
+        return 0;
+
+    /* Same range as accepted by SSL_CTX_set_max_send_fragment() */
+    if (init_len > 0
+            && (init_len < 512 || init_len > SSL3_RT_MAX_PLAIN_LENGTH))
+        return 0;
+
+    ctx->dyn_rec_size = init_len;
+    ctx->dyn_rec_threshold = threshold;
+    ctx->dyn_rec_idle_ms = idle_ms;
+    return 1;
+}
+
+int SSL_set_dynamic_record_size(SSL *ssl, size_t init_len, size_t threshold,
+                                uint64_t idle_ms)
+{
+    OSSL_PARAM options[4], *opts = options;
+    SSL_CONNECTION *sc = SSL_CONNECTION_FROM_SSL(ssl);
+
+    if (sc == NULL || (IS_QUIC(ssl) && init_len > 0))
+        return 0;
+
+    if (init_len > 0
+            && (init_len < 512 || init_len > SSL3_RT_MAX_PLAIN_LENGTH))
+        return 0;
+
+    sc->rlayer.dyn_rec_size = init_len;
+    sc->rlayer.dyn_rec_threshold = threshold;
+    sc->rlayer.dyn_rec_idle_ms = idle_ms;
+
+    /* Apply the new settings to the current write record layer too */
+    *opts++ = OSSL_PARAM_construct_size_t(OSSL_LIBSSL_RECORD_LAYER_PARAM_DYN_REC_SIZE,
+                                          &sc->rlayer.dyn_rec_size);
+    *opts++ = OSSL_PARAM_construct_size_t(OSSL_LIBSSL_RECORD_LAYER_PARAM_DYN_REC_THRESHOLD,
+                                          &sc->rlayer.dyn_rec_threshold);
+    *opts++ = OSSL_PARAM_construct_uint64(OSSL_LIBSSL_RECORD_LAYER_PARAM_DYN_REC_IDLE,
+                                          &sc->rlayer.dyn_rec_idle_ms);
+    *opts = OSSL_PARAM_construct_end();
+
+    return sc->rlayer.wrlmethod->set_options(sc->rlayer.wrl, options);
+}
+
 int SSL_set_num_tickets(SSL *s, size_t num_tickets)
 {
     SSL_CONNECTION *sc = SSL_CONNECTION_FROM_SSL(s);
@@ -5972,34 +6368,35 @@ int ssl_handshake_hash(SSL_CONNECTION *s,
                        unsigned char *out, size_t outlen,
                        size_t *hashlen)
 {
-    EVP_MD_CTX *ctx = NULL;
+    EVP_MD_CTX *ctx = s->s3.handshake_dgst_snap;
     EVP_MD_CTX *hdgst = s->s3.handshake_dgst;
     int hashleni = EVP_MD_CTX_get_size(hdgst);
-    int ret = 0;
 
     if (hashleni < 0 || (size_t)hashleni > outlen) {
         SSLfatal(s, SSL_AD_INTERNAL_ERROR, ERR_R_INTERNAL_ERROR);
-        goto err;
+        return 0;
     }
 
-    ctx = EVP_MD_CTX_new();
+    /*
+     * The scratch context is reused for every snapshot of the transcript, so
+     * once it has been set up the copy below does not need to allocate.
+     */
     if (ctx == NULL) {
-        SSLfatal(s, SSL_AD_INTERNAL_ERROR, ERR_R_INTERNAL_ERROR);
-        goto err;
+        ctx = s->s3.handshake_dgst_snap = EVP_MD_CTX_new();
+        if (ctx == NULL) {
+            SSLfatal(s, SSL_AD_INTERNAL_ERROR, ERR_R_INTERNAL_ERROR);
+            return 0;
+        }
     }
 
     if (!EVP_MD_CTX_copy_ex(ctx, hdgst)
         || EVP_DigestFinal_ex(ctx, out, NULL) <= 0) {
         SSLfatal(s, SSL_AD_INTERNAL_ERROR, ERR_R_INTERNAL_ERROR);
-        goto err;
+        return 0;
     }
 
     *hashlen = hashleni;
-
-    ret = 1;
- err:
-    EVP_MD_CTX_free(ctx);
-    return ret;
+    return 1;
 }
 
 int SSL_session_reused(const SSL *s)
@@ -7196,6 +7593,57 @@ __owur unsigned int ssl_get_max_send_fragment(const SSL_CONNECTION *sc)
     return sc->max_send_fragment;
 }
 
+/*
+ * The pool is only created once a connection needs a handshake arena, which
+ * happens once per handshake.
+ */
+static OSSL_ARENA_POOL *ssl_ctx_get_hs_arena_pool(SSL_CTX *ctx)
+{
+    OSSL_ARENA_POOL *pool;
+
+    if (!CRYPTO_THREAD_read_lock(ctx->lock))
+        return NULL;
+    pool = ctx->hs_arena_pool;
+    CRYPTO_THREAD_unlock(ctx->lock);
+    if (pool != NULL)
+        return pool;
+
+    if (!CRYPTO_THREAD_write_lock(ctx->lock))
+        return NULL;
+    /* Room for the chunks of a few dozen concurrent handshake arenas */
+    if (ctx->hs_arena_pool == NULL)
+        ctx->hs_arena_pool = ossl_arena_pool_new(64);
+    pool = ctx->hs_arena_pool;
+    CRYPTO_THREAD_unlock(ctx->lock);
+    return pool;
+}
+
+/*
+ * Allocate memory that does not outlive the current handshake.  It comes from
+ * the connection's handshake arena, which is released in bulk when the
+ * handshake finishes, and falls back to OPENSSL_zalloc() if the arena cannot
+ * be used.  Either way it must be released with ssl_hs_free().
+ */
+void *ssl_hs_zalloc(SSL_CONNECTION *s, size_t num)
+{
+    void *ret;
+    OSSL_ARENA_POOL *pool;
+
+    if (s->hs_arena == NULL
+            && (pool = ssl_ctx_get_hs_arena_pool(s->session_ctx)) != NULL)
+        s->hs_arena = ossl_arena_new(pool, 0);
+    if (s->hs_arena != NULL
+            && (ret = ossl_arena_zalloc(s->hs_arena, num)) != NULL)
+        return ret;
+    return OPENSSL_zalloc(num);
+}
+
+void ssl_hs_free(SSL_CONNECTION *s, void *ptr)
+{
+    if (!ossl_arena_owns(s->hs_arena, ptr))
+        OPENSSL_free(ptr);
+}
+
 __owur unsigned int ssl_get_split_send_fragment(const SSL_CONNECTION *sc)
 {
     /* Return a value regarding an active Max Fragment Len extension */
@@ -35,6 +35,7 @@
 # include "internal/bio.h"
 # include "internal/ktls.h"
 # include "internal/time.h"
+# include "internal/arena.h"
 # include "internal/ssl.h"
 # include "internal/cryptlib.h"
 # include "record/record.h"
@@ -542,6 +543,13 @@ struct ssl_session_st {
         /* The ALPN protocol selected for this session */
         unsigned char *alpn_selected;
         size_t alpn_selected_len;
+        /*
+         * Encoded QUIC transport parameters received from the server, kept by
+         * clients so that 0-RTT data can be sent within the limits they
+         * impose when the session is resumed (RFC 9000 s. 7.4.1).
+         */
+        unsigned char *quic_transport_params;
+        size_t quic_transport_params_len;
         /*
          * Maximum Fragment Length as per RFC 4366.
          * If this value does not contain RFC 4366 allowed values (1-4) then
@@ -1124,6 +1132,11 @@ struct ssl_ctx_st {
     size_t block_padding;
     size_t hs_padding;
 
+    /* Dynamic record sizing, disabled if dyn_rec_size is 0 */
+    size_t dyn_rec_size;
+    size_t dyn_rec_threshold;
+    uint64_t dyn_rec_idle_ms;
+
     /* Session ticket appdata */
     SSL_CTX_generate_session_ticket_fn generate_ticket_cb;
     SSL_CTX_decrypt_session_ticket_fn decrypt_ticket_cb;
@@ -1170,6 +1183,12 @@ struct ssl_ctx_st {
     uint32_t disabled_mkey_mask;
     uint32_t disabled_auth_mask;
 
+    /*
+     * The template this SSL_CTX was created from, if any. The group and
+     * sigalg tables above are then owned by the template and shared.
+     */
+    SSL_CTX *tmpl;
+
 #ifndef OPENSSL_NO_COMP_ALG
     /* certificate compression preferences */
     int cert_comp_prefs[TLSEXT_comp_cert_limit];
@@ -1184,6 +1203,12 @@ struct ssl_ctx_st {
 # ifndef OPENSSL_NO_QLOG
     char *qlog_title; /* Session title for qlog */
 # endif
+
+    /*
+     * Chunks shared by the handshake arenas of all connections, created on
+     * first use and protected by |lock|
+     */
+    OSSL_ARENA_POOL *hs_arena_pool;
 };
 
 typedef struct cert_pkey_st CERT_PKEY;
@@ -1274,6 +1299,12 @@ struct ssl_connection_st {
          * freed and MD_CTX for the required digest is stored here.
          */
         EVP_MD_CTX *handshake_dgst;
+        /*
+         * Scratch context that handshake_dgst is copied into to take the
+         * current transcript hash. It is kept for the whole handshake, so
+         * that taking a snapshot does not need any allocations.
+         */
+        EVP_MD_CTX *handshake_dgst_snap;
         /*
          * Set whenever an expected ChangeCipherSpec message is processed.
          * Unset when the peer's Finished message is received.
@@ -1681,6 +1712,13 @@ struct ssl_connection_st {
      */
     CLIENTHELLO_MSG *clienthello;
 
+    /*
+     * Handshake messages are parsed into here, see ssl_hs_zalloc().  Freed
+     * when the handshake finishes, so that idle connections do not hold on
+     * to its memory.
+     */
+    OSSL_ARENA *hs_arena;
+
     /*-
      * no further mod of servername
      * 0 : call the servername extension callback.
@@ -1740,6 +1778,24 @@ struct ssl_connection_st {
     /* Record layer data */
     RECORD_LAYER rlayer;
 
+    /*
+     * Used by SSL_writev_ex() to gather small iovecs into whole records. For
+     * an interrupted SSL_writev_ex() call, the number of bytes already sent
+     * and the shape of the call, which a retry must match.
+     */
+    unsigned char *writev_buf;
+    size_t writev_done;
+    size_t writev_total;
+    size_t writev_iovcnt;
+
+    /*
+     * Pipe used by SSL_recvfile() to move received data to the file, and the
+     * number of bytes in it which have not been written to the file yet
+     */
+    int recvfile_pipe[2];
+    int recvfile_have_pipe;
+    size_t recvfile_pending;
+
     /* Default password callback. */
     pem_password_cb *default_passwd_callback;
     /* Default password callback user data. */
@@ -2476,6 +2532,7 @@ __owur int ossl_ssl_init(SSL *ssl, SSL_CTX *ctx, const SSL_METHOD *method,
 __owur SSL *ossl_ssl_connection_new_int(SSL_CTX *ctx, const SSL_METHOD *method);
 __owur SSL *ossl_ssl_connection_new(SSL_CTX *ctx);
 void ossl_ssl_connection_free(SSL *ssl);
+void ossl_ssl_recvfile_free(SSL_CONNECTION *s);
 __owur int ossl_ssl_connection_reset(SSL *ssl);
 
 __owur int ssl_read_internal(SSL *s, void *buf, size_t num, size_t *readbytes);
@@ -2587,6 +2644,8 @@ __owur EVP_PKEY *ssl_dh_to_pkey(DH *dh);
 __owur int ssl_set_tmp_ecdh_groups(uint16_t **pext, size_t *pextlen,
                                    void *key);
 __owur unsigned int ssl_get_max_send_fragment(const SSL_CONNECTION *sc);
+void *ssl_hs_zalloc(SSL_CONNECTION *s, size_t num);
+void ssl_hs_free(SSL_CONNECTION *s, void *ptr);
 __owur unsigned int ssl_get_split_send_fragment(const SSL_CONNECTION *sc);
 
 __owur const SSL_CIPHER *ssl3_get_cipher_by_id(uint32_t id);
@@ -3000,6 +3059,9 @@ static ossl_unused ossl_inline void ssl_tsan_counter(const SSL_CTX *ctx,
 
 int ossl_comp_has_alg(int a);
 size_t ossl_calculate_comp_expansion(int alg, size_t length);
+# ifndef OPENSSL_NO_COMP_ALG
+int ossl_ssl_auto_compress_cert(SSL_CONNECTION *sc, CERT_PKEY *cpk, int alg);
+# endif
 
 void ossl_ssl_set_custom_record_layer(SSL_CONNECTION *s,
                                       const OSSL_RECORD_METHOD *meth,
@@ -3064,6 +3126,7 @@ long ossl_ctrl_internal(SSL *s, int cmd, long larg, void *parg, int no_quic);
      SSL_OP_DISABLE_TLSEXT_CA_NAMES           | \
      SSL_OP_NO_TX_CERTIFICATE_COMPRESSION     | \
      SSL_OP_NO_RX_CERTIFICATE_COMPRESSION     | \
+     SSL_OP_AUTO_CERTIFICATE_COMPRESSION      | \
      SSL_OP_PRIORITIZE_CHACHA                 | \
      SSL_OP_NO_QUERY_MTU                      | \
      SSL_OP_NO_TICKET                         | \
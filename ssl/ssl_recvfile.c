@@ -0,0 +1,207 @@
+/*
+ * Copyright 2025 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+/*
+ * This is kept apart from ssl_lib.c so that _GNU_SOURCE, which is needed for
+ * splice() to be declared, does not change the rest of libssl.
+ */
+#ifndef _GNU_SOURCE
+# define _GNU_SOURCE
+#endif
+
+#include "internal/e_os.h"
+#include "ssl_local.h"
+
+#ifdef OPENSSL_KTLS_RECVFILE
+static int ssl_recvfile_pipe(SSL_CONNECTION *sc)
+{
+    if (sc->recvfile_have_pipe)
+        return 1;
+
+    if (pipe(sc->recvfile_pipe) < 0) {
+        ERR_raise_data(ERR_LIB_SYS, get_last_sys_error(),
+                       "calling pipe()");
+        return 0;
+    }
+# ifdef F_GETPIPE_SZ
+    /* Make sure that a whole record always fits into the pipe */
+    if (fcntl(sc->recvfile_pipe[0], F_GETPIPE_SZ) < SSL3_RT_MAX_PLAIN_LENGTH
+            && fcntl(sc->recvfile_pipe[0], F_SETPIPE_SZ,
+                     SSL3_RT_MAX_PLAIN_LENGTH) < 0) {
+        ERR_raise_data(ERR_LIB_SYS, get_last_sys_error(),
+                       "calling fcntl()");
+        close(sc->recvfile_pipe[0]);
+        close(sc->recvfile_pipe[1]);
+        return 0;
+    }
+# endif
+    sc->recvfile_have_pipe = 1;
+    return 1;
+}
+
+/*
+ * Read the next record through the record layer, and put what we read into
+ * the pipe. This is used to drain anything already buffered in the record
+ * layer, and to process control records, which the kernel will not splice.
+ * The pipe is empty when this is called.
+ */
+static ossl_ssize_t ssl_recvfile_read(SSL *s, SSL_CONNECTION *sc, size_t size)
+{
+    unsigned char *buf;
+    size_t readbytes, done;
+    ossl_ssize_t ret;
+
+    if (size > SSL3_RT_MAX_PLAIN_LENGTH)
+        size = SSL3_RT_MAX_PLAIN_LENGTH;
+
+    if ((buf = OPENSSL_malloc(size)) == NULL)
+        return -1;
+
+    ret = ssl_read_internal(s, buf, size, &readbytes);
+    if (ret <= 0)
+        goto end;
+
+    for (done = 0; done < readbytes; done += ret) {
+        ret = write(sc->recvfile_pipe[1], buf + done, readbytes - done);
+        if (ret <= 0) {
+            /* Cannot happen, the pipe has room for a whole record */
+            ERR_raise_data(ERR_LIB_SSL, ERR_R_INTERNAL_ERROR,
+                           "recvfile pipe write failure");
+            ret = -1;
+            goto end;
+        }
+    }
+    sc->recvfile_pending = readbytes;
+    ret = (ossl_ssize_t)readbytes;
+ end:
+    OPENSSL_clear_free(buf, size);
+    return ret;
+}
+
+/*
+ * Write up to |size| bytes of the data waiting in the pipe to |fd|. If only
+ * part of it could be written then the rest is kept for the next call.
+ */
+static ossl_ssize_t ssl_recvfile_write(SSL_CONNECTION *sc, int fd,
+                                       off_t offset, size_t size, int flags)
+{
+    size_t done = 0;
+    ossl_ssize_t ret = 0;
+
+    if (size > sc->recvfile_pending)
+        size = sc->recvfile_pending;
+
+    while (done < size) {
+        ret = ktls_splice_write(sc->recvfile_pipe[0], fd,
+                                offset < 0 ? NULL : &offset, size - done,
+                                flags);
+        if (ret <= 0)
+            break;
+        done += ret;
+        sc->recvfile_pending -= ret;
+    }
+    if (done > 0)
+        return (ossl_ssize_t)done;
+
+    /* Nothing was written, this is a failure of |fd| rather than of |s| */
+    ERR_raise_data(ERR_LIB_SYS, ret < 0 ? get_last_sys_error() : EIO,
+                   "recvfile write failure");
+    return -1;
+}
+#endif
+
+void ossl_ssl_recvfile_free(SSL_CONNECTION *s)
+{
+#ifdef OPENSSL_KTLS_RECVFILE
+    if (s->recvfile_have_pipe) {
+        close(s->recvfile_pipe[0]);
+        close(s->recvfile_pipe[1]);
+    }
+#endif
+    s->recvfile_have_pipe = 0;
+    s->recvfile_pending = 0;
+}
+
+ossl_ssize_t SSL_recvfile(SSL *s, int fd, off_t offset, size_t size, int flags)
+{
+    SSL_CONNECTION *sc = SSL_CONNECTION_FROM_SSL_ONLY(s);
+#ifdef OPENSSL_KTLS_RECVFILE
+    ossl_ssize_t ret;
+#endif
+
+    if (sc == NULL)
+        return 0;
+
+    if (sc->handshake_func == NULL) {
+        ERR_raise(ERR_LIB_SSL, SSL_R_UNINITIALIZED);
+        return -1;
+    }
+
+    if (sc->recvfile_pending == 0 && (sc->shutdown & SSL_RECEIVED_SHUTDOWN)) {
+        sc->rwstate = SSL_NOTHING;
+        return 0;
+    }
+
+    if (!BIO_get_ktls_recv(sc->rbio)) {
+        ERR_raise(ERR_LIB_SSL, SSL_R_UNINITIALIZED);
+        return -1;
+    }
+
+#ifndef OPENSSL_KTLS_RECVFILE
+    ERR_raise_data(ERR_LIB_SSL, ERR_R_INTERNAL_ERROR,
+                   "can't call ktls_recvfile(), not supported");
+    return -1;
+#else
+    if (size == 0)
+        return 0;
+
+    /* Data received by an earlier call has to be written out first */
+    if (sc->recvfile_pending == 0) {
+        if (!ssl_recvfile_pipe(sc))
+            return -1;
+
+        /* Anything the record layer has already read goes next */
+        if (SSL_has_pending(s)) {
+            ret = ssl_recvfile_read(s, sc, size);
+            if (ret <= 0)
+                return ret;
+        } else {
+            sc->rwstate = SSL_READING;
+            ret = ktls_splice_read(SSL_get_rfd(s), sc->recvfile_pipe[1], size,
+                                   flags);
+            if (ret < 0) {
+                if (get_last_sys_error() == EINVAL) {
+                    /* The next record is not application data */
+                    sc->rwstate = SSL_NOTHING;
+                    ret = ssl_recvfile_read(s, sc, size);
+                    if (ret <= 0)
+                        return ret;
+                } else {
+                    if (get_last_sys_error() == EAGAIN
+                            || get_last_sys_error() == EINTR) {
+                        BIO_set_retry_read(sc->rbio);
+                    } else {
+                        sc->rwstate = SSL_NOTHING;
+                        ERR_raise_data(ERR_LIB_SYS, get_last_sys_error(),
+                                       "ktls_splice_read failure");
+                    }
+                    return -1;
+                }
+            } else {
+                sc->rwstate = SSL_NOTHING;
+                if (ret == 0)
+                    return 0;
+                sc->recvfile_pending = ret;
+            }
+        }
+    }
+
+    return ssl_recvfile_write(sc, fd, offset, size, flags);
+#endif
+}
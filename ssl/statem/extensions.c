@@ -625,7 +625,7 @@ int tls_collect_extensions(SSL_CONNECTION *s, PACKET *packet,
         custom_ext_init(&s->cert->custext);
 
     num_exts = OSSL_NELEM(ext_defs) + (exts != NULL ? exts->meths_count : 0);
-    raw_extensions = OPENSSL_zalloc(num_exts * sizeof(*raw_extensions));
+    raw_extensions = ssl_hs_zalloc(s, num_exts * sizeof(*raw_extensions));
     if (raw_extensions == NULL) {
         SSLfatal(s, SSL_AD_INTERNAL_ERROR, ERR_R_CRYPTO_LIB);
         return 0;
@@ -722,7 +722,7 @@ int tls_collect_extensions(SSL_CONNECTION *s, PACKET *packet,
     return 1;
 
  err:
-    OPENSSL_free(raw_extensions);
+    ssl_hs_free(s, raw_extensions);
     return 0;
 }
 
@@ -1733,9 +1733,15 @@ static int final_early_data(SSL_CONNECTION *s, unsigned int context, int sent)
         return 1;
     }
 
+    /*
+     * A QUIC server never calls SSL_read_early_data(): the early data arrives
+     * in 0-RTT packets, so the QUIC stack decides whether it is wanted by
+     * configuring max_early_data instead.
+     */
     if (s->max_early_data == 0
             || !s->hit
-            || s->early_data_state != SSL_EARLY_DATA_ACCEPTING
+            || (s->early_data_state != SSL_EARLY_DATA_ACCEPTING
+                && !SSL_IS_QUIC_HANDSHAKE(s))
             || !s->ext.early_data_ok
             || s->hello_retry_request != SSL_HRR_NONE
             || (s->allow_early_data_cb != NULL
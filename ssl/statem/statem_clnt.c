@@ -823,6 +823,17 @@ WORK_STATE ossl_statem_client_post_work(SSL_CONNECTION *s, WORK_STATE wst)
             return WORK_MORE_A;
         }
 
+        if (SSL_IS_QUIC_HANDSHAKE(s)
+                && s->early_data_state == SSL_EARLY_DATA_CONNECTING) {
+            /*
+             * QUIC carries early data in 0-RTT packets rather than in TLS
+             * records and never sends EndOfEarlyData (RFC 9001 s. 8.3). Once
+             * the early traffic secret has been yielded the rest of the
+             * handshake proceeds as if no early data had been written.
+             */
+            s->early_data_state = SSL_EARLY_DATA_NONE;
+        }
+
         if (SSL_CONNECTION_IS_DTLS(s)) {
             /* Treat the next message as the first packet */
             s->first_packet = 1;
@@ -1808,10 +1819,10 @@ MSG_PROCESS_RETURN tls_process_server_hello(SSL_CONNECTION *s, PACKET *pkt)
         }
     }
 
-    OPENSSL_free(extensions);
+    ssl_hs_free(s, extensions);
     return MSG_PROCESS_CONTINUE_READING;
  err:
-    OPENSSL_free(extensions);
+    ssl_hs_free(s, extensions);
     return MSG_PROCESS_ERROR;
 }
 
@@ -1845,7 +1856,7 @@ static MSG_PROCESS_RETURN tls_process_as_hello_retry_request(SSL_CONNECTION *s,
         goto err;
     }
 
-    OPENSSL_free(extensions);
+    ssl_hs_free(s, extensions);
     extensions = NULL;
 
     if (s->ext.tls13_cookie_len == 0 && s->s3.tmp.pkey != NULL) {
@@ -1880,7 +1891,7 @@ static MSG_PROCESS_RETURN tls_process_as_hello_retry_request(SSL_CONNECTION *s,
 
     return MSG_PROCESS_FINISHED_READING;
  err:
-    OPENSSL_free(extensions);
+    ssl_hs_free(s, extensions);
     return MSG_PROCESS_ERROR;
 }
 
@@ -2029,11 +2040,11 @@ MSG_PROCESS_RETURN tls_process_server_certificate(SSL_CONNECTION *s,
                 || !tls_parse_all_extensions(s, SSL_EXT_TLS1_3_CERTIFICATE,
                                              rawexts, x, chainidx,
                                              PACKET_remaining(pkt) == 0)) {
-                OPENSSL_free(rawexts);
+                ssl_hs_free(s, rawexts);
                 /* SSLfatal already called */
                 goto err;
             }
-            OPENSSL_free(rawexts);
+            ssl_hs_free(s, rawexts);
         }
 
         if (!sk_X509_push(s->session->peer_chain, x)) {
@@ -2606,10 +2617,10 @@ MSG_PROCESS_RETURN tls_process_certificate_request(SSL_CONNECTION *s,
             || !tls_parse_all_extensions(s, SSL_EXT_TLS1_3_CERTIFICATE_REQUEST,
                                          rawexts, NULL, 0, 1)) {
             /* SSLfatal() already called */
-            OPENSSL_free(rawexts);
+            ssl_hs_free(s, rawexts);
             return MSG_PROCESS_ERROR;
         }
-        OPENSSL_free(rawexts);
+        ssl_hs_free(s, rawexts);
         if (!tls1_process_sigalgs(s)) {
             SSLfatal(s, SSL_AD_INTERNAL_ERROR, SSL_R_BAD_LENGTH);
             return MSG_PROCESS_ERROR;
@@ -2847,7 +2858,7 @@ MSG_PROCESS_RETURN tls_process_new_session_ticket(SSL_CONNECTION *s,
         }
         s->session->master_key_length = hashlen;
 
-        OPENSSL_free(exts);
+        ssl_hs_free(s, exts);
         ssl_update_cache(s, SSL_SESS_CACHE_CLIENT);
         return MSG_PROCESS_FINISHED_READING;
     }
@@ -2855,7 +2866,7 @@ MSG_PROCESS_RETURN tls_process_new_session_ticket(SSL_CONNECTION *s,
     return MSG_PROCESS_CONTINUE_READING;
  err:
     EVP_MD_free(sha256);
-    OPENSSL_free(exts);
+    ssl_hs_free(s, exts);
     return MSG_PROCESS_ERROR;
 }
 
@@ -4034,11 +4045,11 @@ static MSG_PROCESS_RETURN tls_process_encrypted_extensions(SSL_CONNECTION *s,
         goto err;
     }
 
-    OPENSSL_free(rawexts);
+    ssl_hs_free(s, rawexts);
     return MSG_PROCESS_CONTINUE_READING;
 
  err:
-    OPENSSL_free(rawexts);
+    ssl_hs_free(s, rawexts);
     return MSG_PROCESS_ERROR;
 }
 
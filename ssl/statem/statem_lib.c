@@ -1297,7 +1297,7 @@ int tls_process_rpk(SSL_CONNECTION *sc, PACKET *pkt, EVP_PKEY **peer_rpk)
     }
 
  err:
-    OPENSSL_free(rawexts);
+    ssl_hs_free(sc, rawexts);
     EVP_PKEY_free(pkey);
     return ret;
 }
@@ -1441,6 +1441,15 @@ WORK_STATE tls_finish_handshake(SSL_CONNECTION *s, ossl_unused WORK_STATE wst,
         s->init_num = 0;
     }
 
+    /*
+     * Nothing parsed during the handshake is needed any more. The arena's
+     * memory goes back to the pool for the next handshake.
+     */
+    if (s->clienthello == NULL) {
+        ossl_arena_free(s->hs_arena);
+        s->hs_arena = NULL;
+    }
+
     if (SSL_CONNECTION_IS_TLS13(s) && !s->server
             && s->post_handshake_auth == SSL_PHA_REQUESTED)
         s->post_handshake_auth = SSL_PHA_EXT_SENT;
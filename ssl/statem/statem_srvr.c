@@ -84,7 +84,9 @@ static int ossl_statem_server13_read_transition(SSL_CONNECTION *s, int mt)
                 return 1;
             }
             break;
-        } else if (s->ext.early_data == SSL_EARLY_DATA_ACCEPTED) {
+        } else if (s->ext.early_data == SSL_EARLY_DATA_ACCEPTED
+                   && !SSL_IS_QUIC_HANDSHAKE(s)) {
+            /* QUIC does not use EndOfEarlyData (RFC 9001 s. 8.3) */
             if (mt == SSL3_MT_END_OF_EARLY_DATA) {
                 st->hand_state = TLS_ST_SR_END_OF_EARLY_DATA;
                 return 1;
@@ -398,6 +400,14 @@ static int get_compressed_certificate_alg(SSL_CONNECTION *sc)
         if (sc->s3.tmp.cert->comp_cert[*alg] != NULL)
             return *alg;
     }
+
+    if ((sc->options & SSL_OP_AUTO_CERTIFICATE_COMPRESSION) != 0) {
+        for (alg = sc->ext.compress_certificate_from_peer;
+             *alg != TLSEXT_comp_cert_none; alg++) {
+            if (ossl_ssl_auto_compress_cert(sc, sc->s3.tmp.cert, *alg))
+                return *alg;
+        }
+    }
 #endif
     return TLSEXT_comp_cert_none;
 }
@@ -966,7 +976,13 @@ WORK_STATE ossl_statem_server_post_work(SSL_CONNECTION *s, WORK_STATE wst)
                 return WORK_ERROR;
             }
 
-            if (s->ext.early_data != SSL_EARLY_DATA_ACCEPTED
+            /*
+             * If we accepted early data we normally delay changing the read
+             * keys until EndOfEarlyData arrives. QUIC has no such message and
+             * keeps 0-RTT and handshake keys side by side, so change now.
+             */
+            if ((s->ext.early_data != SSL_EARLY_DATA_ACCEPTED
+                 || SSL_IS_QUIC_HANDSHAKE(s))
                 && !ssl->method->ssl3_enc->change_cipher_state(s,
                         SSL3_CC_HANDSHAKE |SSL3_CHANGE_CIPHER_SERVER_READ)) {
                 /* SSLfatal() already called */
@@ -1492,7 +1508,7 @@ MSG_PROCESS_RETURN tls_process_client_hello(SSL_CONNECTION *s, PACKET *pkt)
         s->new_session = 1;
     }
 
-    clienthello = OPENSSL_zalloc(sizeof(*clienthello));
+    clienthello = ssl_hs_zalloc(s, sizeof(*clienthello));
     if (clienthello == NULL) {
         SSLfatal(s, SSL_AD_INTERNAL_ERROR, ERR_R_INTERNAL_ERROR);
         goto err;
@@ -1625,7 +1641,7 @@ MSG_PROCESS_RETURN tls_process_client_hello(SSL_CONNECTION *s, PACKET *pkt)
              */
             if (SSL_get_options(SSL_CONNECTION_GET_SSL(s)) & SSL_OP_COOKIE_EXCHANGE) {
                 if (clienthello->dtls_cookie_len == 0) {
-                    OPENSSL_free(clienthello);
+                    ssl_hs_free(s, clienthello);
                     return MSG_PROCESS_FINISHED_READING;
                 }
             }
@@ -1674,8 +1690,8 @@ MSG_PROCESS_RETURN tls_process_client_hello(SSL_CONNECTION *s, PACKET *pkt)
 
  err:
     if (clienthello != NULL)
-        OPENSSL_free(clienthello->pre_proc_exts);
-    OPENSSL_free(clienthello);
+        ssl_hs_free(s, clienthello->pre_proc_exts);
+    ssl_hs_free(s, clienthello);
 
     return MSG_PROCESS_ERROR;
 }
@@ -2123,15 +2139,15 @@ static int tls_early_post_process_client_hello(SSL_CONNECTION *s)
 
     sk_SSL_CIPHER_free(ciphers);
     sk_SSL_CIPHER_free(scsvs);
-    OPENSSL_free(clienthello->pre_proc_exts);
-    OPENSSL_free(s->clienthello);
+    ssl_hs_free(s, clienthello->pre_proc_exts);
+    ssl_hs_free(s, s->clienthello);
     s->clienthello = NULL;
     return 1;
  err:
     sk_SSL_CIPHER_free(ciphers);
     sk_SSL_CIPHER_free(scsvs);
-    OPENSSL_free(clienthello->pre_proc_exts);
-    OPENSSL_free(s->clienthello);
+    ssl_hs_free(s, clienthello->pre_proc_exts);
+    ssl_hs_free(s, s->clienthello);
     s->clienthello = NULL;
 
     return 0;
@@ -3683,10 +3699,10 @@ MSG_PROCESS_RETURN tls_process_client_certificate(SSL_CONNECTION *s,
                 || !tls_parse_all_extensions(s, SSL_EXT_TLS1_3_CERTIFICATE,
                                              rawexts, x, chainidx,
                                              PACKET_remaining(&spkt) == 0)) {
-                OPENSSL_free(rawexts);
+                ssl_hs_free(s, rawexts);
                 goto err;
             }
-            OPENSSL_free(rawexts);
+            ssl_hs_free(s, rawexts);
         }
 
         if (!sk_X509_push(sk, x)) {
@@ -0,0 +1,147 @@
+/*
+ * Copyright 2025 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+#include <string.h>
+#include <openssl/crypto.h>
+#include "internal/arena.h"
+#include "internal/nelem.h"
+#include "testutil.h"
+
+static int test_arena_alloc(void)
+{
+    OSSL_ARENA *arena = NULL;
+    unsigned char *p[100];
+    size_t i;
+    int res = 0;
+
+    if (!TEST_ptr(arena = ossl_arena_new(NULL, 0)))
+        goto err;
+
+    for (i = 0; i < OSSL_NELEM(p); i++) {
+        if (!TEST_ptr(p[i] = ossl_arena_alloc(arena, i + 1))
+                || !TEST_size_t_eq((size_t)p[i] % 16, 0))
+            goto err;
+        memset(p[i], (int)i, i + 1);
+    }
+    /* Nothing handed out may overlap */
+    for (i = 0; i < OSSL_NELEM(p); i++)
+        if (!TEST_uchar_eq(p[i][0], (unsigned char)i)
+                || !TEST_uchar_eq(p[i][i], (unsigned char)i)
+                || !TEST_true(ossl_arena_owns(arena, p[i])))
+            goto err;
+
+    if (!TEST_ptr_null(ossl_arena_alloc(arena, 0))
+            || !TEST_false(ossl_arena_owns(arena, &res))
+            || !TEST_false(ossl_arena_owns(arena, NULL)))
+        goto err;
+    res = 1;
+ err:
+    ossl_arena_free(arena);
+    return res;
+}
+
+static int test_arena_large(void)
+{
+    OSSL_ARENA *arena = NULL;
+    unsigned char *small1, *small2, *big;
+    int res = 0;
+
+    if (!TEST_ptr(arena = ossl_arena_new(NULL, 0))
+            || !TEST_ptr(small1 = ossl_arena_zalloc(arena, 32))
+            || !TEST_ptr(big = ossl_arena_zalloc(arena, 20000))
+            || !TEST_ptr(small2 = ossl_arena_zalloc(arena, 32)))
+        goto err;
+
+    /* The large block must not push small allocations into a new chunk */
+    if (!TEST_ptr_eq(small2, small1 + 32)
+            || !TEST_uchar_eq(big[0], 0)
+            || !TEST_uchar_eq(big[19999], 0)
+            || !TEST_true(ossl_arena_owns(arena, big + 19999))
+            || !TEST_size_t_ge(ossl_arena_get_peak(arena), 20064))
+        goto err;
+    res = 1;
+ err:
+    ossl_arena_free(arena);
+    return res;
+}
+
+static int test_arena_reset(void)
+{
+    OSSL_ARENA *arena = NULL;
+    unsigned char *p, *q;
+    size_t i;
+    int res = 0;
+
+    if (!TEST_ptr(arena = ossl_arena_new(NULL, OSSL_ARENA_FLAG_CLEAR)))
+        goto err;
+
+    for (i = 0; i < 200; i++)
+        if (!TEST_ptr(ossl_arena_alloc(arena, 100)))
+            goto err;
+    if (!TEST_ptr(p = ossl_arena_alloc(arena, 5000))
+            || !TEST_size_t_eq(ossl_arena_get_peak(arena), 200 * 112 + 5008))
+        goto err;
+
+    ossl_arena_reset(arena);
+    if (!TEST_false(ossl_arena_owns(arena, p))
+            || !TEST_ptr(q = ossl_arena_alloc(arena, 10))
+            || !TEST_true(ossl_arena_owns(arena, q))
+            /* The peak survives a reset */
+            || !TEST_size_t_eq(ossl_arena_get_peak(arena), 200 * 112 + 5008))
+        goto err;
+    res = 1;
+ err:
+    ossl_arena_free(arena);
+    return res;
+}
+
+static int test_arena_pool(void)
+{
+    OSSL_ARENA_POOL *pool = NULL;
+    OSSL_ARENA *a1 = NULL, *a2 = NULL;
+    unsigned char *p, *q;
+    int res = 0;
+
+    if (!TEST_ptr(pool = ossl_arena_pool_new(4))
+            || !TEST_ptr(a1 = ossl_arena_new(pool, 0))
+            || !TEST_ptr(p = ossl_arena_alloc(a1, 64)))
+        goto err;
+    ossl_arena_free(a1);
+    a1 = NULL;
+
+    /* The released chunk is handed straight to the next arena */
+    if (!TEST_ptr(a2 = ossl_arena_new(pool, 0))
+            || !TEST_ptr(q = ossl_arena_alloc(a2, 64))
+            || !TEST_ptr_eq(p, q))
+        goto err;
+
+    /*
+     * Blocks the size of libssl's raw extension arrays must come from the
+     * pooled chunks rather than each getting a dedicated one
+     */
+    if (!TEST_ptr(p = ossl_arena_alloc(a2, 1200))
+            || !TEST_ptr(q = ossl_arena_alloc(a2, 1200))
+            || !TEST_ptr_eq(q, p + 1200))
+        goto err;
+    res = 1;
+ err:
+    ossl_arena_free(a1);
+    ossl_arena_free(a2);
+    ossl_arena_pool_free(pool);
+    return res;
+}
+
+int setup_tests(void)
+{
+    ADD_TEST(test_arena_alloc);
+    ADD_TEST(test_arena_large);
+    ADD_TEST(test_arena_reset);
+    ADD_TEST(test_arena_pool);
+    return 1;
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright 2016-2022 The OpenSSL Project Authors. All Rights Reserved.
+ * Copyright 2016-2024 The OpenSSL Project Authors. All Rights Reserved.
  *
  * Licensed under the Apache License 2.0 (the "License").  You may not use
  * this file except in compliance with the License.  You can obtain a copy
@@ -83,6 +83,7 @@ static int verify_cb(int preverify_ok, X509_STORE_CTX *x509_ctx)
  * Test 1 = app pre-compresses certificate in SSL_CTX
  * Test 2 = app pre-compresses certificate in SSL_CTX, client authentication
  * Test 3 = app pre-compresses certificate in SSL_CTX, but it's unused due to prefs
+ * Test 4 = certificate is compressed during the handshake
  */
 /* Compression helper */
 static int ssl_comp_cert(SSL *ssl, int alg)
@@ -188,6 +189,8 @@ static int test_ssl_cert_comp(int test)
         if (!TEST_true(SSL_CTX_compress_certs(sctx, expected_server)))
             goto end;
     }
+    if (test == 4)
+        SSL_CTX_set_options(sctx, SSL_OP_AUTO_CERTIFICATE_COMPRESSION);
 
     if (!TEST_true(create_ssl_objects(sctx, cctx, &serverssl, &clientssl,
                                       NULL, NULL)))
@@ -243,6 +246,74 @@ static int test_ssl_cert_comp(int test)
 
     return testresult;
 }
+
+/*
+ * Check that the same certificate chain compressed for different SSL_CTXs,
+ * in advance or during the handshake, shares the same compressed data.
+ */
+static int test_ssl_cert_comp_shared(void)
+{
+    SSL_CTX *cctx = NULL, *sctx = NULL, *sctx2 = NULL;
+    SSL *clientssl = NULL, *serverssl = NULL;
+    SSL_CONNECTION *sc;
+    int alg = TLSEXT_comp_cert_none;
+    int testresult = 0;
+
+#ifndef OPENSSL_NO_ZSTD
+    alg = TLSEXT_comp_cert_zstd;
+#endif
+#ifndef OPENSSL_NO_ZLIB
+    alg = TLSEXT_comp_cert_zlib;
+#endif
+#ifndef OPENSSL_NO_BROTLI
+    alg = TLSEXT_comp_cert_brotli;
+#endif
+
+    if (!TEST_true(create_ssl_ctx_pair(NULL, TLS_server_method(),
+                                       TLS_client_method(),
+                                       TLS1_3_VERSION, 0,
+                                       &sctx, &cctx, cert, privkey))
+            || !TEST_true(create_ssl_ctx_pair(NULL, TLS_server_method(), NULL,
+                                              TLS1_3_VERSION, 0,
+                                              &sctx2, NULL, cert, privkey)))
+        goto end;
+
+    if (!TEST_true(SSL_CTX_set1_cert_comp_preference(sctx, &alg, 1))
+            || !TEST_true(SSL_CTX_set1_cert_comp_preference(sctx2, &alg, 1))
+            || !TEST_true(SSL_CTX_compress_certs(sctx, alg))
+            || !TEST_ptr(sctx->cert->key->comp_cert[alg]))
+        goto end;
+
+    /* Compress the certificate for |sctx2| during the handshake */
+    SSL_CTX_set_options(sctx2, SSL_OP_AUTO_CERTIFICATE_COMPRESSION);
+    if (!TEST_true(create_ssl_objects(sctx2, cctx, &serverssl, &clientssl,
+                                      NULL, NULL))
+            || !TEST_true(create_ssl_connection(serverssl, clientssl,
+                                                SSL_ERROR_NONE)))
+        goto end;
+
+    sc = SSL_CONNECTION_FROM_SSL(serverssl);
+    if (!TEST_int_gt(sc->cert->key->cert_comp_used, 0)
+            || !TEST_ptr_eq(sc->cert->key->comp_cert[alg],
+                            sctx->cert->key->comp_cert[alg]))
+        goto end;
+
+    if (!TEST_true(SSL_CTX_compress_certs(sctx2, alg))
+            || !TEST_ptr_eq(sctx2->cert->key->comp_cert[alg],
+                            sctx->cert->key->comp_cert[alg]))
+        goto end;
+
+    testresult = 1;
+
+ end:
+    SSL_free(serverssl);
+    SSL_free(clientssl);
+    SSL_CTX_free(sctx);
+    SSL_CTX_free(sctx2);
+    SSL_CTX_free(cctx);
+
+    return testresult;
+}
 #endif
 
 OPT_TEST_DECLARE_USAGE("certdir\n")
@@ -266,7 +337,8 @@ int setup_tests(void)
     if (privkey == NULL)
         goto err;
 
-    ADD_ALL_TESTS(test_ssl_cert_comp, 4);
+    ADD_ALL_TESTS(test_ssl_cert_comp, 5);
+    ADD_TEST(test_ssl_cert_comp_shared);
     return 1;
 
  err:
@@ -1,5 +1,5 @@
 /*
- * Copyright 2016-2021 The OpenSSL Project Authors. All Rights Reserved.
+ * Copyright 2016-2024 The OpenSSL Project Authors. All Rights Reserved.
  *
  * Licensed under the Apache License 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -259,11 +259,59 @@ end:
     return result;
 }
 
+/*
+ * Cipher lists are cached by rule string. A second SSL_CTX using the same rule
+ * string must get the same list and the security level set by the string.
+ */
+static int test_cached_cipherlist(void)
+{
+    static const char rules[] = "AES128-SHA:AES256-SHA:@SECLEVEL=0";
+    STACK_OF(SSL_CIPHER) *sk1, *sk2;
+    int i;
+
+    SETUP_CIPHERLIST_TEST_FIXTURE();
+    SSL_CTX_set_security_level(fixture->client, 3);
+    if (!TEST_true(SSL_CTX_set_cipher_list(fixture->server, rules))
+            || !TEST_true(SSL_CTX_set_cipher_list(fixture->client, rules))
+            || !TEST_int_eq(SSL_CTX_get_security_level(fixture->server), 0)
+            || !TEST_int_eq(SSL_CTX_get_security_level(fixture->client), 0))
+        goto end;
+
+    sk1 = SSL_CTX_get_ciphers(fixture->server);
+    sk2 = SSL_CTX_get_ciphers(fixture->client);
+    if (!TEST_int_eq(sk_SSL_CIPHER_num(sk1), sk_SSL_CIPHER_num(sk2)))
+        goto end;
+    for (i = 0; i < sk_SSL_CIPHER_num(sk1); i++)
+        if (!TEST_ptr_eq(sk_SSL_CIPHER_value(sk1, i),
+                         sk_SSL_CIPHER_value(sk2, i)))
+            goto end;
+
+    /* A different rule string must not be answered from the cache */
+    if (!TEST_true(SSL_CTX_set_cipher_list(fixture->client,
+                                           "AES256-SHA:AES128-SHA")))
+        goto end;
+    sk2 = SSL_CTX_get_ciphers(fixture->client);
+    i = sk_SSL_CIPHER_num(sk2);
+    if (!TEST_int_ge(i, 2)
+            || !TEST_uint_eq(SSL_CIPHER_get_id(sk_SSL_CIPHER_value(sk2, i - 2)),
+                             TLS1_CK_RSA_WITH_AES_256_SHA)
+            || !TEST_uint_eq(SSL_CIPHER_get_id(sk_SSL_CIPHER_value(sk2, i - 1)),
+                             TLS1_CK_RSA_WITH_AES_128_SHA))
+        goto end;
+
+    result = 1;
+end:
+    tear_down(fixture);
+    fixture = NULL;
+    return result;
+}
+
 int setup_tests(void)
 {
     ADD_TEST(test_default_cipherlist_implicit);
     ADD_TEST(test_default_cipherlist_explicit);
     ADD_TEST(test_default_cipherlist_clear);
     ADD_TEST(test_stdname_cipherlist);
+    ADD_TEST(test_cached_cipherlist);
     return 1;
 }
@@ -32,6 +32,7 @@
 #include <openssl/rsa.h>
 #include <openssl/engine.h>
 #include <openssl/proverr.h>
+#include <openssl/thread.h>
 #include "testutil.h"
 #include "internal/nelem.h"
 #include "internal/sizes.h"
@@ -2066,6 +2067,69 @@ static int test_d2i_AutoPrivateKey(int i)
     return ret;
 }
 
+/*
+ * Decode all of |keydata|, each key twice, with one bad input in between.
+ * The second run lets the decoding spread over the thread pool, if there is
+ * one.
+ */
+static int test_OSSL_DECODER_pkeys_from_data(int idx)
+{
+    static const unsigned char bad[] = { 0x30, 0x03, 0x02, 0x01, 0x00 };
+    EVP_PKEY *pkeys[2 * OSSL_NELEM(keydata) + 1];
+    const unsigned char *data[OSSL_NELEM(pkeys)];
+    size_t data_len[OSSL_NELEM(pkeys)];
+    size_t i, j, bad_idx = OSSL_NELEM(keydata);
+    int ret = 0, threads = 0;
+
+    for (i = 0, j = 0; i < OSSL_NELEM(pkeys); i++) {
+        if (i == bad_idx) {
+            data[i] = bad;
+            data_len[i] = sizeof(bad);
+        } else {
+            data[i] = keydata[j % OSSL_NELEM(keydata)].kder;
+            data_len[i] = keydata[j % OSSL_NELEM(keydata)].size;
+            j++;
+        }
+    }
+
+    if (idx == 1) {
+        if ((OSSL_get_thread_support_flags()
+             & OSSL_THREAD_SUPPORT_FLAG_DEFAULT_SPAWN) == 0)
+            return TEST_skip("no default thread pool");
+        if (!TEST_true(OSSL_set_max_threads(testctx, 2)))
+            return 0;
+        threads = 1;
+    }
+
+    if (!TEST_size_t_eq(OSSL_DECODER_pkeys_from_data(pkeys, OSSL_NELEM(pkeys),
+                                                     data, data_len,
+                                                     "DER", NULL, NULL,
+                                                     EVP_PKEY_KEYPAIR,
+                                                     testctx, testpropq),
+                        OSSL_NELEM(pkeys) - 1))
+        goto done;
+
+    for (i = 0, j = 0; i < OSSL_NELEM(pkeys); i++) {
+        if (i == bad_idx) {
+            if (!TEST_ptr_null(pkeys[i]))
+                goto done;
+            continue;
+        }
+        if (!TEST_ptr(pkeys[i])
+                || !TEST_true(EVP_PKEY_is_a(pkeys[i],
+                                            keydata[j % OSSL_NELEM(keydata)].keytype)))
+            goto done;
+        j++;
+    }
+    ret = 1;
+ done:
+    for (i = 0; i < OSSL_NELEM(pkeys); i++)
+        EVP_PKEY_free(pkeys[i]);
+    if (threads)
+        OSSL_set_max_threads(testctx, 0);
+    return ret;
+}
+
 #ifndef OPENSSL_NO_EC
 
 static const unsigned char ec_public_sect163k1_validxy[] = {
@@ -2292,8 +2356,113 @@ static int test_EC_keygen_with_enc(int idx)
     EVP_PKEY_CTX_free(pctx);
     return ret;
 }
+
+static const struct {
+    const char *keytype;
+    const char *group;
+} keygen_batch_tests[] = {
+    { "EC", "P-256" },
+    { "EC", "P-384" },
+# ifndef OPENSSL_NO_ECX
+    { "X25519", NULL },
+    { "ED25519", NULL },
+# endif
+};
+
+static int test_EVP_PKEY_keygen_batch(int idx)
+{
+    EVP_PKEY *keys[9] = { NULL };
+    EVP_PKEY_CTX *kctx = NULL, *cctx = NULL;
+    const char *group = keygen_batch_tests[idx].group;
+    size_t i, j;
+    int ret = 0;
+
+    if (!TEST_ptr(kctx = EVP_PKEY_CTX_new_from_name(testctx,
+                                                    keygen_batch_tests[idx].keytype,
+                                                    testpropq))
+        || !TEST_int_gt(EVP_PKEY_keygen_init(kctx), 0)
+        || (group != NULL
+            && !TEST_int_gt(EVP_PKEY_CTX_set_group_name(kctx, group), 0))
+        || !TEST_int_gt(EVP_PKEY_keygen_batch(kctx, keys, OSSL_NELEM(keys)), 0))
+        goto done;
+
+    for (i = 0; i < OSSL_NELEM(keys); i++) {
+        /* Each public key must be the one that belongs to its private key */
+        if (!TEST_ptr(keys[i])
+            || !TEST_ptr(cctx = EVP_PKEY_CTX_new_from_pkey(testctx, keys[i],
+                                                           testpropq))
+            || !TEST_int_gt(EVP_PKEY_pairwise_check(cctx), 0))
+            goto done;
+        EVP_PKEY_CTX_free(cctx);
+        cctx = NULL;
+
+        for (j = 0; j < i; j++)
+            if (!TEST_int_ne(EVP_PKEY_eq(keys[i], keys[j]), 1))
+                goto done;
+    }
+
+    ret = 1;
+ done:
+    for (i = 0; i < OSSL_NELEM(keys); i++)
+        EVP_PKEY_free(keys[i]);
+    EVP_PKEY_CTX_free(cctx);
+    EVP_PKEY_CTX_free(kctx);
+    return ret;
+}
 #endif
 
+static int test_EVP_PKEY_prepare_for_provider(void)
+{
+    static const unsigned char msg[] = "prepared key";
+    OSSL_LIB_CTX *otherctx = NULL;
+    EVP_PKEY *pkey = NULL, *empty = NULL;
+    EVP_MD_CTX *mctx = NULL;
+    unsigned char sig[256];
+    size_t siglen = sizeof(sig);
+    int ret = 0;
+
+    if (!TEST_false(EVP_PKEY_prepare_for_provider(NULL, testctx, testpropq))
+            || !TEST_ptr(empty = EVP_PKEY_new())
+            || !TEST_false(EVP_PKEY_prepare_for_provider(empty, testctx,
+                                                         testpropq)))
+        goto done;
+
+    /* The same key, made ready for two different library contexts */
+    if (!TEST_ptr(otherctx = OSSL_LIB_CTX_new())
+            || !TEST_ptr(pkey = load_example_rsa_key())
+            || !TEST_true(EVP_PKEY_prepare_for_provider(pkey, testctx,
+                                                        testpropq))
+            || !TEST_true(EVP_PKEY_prepare_for_provider(pkey, otherctx, NULL))
+            /* Preparing again is harmless */
+            || !TEST_true(EVP_PKEY_prepare_for_provider(pkey, otherctx, NULL)))
+        goto done;
+
+    if (!TEST_ptr(mctx = EVP_MD_CTX_new())
+            || !TEST_int_eq(EVP_DigestSignInit_ex(mctx, NULL, "SHA256",
+                                                  otherctx, NULL, pkey,
+                                                  NULL), 1)
+            || !TEST_int_eq(EVP_DigestSign(mctx, sig, &siglen, msg,
+                                           sizeof(msg)), 1))
+        goto done;
+    EVP_MD_CTX_free(mctx);
+
+    if (!TEST_ptr(mctx = EVP_MD_CTX_new())
+            || !TEST_int_eq(EVP_DigestVerifyInit_ex(mctx, NULL, "SHA256",
+                                                    testctx, testpropq, pkey,
+                                                    NULL), 1)
+            || !TEST_int_eq(EVP_DigestVerify(mctx, sig, siglen, msg,
+                                             sizeof(msg)), 1))
+        goto done;
+
+    ret = 1;
+ done:
+    EVP_MD_CTX_free(mctx);
+    EVP_PKEY_free(pkey);
+    EVP_PKEY_free(empty);
+    OSSL_LIB_CTX_free(otherctx);
+    return ret;
+}
+
 #if !defined(OPENSSL_NO_SM2)
 
 static int test_EVP_SM2_verify(void)
@@ -4804,6 +4973,40 @@ static int test_ivlen_change(int idx)
     return res;
 }
 
+static const char *get_params_null_ciphers[] = {
+    "AES-128-CBC",
+    "AES-128-CCM",
+    "AES-128-GCM",
+#if !defined(OPENSSL_NO_CHACHA) && !defined(OPENSSL_NO_POLY1305)
+    "ChaCha20-Poly1305",
+#endif
+};
+
+/* Getting no parameters at all must succeed, not dereference the array */
+static int test_cipher_get_params_null(int idx)
+{
+    EVP_CIPHER_CTX *ctx = NULL;
+    EVP_CIPHER *ciph = NULL;
+    int res = 0;
+
+    ERR_set_mark();
+    ciph = EVP_CIPHER_fetch(testctx, get_params_null_ciphers[idx], testpropq);
+    ERR_pop_to_mark();
+    if (ciph == NULL)
+        return TEST_skip("%s is not available", get_params_null_ciphers[idx]);
+
+    if (!TEST_ptr(ctx = EVP_CIPHER_CTX_new())
+            || !TEST_true(EVP_CipherInit_ex2(ctx, ciph, NULL, NULL, 1, NULL))
+            || !TEST_true(EVP_CIPHER_CTX_get_params(ctx, NULL)))
+        goto err;
+
+    res = 1;
+ err:
+    EVP_CIPHER_CTX_free(ctx);
+    EVP_CIPHER_free(ciph);
+    return res;
+}
+
 static const char *keylen_change_ciphers[] = {
 #ifndef OPENSSL_NO_BF
     "BF-ECB",
@@ -5970,6 +6173,7 @@ int setup_tests(void)
 #endif
     ADD_ALL_TESTS(test_EVP_Enveloped, 2);
     ADD_ALL_TESTS(test_d2i_AutoPrivateKey, OSSL_NELEM(keydata));
+    ADD_ALL_TESTS(test_OSSL_DECODER_pkeys_from_data, 2);
     ADD_TEST(test_privatekey_to_pkcs8);
     ADD_TEST(test_EVP_PKCS82PKEY_wrong_tag);
 #ifndef OPENSSL_NO_EC
@@ -5977,7 +6181,9 @@ int setup_tests(void)
 #endif
 #ifndef OPENSSL_NO_EC
     ADD_ALL_TESTS(test_EC_keygen_with_enc, OSSL_NELEM(ec_encodings));
+    ADD_ALL_TESTS(test_EVP_PKEY_keygen_batch, OSSL_NELEM(keygen_batch_tests));
 #endif
+    ADD_TEST(test_EVP_PKEY_prepare_for_provider);
 #if !defined(OPENSSL_NO_SM2)
     ADD_TEST(test_EVP_SM2);
     ADD_TEST(test_EVP_SM2_verify);
@@ -6059,6 +6265,8 @@ int setup_tests(void)
     ADD_ALL_TESTS(test_gcm_reinit, OSSL_NELEM(gcm_reinit_tests));
     ADD_ALL_TESTS(test_evp_updated_iv, OSSL_NELEM(evp_updated_iv_tests));
     ADD_ALL_TESTS(test_ivlen_change, OSSL_NELEM(ivlen_change_ciphers));
+    ADD_ALL_TESTS(test_cipher_get_params_null,
+                  OSSL_NELEM(get_params_null_ciphers));
     if (OSSL_NELEM(keylen_change_ciphers) - 1 > 0)
         ADD_ALL_TESTS(test_keylen_change, OSSL_NELEM(keylen_change_ciphers) - 1);
 
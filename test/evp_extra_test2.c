@@ -1298,6 +1298,41 @@ static int test_evp_md_ctx_copy(void)
     return ret;
 }
 
+/* Test copying repeatedly into a context already set up for the digest */
+static int test_evp_md_ctx_copy_reuse(void)
+{
+    static const unsigned char msg[] = "abcdefgh";
+    EVP_MD *md = NULL;
+    EVP_MD_CTX *mdctx = NULL;
+    EVP_MD_CTX *copyctx = NULL;
+    unsigned char expected[EVP_MAX_MD_SIZE], out[EVP_MAX_MD_SIZE];
+    unsigned int explen, outlen;
+    size_t i;
+    int ret = 0;
+
+    if (!TEST_ptr(md = EVP_MD_fetch(mainctx, "SHA2-256", NULL))
+            || !TEST_ptr(mdctx = EVP_MD_CTX_new())
+            || !TEST_ptr(copyctx = EVP_MD_CTX_new())
+            || !TEST_true(EVP_DigestInit_ex2(mdctx, md, NULL)))
+        goto err;
+
+    for (i = 0; i < sizeof(msg) - 1; i++) {
+        if (!TEST_true(EVP_DigestUpdate(mdctx, msg + i, 1))
+                || !TEST_true(EVP_MD_CTX_copy_ex(copyctx, mdctx))
+                || !TEST_true(EVP_DigestFinal_ex(copyctx, out, &outlen))
+                || !TEST_true(EVP_Digest(msg, i + 1, expected, &explen, md,
+                                         NULL))
+                || !TEST_mem_eq(out, outlen, expected, explen))
+            goto err;
+    }
+    ret = 1;
+ err:
+    EVP_MD_CTX_free(mdctx);
+    EVP_MD_CTX_free(copyctx);
+    EVP_MD_free(md);
+    return ret;
+}
+
 #if !defined OPENSSL_NO_DES && !defined OPENSSL_NO_MD5
 static int test_evp_pbe_alg_add(void)
 {
@@ -1391,6 +1426,7 @@ int setup_tests(void)
     ADD_TEST(test_rsa_pss_sign);
     ADD_TEST(test_evp_md_ctx_dup);
     ADD_TEST(test_evp_md_ctx_copy);
+    ADD_TEST(test_evp_md_ctx_copy_reuse);
     ADD_ALL_TESTS(test_provider_unload_effective, 2);
 #if !defined OPENSSL_NO_DES && !defined OPENSSL_NO_MD5
     ADD_TEST(test_evp_pbe_alg_add);
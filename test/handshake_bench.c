@@ -0,0 +1,589 @@
+/*
+ * Copyright 2024 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+/*
+ * Server side TLS handshake benchmark.
+ *
+ * This runs TLS handshakes between a client and a server entirely in memory,
+ * using a BIO pair as the network, and measures the time spent by the server
+ * only. The following handshake types are run:
+ *
+ *   - full: full handshakes for each protocol version, certificate type and
+ *     supported group;
+ *
+ *   - resume: session resumption for each protocol version and group;
+ *
+ *   - psk: TLSv1.3 external PSK with (EC)DHE for each group;
+ *
+ *   - 0rtt: TLSv1.3 resumption with early data for each group.
+ *
+ * For every case the server side handshake rate per core and the number of
+ * memory allocations per handshake are reported, together with a breakdown
+ * of the server's time by handshake phase. The phases are derived from the
+ * server's state machine with an info callback, so the time reported for a
+ * phase is the time spent processing a received message or constructing and
+ * sending a message of that phase.
+ *
+ * This is not run as part of the regular test suite other than as a quick
+ * smoke test; it is intended to be used to detect performance regressions in
+ * the TLS handshake.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <openssl/ssl.h>
+#include <openssl/bio.h>
+#include <openssl/err.h>
+#include "internal/nelem.h"
+#include "internal/time.h"
+
+#define BENCH_BIO_BUF_SIZE  (64 * 1024)
+
+/* Handshake phases the server's time is accounted to */
+enum {
+    PHASE_CLIENT_HELLO,
+    PHASE_KEY_EXCHANGE,
+    PHASE_CERTIFICATE,
+    PHASE_CERT_VERIFY,
+    PHASE_FINISHED,
+    PHASE_TICKET,
+    PHASE_OTHER,
+    PHASE_NUM
+};
+
+static const char *phase_names[PHASE_NUM] = {
+    "CH", "KEX", "Cert", "CV", "Fin", "Ticket", "Other"
+};
+
+enum {
+    MODE_FULL,
+    MODE_RESUME,
+    MODE_PSK,
+    MODE_EARLY_DATA
+};
+
+static const char *mode_names[] = { "full", "resume", "psk", "0rtt" };
+
+typedef struct bench_cert_st {
+    const char *name;
+    const char *certfile;
+    const char *keyfile;
+} BENCH_CERT;
+
+static const BENCH_CERT bench_certs[] = {
+    { "rsa", "servercert.pem", "serverkey.pem" },
+    { "ecdsa", "server-ecdsa-cert.pem", "server-ecdsa-key.pem" },
+    { "ed25519", "server-ed25519-cert.pem", "server-ed25519-key.pem" },
+};
+
+static const char *bench_groups[] = {
+    "x25519", "x448", "P-256", "P-384", "P-521", "ffdhe2048", "ffdhe3072"
+};
+
+typedef struct bench_result_st {
+    size_t handshakes;
+    OSSL_TIME server_time;
+    OSSL_TIME phase_time[PHASE_NUM];
+    size_t allocs;
+} BENCH_RESULT;
+
+static const char *prog;
+static const char *certsdir;
+static const char *pattern = NULL;
+static size_t num_handshakes = 500;
+static int verbose = 0;
+
+/* Allocation counting, only active while the server is running */
+static int counting = 0;
+static size_t num_allocs = 0;
+
+/* Phase accounting for the server currently being timed */
+static BENCH_RESULT *cur_result;
+static OSSL_TIME phase_start;
+
+static const unsigned char psk_identity[] = "handshake_bench";
+static const unsigned char psk_key[32] = { 0x42 };
+static SSL_SESSION *psk_session;
+
+static unsigned char early_data[] = "early data";
+
+static void usage(void)
+{
+    fprintf(stderr, "Usage: %s [flags] certsdir\n", prog);
+    fprintf(stderr, "Flags:\n");
+    fprintf(stderr, "  -n #    Number of handshakes per case (default %zu)\n",
+            num_handshakes);
+    fprintf(stderr, "  -p str  Only run cases with names containing str\n");
+    fprintf(stderr, "  -v      Verbose output\n");
+    exit(EXIT_FAILURE);
+}
+
+static int parse_size(const char *s, size_t *out)
+{
+    char *end;
+    unsigned long v;
+
+    if (s == NULL)
+        return 0;
+    v = strtoul(s, &end, 10);
+    if (end == s || *end != '\0' || v == 0)
+        return 0;
+    *out = (size_t)v;
+    return 1;
+}
+
+static void *count_malloc(size_t num, const char *file, int line)
+{
+    if (counting)
+        ++num_allocs;
+    return malloc(num);
+}
+
+static void *count_realloc(void *addr, size_t num, const char *file, int line)
+{
+    if (counting)
+        ++num_allocs;
+    return realloc(addr, num);
+}
+
+static void count_free(void *addr, const char *file, int line)
+{
+    free(addr);
+}
+
+static double time_usecs(OSSL_TIME t)
+{
+    return (double)ossl_time2ticks(t) / (double)OSSL_TIME_US;
+}
+
+static int state_phase(OSSL_HANDSHAKE_STATE st)
+{
+    switch (st) {
+    case TLS_ST_BEFORE:
+    case TLS_ST_SR_CLNT_HELLO:
+    case TLS_ST_EARLY_DATA:
+    case TLS_ST_SR_END_OF_EARLY_DATA:
+        return PHASE_CLIENT_HELLO;
+    case TLS_ST_SW_SRVR_HELLO:
+    case TLS_ST_SW_KEY_EXCH:
+    case TLS_ST_SR_KEY_EXCH:
+        return PHASE_KEY_EXCHANGE;
+    case TLS_ST_SW_CERT:
+    case TLS_ST_SW_COMP_CERT:
+    case TLS_ST_SW_CERT_STATUS:
+        return PHASE_CERTIFICATE;
+    case TLS_ST_SW_CERT_VRFY:
+        return PHASE_CERT_VERIFY;
+    case TLS_ST_SW_CHANGE:
+    case TLS_ST_SR_CHANGE:
+    case TLS_ST_SW_FINISHED:
+    case TLS_ST_SR_FINISHED:
+        return PHASE_FINISHED;
+    case TLS_ST_SW_SESSION_TICKET:
+        return PHASE_TICKET;
+    default:
+        return PHASE_OTHER;
+    }
+}
+
+/* Accounts the time since the last state change to the state just left */
+static void account_phase(const SSL *s)
+{
+    OSSL_TIME now = ossl_time_now();
+    int phase = state_phase(SSL_get_state(s));
+
+    cur_result->phase_time[phase]
+        = ossl_time_add(cur_result->phase_time[phase],
+                        ossl_time_subtract(now, phase_start));
+    phase_start = now;
+}
+
+static void server_info_cb(const SSL *s, int where, int ret)
+{
+    if ((where & SSL_CB_LOOP) != 0 && cur_result != NULL)
+        account_phase(s);
+}
+
+static int psk_use_session_cb(SSL *ssl, const EVP_MD *md,
+                              const unsigned char **id, size_t *idlen,
+                              SSL_SESSION **sess)
+{
+    if (!SSL_SESSION_up_ref(psk_session))
+        return 0;
+    *sess = psk_session;
+    *id = psk_identity;
+    *idlen = sizeof(psk_identity) - 1;
+    return 1;
+}
+
+static int psk_find_session_cb(SSL *ssl, const unsigned char *identity,
+                               size_t identity_len, SSL_SESSION **sess)
+{
+    *sess = NULL;
+    if (identity_len != sizeof(psk_identity) - 1
+            || memcmp(identity, psk_identity, identity_len) != 0)
+        return 1;
+    if (!SSL_SESSION_up_ref(psk_session))
+        return 0;
+    *sess = psk_session;
+    return 1;
+}
+
+static int is_retry(SSL *s, int ret)
+{
+    int err = SSL_get_error(s, ret);
+
+    return err == SSL_ERROR_WANT_READ || err == SSL_ERROR_WANT_WRITE;
+}
+
+/* Runs one step of the server side, timing it if |res| is not NULL */
+static int server_step(SSL *s, int *early, BENCH_RESULT *res)
+{
+    unsigned char buf[64];
+    size_t readbytes;
+    OSSL_TIME start = ossl_time_zero();
+    int ret, done = 0;
+
+    if (res != NULL) {
+        cur_result = res;
+        counting = 1;
+        phase_start = start = ossl_time_now();
+    }
+    if (*early) {
+        ret = SSL_read_early_data(s, buf, sizeof(buf), &readbytes);
+        if (ret == SSL_READ_EARLY_DATA_FINISH)
+            *early = 0;
+        else if (ret == SSL_READ_EARLY_DATA_ERROR && !is_retry(s, -1))
+            done = -1;
+    } else {
+        ret = SSL_do_handshake(s);
+        if (ret == 1)
+            done = 1;
+        else if (!is_retry(s, ret))
+            done = -1;
+    }
+    if (res != NULL) {
+        account_phase(s);
+        res->server_time = ossl_time_add(res->server_time,
+                                         ossl_time_subtract(phase_start,
+                                                            start));
+        counting = 0;
+        cur_result = NULL;
+    }
+    return done;
+}
+
+/*
+ * Runs a single handshake. If |res| is not NULL the server side is measured.
+ * If |sess_out| is not NULL the client's session is returned in it.
+ */
+static int do_handshake(SSL_CTX *s_ctx, SSL_CTX *c_ctx, int mode,
+                        SSL_SESSION *sess, SSL_SESSION **sess_out,
+                        BENCH_RESULT *res)
+{
+    SSL *c_ssl = NULL, *s_ssl = NULL;
+    BIO *c_bio = NULL, *s_bio = NULL;
+    unsigned char buf[64];
+    size_t written;
+    int c_done = 0, s_done = 0, s_early = 0, i, ret, ok = 0;
+
+    if ((c_ssl = SSL_new(c_ctx)) == NULL
+            || (s_ssl = SSL_new(s_ctx)) == NULL
+            || !BIO_new_bio_pair(&c_bio, BENCH_BIO_BUF_SIZE,
+                                 &s_bio, BENCH_BIO_BUF_SIZE))
+        goto err;
+    SSL_set_bio(c_ssl, c_bio, c_bio);
+    SSL_set_bio(s_ssl, s_bio, s_bio);
+    SSL_set_connect_state(c_ssl);
+    SSL_set_accept_state(s_ssl);
+    if (sess != NULL && !SSL_set_session(c_ssl, sess))
+        goto err;
+
+    if (mode == MODE_EARLY_DATA) {
+        if (!SSL_write_early_data(c_ssl, early_data, sizeof(early_data),
+                                  &written))
+            goto err;
+        s_early = 1;
+    }
+
+    for (i = 0; i < 100 && (!c_done || !s_done); ++i) {
+        if (!c_done) {
+            ret = SSL_do_handshake(c_ssl);
+            if (ret == 1)
+                c_done = 1;
+            else if (!is_retry(c_ssl, ret))
+                goto err;
+        }
+        if (!s_done || s_early) {
+            if ((ret = server_step(s_ssl, &s_early, res)) < 0)
+                goto err;
+            s_done = ret;
+        }
+    }
+    if (!c_done || !s_done)
+        goto err;
+
+    if (mode != MODE_FULL && !SSL_session_reused(s_ssl)) {
+        fprintf(stderr, "%s: session not reused\n", prog);
+        goto err;
+    }
+    if (mode == MODE_EARLY_DATA
+            && SSL_get_early_data_status(s_ssl) != SSL_EARLY_DATA_ACCEPTED) {
+        fprintf(stderr, "%s: early data not accepted\n", prog);
+        goto err;
+    }
+
+    if (sess_out != NULL) {
+        /* Process any TLSv1.3 session tickets */
+        if (SSL_read(c_ssl, buf, sizeof(buf)) > 0)
+            goto err;
+        if ((*sess_out = SSL_get1_session(c_ssl)) == NULL)
+            goto err;
+    }
+    if (res != NULL)
+        ++res->handshakes;
+    /* Mark the connections as cleanly closed so the session stays usable */
+    SSL_set_shutdown(c_ssl, SSL_SENT_SHUTDOWN | SSL_RECEIVED_SHUTDOWN);
+    SSL_set_shutdown(s_ssl, SSL_SENT_SHUTDOWN | SSL_RECEIVED_SHUTDOWN);
+    ok = 1;
+ err:
+    SSL_free(c_ssl);
+    SSL_free(s_ssl);
+    return ok;
+}
+
+static void print_result(const char *name, const BENCH_RESULT *res)
+{
+    double usecs = time_usecs(res->server_time);
+    int i;
+
+    printf("%-32s %10.1f %8.1f %8.1f", name,
+           usecs > 0 ? (double)res->handshakes * 1e6 / usecs : 0.0,
+           (double)res->allocs / (double)res->handshakes,
+           usecs / (double)res->handshakes);
+    for (i = 0; i < PHASE_NUM; ++i)
+        printf(" %7.1f", time_usecs(res->phase_time[i])
+                         / (double)res->handshakes);
+    printf("\n");
+}
+
+static SSL_CTX *make_ctx(int server, int version, const char *group,
+                         const BENCH_CERT *cert)
+{
+    SSL_CTX *ctx = SSL_CTX_new(server ? TLS_server_method()
+                                      : TLS_client_method());
+    char *certfile = NULL, *keyfile = NULL;
+    char groups[64];
+    size_t len;
+
+    /*
+     * In TLSv1.2 the curve of an ECDSA certificate must be one of the
+     * supported groups, but it is listed last so |group| is still used for
+     * the key exchange.
+     */
+    if (version == TLS1_2_VERSION && strcmp(cert->name, "ecdsa") == 0
+            && strcmp(group, "P-256") != 0)
+        BIO_snprintf(groups, sizeof(groups), "%s:P-256", group);
+    else
+        BIO_snprintf(groups, sizeof(groups), "%s", group);
+
+    if (ctx == NULL
+            || !SSL_CTX_set_min_proto_version(ctx, version)
+            || !SSL_CTX_set_max_proto_version(ctx, version)
+            || !SSL_CTX_set1_groups_list(ctx, groups))
+        goto err;
+
+    if (server) {
+        len = strlen(certsdir) + 64;
+        if ((certfile = OPENSSL_malloc(len)) == NULL
+                || (keyfile = OPENSSL_malloc(len)) == NULL)
+            goto err;
+        BIO_snprintf(certfile, len, "%s/%s", certsdir, cert->certfile);
+        BIO_snprintf(keyfile, len, "%s/%s", certsdir, cert->keyfile);
+        if (SSL_CTX_use_certificate_chain_file(ctx, certfile) <= 0
+                || SSL_CTX_use_PrivateKey_file(ctx, keyfile,
+                                               SSL_FILETYPE_PEM) <= 0)
+            goto err;
+        SSL_CTX_set_info_callback(ctx, server_info_cb);
+        /* Allow early data to be sent again with the same ticket */
+        SSL_CTX_set_options(ctx, SSL_OP_NO_ANTI_REPLAY);
+        if (version == TLS1_3_VERSION
+                && !SSL_CTX_set_max_early_data(ctx, 1024))
+            goto err;
+        SSL_CTX_set_dh_auto(ctx, 1);
+    }
+    OPENSSL_free(certfile);
+    OPENSSL_free(keyfile);
+    return ctx;
+ err:
+    OPENSSL_free(certfile);
+    OPENSSL_free(keyfile);
+    SSL_CTX_free(ctx);
+    return NULL;
+}
+
+/* Returns 1 on success, 0 on failure and -1 if the case is not supported */
+static int run_case(int mode, int version, const char *group,
+                    const BENCH_CERT *cert)
+{
+    SSL_CTX *s_ctx = NULL, *c_ctx = NULL;
+    SSL_SESSION *sess = NULL;
+    BENCH_RESULT res;
+    char name[80];
+    size_t i;
+    int ok = 0;
+
+    BIO_snprintf(name, sizeof(name), "%s/%s/%s%s%s", mode_names[mode],
+                 version == TLS1_3_VERSION ? "TLSv1.3" : "TLSv1.2",
+                 mode == MODE_FULL ? cert->name : "",
+                 mode == MODE_FULL ? "/" : "", group);
+    if (pattern != NULL && strstr(name, pattern) == NULL)
+        return 1;
+
+    if ((s_ctx = make_ctx(1, version, group, cert)) == NULL
+            || (c_ctx = make_ctx(0, version, group, cert)) == NULL) {
+        /* The group or certificate type isn't available in this build */
+        if (verbose)
+            printf("%-32s not supported\n", name);
+        ERR_clear_error();
+        ok = -1;
+        goto err;
+    }
+
+    if (mode == MODE_PSK) {
+        /* The PSK can only be used with a ciphersuite using its hash */
+        if (!SSL_CTX_set_ciphersuites(c_ctx, "TLS_AES_128_GCM_SHA256"))
+            goto err;
+        SSL_CTX_set_psk_use_session_callback(c_ctx, psk_use_session_cb);
+        SSL_CTX_set_psk_find_session_callback(s_ctx, psk_find_session_cb);
+    } else if (mode != MODE_FULL) {
+        /* Get a session to resume from a full handshake */
+        if (!do_handshake(s_ctx, c_ctx, MODE_FULL, NULL, &sess, NULL))
+            goto err;
+    }
+
+    memset(&res, 0, sizeof(res));
+    num_allocs = 0;
+    for (i = 0; i < num_handshakes; ++i) {
+        if (!do_handshake(s_ctx, c_ctx, mode, sess, NULL, &res)) {
+            fprintf(stderr, "%s: %s handshake failed\n", prog, name);
+            goto err;
+        }
+    }
+    res.allocs = num_allocs;
+    print_result(name, &res);
+    ok = 1;
+ err:
+    SSL_SESSION_free(sess);
+    SSL_CTX_free(s_ctx);
+    SSL_CTX_free(c_ctx);
+    return ok;
+}
+
+static int make_psk_session(void)
+{
+    static const unsigned char tls13_aes128gcmsha256_id[] = { 0x13, 0x01 };
+    SSL_CTX *ctx = SSL_CTX_new(TLS_client_method());
+    SSL *ssl = NULL;
+    const SSL_CIPHER *cipher;
+    int ok = 0;
+
+    if (ctx == NULL
+            || (ssl = SSL_new(ctx)) == NULL
+            || (cipher = SSL_CIPHER_find(ssl, tls13_aes128gcmsha256_id)) == NULL
+            || (psk_session = SSL_SESSION_new()) == NULL
+            || !SSL_SESSION_set1_master_key(psk_session, psk_key,
+                                            sizeof(psk_key))
+            || !SSL_SESSION_set_cipher(psk_session, cipher)
+            || !SSL_SESSION_set_protocol_version(psk_session, TLS1_3_VERSION))
+        goto err;
+    ok = 1;
+ err:
+    SSL_free(ssl);
+    SSL_CTX_free(ctx);
+    return ok;
+}
+
+static int run_bench(void)
+{
+    static const int versions[] = { TLS1_2_VERSION, TLS1_3_VERSION };
+    size_t v, c, g;
+    int mode, i, ret, ok = 0;
+
+    if (!make_psk_session())
+        goto err;
+
+    printf("%-32s %10s %8s %8s", "case", "hs/s/core", "allocs",
+           "usec/hs");
+    for (i = 0; i < PHASE_NUM; ++i)
+        printf(" %7s", phase_names[i]);
+    printf("\n");
+
+    for (mode = MODE_FULL; mode <= MODE_EARLY_DATA; ++mode) {
+        for (v = 0; v < OSSL_NELEM(versions); ++v) {
+            if ((mode == MODE_PSK || mode == MODE_EARLY_DATA)
+                    && versions[v] != TLS1_3_VERSION)
+                continue;
+            for (c = 0; c < OSSL_NELEM(bench_certs); ++c) {
+                /* The certificate only matters for full handshakes */
+                if (mode != MODE_FULL && c > 0)
+                    break;
+                for (g = 0; g < OSSL_NELEM(bench_groups); ++g) {
+                    /* TLSv1.2 only negotiates FFDHE groups with DHE suites */
+                    if (versions[v] == TLS1_2_VERSION
+                            && strncmp(bench_groups[g], "ffdhe", 5) == 0)
+                        continue;
+                    ret = run_case(mode, versions[v], bench_groups[g],
+                                   &bench_certs[c]);
+                    if (ret == 0)
+                        goto err;
+                }
+            }
+        }
+    }
+    ok = 1;
+ err:
+    if (!ok)
+        ERR_print_errors_fp(stderr);
+    SSL_SESSION_free(psk_session);
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    int i;
+
+    prog = argv[0];
+    /* This must happen before anything is allocated */
+    if (!CRYPTO_set_mem_functions(count_malloc, count_realloc, count_free)) {
+        fprintf(stderr, "%s: cannot count allocations\n", prog);
+        return EXIT_FAILURE;
+    }
+
+    for (i = 1; i < argc && argv[i][0] == '-'; ++i) {
+        if (strcmp(argv[i], "-n") == 0) {
+            if (!parse_size(argv[++i], &num_handshakes))
+                usage();
+        } else if (strcmp(argv[i], "-p") == 0) {
+            if ((pattern = argv[++i]) == NULL)
+                usage();
+        } else if (strcmp(argv[i], "-v") == 0) {
+            verbose = 1;
+        } else {
+            usage();
+        }
+    }
+
+    if (argc - i != 1)
+        usage();
+    certsdir = argv[i];
+
+    return run_bench() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
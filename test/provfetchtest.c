@@ -1,5 +1,5 @@
 /*
- * Copyright 2021-2023 The OpenSSL Project Authors. All Rights Reserved.
+ * Copyright 2021-2025 The OpenSSL Project Authors. All Rights Reserved.
  *
  * Licensed under the Apache License 2.0 (the "License").  You may not use
  * this file except in compliance with the License.  You can obtain a copy
@@ -13,6 +13,7 @@
 #include <openssl/encoder.h>
 #include <openssl/store.h>
 #include <openssl/rand.h>
+#include <openssl/evp.h>
 #include <openssl/core_names.h>
 #include "testutil.h"
 
@@ -289,9 +290,65 @@ static int fetch_test(int tst)
     return testresult;
 }
 
+static void count_md(EVP_MD *md, void *arg)
+{
+    (*(int *)arg)++;
+}
+
+/*
+ * Only the methods asked for are constructed when fetching by name, check
+ * that the rest are still there when enumerating afterwards.
+ */
+static int fetch_then_do_all_test(void)
+{
+    OSSL_LIB_CTX *libctx1 = OSSL_LIB_CTX_new();
+    OSSL_LIB_CTX *libctx2 = OSSL_LIB_CTX_new();
+    OSSL_PROVIDER *prov1 = NULL, *prov2 = NULL;
+    EVP_MD *md1 = NULL, *md2 = NULL, *md3 = NULL;
+    int count1 = 0, count2 = 0;
+    int testresult = 0;
+
+    if (!TEST_ptr(libctx1)
+            || !TEST_ptr(libctx2)
+            || !TEST_ptr(prov1 = OSSL_PROVIDER_load(libctx1, "default"))
+            || !TEST_ptr(prov2 = OSSL_PROVIDER_load(libctx2, "default")))
+        goto err;
+
+    /* A name only the provider knows, then a legacy alias of it */
+    if (!TEST_ptr(md1 = EVP_MD_fetch(libctx1, "SHA2-256", NULL))
+            || !TEST_ptr(md2 = EVP_MD_fetch(libctx1, "sha256", NULL))
+            || !TEST_ptr_eq(md1, md2))
+        goto err;
+
+    ERR_set_mark();
+    md3 = EVP_MD_fetch(libctx1, "NO-SUCH-DIGEST", NULL);
+    ERR_pop_to_mark();
+    if (!TEST_ptr_null(md3))
+        goto err;
+
+    EVP_MD_do_all_provided(libctx1, count_md, &count1);
+    EVP_MD_do_all_provided(libctx2, count_md, &count2);
+    if (!TEST_int_gt(count1, 1)
+            || !TEST_int_eq(count1, count2)
+            || !TEST_ptr(md3 = EVP_MD_fetch(libctx1, "SHA3-256", NULL)))
+        goto err;
+
+    testresult = 1;
+ err:
+    EVP_MD_free(md1);
+    EVP_MD_free(md2);
+    EVP_MD_free(md3);
+    OSSL_PROVIDER_unload(prov1);
+    OSSL_PROVIDER_unload(prov2);
+    OSSL_LIB_CTX_free(libctx1);
+    OSSL_LIB_CTX_free(libctx2);
+    return testresult;
+}
+
 int setup_tests(void)
 {
     ADD_ALL_TESTS(fetch_test, 8);
+    ADD_TEST(fetch_then_do_all_test);
 
     return 1;
 }
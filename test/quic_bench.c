@@ -0,0 +1,542 @@
+/*
+ * Copyright 2024 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+/*
+ * QUIC performance benchmark.
+ *
+ * This runs a number of QUIC client connections against the same number of
+ * QUIC test server instances entirely in memory, using BIO_s_dgram_pair() as
+ * the network. Everything runs on a single thread, so the figures reported
+ * include the cost of both endpoints.
+ *
+ * Two phases are measured:
+ *
+ *   - handshake: all connections are established concurrently and the
+ *     handshake rate is reported;
+ *
+ *   - bulk: every connection opens a number of unidirectional streams and
+ *     sends a fixed amount of data on each. Goodput, per-stream completion
+ *     latency percentiles and CPU time per GB transferred are reported.
+ *
+ * This is not run as part of the regular test suite other than as a quick
+ * smoke test; it is intended to be used to detect performance regressions in
+ * the QUIC stack.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <openssl/ssl.h>
+#include <openssl/quic.h>
+#include <openssl/bio.h>
+#include <openssl/err.h>
+#include "internal/e_os.h"
+#include "internal/sockets.h"
+#include "internal/quic_tserver.h"
+#include "internal/time.h"
+
+#ifndef OPENSSL_NO_QUIC
+
+typedef struct bench_stream_st {
+    SSL         *ssl;
+    uint64_t    id;
+    size_t      written, read;
+    OSSL_TIME   start, end;
+    int         concluded, done;
+} BENCH_STREAM;
+
+typedef struct bench_conn_st {
+    SSL             *c_ssl;
+    BIO             *c_net_bio;
+    QUIC_TSERVER    *tserver;
+    BENCH_STREAM    *streams;
+    size_t          num_created, num_done;
+    int             connected;
+} BENCH_CONN;
+
+static const char *prog;
+static size_t num_conns = 16, num_streams = 8, stream_len = 1024 * 1024;
+static int verbose = 0;
+
+static unsigned char alpn[] = { 8, 'o', 's', 's', 'l', 't', 'e', 's', 't' };
+static unsigned char tx_buf[16384], rx_buf[16384];
+
+static void usage(void)
+{
+    fprintf(stderr, "Usage: %s [flags] certfile keyfile\n", prog);
+    fprintf(stderr, "Flags:\n");
+    fprintf(stderr, "  -c #  Number of concurrent connections (default %zu)\n",
+            num_conns);
+    fprintf(stderr, "  -s #  Number of streams per connection (default %zu)\n",
+            num_streams);
+    fprintf(stderr, "  -b #  Bytes sent on each stream (default %zu)\n",
+            stream_len);
+    fprintf(stderr, "  -v    Verbose output\n");
+    exit(EXIT_FAILURE);
+}
+
+static int parse_size(const char *s, size_t *out)
+{
+    char *end;
+    unsigned long v;
+
+    if (s == NULL)
+        return 0;
+    v = strtoul(s, &end, 10);
+    if (end == s || *end != '\0' || v == 0)
+        return 0;
+    *out = (size_t)v;
+    return 1;
+}
+
+static double cpu_seconds(void)
+{
+    return (double)clock() / CLOCKS_PER_SEC;
+}
+
+static double time_seconds(OSSL_TIME t)
+{
+    return (double)ossl_time2ticks(t) / (double)OSSL_TIME_SECOND;
+}
+
+static int conn_init(BENCH_CONN *conn, SSL_CTX *c_ctx,
+                     const char *certfile, const char *keyfile)
+{
+    QUIC_TSERVER_ARGS tserver_args = {0};
+    BIO *c_bio = NULL, *s_bio = NULL;
+    BIO_ADDR *peer_addr = NULL;
+    struct in_addr ina = {0};
+    int ok = 0;
+
+    memset(conn, 0, sizeof(*conn));
+
+    conn->streams = OPENSSL_zalloc(sizeof(*conn->streams) * num_streams);
+    if (conn->streams == NULL)
+        goto err;
+
+    if (!BIO_new_bio_dgram_pair(&c_bio, 0, &s_bio, 0)
+        || !BIO_dgram_set_caps(c_bio, BIO_DGRAM_CAP_HANDLES_DST_ADDR)
+        || !BIO_dgram_set_caps(s_bio, BIO_DGRAM_CAP_HANDLES_DST_ADDR))
+        goto err;
+
+    if ((peer_addr = BIO_ADDR_new()) == NULL
+        || !BIO_ADDR_rawmake(peer_addr, AF_INET, &ina, sizeof(ina), htons(0)))
+        goto err;
+
+    /* The tserver takes a reference for each of the read and write BIOs */
+    if (!BIO_up_ref(s_bio))
+        goto err;
+
+    tserver_args.net_rbio = s_bio;
+    tserver_args.net_wbio = s_bio;
+    if ((conn->tserver = ossl_quic_tserver_new(&tserver_args,
+                                               certfile, keyfile)) == NULL) {
+        BIO_free(s_bio);
+        goto err;
+    }
+    s_bio = NULL;
+
+    if ((conn->c_ssl = SSL_new(c_ctx)) == NULL)
+        goto err;
+
+    /* SSL_set_alpn_protos returns 0 for success */
+    if (SSL_set_alpn_protos(conn->c_ssl, alpn, sizeof(alpn)) != 0
+        || !SSL_set_blocking_mode(conn->c_ssl, 0)
+        || !SSL_set_default_stream_mode(conn->c_ssl,
+                                        SSL_DEFAULT_STREAM_MODE_NONE)
+        || !SSL_set1_initial_peer_addr(conn->c_ssl, peer_addr))
+        goto err;
+
+    conn->c_net_bio = c_bio;
+    SSL_set_bio(conn->c_ssl, c_bio, c_bio);
+    c_bio = NULL;
+    ok = 1;
+ err:
+    BIO_ADDR_free(peer_addr);
+    BIO_free(c_bio);
+    BIO_free(s_bio);
+    return ok;
+}
+
+static void conn_cleanup(BENCH_CONN *conn)
+{
+    size_t i;
+
+    if (conn->streams != NULL)
+        for (i = 0; i < num_streams; ++i)
+            SSL_free(conn->streams[i].ssl);
+
+    OPENSSL_free(conn->streams);
+    SSL_free(conn->c_ssl);
+    ossl_quic_tserver_free(conn->tserver);
+}
+
+/*
+ * Returns the number of bytes waiting to be processed by either endpoint of a
+ * connection. When nothing is pending and no application progress was made we
+ * can sleep until the next timer deadline rather than spinning.
+ */
+static size_t conn_net_pending(BENCH_CONN *conn)
+{
+    return BIO_pending(conn->c_net_bio)
+        + BIO_pending(ossl_quic_tserver_get0_rbio(conn->tserver));
+}
+
+static OSSL_TIME conn_deadline(BENCH_CONN *conn)
+{
+    OSSL_TIME deadline = ossl_quic_tserver_get_deadline(conn->tserver);
+    struct timeval tv;
+    int is_infinite = 1;
+
+    if (SSL_get_event_timeout(conn->c_ssl, &tv, &is_infinite) && !is_infinite)
+        deadline = ossl_time_min(deadline,
+                                 ossl_time_add(ossl_time_now(),
+                                               ossl_time_from_timeval(tv)));
+
+    return deadline;
+}
+
+static void wait_for_deadline(BENCH_CONN *conns)
+{
+    OSSL_TIME deadline = ossl_time_infinite(), now;
+    size_t i;
+
+    for (i = 0; i < num_conns; ++i) {
+        if (conn_net_pending(&conns[i]) > 0)
+            return;
+        deadline = ossl_time_min(deadline, conn_deadline(&conns[i]));
+    }
+
+    now = ossl_time_now();
+    if (ossl_time_compare(deadline, now) <= 0)
+        return;
+
+    /* Do not oversleep in case a deadline is missed by a component. */
+    deadline = ossl_time_min(deadline, ossl_time_add(now, ossl_ms2time(10)));
+    OSSL_sleep(ossl_time2ms(ossl_time_subtract(deadline, now)));
+}
+
+/* Returns 1 if progress was made, 0 if not and -1 on error. */
+static int conn_step_handshake(BENCH_CONN *conn)
+{
+    int ret;
+
+    ossl_quic_tserver_tick(conn->tserver);
+    if (conn->connected)
+        return 0;
+
+    ret = SSL_connect(conn->c_ssl);
+    if (ret == 1) {
+        conn->connected = 1;
+        return 1;
+    }
+
+    switch (SSL_get_error(conn->c_ssl, ret)) {
+    case SSL_ERROR_WANT_READ:
+    case SSL_ERROR_WANT_WRITE:
+        return 0;
+    default:
+        return -1;
+    }
+}
+
+static int stream_write(BENCH_STREAM *bs)
+{
+    size_t written = 0, to_write;
+    int progress = 0;
+
+    while (bs->written < stream_len) {
+        to_write = stream_len - bs->written;
+        if (to_write > sizeof(tx_buf))
+            to_write = sizeof(tx_buf);
+
+        if (!SSL_write_ex(bs->ssl, tx_buf, to_write, &written)) {
+            switch (SSL_get_error(bs->ssl, 0)) {
+            case SSL_ERROR_WANT_READ:
+            case SSL_ERROR_WANT_WRITE:
+                return progress;
+            default:
+                return -1;
+            }
+        }
+
+        bs->written += written;
+        progress = 1;
+    }
+
+    if (!bs->concluded) {
+        if (!SSL_stream_conclude(bs->ssl, 0))
+            return -1;
+        bs->concluded = 1;
+        progress = 1;
+    }
+
+    return progress;
+}
+
+static int stream_read(BENCH_CONN *conn, BENCH_STREAM *bs)
+{
+    size_t bytes_read;
+    int progress = 0;
+
+    for (;;) {
+        /*
+         * Check for the end of the stream before reading as reading from a
+         * stream which has been read to the end is an error.
+         */
+        if (ossl_quic_tserver_has_read_ended(conn->tserver, bs->id)) {
+            if (bs->read != stream_len)
+                return -1;
+
+            bs->end = ossl_time_now();
+            bs->done = 1;
+            ++conn->num_done;
+            return 1;
+        }
+
+        bytes_read = 0;
+        if (!ossl_quic_tserver_read(conn->tserver, bs->id, rx_buf,
+                                    sizeof(rx_buf), &bytes_read))
+            return -1;
+
+        if (bytes_read == 0)
+            break;
+
+        bs->read += bytes_read;
+        progress = 1;
+    }
+
+    return progress;
+}
+
+/* Returns 1 if progress was made, 0 if not and -1 on error. */
+static int conn_step_bulk(BENCH_CONN *conn)
+{
+    BENCH_STREAM *bs;
+    size_t i;
+    int progress = 0, ret;
+
+    SSL_handle_events(conn->c_ssl);
+    ossl_quic_tserver_tick(conn->tserver);
+
+    while (ossl_quic_tserver_pop_incoming_stream(conn->tserver) != UINT64_MAX)
+        ;
+
+    /*
+     * Open new streams until we hit the peer's stream limit. The remaining
+     * streams are opened once the server has retired earlier ones.
+     */
+    while (conn->num_created < num_streams) {
+        bs = &conn->streams[conn->num_created];
+        bs->ssl = SSL_new_stream(conn->c_ssl,
+                                 SSL_STREAM_FLAG_UNI | SSL_STREAM_FLAG_NO_BLOCK);
+        if (bs->ssl == NULL) {
+            ERR_clear_error();
+            break;
+        }
+
+        bs->id = SSL_get_stream_id(bs->ssl);
+        bs->start = ossl_time_now();
+        ++conn->num_created;
+        progress = 1;
+    }
+
+    for (i = 0; i < conn->num_created; ++i) {
+        bs = &conn->streams[i];
+        if (bs->done)
+            continue;
+
+        if (!bs->concluded) {
+            if ((ret = stream_write(bs)) < 0)
+                return -1;
+            progress |= ret;
+        }
+
+        if ((ret = stream_read(conn, bs)) < 0)
+            return -1;
+        progress |= ret;
+    }
+
+    return progress;
+}
+
+static int cmp_double(const void *a, const void *b)
+{
+    double da = *(const double *)a, db = *(const double *)b;
+
+    return da < db ? -1 : da > db ? 1 : 0;
+}
+
+static double percentile(const double *sorted, size_t n, double pct)
+{
+    size_t idx = (size_t)(pct / 100.0 * (double)(n - 1) + 0.5);
+
+    return sorted[idx < n ? idx : n - 1];
+}
+
+static int run_bench(const char *certfile, const char *keyfile)
+{
+    SSL_CTX *c_ctx = NULL;
+    BENCH_CONN *conns = NULL;
+    double *latencies = NULL;
+    size_t i, j, n, remaining;
+    double cpu_start, cpu_hs, cpu_bulk, wall_hs, wall_bulk, bytes;
+    OSSL_TIME start;
+    int ret, progress, ok = 0;
+
+    memset(tx_buf, 'A', sizeof(tx_buf));
+
+    if ((c_ctx = SSL_CTX_new(OSSL_QUIC_client_method())) == NULL)
+        goto err;
+
+    SSL_CTX_set_verify(c_ctx, SSL_VERIFY_NONE, NULL);
+    SSL_CTX_set_mode(c_ctx, SSL_MODE_ENABLE_PARTIAL_WRITE);
+
+    conns = OPENSSL_zalloc(sizeof(*conns) * num_conns);
+    latencies = OPENSSL_malloc(sizeof(*latencies) * num_conns * num_streams);
+    if (conns == NULL || latencies == NULL)
+        goto err;
+
+    for (i = 0; i < num_conns; ++i)
+        if (!conn_init(&conns[i], c_ctx, certfile, keyfile))
+            goto err;
+
+    /* Handshake phase */
+    start = ossl_time_now();
+    cpu_start = cpu_seconds();
+    remaining = num_conns;
+    while (remaining > 0) {
+        progress = 0;
+        for (i = 0; i < num_conns; ++i) {
+            if ((ret = conn_step_handshake(&conns[i])) < 0) {
+                fprintf(stderr, "%s: handshake failed on connection %zu\n",
+                        prog, i);
+                goto err;
+            }
+            if (ret > 0) {
+                progress = 1;
+                --remaining;
+            }
+        }
+
+        if (!progress)
+            wait_for_deadline(conns);
+    }
+    wall_hs = time_seconds(ossl_time_subtract(ossl_time_now(), start));
+    cpu_hs = cpu_seconds() - cpu_start;
+
+    /* Bulk transfer phase */
+    start = ossl_time_now();
+    cpu_start = cpu_seconds();
+    remaining = num_conns;
+    while (remaining > 0) {
+        progress = 0;
+        remaining = 0;
+        for (i = 0; i < num_conns; ++i) {
+            if (conns[i].num_done == num_streams)
+                continue;
+
+            if ((ret = conn_step_bulk(&conns[i])) < 0) {
+                fprintf(stderr, "%s: transfer failed on connection %zu\n",
+                        prog, i);
+                goto err;
+            }
+            progress |= ret;
+            if (conns[i].num_done < num_streams)
+                ++remaining;
+        }
+
+        if (remaining > 0 && !progress)
+            wait_for_deadline(conns);
+    }
+    wall_bulk = time_seconds(ossl_time_subtract(ossl_time_now(), start));
+    cpu_bulk = cpu_seconds() - cpu_start;
+
+    for (i = 0, n = 0; i < num_conns; ++i)
+        for (j = 0; j < num_streams; ++j)
+            latencies[n++]
+                = time_seconds(ossl_time_subtract(conns[i].streams[j].end,
+                                                  conns[i].streams[j].start));
+
+    qsort(latencies, n, sizeof(*latencies), cmp_double);
+    bytes = (double)num_conns * (double)num_streams * (double)stream_len;
+
+    printf("connections:          %zu\n", num_conns);
+    printf("streams/connection:   %zu\n", num_streams);
+    printf("bytes/stream:         %zu\n", stream_len);
+    printf("handshakes/sec:       %.1f\n",
+           wall_hs > 0 ? (double)num_conns / wall_hs : 0.0);
+    printf("handshake cpu/conn:   %.3f ms\n",
+           cpu_hs * 1000.0 / (double)num_conns);
+    printf("goodput:              %.2f Mbit/s\n",
+           wall_bulk > 0 ? bytes * 8 / wall_bulk / 1e6 : 0.0);
+    printf("cpu/GB:               %.3f s\n",
+           bytes > 0 ? cpu_bulk * 1e9 / bytes : 0.0);
+    printf("stream latency p50:   %.3f ms\n",
+           percentile(latencies, n, 50) * 1000.0);
+    printf("stream latency p90:   %.3f ms\n",
+           percentile(latencies, n, 90) * 1000.0);
+    printf("stream latency p99:   %.3f ms\n",
+           percentile(latencies, n, 99) * 1000.0);
+    printf("stream latency max:   %.3f ms\n", latencies[n - 1] * 1000.0);
+    if (verbose)
+        printf("wall time:            %.3f s handshake, %.3f s bulk\n",
+               wall_hs, wall_bulk);
+
+    ok = 1;
+ err:
+    if (!ok)
+        ERR_print_errors_fp(stderr);
+    if (conns != NULL)
+        for (i = 0; i < num_conns; ++i)
+            conn_cleanup(&conns[i]);
+    OPENSSL_free(conns);
+    OPENSSL_free(latencies);
+    SSL_CTX_free(c_ctx);
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    int i;
+
+    prog = argv[0];
+    for (i = 1; i < argc && argv[i][0] == '-'; ++i) {
+        if (strcmp(argv[i], "-c") == 0) {
+            if (!parse_size(argv[++i], &num_conns))
+                usage();
+        } else if (strcmp(argv[i], "-s") == 0) {
+            if (!parse_size(argv[++i], &num_streams))
+                usage();
+        } else if (strcmp(argv[i], "-b") == 0) {
+            if (!parse_size(argv[++i], &stream_len))
+                usage();
+        } else if (strcmp(argv[i], "-v") == 0) {
+            verbose = 1;
+        } else {
+            usage();
+        }
+    }
+
+    if (argc - i != 2)
+        usage();
+
+    return run_bench(argv[i], argv[i + 1]) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#else
+
+int main(int argc, char **argv)
+{
+    fprintf(stderr, "QUIC support is disabled\n");
+    return EXIT_FAILURE;
+}
+
+#endif
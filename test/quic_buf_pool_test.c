@@ -0,0 +1,147 @@
+/*
+ * Copyright 2024 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+#include <string.h>
+#include "internal/quic_buf_pool.h"
+#include "testutil.h"
+
+#define NUM_BUFS    8
+
+static int test_buf_pool_reuse(void)
+{
+    int testresult = 0;
+    QUIC_BUF_POOL *pool;
+    QUIC_BUF_POOL_STATS stats;
+    void *bufs[NUM_BUFS] = {0};
+    void *buf;
+    size_t i;
+
+    if (!TEST_ptr(pool = ossl_quic_buf_pool_new(1000)))
+        goto err;
+
+    /* Buffer size is rounded up to a multiple of the cache line size. */
+    if (!TEST_size_t_eq(ossl_quic_buf_pool_get_buf_len(pool), 1024))
+        goto err;
+
+    for (i = 0; i < NUM_BUFS; ++i) {
+        if (!TEST_ptr(bufs[i] = ossl_quic_buf_pool_alloc(pool, 1000))
+            || !TEST_size_t_eq((size_t)bufs[i] % 64, 0))
+            goto err;
+
+        memset(bufs[i], (int)i, 1000);
+    }
+
+    ossl_quic_buf_pool_get_stats(pool, &stats);
+    if (!TEST_uint64_t_eq(stats.num_alloc, NUM_BUFS)
+        || !TEST_uint64_t_eq(stats.num_alloc_cached, 0)
+        || !TEST_size_t_eq(stats.num_in_use, NUM_BUFS)
+        || !TEST_size_t_eq(stats.high_water, NUM_BUFS))
+        goto err;
+
+    /* Released buffers are reused. */
+    buf = bufs[3];
+    ossl_quic_buf_pool_release(pool, bufs[3]);
+    if (!TEST_ptr_eq(bufs[3] = ossl_quic_buf_pool_alloc(pool, 10), buf))
+        goto err;
+
+    /* Growing a pool buffer within the pool buffer size happens in place. */
+    if (!TEST_ptr_eq(ossl_quic_buf_pool_realloc(pool, bufs[3], 10, 1024), buf))
+        goto err;
+
+    /* Growing beyond it moves the buffer to the heap, preserving contents. */
+    if (!TEST_ptr(buf = ossl_quic_buf_pool_realloc(pool, bufs[4], 1000, 4096))
+        || !TEST_ptr_ne(buf, bufs[4]))
+        goto err;
+
+    bufs[4] = buf;
+    for (i = 0; i < 1000; ++i)
+        if (!TEST_int_eq(((unsigned char *)buf)[i], 4))
+            goto err;
+
+    ossl_quic_buf_pool_get_stats(pool, &stats);
+    if (!TEST_uint64_t_eq(stats.num_alloc_cached, 1)
+        || !TEST_uint64_t_eq(stats.num_alloc_oversize, 1)
+        || !TEST_size_t_eq(stats.num_in_use, NUM_BUFS - 1)
+        || !TEST_size_t_eq(stats.num_cached, 1))
+        goto err;
+
+    testresult = 1;
+err:
+    for (i = 0; i < NUM_BUFS; ++i)
+        ossl_quic_buf_pool_release(pool, bufs[i]);
+
+    ossl_quic_buf_pool_free(pool);
+    return testresult;
+}
+
+static int test_buf_pool_trim(void)
+{
+    int testresult = 0;
+    QUIC_BUF_POOL *pool;
+    QUIC_BUF_POOL_STATS stats;
+    void *bufs[NUM_BUFS] = {0};
+    size_t i;
+
+    if (!TEST_ptr(pool = ossl_quic_buf_pool_new(QUIC_BUF_POOL_DEFAULT_BUF_LEN)))
+        goto err;
+
+    /* Peak demand of NUM_BUFS, then everything is released. */
+    for (i = 0; i < NUM_BUFS; ++i)
+        if (!TEST_ptr(bufs[i] = ossl_quic_buf_pool_alloc(pool, 1200)))
+            goto err;
+
+    for (i = 0; i < NUM_BUFS; ++i) {
+        ossl_quic_buf_pool_release(pool, bufs[i]);
+        bufs[i] = NULL;
+    }
+
+    /* The first trim keeps enough buffers to meet the recent peak. */
+    ossl_quic_buf_pool_trim(pool);
+    ossl_quic_buf_pool_get_stats(pool, &stats);
+    if (!TEST_size_t_eq(stats.num_cached, NUM_BUFS)
+        || !TEST_uint64_t_eq(stats.num_trimmed, 0))
+        goto err;
+
+    /* Demand since then has been lower, so the surplus is freed. */
+    if (!TEST_ptr(bufs[0] = ossl_quic_buf_pool_alloc(pool, 1200))
+        || !TEST_ptr(bufs[1] = ossl_quic_buf_pool_alloc(pool, 1200)))
+        goto err;
+
+    ossl_quic_buf_pool_release(pool, bufs[1]);
+    bufs[1] = NULL;
+
+    ossl_quic_buf_pool_trim(pool);
+    ossl_quic_buf_pool_get_stats(pool, &stats);
+    if (!TEST_size_t_eq(stats.num_in_use, 1)
+        || !TEST_size_t_eq(stats.num_cached, 1)
+        || !TEST_uint64_t_eq(stats.num_trimmed, NUM_BUFS - 2)
+        || !TEST_size_t_eq(stats.high_water, NUM_BUFS))
+        goto err;
+
+    /* With no further demand, all cached buffers are freed. */
+    ossl_quic_buf_pool_trim(pool);
+    ossl_quic_buf_pool_get_stats(pool, &stats);
+    if (!TEST_size_t_eq(stats.num_cached, 0))
+        goto err;
+
+    testresult = 1;
+err:
+    for (i = 0; i < NUM_BUFS; ++i)
+        ossl_quic_buf_pool_release(pool, bufs[i]);
+
+    ossl_quic_buf_pool_free(pool);
+    return testresult;
+}
+
+int setup_tests(void)
+{
+    ADD_TEST(test_buf_pool_reuse);
+    ADD_TEST(test_buf_pool_trim);
+    return 1;
+}
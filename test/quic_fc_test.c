@@ -191,6 +191,21 @@ static int test_txfc(int is_stream)
             goto err;
     }
 
+    /* A reset forgets all credit granted and consumed */
+    ossl_quic_txfc_reset(txfc);
+
+    if (!TEST_uint64_t_eq(ossl_quic_txfc_get_cwm(txfc), 0))
+        goto err;
+
+    if (!TEST_uint64_t_eq(ossl_quic_txfc_get_swm(txfc), 0))
+        goto err;
+
+    if (!TEST_true(ossl_quic_txfc_bump_cwm(txfc, 100)))
+        goto err;
+
+    if (!TEST_uint64_t_eq(ossl_quic_txfc_get_credit_local(txfc, 0), 100))
+        goto err;
+
     testresult = 1;
 err:
     return testresult;
@@ -26,12 +26,14 @@ static int add_ncid_frame_cb(QTEST_FAULT *fault, QUIC_PKT_HDR *hdr,
     /*
      * We inject NEW_CONNECTION_ID frame to trigger change of the DCID.
      * The connection id length must be 8, otherwise the tserver won't be
-     * able to receive packets with this new id.
+     * able to receive packets with this new id. The server itself issues a
+     * connection id with sequence number 1 once the handshake is confirmed,
+     * so we use the next sequence number and retire all earlier ids.
      */
     static unsigned char new_conn_id_frame[] = {
         0x18,                           /* Type */
-        0x01,                           /* Sequence Number */
-        0x01,                           /* Retire Prior To */
+        0x02,                           /* Sequence Number */
+        0x02,                           /* Retire Prior To */
         0x08,                           /* Connection ID Length */
         0x33, 0x44, 0x55, 0x66, 0xde, 0xad, 0xbe, 0xef, /* Connection ID */
         0xab, 0xcd, 0xef, 0x01, 0x12, 0x32, 0x23, 0x45, /* Stateless Reset Token */
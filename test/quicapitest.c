@@ -1221,6 +1221,374 @@ static int test_quic_psk(void)
     return testresult;
 }
 
+static int allow_early_data_cb_cnt = 0;
+
+static int allow_early_data_cb(SSL *s, void *arg)
+{
+    int *allow = arg;
+
+    allow_early_data_cb_cnt++;
+    return *allow;
+}
+
+/*
+ * Replace the initial_max_streams_bidi transport parameter remembered in |sess|
+ * by |limit|.
+ */
+static int set_remembered_max_streams_bidi(SSL_SESSION *sess, uint64_t limit)
+{
+    PACKET pkt;
+    WPACKET wpkt;
+    BUF_MEM *bufm = NULL;
+    const unsigned char *body;
+    unsigned char *params;
+    uint64_t id;
+    size_t len;
+    int have_wpkt = 0, ok = 0;
+
+    if (!TEST_ptr(bufm = BUF_MEM_new())
+            || !TEST_true(WPACKET_init(&wpkt, bufm)))
+        goto err;
+    have_wpkt = 1;
+
+    if (!TEST_true(PACKET_buf_init(&pkt, sess->ext.quic_transport_params,
+                                   sess->ext.quic_transport_params_len)))
+        goto err;
+
+    while (PACKET_remaining(&pkt) > 0) {
+        body = ossl_quic_wire_decode_transport_param_bytes(&pkt, &id, &len);
+        if (!TEST_ptr(body))
+            goto err;
+
+        if (id == QUIC_TPARAM_INITIAL_MAX_STREAMS_BIDI) {
+            if (!TEST_true(ossl_quic_wire_encode_transport_param_int(&wpkt, id,
+                                                                     limit)))
+                goto err;
+        } else if (!TEST_ptr(ossl_quic_wire_encode_transport_param_bytes(&wpkt,
+                                                                         id,
+                                                                         body,
+                                                                         len))) {
+            goto err;
+        }
+    }
+
+    if (!TEST_true(WPACKET_get_total_written(&wpkt, &len))
+            || !TEST_true(WPACKET_finish(&wpkt)))
+        goto err;
+    have_wpkt = 0;
+
+    if (!TEST_ptr(params = OPENSSL_memdup(bufm->data, len)))
+        goto err;
+    OPENSSL_free(sess->ext.quic_transport_params);
+    sess->ext.quic_transport_params = params;
+    sess->ext.quic_transport_params_len = len;
+    ok = 1;
+ err:
+    if (have_wpkt)
+        WPACKET_cleanup(&wpkt);
+    BUF_MEM_free(bufm);
+    return ok;
+}
+
+/*
+ * Test that a QUIC client can send 0-RTT data on a resumed connection.
+ * Test 0: The server accepts the early data
+ * Test 1: The server rejects the early data via the replay callback, so the
+ *         data must be retransmitted in 1-RTT packets
+ * Test 2: As test 1, but the client remembers a higher bidirectional stream
+ *         limit than the server now has, and the server's limit must apply
+ *         once the early data is rejected
+ */
+static int test_quic_early_data(int idx)
+{
+    SSL_CTX *cctx = SSL_CTX_new_ex(libctx, NULL, OSSL_QUIC_client_method());
+    SSL_CTX *sctx = NULL;
+    SSL *clientquic = NULL;
+    QUIC_TSERVER *qtserv = NULL;
+    SSL_SESSION *sess = NULL;
+    int testresult = 0, allow = (idx == 0);
+    unsigned char buf[20];
+    static char *msg = "A test message";
+    size_t msglen = strlen(msg), numbytes = 0;
+    uint64_t enabled = 0, sid = 0, avail = 0;
+
+    if (!TEST_ptr(cctx)
+            || !TEST_true(qtest_create_quic_objects(libctx, cctx, NULL, cert,
+                                                    privkey, 0, &qtserv,
+                                                    &clientquic, NULL, NULL))
+            || !TEST_true(ossl_quic_tserver_set_max_early_data(qtserv,
+                                                               0xffffffff))
+            || !TEST_true(qtest_create_quic_connection(qtserv, clientquic)))
+        goto end;
+
+    /* Exchange some data so that the client receives a session ticket */
+    if (!TEST_true(ossl_quic_tserver_stream_new(qtserv, 0, &sid))
+            || !TEST_true(ossl_quic_tserver_write(qtserv, sid,
+                                                  (unsigned char *)msg,
+                                                  msglen, &numbytes)))
+        goto end;
+    ossl_quic_tserver_tick(qtserv);
+    if (!TEST_true(SSL_read_ex(clientquic, buf, sizeof(buf), &numbytes))
+            || !TEST_mem_eq(buf, numbytes, msg, msglen)
+            || !TEST_ptr(sess = SSL_get1_session(clientquic))
+            || !TEST_true(qtest_shutdown(qtserv, clientquic)))
+        goto end;
+
+    sctx = ossl_quic_tserver_get0_ssl_ctx(qtserv);
+    if (!TEST_true(SSL_CTX_up_ref(sctx))) {
+        sctx = NULL;
+        goto end;
+    }
+    ossl_quic_tserver_free(qtserv);
+    qtserv = NULL;
+    SSL_free(clientquic);
+    clientquic = NULL;
+
+    /* The server's limit is 100 */
+    if (idx == 2 && !TEST_true(set_remembered_max_streams_bidi(sess, 200)))
+        goto end;
+
+    if (!TEST_true(qtest_create_quic_objects(libctx, cctx, sctx, cert, privkey,
+                                             0, &qtserv, &clientquic,
+                                             NULL, NULL))
+            || !TEST_true(ossl_quic_tserver_set_max_early_data(qtserv,
+                                                               0xffffffff))
+            || !TEST_true(SSL_set_session(clientquic, sess))
+            || !TEST_true(SSL_get_quic_early_data_enabled(clientquic,
+                                                          &enabled))
+            || !TEST_uint64_t_eq(enabled, 0)
+            || !TEST_true(SSL_set_quic_early_data_enabled(clientquic, 1))
+            || !TEST_true(SSL_get_quic_early_data_enabled(clientquic,
+                                                          &enabled))
+            || !TEST_uint64_t_eq(enabled, 1)
+            || !TEST_false(SSL_set_quic_early_data_enabled(clientquic, 2)))
+        goto end;
+
+    ossl_quic_tserver_set_allow_early_data_cb(qtserv, allow_early_data_cb,
+                                              &allow);
+    allow_early_data_cb_cnt = 0;
+
+    /* The write must succeed before the handshake has completed */
+    if (!TEST_true(SSL_write_ex(clientquic, msg, msglen, &numbytes))
+            || !TEST_size_t_eq(numbytes, msglen)
+            || !TEST_false(SSL_is_init_finished(clientquic))
+            || !TEST_false(SSL_set_quic_early_data_enabled(clientquic, 0)))
+        goto end;
+
+    /* The write used up one stream under the remembered limit */
+    if (idx == 2
+            && (!TEST_true(SSL_get_quic_stream_bidi_local_avail(clientquic,
+                                                                &avail))
+                || !TEST_uint64_t_eq(avail, 199)))
+        goto end;
+
+    /*
+     * If the early data is accepted the server can read it as soon as it has
+     * processed the ClientHello, before the client has completed the
+     * handshake.
+     */
+    if (idx == 0) {
+        ossl_quic_tserver_tick(qtserv);
+        if (!TEST_true(ossl_quic_tserver_read(qtserv, 0, buf, sizeof(buf),
+                                              &numbytes))
+                || !TEST_mem_eq(buf, numbytes, msg, msglen))
+            goto end;
+    }
+
+    if (!TEST_true(qtest_create_quic_connection(qtserv, clientquic))
+            || !TEST_true(SSL_session_reused(clientquic))
+            || !TEST_int_eq(allow_early_data_cb_cnt, 1)
+            || !TEST_int_eq(SSL_get_early_data_status(clientquic),
+                            idx == 0 ? SSL_EARLY_DATA_ACCEPTED
+                                     : SSL_EARLY_DATA_REJECTED))
+        goto end;
+
+    if (idx == 0) {
+        testresult = 1;
+        goto end;
+    }
+
+    /* The rejected data must be retransmitted once the handshake completes */
+    numbytes = 0;
+    do {
+        ossl_quic_tserver_tick(qtserv);
+        SSL_handle_events(clientquic);
+        if (!TEST_true(ossl_quic_tserver_read(qtserv, 0, buf, sizeof(buf),
+                                              &numbytes)))
+            goto end;
+    } while (numbytes == 0);
+
+    if (!TEST_mem_eq(buf, numbytes, msg, msglen))
+        goto end;
+
+    if (idx == 2
+            && (!TEST_true(SSL_get_quic_stream_bidi_local_avail(clientquic,
+                                                                &avail))
+                || !TEST_uint64_t_eq(avail, 99)))
+        goto end;
+
+    testresult = 1;
+
+ end:
+    SSL_SESSION_free(sess);
+    SSL_free(clientquic);
+    ossl_quic_tserver_free(qtserv);
+    SSL_CTX_free(cctx);
+    SSL_CTX_free(sctx);
+
+    return testresult;
+}
+
+/*
+ * Send a message from the client to the server on stream 0 and echo it back,
+ * ticking both sides until the data arrives.
+ */
+static int migration_exchange(QUIC_TSERVER *qtserv, SSL *clientquic)
+{
+    static const unsigned char msg[] = "migrate";
+    unsigned char buf[sizeof(msg)];
+    size_t numbytes = 0, total = 0;
+    int i;
+
+    if (!TEST_true(SSL_write_ex(clientquic, msg, sizeof(msg), &numbytes))
+            || !TEST_size_t_eq(numbytes, sizeof(msg)))
+        return 0;
+
+    for (i = 0; i < 1000 && total < sizeof(msg); i++) {
+        SSL_handle_events(clientquic);
+        ossl_quic_tserver_tick(qtserv);
+        if (!TEST_true(ossl_quic_tserver_read(qtserv, 0, buf + total,
+                                              sizeof(buf) - total, &numbytes)))
+            return 0;
+        total += numbytes;
+        if (total < sizeof(msg))
+            OSSL_sleep(1);
+    }
+
+    if (!TEST_mem_eq(buf, total, msg, sizeof(msg))
+            || !TEST_true(ossl_quic_tserver_write(qtserv, 0, msg, sizeof(msg),
+                                                  &numbytes))
+            || !TEST_size_t_eq(numbytes, sizeof(msg)))
+        return 0;
+
+    for (i = 0, total = 0; i < 1000 && total < sizeof(msg); i++) {
+        ossl_quic_tserver_tick(qtserv);
+        if (SSL_read_ex(clientquic, buf + total, sizeof(buf) - total,
+                        &numbytes))
+            total += numbytes;
+        else if (!TEST_int_eq(SSL_get_error(clientquic, 0),
+                              SSL_ERROR_WANT_READ))
+            return 0;
+        if (total < sizeof(msg))
+            OSSL_sleep(1);
+    }
+
+    return TEST_mem_eq(buf, total, msg, sizeof(msg));
+}
+
+/*
+ * Test that a connection survives a change of the client's address.
+ * Test 0: NAT rebinding; the client is unaware its address has changed
+ * Test 1: Active migration; the application gives the client a new socket
+ */
+static int test_quic_migration(int idx)
+{
+    SSL_CTX *cctx = NULL;
+    SSL *clientquic = NULL;
+    QUIC_TSERVER *qtserv = NULL;
+    QUIC_CHANNEL *sch, *cch, *vch;
+    BIO *newbio = NULL;
+    BIO_ADDR *localaddr = NULL, *peeraddr = NULL;
+    union BIO_sock_info_u info;
+    int newfd = -1, newfd_owned = 0, testresult = 0, i;
+
+    if (!qtest_supports_blocking())
+        return TEST_skip("Socket-based tests not supported in this build");
+
+    /*
+     * We need real sockets for the server to see the client's address, but
+     * drive both sides from this thread.
+     */
+    if (!TEST_ptr(cctx = SSL_CTX_new_ex(libctx, NULL, OSSL_QUIC_client_method()))
+            || !TEST_true(qtest_create_quic_objects(libctx, cctx, NULL, cert,
+                                                    privkey, QTEST_FLAG_BLOCK,
+                                                    &qtserv, &clientquic, NULL,
+                                                    NULL))
+            || !TEST_true(SSL_set_blocking_mode(clientquic, 0))
+            || !TEST_true(qtest_create_quic_connection(qtserv, clientquic))
+            || !TEST_true(migration_exchange(qtserv, clientquic)))
+        goto err;
+
+    sch = ossl_quic_tserver_get_channel(qtserv);
+    cch = ossl_quic_conn_get_channel(clientquic);
+    if (!TEST_ptr(sch) || !TEST_ptr(cch)
+            || !TEST_true(ossl_quic_channel_is_handshake_confirmed(cch)))
+        goto err;
+
+    if (!TEST_int_ge(newfd = BIO_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP, 0), 0))
+        goto err;
+    newfd_owned = 1;
+    if (!TEST_true(BIO_socket_nbio(newfd, 1)))
+        goto err;
+
+    if (idx == 0) {
+        /* Swap the socket out from under the client; this closes the old one */
+        BIO_set_fd(SSL_get_wbio(clientquic), newfd, BIO_CLOSE);
+        newfd_owned = 0;
+        vch = sch;
+    } else {
+        if (!TEST_ptr(newbio = BIO_new_dgram(newfd, BIO_CLOSE)))
+            goto err;
+        newfd_owned = 0;
+        SSL_set_bio(clientquic, newbio, newbio);
+        vch = cch;
+        if (!TEST_true(ossl_quic_channel_is_validating_path(cch)))
+            goto err;
+    }
+
+    if (!TEST_true(migration_exchange(qtserv, clientquic)))
+        goto err;
+
+    /* Wait for validation of the new path to complete */
+    for (i = 0; i < 1000 && ossl_quic_channel_is_validating_path(vch); i++) {
+        SSL_handle_events(clientquic);
+        ossl_quic_tserver_tick(qtserv);
+        OSSL_sleep(1);
+    }
+
+    if (!TEST_false(ossl_quic_channel_is_validating_path(vch))
+            || !TEST_true(ossl_quic_channel_is_active(sch))
+            || !TEST_true(ossl_quic_channel_is_active(cch)))
+        goto err;
+
+    /* The server should now be talking to our new socket */
+    if (!TEST_ptr(localaddr = BIO_ADDR_new())
+            || !TEST_ptr(peeraddr = BIO_ADDR_new()))
+        goto err;
+    info.addr = localaddr;
+    if (!TEST_true(BIO_sock_info(newfd, BIO_SOCK_INFO_ADDRESS, &info))
+            || !TEST_true(ossl_quic_channel_get_peer_addr(sch, peeraddr))
+            || !TEST_int_eq(BIO_ADDR_rawport(peeraddr),
+                            BIO_ADDR_rawport(localaddr)))
+        goto err;
+
+    /* And the connection should continue to work */
+    if (!TEST_true(migration_exchange(qtserv, clientquic)))
+        goto err;
+
+    testresult = 1;
+ err:
+    if (newfd_owned)
+        BIO_closesocket(newfd);
+    BIO_ADDR_free(localaddr);
+    BIO_ADDR_free(peeraddr);
+    SSL_free(clientquic);
+    ossl_quic_tserver_free(qtserv);
+    SSL_CTX_free(cctx);
+
+    return testresult;
+}
+
 static int test_client_auth(int idx)
 {
     SSL_CTX *cctx = SSL_CTX_new_ex(libctx, NULL, OSSL_QUIC_client_method());
@@ -1834,8 +2202,8 @@ static const struct tparam_test tparam_tests[] = {
                      "MAX_UDP_PAYLOAD_SIZE appears multiple times")
     TPARAM_CHECK_DUP(ACTIVE_CONN_ID_LIMIT,
                      "ACTIVE_CONN_ID_LIMIT appears multiple times")
-    TPARAM_CHECK_DUP(DISABLE_ACTIVE_MIGRATION,
-                     "DISABLE_ACTIVE_MIGRATION appears multiple times")
+    TPARAM_CHECK_INJECT_TWICE(DISABLE_ACTIVE_MIGRATION, NULL, 0,
+                              "DISABLE_ACTIVE_MIGRATION appears multiple times")
 
     TPARAM_CHECK_DROP(INITIAL_SCID,
                       "INITIAL_SCID was not sent but is required")
@@ -2261,6 +2629,8 @@ int setup_tests(void)
     ADD_TEST(test_multiple_dgrams);
     ADD_ALL_TESTS(test_non_io_retry, 2);
     ADD_TEST(test_quic_psk);
+    ADD_ALL_TESTS(test_quic_early_data, 3);
+    ADD_ALL_TESTS(test_quic_migration, 2);
     ADD_ALL_TESTS(test_client_auth, 3);
     ADD_ALL_TESTS(test_alpn, 2);
     ADD_ALL_TESTS(test_noisy_dgram, 2);
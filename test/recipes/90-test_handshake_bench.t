@@ -0,0 +1,21 @@
+#! /usr/bin/env perl
+# Copyright 2024 The OpenSSL Project Authors. All Rights Reserved.
+#
+# Licensed under the Apache License 2.0 (the "License").  You may not use
+# this file except in compliance with the License.  You can obtain a copy
+# in the file LICENSE in the source distribution or at
+# https://www.openssl.org/source/license.html
+
+use OpenSSL::Test qw/:DEFAULT srctop_dir/;
+use OpenSSL::Test::Utils;
+
+setup("test_handshake_bench");
+
+plan skip_all => "Needs TLSv1.2 and TLSv1.3 enabled"
+    if disabled("tls1_2") || disabled("tls1_3");
+
+plan tests => 1;
+
+# This is only a smoke test making sure the benchmark keeps working, so only
+# run a couple of handshakes for each case.
+ok(run(test(["handshake_bench", "-n", "2", srctop_dir("test", "certs")])));
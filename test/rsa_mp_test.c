@@ -289,6 +289,50 @@ err:
     return ret;
 }
 
+/*
+ * Generate keys whose primes are large enough for the per-prime
+ * exponentiations to be paired up, and check private key operations on them.
+ */
+static int test_rsa_mp_gen(int i)
+{
+    static const struct {
+        int bits, primes;
+    } params[] = {
+        { 3072, 3 },
+        { 4096, 4 },
+    };
+    int ret = 0, num;
+    RSA *key = NULL;
+    BIGNUM *ebn = NULL;
+    unsigned char ptext[512];
+    unsigned char ctext[512];
+    static unsigned char ptext_ex[] = "\x54\x85\x9b\x34\x2c\x49\xea\x2a";
+    int plen = sizeof(ptext_ex) - 1;
+
+    if (!TEST_ptr(key = RSA_new())
+            || !TEST_ptr(ebn = BN_new())
+            || !TEST_true(BN_set_word(ebn, RSA_F4))
+            || !TEST_true(RSA_generate_multi_prime_key(key, params[i].bits,
+                                                       params[i].primes,
+                                                       ebn, NULL))
+            || !TEST_int_eq(RSA_get_multi_prime_extra_count(key),
+                            params[i].primes - 2))
+        goto err;
+
+    num = RSA_private_encrypt(plen, ptext_ex, ctext, key, RSA_PKCS1_PADDING);
+    if (!TEST_int_eq(num, params[i].bits / 8))
+        goto err;
+    num = RSA_public_decrypt(num, ctext, ptext, key, RSA_PKCS1_PADDING);
+    if (!TEST_mem_eq(ptext, num, ptext_ex, plen))
+        goto err;
+
+    ret = 1;
+err:
+    BN_free(ebn);
+    RSA_free(key);
+    return ret;
+}
+
 static int test_rsa_mp_gen_bad_input(void)
 {
     int ret = 0;
@@ -325,5 +369,6 @@ int setup_tests(void)
 {
     ADD_TEST(test_rsa_mp_gen_bad_input);
     ADD_ALL_TESTS(test_rsa_mp, 2);
+    ADD_ALL_TESTS(test_rsa_mp_gen, 2);
     return 1;
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright 2015-2022 The OpenSSL Project Authors. All Rights Reserved.
+ * Copyright 2015-2025 The OpenSSL Project Authors. All Rights Reserved.
  *
  * Licensed under the Apache License 2.0 (the "License").  You may not use
  * this file except in compliance with the License.  You can obtain a copy
@@ -11,6 +11,7 @@
 
 #include "testutil.h"
 #include "internal/e_os.h"
+#include "internal/nelem.h"
 
 static int test_sec_mem(void)
 {
@@ -175,9 +176,51 @@ err:
 #endif
 }
 
+static int test_sec_mem_arenas(void)
+{
+#ifndef OPENSSL_NO_SECURE_MEMORY
+    char *p[5] = { NULL };
+    size_t i;
+    int res = 0;
+
+    if (!TEST_true(CRYPTO_secure_malloc_init_ex(4096, 32, 4)))
+        return 0;
+
+    /* Each arena can satisfy one full sized request */
+    for (i = 0; i < 4; i++)
+        if (!TEST_ptr(p[i] = OPENSSL_secure_malloc(4096))
+                || !TEST_true(CRYPTO_secure_allocated(p[i]))
+                || !TEST_size_t_eq(CRYPTO_secure_actual_size(p[i]), 4096))
+            goto err;
+    if (!TEST_size_t_eq(CRYPTO_secure_used(), 4 * 4096)
+            || !TEST_ptr_null(p[4] = OPENSSL_secure_malloc(32))
+            || !TEST_ptr_null(OPENSSL_secure_malloc(8192))
+            /* Cannot be released while any arena is still in use */
+            || !TEST_false(CRYPTO_secure_malloc_done()))
+        goto err;
+
+    OPENSSL_secure_free(p[2]);
+    p[2] = NULL;
+    if (!TEST_ptr(p[4] = OPENSSL_secure_malloc(32))
+            || !TEST_size_t_eq(CRYPTO_secure_used(), 3 * 4096 + 32))
+        goto err;
+    res = 1;
+ err:
+    for (i = 0; i < OSSL_NELEM(p); i++)
+        OPENSSL_secure_free(p[i]);
+    if (!TEST_size_t_eq(CRYPTO_secure_used(), 0)
+            || !TEST_true(CRYPTO_secure_malloc_done()))
+        res = 0;
+    return res;
+#else
+    return TEST_false(CRYPTO_secure_malloc_init_ex(4096, 32, 4));
+#endif
+}
+
 int setup_tests(void)
 {
     ADD_TEST(test_sec_mem);
     ADD_TEST(test_sec_mem_clear);
+    ADD_TEST(test_sec_mem_arenas);
     return 1;
 }
@@ -75,6 +75,10 @@ static int use_session_cb(SSL *ssl, const EVP_MD *md, const unsigned char **id,
                           size_t *idlen, SSL_SESSION **sess);
 static int find_session_cb(SSL *ssl, const unsigned char *identity,
                            size_t identity_len, SSL_SESSION **sess);
+# ifndef OPENSSL_NO_PSK
+static unsigned int psk_server_cb(SSL *ssl, const char *identity,
+                                  unsigned char *psk, unsigned int max_psk_len);
+# endif
 
 static int use_session_cb_cnt = 0;
 static int find_session_cb_cnt = 0;
@@ -680,6 +684,67 @@ static int get_password_cb(char *buf, int size, int rw_flag, void *userdata)
     return sizeof(pass) - 1;
 }
 
+/*
+ * Test that an SSL_CTX created from a template shares the provider tables and
+ * settings of the template but has its own certificates.
+ */
+static int test_ssl_ctx_template(void)
+{
+    SSL_CTX *cctx = NULL, *sctx = NULL, *tctx = NULL;
+    SSL *clientssl = NULL, *serverssl = NULL;
+    int testresult = 0;
+
+    if (!TEST_true(create_ssl_ctx_pair(libctx, TLS_server_method(),
+                                       TLS_client_method(), TLS1_2_VERSION, 0,
+                                       &sctx, &cctx, cert, privkey)))
+        goto end;
+
+    if (!TEST_true(SSL_CTX_set_num_tickets(sctx, 1))
+            || !TEST_true(SSL_CTX_set1_groups_list(sctx, "P-256:X25519")))
+        goto end;
+
+    if (!TEST_ptr(tctx = SSL_CTX_new_from_template(sctx)))
+        goto end;
+
+    if (!TEST_ptr_null(SSL_CTX_get0_certificate(tctx))
+            || !TEST_ptr_null(SSL_CTX_get0_privatekey(tctx))
+            || !TEST_ptr_eq(tctx->group_list, sctx->group_list)
+            || !TEST_ptr_eq(tctx->sigalg_lookup_cache,
+                            sctx->sigalg_lookup_cache)
+            || !TEST_ptr_eq(SSL_CTX_get_cert_store(tctx),
+                            SSL_CTX_get_cert_store(sctx))
+            || !TEST_int_eq(SSL_CTX_get_min_proto_version(tctx),
+                            TLS1_2_VERSION)
+            || !TEST_size_t_eq(SSL_CTX_get_num_tickets(tctx), 1)
+            || !TEST_size_t_eq(tctx->ext.supportedgroups_len, 2)
+            || !TEST_int_eq(sk_SSL_CIPHER_num(SSL_CTX_get_ciphers(tctx)),
+                            sk_SSL_CIPHER_num(SSL_CTX_get_ciphers(sctx))))
+        goto end;
+
+    /* The new context must outlive the template */
+    SSL_CTX_free(sctx);
+    sctx = NULL;
+
+    if (!TEST_int_eq(SSL_CTX_use_certificate_file(tctx, cert,
+                                                  SSL_FILETYPE_PEM), 1)
+            || !TEST_int_eq(SSL_CTX_use_PrivateKey_file(tctx, privkey,
+                                                        SSL_FILETYPE_PEM), 1)
+            || !TEST_true(create_ssl_objects(tctx, cctx, &serverssl,
+                                             &clientssl, NULL, NULL))
+            || !TEST_true(create_ssl_connection(serverssl, clientssl,
+                                                SSL_ERROR_NONE)))
+        goto end;
+
+    testresult = 1;
+ end:
+    SSL_free(serverssl);
+    SSL_free(clientssl);
+    SSL_CTX_free(tctx);
+    SSL_CTX_free(sctx);
+    SSL_CTX_free(cctx);
+    return testresult;
+}
+
 static int test_ssl_ctx_build_cert_chain(void)
 {
     int ret = 0;
@@ -1442,6 +1507,254 @@ end:
     return testresult;
 }
 
+static int execute_test_ktls_recvfile(int tls_version, const char *cipher)
+{
+    SSL_CTX *cctx = NULL, *sctx = NULL;
+    SSL *clientssl = NULL, *serverssl = NULL;
+    unsigned char *buf = NULL, *buf_dst = NULL;
+    BIO *out = NULL, *in = NULL;
+    int cfd = -1, sfd = -1, ffd, testresult = 0;
+    ossl_ssize_t ret;
+    size_t written;
+    off_t off = 0;
+    FILE *ffdp;
+
+    buf = OPENSSL_zalloc(SENDFILE_SZ);
+    buf_dst = OPENSSL_zalloc(SENDFILE_SZ);
+    if (!TEST_ptr(buf) || !TEST_ptr(buf_dst)
+        || !TEST_true(create_test_sockets(&cfd, &sfd, SOCK_STREAM, NULL)))
+        goto end;
+
+    /* Skip this test if the platform does not support ktls */
+    if (!ktls_chk_platform(sfd)) {
+        testresult = TEST_skip("Kernel does not support KTLS");
+        goto end;
+    }
+
+    if (is_fips && strstr(cipher, "CHACHA") != NULL) {
+        testresult = TEST_skip("CHACHA is not supported in FIPS");
+        goto end;
+    }
+
+    if (!TEST_true(create_ssl_ctx_pair(libctx, TLS_server_method(),
+                                       TLS_client_method(),
+                                       tls_version, tls_version,
+                                       &sctx, &cctx, cert, privkey)))
+        goto end;
+
+    if (tls_version == TLS1_3_VERSION) {
+        if (!TEST_true(SSL_CTX_set_ciphersuites(cctx, cipher))
+            || !TEST_true(SSL_CTX_set_ciphersuites(sctx, cipher)))
+            goto end;
+    } else {
+        if (!TEST_true(SSL_CTX_set_cipher_list(cctx, cipher))
+            || !TEST_true(SSL_CTX_set_cipher_list(sctx, cipher)))
+            goto end;
+    }
+
+    if (!TEST_true(create_ssl_objects2(sctx, cctx, &serverssl,
+                                       &clientssl, sfd, cfd))
+            || !TEST_true(SSL_set_options(serverssl, SSL_OP_ENABLE_KTLS))
+            || !TEST_true(create_ssl_connection(serverssl, clientssl,
+                                                SSL_ERROR_NONE)))
+        goto end;
+
+    if (!BIO_get_ktls_recv(SSL_get_rbio(serverssl))) {
+        testresult = TEST_skip("Failed to enable KTLS RX for %s cipher %s",
+                               tls_version == TLS1_3_VERSION ? "TLS 1.3" :
+                               "TLS 1.2", cipher);
+        goto end;
+    }
+
+    if (!TEST_int_gt(RAND_bytes_ex(libctx, buf, SENDFILE_SZ, 0), 0))
+        goto end;
+
+    out = BIO_new_file(tmpfilename, "wb");
+    if (!TEST_ptr(out))
+        goto end;
+    BIO_get_fp(out, &ffdp);
+    ffd = fileno(ffdp);
+
+    while (!SSL_write_ex(clientssl, buf, SENDFILE_SZ, &written))
+        if (!TEST_int_eq(SSL_get_error(clientssl, 0), SSL_ERROR_WANT_WRITE))
+            goto end;
+
+    /*
+     * A failure to write to the file is reported as SSL_ERROR_SYSCALL, and
+     * the data which was already received is kept for the next call
+     */
+    in = BIO_new_file(tmpfilename, "rb");
+    if (!TEST_ptr(in))
+        goto end;
+    BIO_get_fp(in, &ffdp);
+    while ((ret = SSL_recvfile(serverssl, fileno(ffdp), 0, SENDFILE_SZ, 0)) < 0
+           && SSL_get_error(serverssl, (int)ret) == SSL_ERROR_WANT_READ)
+        continue;
+    if (!TEST_int_lt((int)ret, 0)
+            || !TEST_int_eq(SSL_get_error(serverssl, (int)ret),
+                            SSL_ERROR_SYSCALL))
+        goto end;
+    ERR_clear_error();
+    BIO_free(in);
+    in = NULL;
+
+    while (off < SENDFILE_SZ) {
+        ret = SSL_recvfile(serverssl, ffd, off, SENDFILE_SZ - off, 0);
+        if (ret <= 0) {
+            if (!TEST_int_eq(SSL_get_error(serverssl, (int)ret),
+                             SSL_ERROR_WANT_READ))
+                goto end;
+            continue;
+        }
+        off += ret;
+    }
+    if (!TEST_int_eq((int)off, SENDFILE_SZ))
+        goto end;
+
+    /* A close_notify is a control record, which cannot be spliced */
+    if (!TEST_int_eq(SSL_shutdown(clientssl), 0))
+        goto end;
+    while ((ret = SSL_recvfile(serverssl, ffd, off, SENDFILE_SZ, 0)) < 0)
+        if (!TEST_int_eq(SSL_get_error(serverssl, (int)ret),
+                         SSL_ERROR_WANT_READ))
+            goto end;
+    if (!TEST_int_eq((int)ret, 0)
+            || !TEST_int_eq(SSL_get_error(serverssl, 0),
+                            SSL_ERROR_ZERO_RETURN))
+        goto end;
+
+    BIO_free(out);
+    out = NULL;
+    in = BIO_new_file(tmpfilename, "rb");
+    if (!TEST_ptr(in)
+            || !TEST_int_eq(BIO_read(in, buf_dst, SENDFILE_SZ), SENDFILE_SZ)
+            || !TEST_mem_eq(buf, SENDFILE_SZ, buf_dst, SENDFILE_SZ))
+        goto end;
+
+    testresult = 1;
+end:
+    SSL_free(clientssl);
+    SSL_free(serverssl);
+    SSL_CTX_free(sctx);
+    SSL_CTX_free(cctx);
+    BIO_free(out);
+    BIO_free(in);
+    if (cfd != -1)
+        close(cfd);
+    if (sfd != -1)
+        close(sfd);
+    OPENSSL_free(buf);
+    OPENSSL_free(buf_dst);
+    return testresult;
+}
+
+/* Send |len| bytes from |writer| to |reader| over non-blocking sockets */
+static int ktls_transfer(SSL *writer, SSL *reader, unsigned char *buf,
+                         size_t len)
+{
+    size_t written, readbytes;
+
+    while (!SSL_write_ex(writer, buf, len, &written))
+        if (SSL_get_error(writer, 0) != SSL_ERROR_WANT_WRITE)
+            return 0;
+
+    while (!SSL_read_ex(reader, buf, len, &readbytes))
+        if (SSL_get_error(reader, 0) != SSL_ERROR_WANT_READ)
+            return 0;
+
+    return readbytes == len;
+}
+
+/*
+ * Exchange data after a TLSv1.3 key update has been requested. With KTLS the
+ * new keys have to be passed to the kernel in both directions.
+ */
+static int execute_test_ktls_key_update(const char *cipher)
+{
+    SSL_CTX *cctx = NULL, *sctx = NULL;
+    SSL *clientssl = NULL, *serverssl = NULL;
+    int testresult = 0, cfd = -1, sfd = -1, i;
+    unsigned char msg[16], buf[16];
+
+    if (!TEST_true(create_test_sockets(&cfd, &sfd, SOCK_STREAM, NULL)))
+        goto end;
+
+    /* Skip this test if the platform does not support ktls */
+    if (!ktls_chk_platform(cfd)) {
+        testresult = TEST_skip("Kernel does not support KTLS");
+        goto end;
+    }
+
+    if (is_fips && strstr(cipher, "CHACHA") != NULL) {
+        testresult = TEST_skip("CHACHA is not supported in FIPS");
+        goto end;
+    }
+
+    if (!TEST_true(create_ssl_ctx_pair(libctx, TLS_server_method(),
+                                       TLS_client_method(),
+                                       TLS1_3_VERSION, TLS1_3_VERSION,
+                                       &sctx, &cctx, cert, privkey))
+            || !TEST_true(SSL_CTX_set_ciphersuites(cctx, cipher))
+            || !TEST_true(SSL_CTX_set_ciphersuites(sctx, cipher))
+            || !TEST_true(create_ssl_objects2(sctx, cctx, &serverssl,
+                                              &clientssl, sfd, cfd))
+            || !TEST_true(SSL_set_options(clientssl, SSL_OP_ENABLE_KTLS))
+            || !TEST_true(SSL_set_options(serverssl, SSL_OP_ENABLE_KTLS))
+            || !TEST_true(create_ssl_connection(serverssl, clientssl,
+                                                SSL_ERROR_NONE)))
+        goto end;
+
+    if (!BIO_get_ktls_send(SSL_get_wbio(clientssl))
+            || !BIO_get_ktls_recv(SSL_get_rbio(serverssl))
+            || !BIO_get_ktls_send(SSL_get_wbio(serverssl))
+            || !BIO_get_ktls_recv(SSL_get_rbio(clientssl))) {
+        testresult = TEST_skip("KTLS not supported in both directions for %s",
+                               cipher);
+        goto end;
+    }
+
+    for (i = 0; i < 2; i++) {
+        memset(msg, i, sizeof(msg));
+        memcpy(buf, msg, sizeof(buf));
+
+        /* The server responds to the update with one of its own */
+        if (!TEST_true(SSL_key_update(clientssl, SSL_KEY_UPDATE_REQUESTED)))
+            goto end;
+
+        if (!ktls_transfer(clientssl, serverssl, buf, sizeof(buf))
+                || !ktls_transfer(serverssl, clientssl, buf, sizeof(buf))) {
+            if (ERR_GET_REASON(ERR_peek_last_error())
+                    == SSL_R_KTLS_KEY_UPDATE_FAILED) {
+                testresult = TEST_skip("Kernel does not support KTLS key updates");
+                goto end;
+            }
+            TEST_error("Data exchange failed after key update");
+            goto end;
+        }
+
+        if (!TEST_mem_eq(msg, sizeof(msg), buf, sizeof(buf)))
+            goto end;
+    }
+
+    /* Both sides must still be using KTLS */
+    if (!TEST_true(BIO_get_ktls_send(SSL_get_wbio(clientssl)))
+            || !TEST_true(BIO_get_ktls_recv(SSL_get_rbio(serverssl))))
+        goto end;
+
+    testresult = 1;
+end:
+    ERR_clear_error();
+    SSL_free(clientssl);
+    SSL_free(serverssl);
+    SSL_CTX_free(sctx);
+    SSL_CTX_free(cctx);
+    if (cfd != -1)
+        close(cfd);
+    if (sfd != -1)
+        close(sfd);
+    return testresult;
+}
+
 static struct ktls_test_cipher {
     int tls_version;
     const char *cipher;
@@ -1495,6 +1808,29 @@ static int test_ktls(int test)
                              cipher->cipher);
 }
 
+static int test_ktls_recvfile(int test)
+{
+    struct ktls_test_cipher *cipher;
+
+    OPENSSL_assert(test < (int)NUM_KTLS_TEST_CIPHERS);
+    cipher = &ktls_test_ciphers[test];
+
+    return execute_test_ktls_recvfile(cipher->tls_version, cipher->cipher);
+}
+
+static int test_ktls_key_update(int test)
+{
+    struct ktls_test_cipher *cipher;
+
+    OPENSSL_assert(test < (int)NUM_KTLS_TEST_CIPHERS);
+    cipher = &ktls_test_ciphers[test];
+
+    if (cipher->tls_version != TLS1_3_VERSION)
+        return TEST_skip("Key updates need TLS 1.3");
+
+    return execute_test_ktls_key_update(cipher->cipher);
+}
+
 static int test_ktls_sendfile(int test)
 {
     struct ktls_test_cipher *cipher;
@@ -2717,6 +3053,88 @@ static int test_psk_tickets(void)
     return testresult;
 }
 
+/*
+ * Test that the PSK callbacks and the session id context of a template are
+ * used by an SSL_CTX created from it.
+ */
+static int test_ssl_ctx_template_psk(void)
+{
+    SSL_CTX *sctx = NULL, *cctx = NULL, *tctx = NULL;
+    SSL *serverssl = NULL, *clientssl = NULL;
+    SSL_SESSION *sess;
+    const unsigned char *sid_ctx;
+    unsigned int sid_ctx_len = 0;
+    int testresult = 0;
+    int sess_id_ctx = 1;
+
+    if (!TEST_true(create_ssl_ctx_pair(libctx, TLS_server_method(),
+                                       TLS_client_method(), TLS1_3_VERSION, 0,
+                                       &sctx, &cctx, NULL, NULL))
+            || !TEST_true(SSL_CTX_set_session_id_context(sctx,
+                                                         (void *)&sess_id_ctx,
+                                                         sizeof(sess_id_ctx))))
+        goto end;
+
+    SSL_CTX_set_psk_use_session_callback(cctx, use_session_cb);
+    SSL_CTX_set_psk_find_session_callback(sctx, find_session_cb);
+#ifndef OPENSSL_NO_PSK
+    SSL_CTX_set_psk_server_callback(sctx, psk_server_cb);
+#endif
+    use_session_cb_cnt = 0;
+    find_session_cb_cnt = 0;
+    srvid = pskid;
+
+    if (!TEST_ptr(tctx = SSL_CTX_new_from_template(sctx)))
+        goto end;
+
+    /* Later changes to the template do not affect the new context */
+    SSL_CTX_set_psk_find_session_callback(sctx, NULL);
+    if (!TEST_true(SSL_CTX_set_session_id_context(sctx, NULL, 0)))
+        goto end;
+
+    if (!TEST_true(tctx->psk_find_session_cb == find_session_cb)
+#ifndef OPENSSL_NO_PSK
+            || !TEST_true(tctx->psk_server_callback == psk_server_cb)
+#endif
+            || !TEST_mem_eq(tctx->sid_ctx, tctx->sid_ctx_length,
+                            &sess_id_ctx, sizeof(sess_id_ctx)))
+        goto end;
+
+    if (!TEST_true(create_ssl_objects(tctx, cctx, &serverssl, &clientssl,
+                                      NULL, NULL)))
+        goto end;
+    clientpsk = serverpsk = create_a_psk(clientssl, SHA256_DIGEST_LENGTH);
+    if (!TEST_ptr(clientpsk))
+        goto end;
+    SSL_SESSION_up_ref(clientpsk);
+
+    if (!TEST_true(create_ssl_connection(serverssl, clientssl,
+                                         SSL_ERROR_NONE))
+            || !TEST_int_eq(1, find_session_cb_cnt)
+            || !TEST_int_eq(1, use_session_cb_cnt)
+            || !TEST_true(SSL_session_reused(serverssl))
+            || !TEST_ptr(sess = SSL_get_session(serverssl)))
+        goto end;
+
+    sid_ctx = SSL_SESSION_get0_id_context(sess, &sid_ctx_len);
+    if (!TEST_mem_eq(sid_ctx, sid_ctx_len, &sess_id_ctx, sizeof(sess_id_ctx)))
+        goto end;
+
+    testresult = 1;
+
+ end:
+    SSL_free(serverssl);
+    SSL_free(clientssl);
+    SSL_CTX_free(tctx);
+    SSL_CTX_free(sctx);
+    SSL_CTX_free(cctx);
+    SSL_SESSION_free(clientpsk);
+    SSL_SESSION_free(serverpsk);
+    clientpsk = serverpsk = NULL;
+
+    return testresult;
+}
+
 static int test_extra_tickets(int idx)
 {
     SSL_CTX *sctx = NULL, *cctx = NULL;
@@ -11412,6 +11830,401 @@ end:
 }
 #endif /* !defined(OPENSSL_NO_TLS1_2) && !defined(OPENSSL_NO_DYNAMIC_ENGINE) */
 
+#ifndef OSSL_NO_USABLE_TLS1_3
+/*
+ * In TLSv1.3 pipelining does not need a pipeline capable cipher. Check that a
+ * large write is split into multiple records which are all protected in one
+ * go.
+ * Test 0: No padding
+ * Test 1: Block padding, so the records must be compacted before sending
+ * Test 2: More data than the available pipelines can take
+ */
+static int test_tls13_pipelining(int idx)
+{
+    SSL_CTX *cctx = NULL, *sctx = NULL;
+    SSL *clientssl = NULL, *serverssl = NULL;
+    int testresult = 0, numreads;
+    unsigned char *msg = NULL, *buf = NULL;
+    size_t written, readbytes, offset, fragsize = 1000, numpipes = 4;
+    size_t msglen = fragsize * numpipes, expectedreads = numpipes;
+
+    if (idx == 2) {
+        msglen += fragsize / 2;
+        expectedreads++;
+    }
+
+    if (!TEST_ptr(msg = OPENSSL_malloc(msglen))
+            || !TEST_ptr(buf = OPENSSL_malloc(msglen))
+            || !TEST_int_gt(RAND_bytes_ex(libctx, msg, msglen, 0), 0))
+        goto end;
+
+    if (!TEST_true(create_ssl_ctx_pair(libctx, TLS_server_method(),
+                                       TLS_client_method(), TLS1_3_VERSION,
+                                       TLS1_3_VERSION, &sctx, &cctx, cert,
+                                       privkey))
+            || !TEST_true(create_ssl_objects(sctx, cctx, &serverssl,
+                                             &clientssl, NULL, NULL)))
+        goto end;
+
+    if (!TEST_true(SSL_set_max_pipelines(clientssl, numpipes))
+            || !TEST_true(SSL_set_split_send_fragment(clientssl, fragsize))
+            || (idx == 1
+                && !TEST_true(SSL_set_block_padding(clientssl, 64))))
+        goto end;
+
+    if (!TEST_true(create_ssl_connection(serverssl, clientssl, SSL_ERROR_NONE)))
+        goto end;
+
+    if (!TEST_true(SSL_write_ex(clientssl, msg, msglen, &written))
+            || !TEST_size_t_eq(written, msglen))
+        goto end;
+
+    /*
+     * The server is not using read_ahead, so we expect to read each record in
+     * a separate SSL_read_ex call.
+     */
+    for (offset = 0, numreads = 0;
+         offset < msglen;
+         offset += readbytes, numreads++) {
+        if (!TEST_true(SSL_read_ex(serverssl, buf + offset,
+                                   msglen - offset, &readbytes)))
+            goto end;
+    }
+
+    if (!TEST_mem_eq(msg, msglen, buf, offset)
+            || !TEST_int_eq(numreads, expectedreads))
+        goto end;
+
+    /* Make sure the connection is still usable in the other direction */
+    if (!TEST_true(SSL_write_ex(serverssl, msg, fragsize, &written))
+            || !TEST_true(SSL_read_ex(clientssl, buf, msglen, &readbytes))
+            || !TEST_mem_eq(msg, fragsize, buf, readbytes))
+        goto end;
+
+    testresult = 1;
+end:
+    SSL_free(serverssl);
+    SSL_free(clientssl);
+    SSL_CTX_free(sctx);
+    SSL_CTX_free(cctx);
+    OPENSSL_free(msg);
+    OPENSSL_free(buf);
+    return testresult;
+}
+#endif /* OSSL_NO_USABLE_TLS1_3 */
+
+/*
+ * Test SSL_writev_ex()
+ * Test 0: Small iovecs are gathered into full records
+ * Test 1: As test 0 with a small max_send_fragment
+ * Test 2: Non-blocking writes which have to be retried
+ */
+static int test_writev(int idx)
+{
+    SSL_CTX *cctx = NULL, *sctx = NULL;
+    SSL *clientssl = NULL, *serverssl = NULL;
+    BIO *cbio = NULL, *sbio = NULL;
+    int testresult = 0, ret, numreads = 0, numretries = 0;
+    unsigned char *msg = NULL, *buf = NULL;
+    size_t written = 0, readbytes, offset = 0, msglen = 40160, i;
+    size_t frag = idx == 1 ? 512 : SSL3_RT_MAX_PLAIN_LENGTH;
+    SSL_IOVEC iov[5];
+
+    if (!TEST_ptr(msg = OPENSSL_malloc(msglen))
+            || !TEST_ptr(buf = OPENSSL_malloc(msglen))
+            || !TEST_int_gt(RAND_bytes_ex(libctx, msg, msglen, 0), 0))
+        goto end;
+
+    /* A header, a body and some trailers, one of them empty */
+    iov[0].data = msg;
+    iov[0].data_len = 100;
+    iov[1].data = msg + 100;
+    iov[1].data_len = 40000;
+    iov[2].data = msg + 40100;
+    iov[2].data_len = 10;
+    iov[3].data = NULL;
+    iov[3].data_len = 0;
+    iov[4].data = msg + 40110;
+    iov[4].data_len = 50;
+
+    if (!TEST_true(create_ssl_ctx_pair(libctx, TLS_server_method(),
+                                       TLS_client_method(), 0, 0,
+                                       &sctx, &cctx, cert, privkey))
+            || !TEST_true(create_ssl_objects(sctx, cctx, &serverssl,
+                                             &clientssl, NULL, NULL)))
+        goto end;
+
+    if (idx == 1
+            && !TEST_true(SSL_set_max_send_fragment(clientssl, frag)))
+        goto end;
+
+    if (idx == 2) {
+        if (!TEST_true(BIO_new_bio_pair(&cbio, 4096, &sbio, 4096)))
+            goto end;
+        SSL_set_bio(clientssl, cbio, cbio);
+        SSL_set_bio(serverssl, sbio, sbio);
+    }
+
+    if (!TEST_true(create_ssl_connection(serverssl, clientssl, SSL_ERROR_NONE)))
+        goto end;
+
+    if (idx == 2) {
+        /*
+         * Drain the data as it is written, retrying until it all goes. The
+         * BIO pair is smaller than a record, so the server may not have a
+         * whole record to read yet.
+         */
+        while ((ret = SSL_writev_ex(clientssl, iov, OSSL_NELEM(iov),
+                                    &written)) == 0) {
+            if (!TEST_int_eq(SSL_get_error(clientssl, ret),
+                             SSL_ERROR_WANT_WRITE))
+                goto end;
+            ret = SSL_read_ex(serverssl, buf + offset, msglen - offset,
+                              &readbytes);
+            if (ret == 1)
+                offset += readbytes;
+            else if (!TEST_int_eq(SSL_get_error(serverssl, ret),
+                                  SSL_ERROR_WANT_READ))
+                goto end;
+            numretries++;
+        }
+        if (!TEST_int_gt(numretries, 0))
+            goto end;
+    } else if (!TEST_true(SSL_writev_ex(clientssl, iov, OSSL_NELEM(iov),
+                                        &written))) {
+        goto end;
+    }
+    if (!TEST_size_t_eq(written, msglen))
+        goto end;
+
+    /*
+     * The server is not using read_ahead so each read returns a single record.
+     * Check that we did not send any more records than we had to.
+     */
+    for (; offset < msglen; offset += readbytes, numreads++) {
+        if (!TEST_true(SSL_read_ex(serverssl, buf + offset, msglen - offset,
+                                   &readbytes)))
+            goto end;
+    }
+    if (!TEST_mem_eq(msg, msglen, buf, offset)
+            || (idx != 2
+                && !TEST_int_eq(numreads, (msglen + frag - 1) / frag)))
+        goto end;
+
+    /* An empty write succeeds without sending anything */
+    for (i = 0; i < OSSL_NELEM(iov); i++)
+        iov[i].data_len = 0;
+    if (!TEST_true(SSL_writev_ex(clientssl, iov, OSSL_NELEM(iov), &written))
+            || !TEST_size_t_eq(written, 0))
+        goto end;
+
+    testresult = 1;
+end:
+    SSL_free(serverssl);
+    SSL_free(clientssl);
+    SSL_CTX_free(sctx);
+    SSL_CTX_free(cctx);
+    OPENSSL_free(msg);
+    OPENSSL_free(buf);
+    return testresult;
+}
+
+/*
+ * Test that an interrupted SSL_writev_ex() call does not affect a new one
+ * after SSL_clear()
+ */
+static int test_writev_clear(void)
+{
+    SSL_CTX *cctx = NULL, *sctx = NULL;
+    SSL *clientssl = NULL, *serverssl = NULL;
+    BIO *cbio = NULL, *sbio = NULL;
+    int testresult = 0, ret;
+    unsigned char *msg = NULL, *buf = NULL;
+    size_t written = 0, readbytes, offset, msglen = 8000, i;
+    SSL_IOVEC iov[80];
+
+    if (!TEST_ptr(msg = OPENSSL_malloc(msglen))
+            || !TEST_ptr(buf = OPENSSL_malloc(msglen))
+            || !TEST_int_gt(RAND_bytes_ex(libctx, msg, msglen, 0), 0))
+        goto end;
+
+    for (i = 0; i < OSSL_NELEM(iov); i++) {
+        iov[i].data = msg + i * 100;
+        iov[i].data_len = 100;
+    }
+
+    if (!TEST_true(create_ssl_ctx_pair(libctx, TLS_server_method(),
+                                       TLS_client_method(), 0, 0,
+                                       &sctx, &cctx, cert, privkey))
+            || !TEST_true(create_ssl_objects(sctx, cctx, &serverssl,
+                                             &clientssl, NULL, NULL))
+            || !TEST_true(BIO_new_bio_pair(&cbio, 4096, &sbio, 4096)))
+        goto end;
+    SSL_set_bio(clientssl, cbio, cbio);
+    SSL_set_bio(serverssl, sbio, sbio);
+
+    /*
+     * With small records several of them go before the BIO pair fills up, so
+     * the write is interrupted part of the way through
+     */
+    if (!TEST_true(create_ssl_connection(serverssl, clientssl, SSL_ERROR_NONE))
+            || !TEST_true(SSL_set_max_send_fragment(clientssl, 512)))
+        goto end;
+    ret = SSL_writev_ex(clientssl, iov, OSSL_NELEM(iov), &written);
+    if (!TEST_int_eq(ret, 0)
+            || !TEST_int_eq(SSL_get_error(clientssl, ret),
+                            SSL_ERROR_WANT_WRITE))
+        goto end;
+
+    /* Abandon the write and start again on a new connection */
+    if (!TEST_true(SSL_clear(clientssl)))
+        goto end;
+    SSL_free(serverssl);
+    serverssl = NULL;
+    if (!TEST_true(create_ssl_objects(sctx, cctx, &serverssl, &clientssl,
+                                      NULL, NULL))
+            || !TEST_true(create_ssl_connection(serverssl, clientssl,
+                                                SSL_ERROR_NONE)))
+        goto end;
+
+    /* A different write, with more data than was sent before */
+    iov[0].data = msg;
+    iov[0].data_len = 1000;
+    iov[1].data = msg + 1000;
+    iov[1].data_len = 5000;
+    if (!TEST_true(SSL_writev_ex(clientssl, iov, 2, &written))
+            || !TEST_size_t_eq(written, 6000))
+        goto end;
+
+    for (offset = 0; offset < written; offset += readbytes) {
+        if (!TEST_true(SSL_read_ex(serverssl, buf + offset, msglen - offset,
+                                   &readbytes)))
+            goto end;
+    }
+    if (!TEST_mem_eq(msg, written, buf, offset))
+        goto end;
+
+    testresult = 1;
+end:
+    SSL_free(serverssl);
+    SSL_free(clientssl);
+    SSL_CTX_free(sctx);
+    SSL_CTX_free(cctx);
+    OPENSSL_free(msg);
+    OPENSSL_free(buf);
+    return testresult;
+}
+
+/*
+ * Read |len| bytes one record at a time and check the size of each record
+ * against |recsizes|.
+ */
+static int read_records(SSL *s, unsigned char *buf, size_t len,
+                        const size_t *recsizes, size_t numrecs)
+{
+    size_t i, readbytes, offset = 0;
+
+    for (i = 0; i < numrecs; i++) {
+        if (!TEST_true(SSL_read_ex(s, buf + offset, len - offset, &readbytes))
+                || !TEST_size_t_eq(readbytes, recsizes[i]))
+            return 0;
+        offset += readbytes;
+    }
+    return TEST_size_t_eq(offset, len);
+}
+
+/*
+ * Test dynamic record sizing
+ * Test 0: TLSv1.2, configured on the SSL_CTX
+ * Test 1: TLSv1.3, configured on the SSL after the handshake
+ * Test 2: TLSv1.3, small records are used again after an idle period
+ */
+static int test_dynamic_record_size(int idx)
+{
+    SSL_CTX *cctx = NULL, *sctx = NULL;
+    SSL *clientssl = NULL, *serverssl = NULL;
+    int testresult = 0, tlsvers = idx == 0 ? TLS1_2_VERSION : TLS1_3_VERSION;
+    unsigned char *msg = NULL, *buf = NULL;
+    size_t written, msglen = 10000;
+    static const size_t first[] = { 1000, 1000, 1000, 7000 };
+    static const size_t again[] = { 1000, 1000 };
+
+#ifdef OPENSSL_NO_TLS1_2
+    if (idx == 0)
+        return TEST_skip("No TLSv1.2 in this build");
+#endif
+#ifdef OSSL_NO_USABLE_TLS1_3
+    if (idx != 0)
+        return TEST_skip("No usable TLSv1.3 in this build");
+#endif
+
+    if (!TEST_ptr(msg = OPENSSL_malloc(msglen))
+            || !TEST_ptr(buf = OPENSSL_malloc(msglen))
+            || !TEST_int_gt(RAND_bytes_ex(libctx, msg, msglen, 0), 0))
+        goto end;
+
+    if (!TEST_true(create_ssl_ctx_pair(libctx, TLS_server_method(),
+                                       TLS_client_method(), tlsvers, tlsvers,
+                                       &sctx, &cctx, cert, privkey)))
+        goto end;
+
+    if (!TEST_false(SSL_CTX_set_dynamic_record_size(sctx, 100, 3000, 0))
+            || !TEST_false(SSL_CTX_set_dynamic_record_size(sctx,
+                               SSL3_RT_MAX_PLAIN_LENGTH + 1, 3000, 0)))
+        goto end;
+
+    if (idx == 0
+            && !TEST_true(SSL_CTX_set_dynamic_record_size(sctx, 1000, 3000, 0)))
+        goto end;
+
+    if (!TEST_true(create_ssl_objects(sctx, cctx, &serverssl, &clientssl,
+                                      NULL, NULL))
+            || !TEST_true(create_ssl_connection(serverssl, clientssl,
+                                                SSL_ERROR_NONE)))
+        goto end;
+
+    if (idx != 0
+            && !TEST_true(SSL_set_dynamic_record_size(serverssl, 1000, 3000,
+                                                      idx == 2 ? 200 : 0)))
+        goto end;
+
+    /* Small records until the threshold is reached, full sized after that */
+    if (!TEST_true(SSL_write_ex(serverssl, msg, msglen, &written))
+            || !TEST_size_t_eq(written, msglen)
+            || !read_records(clientssl, buf, msglen, first, OSSL_NELEM(first))
+            || !TEST_mem_eq(msg, msglen, buf, msglen))
+        goto end;
+
+    if (idx == 2)
+        OSSL_sleep(500);
+
+    if (!TEST_true(SSL_write_ex(serverssl, msg, 2000, &written)))
+        goto end;
+    if (idx == 2) {
+        if (!read_records(clientssl, buf, 2000, again, OSSL_NELEM(again)))
+            goto end;
+    } else {
+        if (!read_records(clientssl, buf, 2000, &written, 1))
+            goto end;
+    }
+
+    /* Disabling it again gives full sized records */
+    if (!TEST_true(SSL_set_dynamic_record_size(serverssl, 0, 0, 0))
+            || !TEST_true(SSL_write_ex(serverssl, msg, msglen, &written))
+            || !read_records(clientssl, buf, msglen, &written, 1))
+        goto end;
+
+    testresult = 1;
+end:
+    SSL_free(serverssl);
+    SSL_free(clientssl);
+    SSL_CTX_free(sctx);
+    SSL_CTX_free(cctx);
+    OPENSSL_free(msg);
+    OPENSSL_free(buf);
+    return testresult;
+}
+
 static int check_version_string(SSL *s, int version)
 {
     const char *verstr = NULL;
@@ -12502,6 +13315,8 @@ int setup_tests(void)
 # if !defined(OPENSSL_NO_TLS1_2) || !defined(OSSL_NO_USABLE_TLS1_3)
     ADD_ALL_TESTS(test_ktls, NUM_KTLS_TEST_CIPHERS * 4);
     ADD_ALL_TESTS(test_ktls_sendfile, NUM_KTLS_TEST_CIPHERS * 2);
+    ADD_ALL_TESTS(test_ktls_recvfile, NUM_KTLS_TEST_CIPHERS);
+    ADD_ALL_TESTS(test_ktls_key_update, NUM_KTLS_TEST_CIPHERS);
 # endif
 #endif
     ADD_TEST(test_large_message_tls);
@@ -12522,6 +13337,7 @@ int setup_tests(void)
     ADD_ALL_TESTS(test_stateful_tickets, 3);
     ADD_ALL_TESTS(test_stateless_tickets, 3);
     ADD_TEST(test_psk_tickets);
+    ADD_TEST(test_ssl_ctx_template_psk);
     ADD_ALL_TESTS(test_extra_tickets, 6);
 #endif
     ADD_ALL_TESTS(test_ssl_set_bio, TOTAL_SSL_SET_BIO_TESTS);
@@ -12539,6 +13355,7 @@ int setup_tests(void)
     ADD_TEST(test_client_cert_verify_cb);
     ADD_TEST(test_ssl_build_cert_chain);
     ADD_TEST(test_ssl_ctx_build_cert_chain);
+    ADD_TEST(test_ssl_ctx_template);
 #ifndef OPENSSL_NO_TLS1_2
     ADD_TEST(test_client_hello_cb);
     ADD_TEST(test_no_ems);
@@ -12666,6 +13483,12 @@ int setup_tests(void)
 #if !defined(OPENSSL_NO_TLS1_2) && !defined(OPENSSL_NO_DYNAMIC_ENGINE)
     ADD_ALL_TESTS(test_pipelining, 7);
 #endif
+#ifndef OSSL_NO_USABLE_TLS1_3
+    ADD_ALL_TESTS(test_tls13_pipelining, 3);
+#endif
+    ADD_ALL_TESTS(test_writev, 3);
+    ADD_TEST(test_writev_clear);
+    ADD_ALL_TESTS(test_dynamic_record_size, 3);
     ADD_ALL_TESTS(test_version, 6);
     ADD_TEST(test_rstate_string);
     ADD_ALL_TESTS(test_handshake_retry, 16);
@@ -937,6 +937,42 @@ static void thread_shared_evp_pkey(void)
         multi_set_success(0);
 }
 
+static void thread_shared_evp_pkey_sign(void)
+{
+    const unsigned char tbs[] = "Hello World";
+    unsigned char sig[256];
+    size_t siglen;
+    EVP_PKEY_CTX *ctx = NULL;
+    int success = 0;
+    int i;
+
+    /*
+     * Sign several times so that the blindings of the shared key are both set
+     * up and reused, and, with more threads than the key has blindings, some
+     * signatures need a blinding of their own.
+     */
+    for (i = 0; i < 8; i++) {
+        EVP_PKEY_CTX_free(ctx);
+        ctx = EVP_PKEY_CTX_new_from_pkey(multi_libctx, shared_evp_pkey, NULL);
+        siglen = sizeof(sig);
+        if (!TEST_ptr(ctx)
+                || !TEST_int_gt(EVP_PKEY_sign_init(ctx), 0)
+                || !TEST_int_gt(EVP_PKEY_sign(ctx, sig, &siglen,
+                                              tbs, sizeof(tbs)), 0)
+                || !TEST_int_gt(EVP_PKEY_verify_init(ctx), 0)
+                || !TEST_int_gt(EVP_PKEY_verify(ctx, sig, siglen,
+                                                tbs, sizeof(tbs)), 0))
+            goto err;
+    }
+
+    success = 1;
+
+ err:
+    EVP_PKEY_CTX_free(ctx);
+    if (!success)
+        multi_set_success(0);
+}
+
 static void thread_provider_load_unload(void)
 {
     OSSL_PROVIDER *deflt = OSSL_PROVIDER_load(multi_libctx, "default");
@@ -1014,6 +1050,29 @@ static int test_multi_shared_pkey(void)
     return test_multi_shared_pkey_common(&thread_shared_evp_pkey);
 }
 
+static int test_multi_shared_pkey_sign(void)
+{
+    int testresult = 0;
+
+    multi_intialise();
+    if (!thread_setup_libctx(1, default_provider)
+            || !TEST_ptr(shared_evp_pkey = load_pkey_pem(privkey, multi_libctx))
+            || !start_threads(MAXIMUM_THREADS - 1,
+                              &thread_shared_evp_pkey_sign))
+        goto err;
+
+    thread_shared_evp_pkey_sign();
+
+    if (!teardown_threads()
+            || !TEST_true(multi_success))
+        goto err;
+    testresult = 1;
+ err:
+    EVP_PKEY_free(shared_evp_pkey);
+    thead_teardown_libctx();
+    return testresult;
+}
+
 static int test_multi_load_unload_provider(void)
 {
     EVP_MD *sha256 = NULL;
@@ -1303,6 +1362,7 @@ int setup_tests(void)
     ADD_TEST(test_multi_general_worker_fips_provider);
     ADD_TEST(test_multi_fetch_worker);
     ADD_TEST(test_multi_shared_pkey);
+    ADD_TEST(test_multi_shared_pkey_sign);
 #ifndef OPENSSL_NO_DEPRECATED_3_0
     ADD_TEST(test_multi_downgrade_shared_pkey);
 #endif
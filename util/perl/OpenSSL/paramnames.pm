@@ -587,6 +587,9 @@ my %params = (
     'LIBSSL_RECORD_LAYER_PARAM_MAX_EARLY_DATA' => "max_early_data",
     'LIBSSL_RECORD_LAYER_PARAM_BLOCK_PADDING' =>  "block_padding",
     'LIBSSL_RECORD_LAYER_PARAM_HS_PADDING' =>     "hs_padding",
+    'LIBSSL_RECORD_LAYER_PARAM_DYN_REC_SIZE' =>   "dyn_rec_size",
+    'LIBSSL_RECORD_LAYER_PARAM_DYN_REC_THRESHOLD' => "dyn_rec_threshold",
+    'LIBSSL_RECORD_LAYER_PARAM_DYN_REC_IDLE' =>   "dyn_rec_idle_ms",
 );
 
 # Generate string based macros for public consumption